@@ -0,0 +1,171 @@
+#include <iostream>
+#include <iomanip>
+#include <charconv>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "karls_standard_library/charconv.hpp"
+
+namespace ksl = karls_standard_library;
+
+constexpr std::size_t count = 1000000;
+
+// run f over every input and report ns per value and output throughput
+template<typename F>
+void measure(const char* name, F f)
+{
+  auto begin = std::chrono::steady_clock::now();
+  std::size_t bytes = f();
+  auto end = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+  std::cout << "  " << std::left << std::setw(22) << name << std::right
+            << std::setw(8) << std::fixed << std::setprecision(1) << ns / count << " ns/value"
+            << std::setw(10) << std::setprecision(0) << bytes / (ns / 1e3) << " MB/s\n";
+}
+
+// the inputs as one text blob with offsets, for the parsing runs
+struct texts {
+  std::string blob;
+  std::vector<std::size_t> offsets;
+
+  const char* begin(std::size_t i) const { return blob.data() + offsets[i]; }
+  const char* end(std::size_t i) const { return blob.data() + offsets[i + 1] - 1; }
+};
+
+template<typename T>
+texts to_texts(const std::vector<T>& values)
+{
+  texts t;
+  char buffer[64];
+  for (T v : values)
+  {
+    t.offsets.push_back(t.blob.size());
+    t.blob.append(buffer, ksl::to_chars(buffer, buffer + sizeof(buffer), v).ptr);
+    t.blob.push_back('\0');
+  }
+  t.offsets.push_back(t.blob.size());
+  return t;
+}
+
+void integers()
+{
+  std::mt19937_64 rng(1);
+  std::vector<std::uint64_t> values(count);
+  // mixed widths, as ids, sizes and counters are
+  for (auto& v : values) v = rng() >> (rng() % 64);
+
+  std::cout << "uint64 to text\n";
+  char out[32];
+  measure("snprintf", [&] {
+    std::size_t bytes = 0;
+    for (std::uint64_t v : values) bytes += std::snprintf(out, sizeof(out), "%" PRIu64, v);
+    return bytes;
+  });
+  measure("std::to_chars", [&] {
+    std::size_t bytes = 0;
+    for (std::uint64_t v : values) bytes += std::to_chars(out, out + sizeof(out), v).ptr - out;
+    return bytes;
+  });
+  measure("to_chars", [&] {
+    std::size_t bytes = 0;
+    for (std::uint64_t v : values) bytes += ksl::to_chars(out, out + sizeof(out), v).ptr - out;
+    return bytes;
+  });
+
+  texts t = to_texts(values);
+  std::cout << "text to uint64\n";
+  measure("strtoull", [&] {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < count; ++i) sum += std::strtoull(t.begin(i), nullptr, 10);
+    if (sum == 42) std::cout << "";
+    return t.blob.size();
+  });
+  measure("std::from_chars", [&] {
+    std::uint64_t sum = 0, v = 0;
+    for (std::size_t i = 0; i < count; ++i) sum += (std::from_chars(t.begin(i), t.end(i), v), v);
+    if (sum == 42) std::cout << "";
+    return t.blob.size();
+  });
+  measure("from_chars", [&] {
+    std::uint64_t sum = 0, v = 0;
+    for (std::size_t i = 0; i < count; ++i) sum += (ksl::from_chars(t.begin(i), t.end(i), v), v);
+    if (sum == 42) std::cout << "";
+    return t.blob.size();
+  });
+}
+
+void doubles(const char* title, const std::vector<double>& values)
+{
+  std::cout << title << " to text\n";
+  char out[32];
+  // %.17g is what printf needs to round trip every double
+  measure("snprintf %.17g", [&] {
+    std::size_t bytes = 0;
+    for (double v : values) bytes += std::snprintf(out, sizeof(out), "%.17g", v);
+    return bytes;
+  });
+  measure("std::to_chars", [&] {
+    std::size_t bytes = 0;
+    for (double v : values) bytes += std::to_chars(out, out + sizeof(out), v).ptr - out;
+    return bytes;
+  });
+  measure("to_chars", [&] {
+    std::size_t bytes = 0;
+    for (double v : values) bytes += ksl::to_chars(out, out + sizeof(out), v).ptr - out;
+    return bytes;
+  });
+
+  texts t = to_texts(values);
+  std::cout << title << " from text\n";
+  measure("strtod", [&] {
+    double sum = 0;
+    for (std::size_t i = 0; i < count; ++i) sum += std::strtod(t.begin(i), nullptr);
+    if (sum == 42) std::cout << "";
+    return t.blob.size();
+  });
+  measure("std::from_chars", [&] {
+    double sum = 0, v = 0;
+    for (std::size_t i = 0; i < count; ++i) sum += (std::from_chars(t.begin(i), t.end(i), v), v);
+    if (sum == 42) std::cout << "";
+    return t.blob.size();
+  });
+  measure("from_chars", [&] {
+    double sum = 0, v = 0;
+    for (std::size_t i = 0; i < count; ++i) sum += (ksl::from_chars(t.begin(i), t.end(i), v), v);
+    if (sum == 42) std::cout << "";
+    return t.blob.size();
+  });
+}
+
+int main()
+{
+  std::cout << count << " values per run\n\n";
+  integers();
+
+  std::mt19937_64 rng(2);
+  std::vector<double> random_bits(count);
+  for (auto& v : random_bits)
+  {
+    // uniformly random finite bit patterns: full 17 digit significands
+    do
+    {
+      std::uint64_t bits = rng();
+      std::memcpy(&v, &bits, sizeof(v));
+    } while (!(v - v == 0));
+  }
+
+  // prices with two decimals: short texts, the common case in data files
+  std::vector<double> prices(count);
+  for (auto& v : prices) v = static_cast<double>(rng() % 10000000) / 100;
+
+  std::cout << '\n';
+  doubles("random double", random_bits);
+  std::cout << '\n';
+  doubles("price", prices);
+}
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "karls_standard_library/concurrent_unordered_map.hpp"
+
+using namespace karls_standard_library;
+
+constexpr size_t key_space = 1 << 16;
+constexpr size_t operations = 4'000'000;
+
+// single global lock around std::unordered_map, the baseline being replaced
+struct locked_std_map {
+  std::mutex mutex;
+  std::unordered_map<size_t, size_t> map;
+
+  bool find(size_t key)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return map.find(key) != map.end();
+  }
+  void insert_or_assign(size_t key, size_t value)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    map.insert_or_assign(key, value);
+  }
+};
+
+struct sharded_map {
+  concurrent_unordered_map<size_t, size_t> map;
+
+  bool find(size_t key) { return map.find(key).has_value(); }
+  void insert_or_assign(size_t key, size_t value) { map.insert_or_assign(key, value); }
+};
+
+// millions of operations per second with threads sharing the map; nine in
+// ten operations are lookups
+template<typename Map>
+double throughput(int threads)
+{
+  Map* m = new Map();
+  for (size_t k = 0; k < key_space; k += 2) m->insert_or_assign(k, k);
+
+  std::atomic<bool> start{false};
+  std::atomic<size_t> hits{0};
+  size_t per_thread = operations / threads;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([=, &start, &hits]() {
+      size_t state = 0x9e3779b97f4a7c15ull * (t + 1);
+      size_t found = 0;
+      while (!start.load(std::memory_order_acquire)) {}
+      for (size_t i = 0; i < per_thread; ++i)
+      {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        size_t key = (state >> 33) % key_space;
+        if ((state >> 20) % 10 == 0) m->insert_or_assign(key, i);
+        else found += m->find(key);
+      }
+      hits.fetch_add(found, std::memory_order_relaxed);
+    });
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  start.store(true, std::memory_order_release);
+  for (auto& w : workers) w.join();
+  auto end = std::chrono::steady_clock::now();
+  delete m;
+
+  double seconds = std::chrono::duration<double>(end - begin).count();
+  return (per_thread * threads) / seconds / 1e6;
+}
+
+int main()
+{
+  std::cout << "90% find / 10% insert_or_assign over " << key_space << " keys, Mops/s\n";
+  std::cout << std::setw(8) << "threads"
+            << std::setw(20) << "mutex+std::map"
+            << std::setw(20) << "sharded" << '\n';
+  for (int threads : {1, 2, 4, 8, 16, 32, 64})
+  {
+    std::cout << std::setw(8) << threads
+              << std::setw(20) << std::fixed << std::setprecision(2) << throughput<locked_std_map>(threads)
+              << std::setw(20) << throughput<sharded_map>(threads) << '\n';
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include "karls_standard_library/format.hpp"
+
+namespace ksl = karls_standard_library;
+
+constexpr int lines = 1000000;
+
+template<typename F>
+void measure(const char* name, F f)
+{
+  auto begin = std::chrono::steady_clock::now();
+  std::size_t bytes = f();
+  auto end = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+  std::cout << "  " << std::left << std::setw(30) << name << std::right
+            << std::setw(8) << std::fixed << std::setprecision(1) << ns / lines << " ns/line"
+            << "  (" << bytes << " bytes)\n";
+}
+
+int main()
+{
+  const char* path = "/api/v1/orders";
+  ksl::string user("alice");
+
+  std::cout << "one log line: request id, path, user, status, latency\n";
+
+  measure("snprintf into a buffer", [&] {
+    char buffer[256];
+    std::size_t bytes = 0;
+    for (int i = 0; i < lines; ++i)
+    {
+      bytes += std::snprintf(buffer, sizeof(buffer), "request %d %s user=%.*s status=%d took %g ms",
+                             i, path, static_cast<int>(user.size()), user.data(), 200, i * 0.125);
+    }
+    return bytes;
+  });
+
+  // the pattern format replaces: a fresh string grown piece by piece
+  measure("append chain, new string", [&] {
+    std::size_t bytes = 0;
+    for (int i = 0; i < lines; ++i)
+    {
+      ksl::string line;
+      line += "request ";
+      line.append_number(i);
+      line += " ";
+      line += path;
+      line += " user=";
+      line += user;
+      line += " status=";
+      line.append_number(200);
+      line += " took ";
+      line.append_number(i * 0.125);
+      line += " ms";
+      bytes += line.size();
+    }
+    return bytes;
+  });
+
+  measure("format, new string", [&] {
+    std::size_t bytes = 0;
+    for (int i = 0; i < lines; ++i)
+    {
+      ksl::string line = ksl::format<"request {} {} user={} status={} took {} ms">(i, path, user, 200, i * 0.125);
+      bytes += line.size();
+    }
+    return bytes;
+  });
+
+  measure("format_to, reused string", [&] {
+    std::size_t bytes = 0;
+    ksl::string line;
+    for (int i = 0; i < lines; ++i)
+    {
+      line.clear();
+      ksl::format_to<"request {} {} user={} status={} took {} ms">(line, i, path, user, 200, i * 0.125);
+      bytes += line.size();
+    }
+    return bytes;
+  });
+}
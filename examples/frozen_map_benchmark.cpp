@@ -0,0 +1,97 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "karls_standard_library/frozen_map.hpp"
+
+using namespace karls_standard_library;
+
+constexpr size_t lookups = 10'000'000;
+
+// keyword table built entirely at compile time
+constexpr auto keywords = make_frozen_map<string_view, int>({
+  {"if", 0}, {"else", 1}, {"while", 2}, {"for", 3}, {"return", 4},
+  {"break", 5}, {"continue", 6}, {"switch", 7}, {"case", 8}, {"default", 9}
+});
+
+template<typename F>
+double ns_per_lookup(F lookup)
+{
+  auto begin = std::chrono::steady_clock::now();
+  long sink = lookup();
+  auto end = std::chrono::steady_clock::now();
+  if (sink == -1) std::cout << "";
+  return std::chrono::duration<double, std::nano>(end - begin).count() / lookups;
+}
+
+// compare lookups of N generated keys, one probe in eight a miss
+template<size_t N>
+void run()
+{
+  std::vector<std::string> storage;
+  for (size_t i = 0; i < N; ++i) storage.push_back("identifier_" + std::to_string(i * 7919));
+  std::vector<std::string> probes;
+  for (size_t i = 0; i < 4096; ++i)
+  {
+    size_t k = (i * 2654435761u) % N;
+    probes.push_back(i % 8 == 0 ? storage[k] + "_" : storage[k]);
+  }
+
+  auto* items = new Pair<string_view, int>[1][N];
+  std::unordered_map<std::string_view, int> std_map;
+  for (size_t i = 0; i < N; ++i)
+  {
+    items[0][i] = Pair<string_view, int>(string_view(storage[i].data(), storage[i].size()), static_cast<int>(i));
+    std_map.emplace(storage[i], static_cast<int>(i));
+  }
+  auto* frozen = new frozen_map<string_view, int, N>(items[0]);
+
+  double std_ns = ns_per_lookup([&]() {
+    long sum = 0;
+    for (size_t i = 0; i < lookups; ++i)
+    {
+      const std::string& p = probes[i & 4095];
+      auto it = std_map.find(std::string_view(p));
+      if (it != std_map.end()) sum += it->second;
+    }
+    return sum;
+  });
+  double frozen_ns = ns_per_lookup([&]() {
+    long sum = 0;
+    for (size_t i = 0; i < lookups; ++i)
+    {
+      const std::string& p = probes[i & 4095];
+      if (const int* v = frozen->find(string_view(p.data(), p.size()))) sum += *v;
+    }
+    return sum;
+  });
+
+  std::cout << std::setw(8) << N
+            << std::setw(22) << std::fixed << std::setprecision(2) << std_ns
+            << std::setw(16) << frozen_ns << '\n';
+  delete frozen;
+  delete[] items;
+}
+
+int main()
+{
+  const char* words[] = {"while", "goto", "return", "default", "x", "continue", "case", "iff"};
+  double keyword_ns = ns_per_lookup([&]() {
+    long sum = 0;
+    for (size_t i = 0; i < lookups; ++i) sum += keywords.value_or(words[i & 7], -1);
+    return sum;
+  });
+  std::cout << "compile time keyword table: " << std::fixed << std::setprecision(2)
+            << keyword_ns << " ns/lookup\n\n";
+
+  std::cout << "ns per lookup, 1 in 8 misses\n";
+  std::cout << std::setw(8) << "keys" << std::setw(22) << "std::unordered_map" << std::setw(16) << "frozen_map" << '\n';
+  run<10>();
+  run<100>();
+  run<1000>();
+  run<10000>();
+  return 0;
+}
@@ -0,0 +1,80 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include "karls_standard_library/functional.hpp"
+#include "karls_standard_library/vector.hpp"
+
+using namespace karls_standard_library;
+
+constexpr size_t iterations = 10'000'000;
+
+// time body() over all iterations and return nanoseconds per iteration
+template<typename F>
+double time_per_op(F body)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) body(i);
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+}
+
+void report(const char* name, double ours, double theirs)
+{
+  std::cout << std::setw(28) << std::left << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(2) << ours
+            << std::setw(12) << theirs << "\n";
+}
+
+// calls through a callable reference so the call cannot be inlined away
+template<typename Callable>
+[[gnu::noinline]] long call(const Callable& f, long x) { return f(x); }
+
+[[gnu::noinline]] long call_ref(function_ref<long(long)> f, long x) { return f(x); }
+
+int main()
+{
+  long sink = 0;
+  long a = 1, b = 2, c = 3;
+
+  std::cout << std::setw(28) << std::left << "ns/op" << std::right
+            << std::setw(12) << "karls" << std::setw(12) << "std" << "\n";
+
+  // construction with a 24 byte capture; std::function allocates for it
+  report("construct 24 byte capture",
+    time_per_op([&](size_t i) {
+      function<long(long)> f = [a, b, i](long x) { return x + a + b + static_cast<long>(i); };
+      sink += call(f, 1);
+    }),
+    time_per_op([&](size_t i) {
+      std::function<long(long)> f = [a, b, i](long x) { return x + a + b + static_cast<long>(i); };
+      sink += call(f, 1);
+    }));
+
+  // move only callable with a 32 byte capture held in a 32 byte buffer
+  report("move_only construct + call",
+    time_per_op([&](size_t i) {
+      move_only_function<long(long), 32> f = [a, b, c, i](long x) { return x * a + b + c + static_cast<long>(i); };
+      sink += call(f, 1);
+    }),
+    time_per_op([&](size_t i) {
+      std::function<long(long)> f = [a, b, c, i](long x) { return x * a + b + c + static_cast<long>(i); };
+      sink += call(f, 1);
+    }));
+
+  // invocation of a long lived callable
+  function<long(long)> ours = [a, b](long x) { return x + a + b; };
+  std::function<long(long)> theirs = [a, b](long x) { return x + a + b; };
+  report("invoke",
+    time_per_op([&](size_t i) { sink += call(ours, static_cast<long>(i)); }),
+    time_per_op([&](size_t i) { sink += call(theirs, static_cast<long>(i)); }));
+
+  // function_ref against passing a std::function by reference
+  auto lambda = [a, b](long x) { return x ^ (a + b); };
+  report("function_ref invoke",
+    time_per_op([&](size_t i) { sink += call_ref(lambda, static_cast<long>(i)); }),
+    time_per_op([&](size_t i) { sink += call(theirs, static_cast<long>(i)); }));
+
+  std::cout << "checksum " << sink << "\n";
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include <string_view>
+#include "karls_standard_library/algorithm.hpp"
+#include "karls_standard_library/functional.hpp"
+#include "karls_standard_library/vector.hpp"
+
+using namespace karls_standard_library;
+
+// hash the same buffer repeatedly and report throughput in GB/s
+template<typename F>
+double throughput(const char* data, size_t len, F f)
+{
+  size_t rounds = max<size_t>(1, (size_t(1) << 30) / max<size_t>(len, 16));
+  size_t sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < rounds; ++i)
+  {
+    sink += f(data + (i & 7), len);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(stop - start).count();
+  if (sink == 42) std::cout << "";
+  return static_cast<double>(rounds * len) / seconds / 1e9;
+}
+
+int main()
+{
+  vector<char> buffer(size_t(1) << 20, 'a');
+  for (size_t i = 0; i < buffer.size(); ++i)
+  {
+    buffer[i] = static_cast<char>(i * 131 + 7);
+  }
+
+  std::cout << std::setw(10) << "bytes"
+            << std::setw(16) << "karls GB/s"
+            << std::setw(16) << "std GB/s" << "\n";
+  for (size_t len : {8, 16, 64, 256, 1024, 4096, 65536, 1 << 19})
+  {
+    double ours = throughput(buffer.data(), len, [](const char* p, size_t n) {
+      return hash_bytes(p, n);
+    });
+    double theirs = throughput(buffer.data(), len, [](const char* p, size_t n) {
+      return std::hash<std::string_view>{}(std::string_view(p, n));
+    });
+    std::cout << std::setw(10) << len
+              << std::setw(16) << std::fixed << std::setprecision(2) << ours
+              << std::setw(16) << theirs << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "karls_standard_library/algorithm.hpp"
+#include "karls_standard_library/integer_sets.hpp"
+
+namespace ksl = karls_standard_library;
+
+// n distinct sorted values below limit, like a posting list
+static std::vector<uint32_t> posting_list(std::mt19937& rng, std::size_t n, uint32_t limit)
+{
+  std::vector<uint32_t> values;
+  std::uniform_int_distribution<uint32_t> pick(0, limit - 1);
+  while (values.size() < n)
+  {
+    while (values.size() < n) values.push_back(pick(rng));
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+  }
+  return values;
+}
+
+template<typename F>
+double nanoseconds(F f, std::size_t& result)
+{
+  // repeat short runs so every ratio measures at least a few milliseconds
+  int repeats = 0;
+  auto begin = std::chrono::steady_clock::now();
+  auto end = begin;
+  do
+  {
+    result = f();
+    ++repeats;
+    end = std::chrono::steady_clock::now();
+  } while (end - begin < std::chrono::milliseconds(20));
+  return std::chrono::duration<double, std::nano>(end - begin).count() / repeats;
+}
+
+int main()
+{
+  constexpr std::size_t large_size = 4000000;
+  constexpr uint32_t universe = 40000000;
+  std::mt19937 rng(1);
+  std::vector<uint32_t> large = posting_list(rng, large_size, universe);
+  std::vector<uint32_t> out(large_size);
+
+  std::cout << "intersection of a " << large_size << " element list with a shorter one, us (lower is better)\n";
+  std::cout << std::left << std::setw(10) << "ratio" << std::right
+            << std::setw(12) << "std" << std::setw(12) << "ksl merge" << std::setw(12) << "scalar"
+#if defined(__AVX2__)
+            << std::setw(12) << "avx2"
+#endif
+            << std::setw(12) << "galloping" << std::setw(12) << "dispatch" << std::setw(12) << "count"
+            << std::setw(10) << "matches" << '\n';
+
+  for (std::size_t ratio : {1, 3, 10, 30, 100, 1000, 10000})
+  {
+    std::vector<uint32_t> small = posting_list(rng, large_size / ratio, universe);
+    const uint32_t* a = small.data();
+    const uint32_t* b = large.data();
+    std::size_t na = small.size();
+    std::size_t nb = large.size();
+    std::size_t matches = 0;
+
+    auto column = [&](auto f) {
+      std::cout << std::setw(12) << std::fixed << std::setprecision(1) << nanoseconds(f, matches) / 1000;
+    };
+
+    std::cout << std::left << std::setw(10) << ("1:" + std::to_string(ratio)) << std::right;
+    column([&] { return static_cast<std::size_t>(std::set_intersection(a, a + na, b, b + nb, out.data()) - out.data()); });
+    column([&] { return static_cast<std::size_t>(ksl::set_intersection(a, a + na, b, b + nb, out.data()) - out.data()); });
+    column([&] { return ksl::detail::intersect_scalar<true>(a, na, b, nb, out.data()); });
+#if defined(__AVX2__)
+    column([&] { return ksl::detail::intersect_avx2<true>(a, na, b, nb, out.data()); });
+#endif
+    column([&] { return ksl::detail::intersect_galloping<true>(a, na, b, nb, out.data()); });
+    column([&] { return ksl::intersect_sorted(a, na, b, nb, out.data()); });
+    column([&] { return ksl::intersection_size(a, na, b, nb); });
+    std::cout << std::setw(10) << matches << '\n';
+  }
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include "karls_standard_library/utility.hpp"
+#include "karls_standard_library/vector.hpp"
+
+namespace ksl = karls_standard_library;
+
+// the previous Pair: user provided copy / move operations make it non
+// trivially copyable, and the forwarding constructor assigns after
+// default constructing
+template<typename T1, typename T2>
+struct legacy_pair {
+  T1 first;
+  T2 second;
+
+  legacy_pair() : first(T1{}), second(T2{}) {}
+  template<typename U1, typename U2>
+  legacy_pair(U1&& x, U2&& y)
+  {
+    first = std::forward<U1>(x);
+    second = std::forward<U2>(y);
+  }
+  legacy_pair(const legacy_pair& p) : first(p.first), second(p.second) {}
+  legacy_pair(legacy_pair&& p) : first(std::move(p.first)), second(std::move(p.second)) {}
+  legacy_pair& operator=(const legacy_pair& p)
+  {
+    if (this != &p)
+    {
+      first = p.first;
+      second = p.second;
+    }
+    return *this;
+  }
+  legacy_pair& operator=(legacy_pair&& p) noexcept
+  {
+    first = std::move(p.first);
+    second = std::move(p.second);
+    return *this;
+  }
+  bool operator<(const legacy_pair& p) const { return first < p.first || (first == p.first && second < p.second); }
+};
+
+static_assert(!std::is_trivially_copyable_v<legacy_pair<int, int>>);
+static_assert(std::is_trivially_copyable_v<ksl::Pair<int, int>>);
+
+template<typename F>
+double milliseconds(F f)
+{
+  auto begin = std::chrono::steady_clock::now();
+  f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+// push_back without reserve: every growth step relocates the whole vector
+template<typename P>
+double growth(std::size_t n, int rounds)
+{
+  double total = 0;
+  for (int r = 0; r < rounds; ++r)
+  {
+    total += milliseconds([&] {
+      ksl::vector<P> v;
+      for (std::size_t i = 0; i < n; ++i) v.push_back(P(static_cast<int>(i), static_cast<int>(n - i)));
+      if (v.size() != n) std::cout << "";
+    });
+  }
+  return total / rounds;
+}
+
+template<typename P>
+double sorting(std::size_t n, int rounds)
+{
+  double total = 0;
+  for (int r = 0; r < rounds; ++r)
+  {
+    std::mt19937 rng(r);
+    ksl::vector<P> v;
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) v.push_back(P(static_cast<int>(rng() % 1000), static_cast<int>(rng())));
+    total += milliseconds([&] { std::sort(v.data(), v.data() + v.size()); });
+  }
+  return total / rounds;
+}
+
+template<typename P>
+void row(const char* name, std::size_t n)
+{
+  std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(12) << growth<P>(n, 5)
+            << std::setw(12) << sorting<P>(n, 5) << '\n';
+}
+
+int main()
+{
+  constexpr std::size_t n = 4000000;
+  std::cout << n << " pairs of ints, ms (lower is better)\n";
+  std::cout << std::left << std::setw(24) << "" << std::right << std::setw(12) << "growth" << std::setw(12) << "sort" << '\n';
+  row<legacy_pair<int, int>>("legacy Pair<int, int>", n);
+  row<ksl::Pair<int, int>>("Pair<int, int>", n);
+  row<std::pair<int, int>>("std::pair<int, int>", n);
+}
@@ -0,0 +1,179 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+#include "karls_standard_library/priority_queue.hpp"
+
+using namespace karls_standard_library;
+
+using distance_t = std::uint64_t;
+constexpr distance_t unreached = static_cast<distance_t>(-1);
+
+struct edge {
+  std::uint32_t to;
+  std::uint32_t weight;
+};
+
+// random graph in adjacency array form
+struct graph {
+  std::vector<std::uint32_t> first;
+  std::vector<edge> edges;
+};
+
+graph random_graph(std::uint32_t nodes, std::uint32_t degree)
+{
+  std::mt19937 rng(1);
+  graph g;
+  g.first.resize(nodes + 1);
+  for (std::uint32_t n = 0; n < nodes; ++n)
+  {
+    g.first[n] = static_cast<std::uint32_t>(g.edges.size());
+    for (std::uint32_t k = 0; k < degree; ++k) g.edges.push_back({static_cast<std::uint32_t>(rng() % nodes), 1 + static_cast<std::uint32_t>(rng() % 1000)});
+  }
+  g.first[nodes] = static_cast<std::uint32_t>(g.edges.size());
+  return g;
+}
+
+template<typename F>
+double milliseconds(F f)
+{
+  auto begin = std::chrono::steady_clock::now();
+  distance_t sink = f();
+  auto end = std::chrono::steady_clock::now();
+  if (sink == unreached) std::cout << "";
+  return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+// dijkstra with lazy deletion: push a new entry on every improvement and
+// skip stale entries when they surface
+template<typename Queue>
+distance_t dijkstra_lazy(const graph& g)
+{
+  std::vector<distance_t> dist(g.first.size() - 1, unreached);
+  Queue q;
+  dist[0] = 0;
+  q.push({0, 0});
+  while (!q.empty())
+  {
+    auto [d, n] = q.top();
+    q.pop();
+    if (d != dist[n]) continue;
+    for (std::uint32_t e = g.first[n]; e < g.first[n + 1]; ++e)
+    {
+      distance_t nd = d + g.edges[e].weight;
+      if (nd < dist[g.edges[e].to])
+      {
+        dist[g.edges[e].to] = nd;
+        q.push({nd, g.edges[e].to});
+      }
+    }
+  }
+  distance_t total = 0;
+  for (distance_t d : dist) total += d == unreached ? 0 : d;
+  return total;
+}
+
+// dijkstra with one entry per node and decrease_key
+distance_t dijkstra_indexed(const graph& g)
+{
+  size_t nodes = g.first.size() - 1;
+  std::vector<distance_t> dist(nodes, unreached);
+  std::vector<size_t> handle(nodes, npos);
+  std::vector<std::uint32_t> node_of;
+  indexed_priority_queue<distance_t, greater<distance_t>> q;
+  dist[0] = 0;
+  handle[0] = q.push(0);
+  node_of.push_back(0);
+  while (!q.empty())
+  {
+    std::uint32_t n = node_of[q.top_handle()];
+    distance_t d = q.take();
+    for (std::uint32_t e = g.first[n]; e < g.first[n + 1]; ++e)
+    {
+      std::uint32_t to = g.edges[e].to;
+      distance_t nd = d + g.edges[e].weight;
+      if (nd >= dist[to]) continue;
+      bool queued = dist[to] != unreached && q.contains(handle[to]) && node_of[handle[to]] == to;
+      dist[to] = nd;
+      if (queued)
+      {
+        q.decrease_key(handle[to], nd);
+      }
+      else
+      {
+        handle[to] = q.push(nd);
+        if (node_of.size() <= handle[to]) node_of.resize(handle[to] + 1);
+        node_of[handle[to]] = to;
+      }
+    }
+  }
+  distance_t total = 0;
+  for (distance_t d : dist) total += d == unreached ? 0 : d;
+  return total;
+}
+
+// timer wheel style hold model: a fixed population of deadlines, each step
+// fires the earliest and schedules a new one a random delay later
+template<typename Queue>
+distance_t timers(size_t population, size_t steps)
+{
+  std::mt19937_64 rng(2);
+  Queue q;
+  for (size_t i = 0; i < population; ++i) q.push(rng() % 1'000'000);
+  distance_t fired = 0;
+  for (size_t i = 0; i < steps; ++i)
+  {
+    distance_t now = q.top();
+    q.pop();
+    fired += now;
+    q.push(now + 1 + rng() % 1'000'000);
+  }
+  return fired;
+}
+
+using entry = std::pair<distance_t, std::uint32_t>;
+
+int main()
+{
+  std::cout << "dijkstra, ms (random graph, out degree 8)\n";
+  std::cout << std::setw(10) << "nodes" << std::setw(24) << "std::priority_queue"
+            << std::setw(18) << "priority_queue" << std::setw(26) << "indexed decrease_key" << '\n';
+  for (std::uint32_t nodes : {10'000u, 100'000u, 1'000'000u})
+  {
+    graph g = random_graph(nodes, 8);
+    double std_ms = milliseconds([&]() {
+      return dijkstra_lazy<std::priority_queue<entry, std::vector<entry>, std::greater<entry>>>(g);
+    });
+    double klib_ms = milliseconds([&]() {
+      return dijkstra_lazy<priority_queue<entry, greater<entry>>>(g);
+    });
+    double indexed_ms = milliseconds([&]() { return dijkstra_indexed(g); });
+    std::cout << std::setw(10) << nodes << std::fixed << std::setprecision(1)
+              << std::setw(24) << std_ms << std::setw(18) << klib_ms << std::setw(26) << indexed_ms << '\n';
+  }
+
+  std::cout << "\ntimers, ms for 5M fire / reschedule steps\n";
+  std::cout << std::setw(10) << "pending" << std::setw(24) << "std::priority_queue"
+            << std::setw(18) << "priority_queue" << std::setw(18) << "binary heap" << '\n';
+  for (size_t population : {1'000u, 100'000u, 1'000'000u})
+  {
+    size_t steps = 5'000'000;
+    double std_ms = milliseconds([&]() {
+      return timers<std::priority_queue<distance_t, std::vector<distance_t>, std::greater<distance_t>>>(population, steps);
+    });
+    double klib_ms = milliseconds([&]() {
+      return timers<priority_queue<distance_t, greater<distance_t>>>(population, steps);
+    });
+    double binary_ms = milliseconds([&]() {
+      return timers<priority_queue<distance_t, greater<distance_t>, 2>>(population, steps);
+    });
+    std::cout << std::setw(10) << population << std::fixed << std::setprecision(1)
+              << std::setw(24) << std_ms << std::setw(18) << klib_ms << std::setw(18) << binary_ms << '\n';
+  }
+  return 0;
+}
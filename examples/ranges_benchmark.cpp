@@ -0,0 +1,86 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include "karls_standard_library/ranges.hpp"
+#include "karls_standard_library/vector.hpp"
+
+namespace ksl = karls_standard_library;
+
+constexpr int rounds = 20;
+
+template<typename F>
+void measure(const char* name, F f)
+{
+  std::int64_t result = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) result += f();
+  auto end = std::chrono::steady_clock::now();
+  double ms = std::chrono::duration<double, std::milli>(end - begin).count() / rounds;
+  std::cout << "  " << std::left << std::setw(34) << name << std::right
+            << std::setw(8) << std::fixed << std::setprecision(2) << ms << " ms"
+            << "  (" << result / rounds << ")\n";
+}
+
+int main()
+{
+  constexpr std::size_t n = 10000000;
+  std::mt19937 rng(42);
+  ksl::vector<int> v;
+  v.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) v.push_back(static_cast<int>(rng() % 1000));
+
+  auto keep = [](int x) { return x % 3 != 0; };
+  auto scale = [](int x) { return static_cast<std::int64_t>(x) * 7 + 1; };
+
+  std::cout << "filter -> transform -> sum over " << n << " ints\n";
+
+  measure("hand written loop", [&] {
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+      if (keep(v[i])) sum += scale(v[i]);
+    }
+    return sum;
+  });
+
+  // the pattern the views replace: a vector per step
+  measure("intermediate vectors", [&] {
+    ksl::vector<int> kept;
+    for (int x : v) if (keep(x)) kept.push_back(x);
+    ksl::vector<std::int64_t> scaled;
+    scaled.reserve(kept.size());
+    for (int x : kept) scaled.push_back(scale(x));
+    std::int64_t sum = 0;
+    for (std::int64_t x : scaled) sum += x;
+    return sum;
+  });
+
+  measure("views::filter | views::transform", [&] {
+    std::int64_t sum = 0;
+    for (std::int64_t x : v | ksl::views::filter(keep) | ksl::views::transform(scale)) sum += x;
+    return sum;
+  });
+
+  measure("std::views::filter | transform", [&] {
+    std::int64_t sum = 0;
+    for (std::int64_t x : v | std::views::filter(keep) | std::views::transform(scale)) sum += x;
+    return sum;
+  });
+
+  std::cout << "enumerate + take over the same data\n";
+
+  measure("hand written loop", [&] {
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < n / 2; ++i) sum += static_cast<std::int64_t>(i) * v[i];
+    return sum;
+  });
+
+  measure("views::enumerate | views::take", [&] {
+    std::int64_t sum = 0;
+    for (auto [i, x] : v | ksl::views::enumerate | ksl::views::take(n / 2)) sum += i * x;
+    return sum;
+  });
+}
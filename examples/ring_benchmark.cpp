@@ -0,0 +1,131 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "karls_standard_library/ring_buffer.hpp"
+
+using namespace karls_standard_library;
+
+constexpr size_t messages = 5'000'000;
+
+// pin the calling thread to one core so producers and consumers never share
+void pin_to_core(unsigned core)
+{
+#if defined(__linux__)
+  unsigned cores = std::thread::hardware_concurrency();
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(core % (cores ? cores : 1), &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)core;
+#endif
+}
+
+// millions of messages per second through one ring with the given number
+// of producer and consumer threads
+template<typename Ring>
+double throughput(int producers, int consumers, size_t batch)
+{
+  Ring* ring = new Ring();
+  std::atomic<size_t> consumed{0};
+  std::atomic<bool> start{false};
+  size_t per_producer = messages / producers;
+  size_t total = per_producer * producers;
+
+  std::vector<std::thread> threads;
+  unsigned core = 0;
+  for (int p = 0; p < producers; ++p)
+  {
+    threads.emplace_back([=, &start]() {
+      pin_to_core(core);
+      std::vector<long> buffer(batch, 1);
+      while (!start.load(std::memory_order_acquire)) {}
+      for (size_t sent = 0; sent < per_producer;)
+      {
+        size_t n = ring->push_n(buffer.data(), min(batch, per_producer - sent));
+        if (n == 0) std::this_thread::yield();
+        sent += n;
+      }
+    });
+    ++core;
+  }
+  for (int c = 0; c < consumers; ++c)
+  {
+    threads.emplace_back([=, &start, &consumed]() {
+      pin_to_core(core);
+      std::vector<long> buffer(batch);
+      while (!start.load(std::memory_order_acquire)) {}
+      while (consumed.load(std::memory_order_relaxed) < total)
+      {
+        size_t n = ring->pop_n(buffer.data(), batch);
+        if (n == 0) std::this_thread::yield();
+        else consumed.fetch_add(n, std::memory_order_relaxed);
+      }
+    });
+    ++core;
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  start.store(true, std::memory_order_release);
+  for (std::thread& t : threads) t.join();
+  auto end = std::chrono::steady_clock::now();
+  delete ring;
+  return static_cast<double>(total) / std::chrono::duration<double>(end - begin).count() / 1e6;
+}
+
+// average one way latency in nanoseconds, measured as half a ping-pong
+// round trip between two pinned threads over a pair of spsc rings
+double latency()
+{
+  constexpr size_t rounds = 200'000;
+  auto* ping = new spsc_ring<long, 1024>();
+  auto* pong = new spsc_ring<long, 1024>();
+  std::thread echo([=]() {
+    pin_to_core(1);
+    long value;
+    for (size_t i = 0; i < rounds; ++i)
+    {
+      while (!ping->try_pop(value)) std::this_thread::yield();
+      while (!pong->try_push(value)) std::this_thread::yield();
+    }
+  });
+  pin_to_core(0);
+  auto begin = std::chrono::steady_clock::now();
+  long value;
+  for (size_t i = 0; i < rounds; ++i)
+  {
+    while (!ping->try_push(static_cast<long>(i))) std::this_thread::yield();
+    while (!pong->try_pop(value)) std::this_thread::yield();
+  }
+  auto end = std::chrono::steady_clock::now();
+  echo.join();
+  delete ping;
+  delete pong;
+  return std::chrono::duration<double, std::nano>(end - begin).count() / rounds / 2;
+}
+
+int main()
+{
+  std::cout << std::setw(20) << std::left << "Mmsg/s" << std::right
+            << std::setw(10) << "batch 1" << std::setw(10) << "batch 32" << "\n";
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::setw(20) << std::left << "spsc 1p/1c" << std::right
+            << std::setw(10) << throughput<spsc_ring<long, 4096>>(1, 1, 1)
+            << std::setw(10) << throughput<spsc_ring<long, 4096>>(1, 1, 32) << "\n";
+  for (int n : {1, 2, 4, 8})
+  {
+    std::cout << std::setw(20) << std::left
+              << ("mpmc " + std::to_string(n) + "p/" + std::to_string(n) + "c") << std::right
+              << std::setw(10) << throughput<mpmc_ring<long, 4096>>(n, n, 1)
+              << std::setw(10) << throughput<mpmc_ring<long, 4096>>(n, n, 32) << "\n";
+  }
+  std::cout << "spsc one way latency " << latency() << " ns\n";
+  return 0;
+}
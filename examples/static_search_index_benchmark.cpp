@@ -0,0 +1,68 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "karls_standard_library/algorithm.hpp"
+#include "karls_standard_library/static_search_index.hpp"
+
+namespace ksl = karls_standard_library;
+
+// average nanoseconds per lookup over all queries; the results are summed
+// so the searches cannot be dropped
+template<typename F>
+double nanoseconds(const std::vector<uint32_t>& queries, F f, std::size_t& checksum)
+{
+  std::size_t sum = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (uint32_t x : queries) sum += f(x);
+  auto end = std::chrono::steady_clock::now();
+  checksum = sum;
+  return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(queries.size());
+}
+
+// usage: static_search_index_benchmark [max bytes], default 1 GiB
+int main(int argc, char** argv)
+{
+  std::size_t max_bytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 30);
+  constexpr std::size_t query_count = 1000000;
+  std::mt19937 rng(3);
+
+  std::cout << "lower_bound over sorted uint32_t, ns per query (lower is better)\n";
+  std::cout << std::setw(12) << "array" << std::setw(12) << "std" << std::setw(12) << "ksl"
+            << std::setw(12) << "s+ tree" << std::setw(12) << "overhead" << '\n';
+
+  for (std::size_t bytes = 4096; bytes <= max_bytes; bytes *= 8)
+  {
+    // gaps of 0 to 15 keep duplicates and misses in the data
+    std::size_t n = bytes / sizeof(uint32_t);
+    std::vector<uint32_t> keys(n);
+    uint32_t value = 0;
+    std::uniform_int_distribution<uint32_t> gap(0, 15);
+    for (std::size_t i = 0; i < n; ++i) keys[i] = value += gap(rng);
+
+    std::vector<uint32_t> queries(query_count);
+    std::uniform_int_distribution<uint32_t> pick(0, value);
+    for (uint32_t& q : queries) q = pick(rng);
+
+    ksl::static_search_index<uint32_t> index(keys.data(), keys.size());
+    const uint32_t* first = keys.data();
+    const uint32_t* last = keys.data() + n;
+
+    std::size_t expected = 0;
+    std::size_t checksum = 0;
+    double by_std = nanoseconds(queries, [&](uint32_t x) { return static_cast<std::size_t>(std::lower_bound(first, last, x) - first); }, expected);
+    double by_ksl = nanoseconds(queries, [&](uint32_t x) { return static_cast<std::size_t>(ksl::lower_bound(first, last, x) - first); }, checksum);
+    if (checksum != expected) std::cout << "ksl::lower_bound mismatch\n";
+    double by_index = nanoseconds(queries, [&](uint32_t x) { return index.lower_bound(x); }, checksum);
+    if (checksum != expected) std::cout << "static_search_index mismatch\n";
+
+    std::string size = bytes >= (1u << 20) ? std::to_string(bytes >> 20) + " MiB" : std::to_string(bytes >> 10) + " KiB";
+    std::cout << std::setw(12) << size << std::fixed << std::setprecision(1)
+              << std::setw(12) << by_std << std::setw(12) << by_ksl << std::setw(12) << by_index
+              << std::setw(11) << 100.0 * static_cast<double>(index.memory_usage() - bytes) / static_cast<double>(bytes) << "%\n";
+  }
+}
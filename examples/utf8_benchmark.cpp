@@ -0,0 +1,82 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "karls_standard_library/utf8.hpp"
+
+namespace ksl = karls_standard_library;
+
+// throughput of f over bytes of input, in GB/s
+template<typename F>
+double gigabytes_per_second(std::size_t bytes, F f)
+{
+  std::size_t sink = 0;
+  int repeats = 0;
+  auto begin = std::chrono::steady_clock::now();
+  auto end = begin;
+  do
+  {
+    sink += f();
+    ++repeats;
+    end = std::chrono::steady_clock::now();
+  } while (end - begin < std::chrono::milliseconds(200));
+  if (sink == 1) std::cout << ' ';
+  return static_cast<double>(bytes) * repeats / std::chrono::duration<double, std::nano>(end - begin).count();
+}
+
+static std::string make_text(std::mt19937& rng, std::size_t bytes, const std::vector<const char*>& pieces)
+{
+  std::string text;
+  while (text.size() < bytes) text += pieces[rng() % pieces.size()];
+  return text;
+}
+
+int main()
+{
+  constexpr std::size_t bytes = 16 << 20;
+  std::mt19937 rng(17);
+  struct corpus {
+    const char* name;
+    std::string text;
+  };
+  corpus corpora[] = {
+    {"ascii", make_text(rng, bytes, {"the ", "quick ", "Brown ", "fox, ", "JUMPS\n"})},
+    {"latin", make_text(rng, bytes, {"caf\xc3\xa9 ", "na\xc3\xafve ", "stra\xc3\x9f" "e ", "word ", "text "})},
+    {"cjk", make_text(rng, bytes, {"\xe4\xb8\xad", "\xe6\x96\x87", "\xe5\xad\x97", "\xe3\x80\x82"})},
+    {"emoji", make_text(rng, bytes, {"\xf0\x9f\x98\x80", "\xf0\x9f\x8e\x89", "ok "})},
+  };
+
+  std::cout << "GB/s over " << (bytes >> 20) << " MiB of utf-8 (higher is better)\n";
+  std::cout << std::left << std::setw(8) << "text" << std::right
+            << std::setw(10) << "scalar" << std::setw(10) << "validate" << std::setw(10) << "count"
+            << std::setw(10) << "to 16" << std::setw(10) << "to 32" << std::setw(10) << "lower"
+            << std::setw(10) << "iequals" << '\n';
+
+  std::vector<char16_t> utf16(bytes + 64);
+  std::vector<char32_t> utf32(bytes + 64);
+  for (corpus& c : corpora)
+  {
+    const char* data = c.text.data();
+    std::size_t size = c.text.size();
+    std::string copy = c.text;
+    std::string other = c.text;
+    ksl::ascii::to_upper(other.data(), other.size());
+
+    std::cout << std::left << std::setw(8) << c.name << std::right << std::fixed << std::setprecision(2);
+    auto column = [&](auto f) { std::cout << std::setw(10) << gigabytes_per_second(size, f); };
+    column([&] { return static_cast<std::size_t>(ksl::detail::validate_utf8_scalar(data, size)); });
+    column([&] { return static_cast<std::size_t>(ksl::utf8::validate(data, size)); });
+    column([&] { return ksl::utf8::count_codepoints(data, size); });
+    column([&] { return ksl::utf8::to_utf16(data, size, utf16.data()).count; });
+    column([&] { return ksl::utf8::to_utf32(data, size, utf32.data()).count; });
+    column([&] {
+      ksl::ascii::to_lower(copy.data(), copy.size());
+      return static_cast<std::size_t>(copy[0]);
+    });
+    column([&] { return static_cast<std::size_t>(ksl::ascii::iequals(ksl::string_view(data, size), ksl::string_view(other.data(), other.size()))); });
+    std::cout << '\n';
+  }
+}
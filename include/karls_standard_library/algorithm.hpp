@@ -3,15 +3,19 @@
 
 #include <compare>
 #include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include "iterator.hpp"
 
 namespace karls_standard_library {
   template<typename T>
-  const T& min(const T& a, const T& b) 
+  constexpr const T& min(const T& a, const T& b) 
   {
     return (a < b) ? a : b;
   }
   template<typename T>
-  const T& max(const T& a, const T& b) 
+  constexpr const T& max(const T& a, const T& b) 
   {
     return (a > b) ? a : b;
   }
@@ -100,6 +104,328 @@ namespace karls_standard_library {
     return count;
   }
 
+  namespace detail {
+    // copying In to Out is a memmove when both are contiguous over the same
+    // trivially copyable type
+    template<typename In, typename Out>
+    inline constexpr bool is_memmove_copyable_v = [] {
+      if constexpr (std::contiguous_iterator<In> && std::contiguous_iterator<Out>)
+      {
+        using value = std::iter_value_t<In>;
+        using out_element = std::remove_reference_t<std::iter_reference_t<Out>>;
+        return std::is_trivially_copyable_v<value> && !std::is_const_v<out_element> &&
+               std::is_same_v<value, std::remove_cv_t<out_element>>;
+      }
+      else return false;
+    }();
+  }
+
+  // copy [first, last) to out; contiguous ranges of trivially copyable
+  // elements go through memmove, for any iterator type modeling
+  // contiguous_iterator and not only raw pointers
+  template<typename In, typename Out>
+  constexpr Out copy(In first, In last, Out out)
+  {
+    if constexpr (detail::is_memmove_copyable_v<In, Out>)
+    {
+      if (!std::is_constant_evaluated())
+      {
+        auto count = last - first;
+        if (count > 0)
+        {
+          __builtin_memmove(std::to_address(out), std::to_address(first), count * sizeof(std::iter_value_t<In>));
+        }
+        return out + count;
+      }
+    }
+    for (; first != last; ++first, ++out) *out = *first;
+    return out;
+  }
+
+  namespace detail {
+    // operator< for the sorted range algorithms called without a comparator
+    struct less_than {
+      template<typename T, typename U>
+      constexpr bool operator()(const T& a, const U& b) const { return a < b; }
+    };
+  }
+
+  // sorted range algorithms
+  //
+  // the inputs are sorted by comp (operator< when none is given); equal
+  // elements pair up one to one, so the multiset semantics match std.
+  // strictly increasing uint32_t ranges have faster kernels in
+  // integer_sets.hpp
+
+  // all elements of both ranges, in order
+  template<typename It1, typename It2, typename Out, typename Comp>
+  constexpr Out merge(It1 f1, It1 l1, It2 f2, It2 l2, Out out, Comp comp)
+  {
+    for (; f1 != l1; ++out)
+    {
+      if (f2 == l2) return karls_standard_library::copy(f1, l1, out);
+      if (comp(*f2, *f1))
+      {
+        *out = *f2;
+        ++f2;
+      }
+      else
+      {
+        *out = *f1;
+        ++f1;
+      }
+    }
+    return karls_standard_library::copy(f2, l2, out);
+  }
+  template<typename It1, typename It2, typename Out>
+  constexpr Out merge(It1 f1, It1 l1, It2 f2, It2 l2, Out out)
+  {
+    return karls_standard_library::merge(f1, l1, f2, l2, out, detail::less_than{});
+  }
+
+  // elements in either range; an element in both is written once
+  template<typename It1, typename It2, typename Out, typename Comp>
+  constexpr Out set_union(It1 f1, It1 l1, It2 f2, It2 l2, Out out, Comp comp)
+  {
+    for (; f1 != l1; ++out)
+    {
+      if (f2 == l2) return karls_standard_library::copy(f1, l1, out);
+      if (comp(*f2, *f1))
+      {
+        *out = *f2;
+        ++f2;
+      }
+      else
+      {
+        *out = *f1;
+        if (!comp(*f1, *f2)) ++f2;
+        ++f1;
+      }
+    }
+    return karls_standard_library::copy(f2, l2, out);
+  }
+  template<typename It1, typename It2, typename Out>
+  constexpr Out set_union(It1 f1, It1 l1, It2 f2, It2 l2, Out out)
+  {
+    return karls_standard_library::set_union(f1, l1, f2, l2, out, detail::less_than{});
+  }
+
+  // elements in both ranges, copied from the first
+  template<typename It1, typename It2, typename Out, typename Comp>
+  constexpr Out set_intersection(It1 f1, It1 l1, It2 f2, It2 l2, Out out, Comp comp)
+  {
+    while (f1 != l1 && f2 != l2)
+    {
+      if (comp(*f1, *f2)) ++f1;
+      else if (comp(*f2, *f1)) ++f2;
+      else
+      {
+        *out = *f1;
+        ++out;
+        ++f1;
+        ++f2;
+      }
+    }
+    return out;
+  }
+  template<typename It1, typename It2, typename Out>
+  constexpr Out set_intersection(It1 f1, It1 l1, It2 f2, It2 l2, Out out)
+  {
+    return karls_standard_library::set_intersection(f1, l1, f2, l2, out, detail::less_than{});
+  }
+
+  // elements of the first range that are not in the second
+  template<typename It1, typename It2, typename Out, typename Comp>
+  constexpr Out set_difference(It1 f1, It1 l1, It2 f2, It2 l2, Out out, Comp comp)
+  {
+    while (f1 != l1)
+    {
+      if (f2 == l2) return karls_standard_library::copy(f1, l1, out);
+      if (comp(*f1, *f2))
+      {
+        *out = *f1;
+        ++out;
+        ++f1;
+      }
+      else
+      {
+        if (!comp(*f2, *f1)) ++f1;
+        ++f2;
+      }
+    }
+    return out;
+  }
+  template<typename It1, typename It2, typename Out>
+  constexpr Out set_difference(It1 f1, It1 l1, It2 f2, It2 l2, Out out)
+  {
+    return karls_standard_library::set_difference(f1, l1, f2, l2, out, detail::less_than{});
+  }
+
+  // true if every element of the second range is in the first
+  template<typename It1, typename It2, typename Comp>
+  constexpr bool includes(It1 f1, It1 l1, It2 f2, It2 l2, Comp comp)
+  {
+    for (; f2 != l2; ++f1)
+    {
+      if (f1 == l1 || comp(*f2, *f1)) return false;
+      if (!comp(*f1, *f2)) ++f2;
+    }
+    return true;
+  }
+  template<typename It1, typename It2>
+  constexpr bool includes(It1 f1, It1 l1, It2 f2, It2 l2)
+  {
+    return karls_standard_library::includes(f1, l1, f2, l2, detail::less_than{});
+  }
+
+  // remove consecutive equal elements, returning the new end; the
+  // elements past it are left moved from
+  template<typename It, typename Pred>
+  constexpr It unique(It first, It last, Pred pred)
+  {
+    if (first == last) return last;
+    It result = first;
+    while (++first != last)
+    {
+      if (!pred(*result, *first) && ++result != first) *result = karls_standard_library::move(*first);
+    }
+    return ++result;
+  }
+  template<typename It>
+  constexpr It unique(It first, It last)
+  {
+    return karls_standard_library::unique(first, last, [](const auto& a, const auto& b) { return a == b; });
+  }
+
+  // binary search
+  //
+  // random access ranges are searched without data dependent branches: the
+  // midpoint comparison picks the next half arithmetically, so every lookup
+  // costs the same log2(n) steps and no mispredictions. contiguous ranges
+  // also prefetch both candidate midpoints of the next step while the
+  // current one loads. while the range is larger than the l2 cache the
+  // steps branch instead, since a predicted branch lets the cpu start the
+  // loads of several levels ahead, which a one level prefetch cannot.
+  // static_search_index is much faster than either for repeated lookups
+  namespace detail {
+    // first element of [first, first + n) for which go_right is false,
+    // where go_right is true for a prefix of the range
+    template<typename It, typename Pred>
+    constexpr It branchless_partition_point(It first, std::iter_difference_t<It> n, Pred go_right)
+    {
+      if constexpr (std::contiguous_iterator<It>)
+      {
+        if (!std::is_constant_evaluated())
+        {
+          constexpr size_t branching_bytes = size_t(256) << 10;
+          while (static_cast<size_t>(n) * sizeof(std::iter_value_t<It>) > branching_bytes)
+          {
+            auto half = n / 2;
+            if (go_right(first[half - 1])) first += half;
+            n -= half;
+          }
+        }
+      }
+      while (n > 1)
+      {
+        auto half = n / 2;
+        if constexpr (std::contiguous_iterator<It>)
+        {
+          // prefetching only pays off while the range spans many lines
+          if (!std::is_constant_evaluated() && static_cast<size_t>(n) * sizeof(std::iter_value_t<It>) > 4096)
+          {
+            auto next = (n - half) / 2;
+            __builtin_prefetch(std::to_address(first) + next);
+            __builtin_prefetch(std::to_address(first) + half + next);
+          }
+        }
+        // an arithmetic step rather than a ternary, which gcc turns back
+        // into a branch
+        first += static_cast<std::iter_difference_t<It>>(go_right(first[half - 1])) * half;
+        n -= half;
+      }
+      if (n == 1) first += static_cast<std::iter_difference_t<It>>(go_right(*first));
+      return first;
+    }
+  }
+
+  // first element for which pred is false, in a range where pred is true
+  // for a prefix
+  template<typename It, typename Pred>
+  constexpr It partition_point(It first, It last, Pred pred)
+  {
+    if constexpr (std::random_access_iterator<It>)
+    {
+      return detail::branchless_partition_point(first, last - first, pred);
+    }
+    else
+    {
+      auto n = karls_standard_library::distance(first, last);
+      while (n > 0)
+      {
+        auto half = n / 2;
+        It middle = karls_standard_library::next(first, half);
+        if (pred(*middle))
+        {
+          first = ++middle;
+          n -= half + 1;
+        }
+        else n = half;
+      }
+      return first;
+    }
+  }
+
+  // first element not less than value
+  template<typename It, typename T, typename Comp>
+  constexpr It lower_bound(It first, It last, const T& value, Comp comp)
+  {
+    return karls_standard_library::partition_point(first, last, [&](const auto& e) { return comp(e, value); });
+  }
+  template<typename It, typename T>
+  constexpr It lower_bound(It first, It last, const T& value)
+  {
+    return karls_standard_library::lower_bound(first, last, value, detail::less_than{});
+  }
+
+  // first element greater than value
+  template<typename It, typename T, typename Comp>
+  constexpr It upper_bound(It first, It last, const T& value, Comp comp)
+  {
+    return karls_standard_library::partition_point(first, last, [&](const auto& e) { return !comp(value, e); });
+  }
+  template<typename It, typename T>
+  constexpr It upper_bound(It first, It last, const T& value)
+  {
+    return karls_standard_library::upper_bound(first, last, value, detail::less_than{});
+  }
+
+  // the subrange of elements equal to value
+  template<typename It, typename T, typename Comp>
+  constexpr Pair<It, It> equal_range(It first, It last, const T& value, Comp comp)
+  {
+    It lower = karls_standard_library::lower_bound(first, last, value, comp);
+    return Pair<It, It>(lower, karls_standard_library::upper_bound(lower, last, value, comp));
+  }
+  template<typename It, typename T>
+  constexpr Pair<It, It> equal_range(It first, It last, const T& value)
+  {
+    return karls_standard_library::equal_range(first, last, value, detail::less_than{});
+  }
+
+  // true if an element equal to value is in the range
+  template<typename It, typename T, typename Comp>
+  constexpr bool binary_search(It first, It last, const T& value, Comp comp)
+  {
+    first = karls_standard_library::lower_bound(first, last, value, comp);
+    return first != last && !comp(value, *first);
+  }
+  template<typename It, typename T>
+  constexpr bool binary_search(It first, It last, const T& value)
+  {
+    return karls_standard_library::binary_search(first, last, value, detail::less_than{});
+  }
+
   template<typename It1, typename It2>
   constexpr bool equal(It1 f1, It1 l1, It2 f2)
   {
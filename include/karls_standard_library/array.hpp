@@ -4,6 +4,8 @@
 #include "cstddef.hpp"
 #include "utility.hpp"
 #include "algorithm.hpp"
+#include "functional.hpp"
+#include "iterator.hpp"
 #include <initializer_list>
 #include <stdexcept>
 #include <type_traits>
@@ -20,14 +22,24 @@ namespace karls_standard_library {
     using const_pointer = const value_type*;
     using iterator = value_type*;
     using const_iterator = const value_type*;
+    using reverse_iterator = karls_standard_library::reverse_iterator<iterator>;
+    using const_reverse_iterator = karls_standard_library::reverse_iterator<const_iterator>;
 
-    iterator begin() { return data_; }
-    const_iterator begin() const { return data_; }
-    const_iterator cbegin() const { return data_; }
+    constexpr iterator begin() { return data_; }
+    constexpr const_iterator begin() const { return data_; }
+    constexpr const_iterator cbegin() const { return data_; }
 
-    iterator end() { return data_ + N; }
-    const_iterator end() const { return data_ + N; }
-    const_iterator cend() const { return data_ + N; }
+    constexpr iterator end() { return data_ + N; }
+    constexpr const_iterator end() const { return data_ + N; }
+    constexpr const_iterator cend() const { return data_ + N; }
+
+    constexpr reverse_iterator rbegin() { return reverse_iterator(end()); }
+    constexpr const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    constexpr const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+
+    constexpr reverse_iterator rend() { return reverse_iterator(begin()); }
+    constexpr const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    constexpr const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
   private:
     T data_[N];
   public:
@@ -35,7 +47,7 @@ namespace karls_standard_library {
     array() = default;
 
     // brace initialization
-    array(std::initializer_list<T> init) 
+    constexpr array(std::initializer_list<T> init) 
     {
       size_t i = 0;
       for (const T& value : init) 
@@ -49,7 +61,7 @@ namespace karls_standard_library {
     }
 
     // fill constructor
-    explicit array(const T& value)
+    constexpr explicit array(const T& value)
     {
       for (size_t i = 0; i < N; ++i)
       {
@@ -58,18 +70,18 @@ namespace karls_standard_library {
     }
 
     constexpr size_type size() const noexcept { return N; }
-    reference operator[](size_t index) noexcept { return data_[index]; }
-    const_reference operator[](size_t index) const noexcept { return data_[index]; }
+    constexpr reference operator[](size_t index) noexcept { return data_[index]; }
+    constexpr const_reference operator[](size_t index) const noexcept { return data_[index]; }
     constexpr bool empty() const noexcept { return N == 0; }
-    reference front() noexcept { return data_[0]; }
-    const_reference front() const noexcept { return data_[0]; }
-    reference back() noexcept{ return data_[N - 1]; }
-    const_reference back() const noexcept { return data_[N - 1]; }
+    constexpr reference front() noexcept { return data_[0]; }
+    constexpr const_reference front() const noexcept { return data_[0]; }
+    constexpr reference back() noexcept{ return data_[N - 1]; }
+    constexpr const_reference back() const noexcept { return data_[N - 1]; }
 
-    pointer data() noexcept { return data_; }
-    const_pointer data() const noexcept { return data_; }
+    constexpr pointer data() noexcept { return data_; }
+    constexpr const_pointer data() const noexcept { return data_; }
 
-    reference at(size_t index) 
+    constexpr reference at(size_t index) 
     {
       if (index >= N) 
       {
@@ -77,7 +89,7 @@ namespace karls_standard_library {
       }
       return data_[index];
     }
-    const_reference at(size_t index) const 
+    constexpr const_reference at(size_t index) const 
     {
       if (index >= N) 
       {
@@ -86,14 +98,14 @@ namespace karls_standard_library {
       return data_[index];
     }
 
-    void fill(const T& value) noexcept 
+    constexpr void fill(const T& value) noexcept 
     {
       for (size_t i = 0; i < N; ++i) {
         data_[i] = value;
       }
     }
 
-    void swap(array& other) noexcept(std::is_nothrow_swappable_v<T>)
+    constexpr void swap(array& other) noexcept(std::is_nothrow_swappable_v<T>)
     {
       for(size_t i = 0; i < N; ++i)
       {
@@ -117,11 +129,20 @@ namespace karls_standard_library {
 
   // non-member swap
   template<typename T, size_t N>
-  void swap(array<T, N>& lhs, array<T, N>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+  constexpr void swap(array<T, N>& lhs, array<T, N>& rhs) noexcept(noexcept(lhs.swap(rhs)))
   {
     lhs.swap(rhs);
   }
 
+  // hash of the elements in order
+  template<typename T, size_t N>
+  struct hash<array<T, N>> {
+    size_t operator()(const array<T, N>& a) const noexcept
+    {
+      return hash_range(a.data(), N);
+    }
+  };
+
   // convert cstyle arrays to array
   template<typename T, size_t N>
   constexpr array<std::remove_cv_t<T>, N> to_array(T(&a)[N])
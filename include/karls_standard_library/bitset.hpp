@@ -0,0 +1,582 @@
+#ifndef KARLS_STANDARD_LIBRARY_BITSET_HPP
+#define KARLS_STANDARD_LIBRARY_BITSET_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "algorithm.hpp"
+#include "vector.hpp"
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace karls_standard_library {
+  namespace detail {
+    using word = std::uint64_t;
+
+    inline constexpr size_t word_bits = 64;
+
+    constexpr size_t words_for(size_t bits) noexcept { return (bits + word_bits - 1) / word_bits; }
+
+    // mask of the bits of the last word that belong to a set of n bits; an
+    // empty set keeps none, even though bitset<0> still has a storage word
+    constexpr word tail_mask(size_t bits) noexcept
+    {
+      if (bits == 0) return 0;
+      return (bits % word_bits) ? (word(1) << (bits % word_bits)) - 1 : ~word(0);
+    }
+
+#if defined(__AVX2__)
+    // popcount of 32 bytes with a nibble lookup table, summed into four
+    // 64 bit lanes
+    inline __m256i popcount_lanes(__m256i v) noexcept
+    {
+      const __m256i table = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+      const __m256i low = _mm256_set1_epi8(0x0f);
+      __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+      __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+      return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+    }
+#endif
+
+    // number of set bits in n words
+    constexpr size_t popcount_words(const word* w, size_t n) noexcept
+    {
+      size_t total = 0;
+      size_t i = 0;
+#if defined(__AVX2__)
+      if (!std::is_constant_evaluated())
+      {
+        __m256i acc = _mm256_setzero_si256();
+        // whole blocks of four words; the scalar loop below continues from i
+        size_t blocks_end = n & ~size_t(3);
+        for (; i < blocks_end; i += 4)
+        {
+          __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+          acc = _mm256_add_epi64(acc, popcount_lanes(v));
+        }
+        total = static_cast<size_t>(_mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1)
+                                  + _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3));
+      }
+#endif
+      for (; i < n; ++i) total += static_cast<size_t>(std::popcount(w[i]));
+      return total;
+    }
+
+    // dst = op(dst, src) over n words
+    enum class bit_op { op_and, op_or, op_xor, op_and_not };
+
+    template<bit_op Op>
+    constexpr word apply_bit_op(word a, word b) noexcept
+    {
+      if constexpr (Op == bit_op::op_and) return a & b;
+      else if constexpr (Op == bit_op::op_or) return a | b;
+      else if constexpr (Op == bit_op::op_xor) return a ^ b;
+      else return a & ~b;
+    }
+
+    template<bit_op Op>
+    constexpr void combine_words(word* dst, const word* src, size_t n) noexcept
+    {
+      size_t i = 0;
+#if defined(__AVX2__)
+      if (!std::is_constant_evaluated())
+      {
+        size_t blocks_end = n & ~size_t(3);
+        for (; i < blocks_end; i += 4)
+        {
+          __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+          __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+          __m256i r;
+          if constexpr (Op == bit_op::op_and) r = _mm256_and_si256(a, b);
+          else if constexpr (Op == bit_op::op_or) r = _mm256_or_si256(a, b);
+          else if constexpr (Op == bit_op::op_xor) r = _mm256_xor_si256(a, b);
+          else r = _mm256_andnot_si256(b, a);
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+        }
+      }
+#endif
+      for (; i < n; ++i) dst[i] = apply_bit_op<Op>(dst[i], src[i]);
+    }
+
+    // index of the first set bit at or after pos, npos if there is none
+    constexpr size_t find_set_bit(const word* w, size_t n, size_t pos) noexcept
+    {
+      size_t i = pos / word_bits;
+      if (i >= n) return npos;
+      word current = w[i] & (~word(0) << (pos % word_bits));
+      while (current == 0)
+      {
+        if (++i == n) return npos;
+        current = w[i];
+      }
+      return i * word_bits + static_cast<size_t>(std::countr_zero(current));
+    }
+
+    // position of the k-th (0 based) set bit of x
+    constexpr size_t select_in_word(word x, size_t k) noexcept
+    {
+#if defined(__BMI2__)
+      if (!std::is_constant_evaluated())
+      {
+        return static_cast<size_t>(std::countr_zero(_pdep_u64(word(1) << k, x)));
+      }
+#endif
+      for (; k > 0; --k) x &= x - 1;
+      return static_cast<size_t>(std::countr_zero(x));
+    }
+
+    // proxy returned by the mutable operator[] of the bit containers
+    class bit_reference {
+    private:
+      word* word_;
+      word mask_;
+    public:
+      constexpr bit_reference(word* w, size_t bit) noexcept : word_(w), mask_(word(1) << bit) {}
+
+      constexpr operator bool() const noexcept { return (*word_ & mask_) != 0; }
+      constexpr bool operator~() const noexcept { return (*word_ & mask_) == 0; }
+      constexpr bit_reference& operator=(bool value) noexcept
+      {
+        if (value) *word_ |= mask_;
+        else *word_ &= ~mask_;
+        return *this;
+      }
+      constexpr bit_reference& operator=(const bit_reference& other) noexcept
+      {
+        return *this = static_cast<bool>(other);
+      }
+      constexpr bit_reference& flip() noexcept
+      {
+        *word_ ^= mask_;
+        return *this;
+      }
+    };
+  }
+
+  // fixed size set of N bits packed into 64 bit words
+  template<size_t N>
+  class bitset {
+  public:
+    using word_type = std::uint64_t;
+    using reference = detail::bit_reference;
+
+    static constexpr size_t word_count = N == 0 ? 1 : detail::words_for(N);
+  private:
+    word_type words_[word_count];
+
+    // keep the unused high bits of the last word clear
+    constexpr void trim() noexcept { words_[word_count - 1] &= detail::tail_mask(N); }
+  public:
+    // default constructor; all bits clear
+    constexpr bitset() noexcept : words_() {}
+
+    // low bits from value
+    constexpr bitset(unsigned long long value) noexcept : words_()
+    {
+      words_[0] = value;
+      trim();
+    }
+
+    // element access
+    constexpr bool operator[](size_t pos) const noexcept
+    {
+      return (words_[pos / detail::word_bits] >> (pos % detail::word_bits)) & 1;
+    }
+    constexpr reference operator[](size_t pos) noexcept
+    {
+      return reference(&words_[pos / detail::word_bits], pos % detail::word_bits);
+    }
+    constexpr bool test(size_t pos) const
+    {
+      if (pos >= N) throw std::out_of_range("bit index out of bounds");
+      return (*this)[pos];
+    }
+
+    // modifiers
+    constexpr bitset& set() noexcept
+    {
+      for (size_t i = 0; i < word_count; ++i) words_[i] = ~word_type(0);
+      trim();
+      return *this;
+    }
+    constexpr bitset& set(size_t pos, bool value = true) noexcept
+    {
+      (*this)[pos] = value;
+      return *this;
+    }
+    constexpr bitset& reset() noexcept
+    {
+      for (size_t i = 0; i < word_count; ++i) words_[i] = 0;
+      return *this;
+    }
+    constexpr bitset& reset(size_t pos) noexcept { return set(pos, false); }
+    constexpr bitset& flip() noexcept
+    {
+      for (size_t i = 0; i < word_count; ++i) words_[i] = ~words_[i];
+      trim();
+      return *this;
+    }
+    constexpr bitset& flip(size_t pos) noexcept
+    {
+      words_[pos / detail::word_bits] ^= word_type(1) << (pos % detail::word_bits);
+      return *this;
+    }
+
+    // whole set operations
+    constexpr bitset& operator&=(const bitset& other) noexcept
+    {
+      detail::combine_words<detail::bit_op::op_and>(words_, other.words_, word_count);
+      return *this;
+    }
+    constexpr bitset& operator|=(const bitset& other) noexcept
+    {
+      detail::combine_words<detail::bit_op::op_or>(words_, other.words_, word_count);
+      return *this;
+    }
+    constexpr bitset& operator^=(const bitset& other) noexcept
+    {
+      detail::combine_words<detail::bit_op::op_xor>(words_, other.words_, word_count);
+      return *this;
+    }
+    // clear every bit that is set in other
+    constexpr bitset& and_not(const bitset& other) noexcept
+    {
+      detail::combine_words<detail::bit_op::op_and_not>(words_, other.words_, word_count);
+      return *this;
+    }
+    constexpr bitset operator~() const noexcept { return bitset(*this).flip(); }
+
+    // observers
+    static constexpr size_t size() noexcept { return N; }
+    constexpr size_t count() const noexcept { return detail::popcount_words(words_, word_count); }
+    constexpr bool any() const noexcept
+    {
+      for (size_t i = 0; i < word_count; ++i)
+      {
+        if (words_[i]) return true;
+      }
+      return false;
+    }
+    constexpr bool none() const noexcept { return !any(); }
+    constexpr bool all() const noexcept { return count() == N; }
+
+    // index of the first set bit, or of the first one after pos; npos if
+    // there is none
+    constexpr size_t find_first() const noexcept { return detail::find_set_bit(words_, word_count, 0); }
+    constexpr size_t find_next(size_t pos) const noexcept
+    {
+      return pos + 1 >= N ? npos : detail::find_set_bit(words_, word_count, pos + 1);
+    }
+
+    // underlying words, least significant bit first
+    constexpr const word_type* data() const noexcept { return words_; }
+    constexpr word_type* data() noexcept { return words_; }
+
+    constexpr bool operator==(const bitset& other) const noexcept
+    {
+      for (size_t i = 0; i < word_count; ++i)
+      {
+        if (words_[i] != other.words_[i]) return false;
+      }
+      return true;
+    }
+  };
+
+  template<size_t N>
+  constexpr bitset<N> operator&(const bitset<N>& lhs, const bitset<N>& rhs) noexcept
+  {
+    return bitset<N>(lhs) &= rhs;
+  }
+  template<size_t N>
+  constexpr bitset<N> operator|(const bitset<N>& lhs, const bitset<N>& rhs) noexcept
+  {
+    return bitset<N>(lhs) |= rhs;
+  }
+  template<size_t N>
+  constexpr bitset<N> operator^(const bitset<N>& lhs, const bitset<N>& rhs) noexcept
+  {
+    return bitset<N>(lhs) ^= rhs;
+  }
+
+  // growable set of bits packed into 64 bit words
+  //
+  // bits past size() in the last word are always clear, so whole word
+  // operations (count, compare, find) need no masking
+  class dynamic_bitset {
+  public:
+    using word_type = std::uint64_t;
+    using reference = detail::bit_reference;
+  private:
+    vector<word_type> words_;
+    size_t size_;
+
+    void trim() noexcept
+    {
+      if (!words_.empty()) words_.back() &= detail::tail_mask(size_);
+    }
+
+    void check_size(const dynamic_bitset& other) const
+    {
+      if (size_ != other.size_) throw std::invalid_argument("bitset sizes differ");
+    }
+
+    template<detail::bit_op Op>
+    dynamic_bitset& combine(const dynamic_bitset& other)
+    {
+      check_size(other);
+      detail::combine_words<Op>(words_.data(), other.words_.data(), words_.size());
+      return *this;
+    }
+  public:
+    // default constructor
+    dynamic_bitset() : words_(), size_(0) {}
+
+    // count bits, all set to value
+    explicit dynamic_bitset(size_t count, bool value = false) :
+      words_(detail::words_for(count), value ? ~word_type(0) : word_type(0)), size_(count)
+    {
+      trim();
+    }
+
+    // element access
+    bool operator[](size_t pos) const noexcept
+    {
+      return (words_[pos / detail::word_bits] >> (pos % detail::word_bits)) & 1;
+    }
+    reference operator[](size_t pos) noexcept
+    {
+      return reference(&words_[pos / detail::word_bits], pos % detail::word_bits);
+    }
+    bool test(size_t pos) const
+    {
+      if (pos >= size_) throw std::out_of_range("bit index out of bounds");
+      return (*this)[pos];
+    }
+
+    // capacity functions
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_t capacity() const noexcept { return words_.capacity() * detail::word_bits; }
+    void reserve(size_t bits) { words_.reserve(detail::words_for(bits)); }
+
+    // modifiers
+    void resize(size_t count, bool value = false)
+    {
+      size_t old = size_;
+      size_t words = detail::words_for(count);
+      if (words < words_.size())
+      {
+        while (words_.size() > words) words_.pop_back();
+      }
+      else if (words > words_.size())
+      {
+        word_type fill = value ? ~word_type(0) : word_type(0);
+        while (words_.size() < words) words_.push_back(fill);
+      }
+      size_ = count;
+      // bits of the old last word that are now in range
+      if (value && count > old && old % detail::word_bits)
+      {
+        words_[old / detail::word_bits] |= ~word_type(0) << (old % detail::word_bits);
+      }
+      trim();
+    }
+    void push_back(bool value)
+    {
+      if (size_ % detail::word_bits == 0) words_.push_back(0);
+      if (value) words_.back() |= word_type(1) << (size_ % detail::word_bits);
+      ++size_;
+    }
+    // remove the last bit; like vector::pop_back, a no-op when empty
+    void pop_back() noexcept
+    {
+      if (size_ == 0) return;
+      --size_;
+      if (size_ % detail::word_bits == 0) words_.pop_back();
+      else trim();
+    }
+    void clear() noexcept
+    {
+      words_.clear();
+      size_ = 0;
+    }
+
+    dynamic_bitset& set() noexcept
+    {
+      for (size_t i = 0; i < words_.size(); ++i) words_[i] = ~word_type(0);
+      trim();
+      return *this;
+    }
+    dynamic_bitset& set(size_t pos, bool value = true) noexcept
+    {
+      (*this)[pos] = value;
+      return *this;
+    }
+    dynamic_bitset& reset() noexcept
+    {
+      for (size_t i = 0; i < words_.size(); ++i) words_[i] = 0;
+      return *this;
+    }
+    dynamic_bitset& reset(size_t pos) noexcept { return set(pos, false); }
+    dynamic_bitset& flip() noexcept
+    {
+      for (size_t i = 0; i < words_.size(); ++i) words_[i] = ~words_[i];
+      trim();
+      return *this;
+    }
+    dynamic_bitset& flip(size_t pos) noexcept
+    {
+      words_[pos / detail::word_bits] ^= word_type(1) << (pos % detail::word_bits);
+      return *this;
+    }
+
+    // whole set operations; both sets must have the same size
+    dynamic_bitset& operator&=(const dynamic_bitset& other) { return combine<detail::bit_op::op_and>(other); }
+    dynamic_bitset& operator|=(const dynamic_bitset& other) { return combine<detail::bit_op::op_or>(other); }
+    dynamic_bitset& operator^=(const dynamic_bitset& other) { return combine<detail::bit_op::op_xor>(other); }
+    // clear every bit that is set in other
+    dynamic_bitset& and_not(const dynamic_bitset& other) { return combine<detail::bit_op::op_and_not>(other); }
+    dynamic_bitset operator~() const { return dynamic_bitset(*this).flip(); }
+
+    // observers
+    size_t count() const noexcept { return detail::popcount_words(words_.data(), words_.size()); }
+    bool any() const noexcept
+    {
+      for (size_t i = 0; i < words_.size(); ++i)
+      {
+        if (words_[i]) return true;
+      }
+      return false;
+    }
+    bool none() const noexcept { return !any(); }
+    bool all() const noexcept { return count() == size_; }
+
+    // index of the first set bit, or of the first one after pos; npos if
+    // there is none
+    size_t find_first() const noexcept { return detail::find_set_bit(words_.data(), words_.size(), 0); }
+    size_t find_next(size_t pos) const noexcept
+    {
+      return pos + 1 >= size_ ? npos : detail::find_set_bit(words_.data(), words_.size(), pos + 1);
+    }
+
+    // underlying words, least significant bit first
+    const word_type* data() const noexcept { return words_.data(); }
+    word_type* data() noexcept { return words_.data(); }
+    size_t word_count() const noexcept { return words_.size(); }
+
+    bool operator==(const dynamic_bitset& other) const noexcept
+    {
+      return size_ == other.size_ && words_ == other.words_;
+    }
+  };
+
+  inline dynamic_bitset operator&(const dynamic_bitset& lhs, const dynamic_bitset& rhs)
+  {
+    return dynamic_bitset(lhs) &= rhs;
+  }
+  inline dynamic_bitset operator|(const dynamic_bitset& lhs, const dynamic_bitset& rhs)
+  {
+    return dynamic_bitset(lhs) |= rhs;
+  }
+  inline dynamic_bitset operator^(const dynamic_bitset& lhs, const dynamic_bitset& rhs)
+  {
+    return dynamic_bitset(lhs) ^= rhs;
+  }
+
+  // rank / select index over the words of a bitset (rank9 layout)
+  //
+  // for every 512 bit block it stores the number of set bits before the
+  // block and, packed nine bits each, the counts before each of the
+  // block's words: 128 bits of index per 512 bits of data. rank is then
+  // two index reads and one popcount. select binary searches the blocks.
+  // the index refers to the bitset's words and must be rebuilt after the
+  // bitset changes.
+  class rank_select {
+  private:
+    static constexpr size_t block_words = 8;
+
+    const std::uint64_t* words_;
+    size_t size_;
+    size_t ones_;
+    vector<std::uint64_t> index_;
+
+    size_t block_rank(size_t block) const noexcept { return static_cast<size_t>(index_[2 * block]); }
+    size_t word_rank(size_t block, size_t w) const noexcept
+    {
+      return w == 0 ? 0 : static_cast<size_t>((index_[2 * block + 1] >> (9 * (w - 1))) & 0x1ff);
+    }
+  public:
+    // index the first bits bits of words
+    rank_select(const std::uint64_t* words, size_t bits) : words_(words), size_(bits), ones_(0)
+    {
+      size_t word_count = detail::words_for(bits);
+      size_t blocks = word_count / block_words + 1;
+      index_.reserve(2 * blocks);
+      for (size_t b = 0; b < blocks; ++b)
+      {
+        index_.push_back(ones_);
+        std::uint64_t packed = 0;
+        size_t in_block = 0;
+        for (size_t w = 0; w < block_words; ++w)
+        {
+          size_t i = b * block_words + w;
+          if (w > 0) packed |= static_cast<std::uint64_t>(in_block) << (9 * (w - 1));
+          if (i < word_count) in_block += static_cast<size_t>(std::popcount(words[i]));
+        }
+        index_.push_back(packed);
+        ones_ += in_block;
+      }
+    }
+
+    template<size_t N>
+    explicit rank_select(const bitset<N>& bits) : rank_select(bits.data(), N) {}
+    explicit rank_select(const dynamic_bitset& bits) : rank_select(bits.data(), bits.size()) {}
+
+    // number of set bits in [0, pos)
+    size_t rank1(size_t pos) const noexcept
+    {
+      size_t word = pos / detail::word_bits;
+      size_t block = word / block_words;
+      size_t r = block_rank(block) + word_rank(block, word % block_words);
+      size_t bit = pos % detail::word_bits;
+      if (bit) r += static_cast<size_t>(std::popcount(words_[word] & ((std::uint64_t(1) << bit) - 1)));
+      return r;
+    }
+    // number of clear bits in [0, pos)
+    size_t rank0(size_t pos) const noexcept { return pos - rank1(pos); }
+
+    // position of the k-th (0 based) set bit; npos if k >= count()
+    size_t select1(size_t k) const noexcept
+    {
+      if (k >= ones_) return npos;
+      // last block whose preceding count is <= k
+      size_t lo = 0, hi = index_.size() / 2;
+      while (hi - lo > 1)
+      {
+        size_t mid = lo + (hi - lo) / 2;
+        if (block_rank(mid) <= k) lo = mid;
+        else hi = mid;
+      }
+      size_t rest = k - block_rank(lo);
+      size_t w = 0;
+      while (w + 1 < block_words && word_rank(lo, w + 1) <= rest) ++w;
+      rest -= word_rank(lo, w);
+      size_t word = lo * block_words + w;
+      return word * detail::word_bits + detail::select_in_word(words_[word], rest);
+    }
+
+    size_t size() const noexcept { return size_; }
+    size_t count() const noexcept { return ones_; }
+
+    // bytes used by the index itself
+    size_t memory_usage() const noexcept { return index_.size() * sizeof(std::uint64_t); }
+  };
+}
+
+#endif
@@ -0,0 +1,836 @@
+#ifndef KARLS_STANDARD_LIBRARY_CHARCONV_HPP
+#define KARLS_STANDARD_LIBRARY_CHARCONV_HPP
+
+#include "cstddef.hpp"
+#include "charconv_table.hpp"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+namespace karls_standard_library {
+  // locale independent conversion between numbers and decimal text, with
+  // the same contract as std::to_chars / std::from_chars: nothing is
+  // allocated, no null terminator is written or expected, and errors are
+  // reported through ec. floating point output is the shortest text that
+  // reads back to the same value.
+  struct to_chars_result {
+    char* ptr;
+    std::errc ec;
+
+    bool operator==(const to_chars_result&) const = default;
+  };
+
+  struct from_chars_result {
+    const char* ptr;
+    std::errc ec;
+
+    bool operator==(const from_chars_result&) const = default;
+  };
+
+  // the longest text to_chars produces for T, sign included
+  template<typename T>
+  inline constexpr size_t max_chars = std::is_floating_point_v<T>
+    ? (sizeof(T) <= 4 ? 16 : 24)
+    : std::numeric_limits<T>::digits10 + 2;
+
+  namespace detail {
+    template<typename T>
+    inline constexpr bool is_charconv_integer_v = std::is_integral_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool>;
+
+    template<typename T>
+    inline constexpr bool is_charconv_float_v = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    __extension__ typedef unsigned __int128 uint128;
+
+    inline constexpr char digit_pairs[] =
+      "00010203040506070809"
+      "10111213141516171819"
+      "20212223242526272829"
+      "30313233343536373839"
+      "40414243444546474849"
+      "50515253545556575859"
+      "60616263646566676869"
+      "70717273747576777879"
+      "80818283848586878889"
+      "90919293949596979899";
+
+    inline constexpr std::uint64_t pow10_u64[] = {
+      1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+      100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+      10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+      100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+    };
+
+    // number of decimal digits in x, at least one
+    inline int count_digits(std::uint64_t x) noexcept
+    {
+      // bit_width * log10(2), then one compare to settle the boundary
+      int t = (std::bit_width(x | 1) * 1233) >> 12;
+      return t + ((x | 1) >= pow10_u64[t]);
+    }
+
+    // write the digits of x so that they end at last, two per step
+    inline void write_digits(char* last, std::uint64_t x) noexcept
+    {
+      while (x >= 100)
+      {
+        std::uint64_t q = x / 100;
+        std::memcpy(last -= 2, digit_pairs + 2 * (x - q * 100), 2);
+        x = q;
+      }
+      if (x >= 10) std::memcpy(last - 2, digit_pairs + 2 * x, 2);
+      else last[-1] = static_cast<char>('0' + x);
+    }
+
+    // eight bytes as a little endian word, so the first char is the low byte
+    inline std::uint64_t load_eight(const char* p) noexcept
+    {
+      std::uint64_t chunk;
+      std::memcpy(&chunk, p, 8);
+      if constexpr (std::endian::native == std::endian::big) chunk = __builtin_bswap64(chunk);
+      return chunk;
+    }
+
+    // swar test: every byte of chunk is '0'..'9'
+    inline bool is_eight_digits(std::uint64_t chunk) noexcept
+    {
+      return ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+    }
+
+    // swar parse of eight digits: adjacent digits are combined into pairs,
+    // pairs into fours and fours into the result, three multiplies in all
+    inline std::uint32_t parse_eight_digits(std::uint64_t chunk) noexcept
+    {
+      constexpr std::uint64_t mask = 0x000000FF000000FF;
+      constexpr std::uint64_t mul1 = 100 + (1000000ull << 32);
+      constexpr std::uint64_t mul2 = 1 + (10000ull << 32);
+      chunk -= 0x3030303030303030;
+      chunk = chunk * 10 + (chunk >> 8);
+      chunk = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+      return static_cast<std::uint32_t>(chunk);
+    }
+
+    inline bool is_digit(char c) noexcept { return static_cast<unsigned char>(c - '0') < 10; }
+
+    // accumulate the digits at p into x, eight at a time while possible
+    inline const char* parse_digits(const char* p, const char* last, std::uint64_t& x) noexcept
+    {
+      while (last - p >= 8)
+      {
+        std::uint64_t chunk = load_eight(p);
+        if (!is_eight_digits(chunk)) break;
+        x = x * 100000000 + parse_eight_digits(chunk);
+        p += 8;
+      }
+      for (; p != last && is_digit(*p); ++p) x = x * 10 + static_cast<unsigned>(*p - '0');
+      return p;
+    }
+
+    template<typename F>
+    struct float_format;
+
+    template<>
+    struct float_format<double> {
+      using bits_type = std::uint64_t;
+      static constexpr int significand_bits = 52;
+      static constexpr int exponent_bias = 1023;
+      static constexpr int infinite_exponent = 0x7FF;
+      // range of q in which w * 10^q can land exactly between two doubles
+      static constexpr int min_round_to_even = -4;
+      static constexpr int max_round_to_even = 23;
+      // below this any 64 bit w * 10^q rounds to zero, above it to infinity
+      static constexpr int min_decimal_exponent = -342;
+      static constexpr int max_decimal_exponent = 308;
+      // w * 10^q is exact in a double for these q and w <= 2^53
+      static constexpr int max_exact_pow10 = 22;
+    };
+
+    template<>
+    struct float_format<float> {
+      using bits_type = std::uint32_t;
+      static constexpr int significand_bits = 23;
+      static constexpr int exponent_bias = 127;
+      static constexpr int infinite_exponent = 0xFF;
+      static constexpr int min_round_to_even = -17;
+      static constexpr int max_round_to_even = 10;
+      static constexpr int min_decimal_exponent = -65;
+      static constexpr int max_decimal_exponent = 38;
+      static constexpr int max_exact_pow10 = 10;
+    };
+
+    // floor(e * log2(10)), exact for the exponents of the table
+    inline int floor_log2_pow10(int e) noexcept { return (e * 1741647) >> 19; }
+
+    template<typename F>
+    struct decimal_float {
+      typename float_format<F>::bits_type significand;
+      int exponent;
+    };
+
+    // the fraction and biased exponent fields of a binary float
+    struct float_fields {
+      std::uint64_t fraction;
+      int exponent;
+    };
+
+    // the significand of 10^k rounded up: the table entry plus one
+    inline uint128 pow10_rounded_up(int k) noexcept
+    {
+      const uint64_pair& e = pow10_significands[k - pow10_table_min];
+      return ((static_cast<uint128>(e.hi) << 64) | e.lo) + 1;
+    }
+
+    // top bits of x * g with the dropped part folded into the lowest bit
+    // (round to odd), as schubfach needs
+    inline std::uint64_t round_to_odd(uint128 g, std::uint64_t x) noexcept
+    {
+      uint128 low = static_cast<uint128>(x) * static_cast<std::uint64_t>(g);
+      uint128 high = static_cast<uint128>(x) * static_cast<std::uint64_t>(g >> 64) + static_cast<std::uint64_t>(low >> 64);
+      return static_cast<std::uint64_t>(high >> 64) | (static_cast<std::uint64_t>(high) > 1);
+    }
+
+    inline std::uint32_t round_to_odd(std::uint64_t g, std::uint32_t x) noexcept
+    {
+      uint128 p = static_cast<uint128>(g) * x;
+      return static_cast<std::uint32_t>(p >> 64) | (static_cast<std::uint32_t>(static_cast<std::uint64_t>(p) >> 32) > 1);
+    }
+
+    // shortest decimal that rounds to the positive finite value with the
+    // given fields, by giulietti's schubfach: the rounding interval of the
+    // value is scaled by one power of ten so that it contains at most one
+    // number with one digit fewer than the scaled value itself
+    template<typename F>
+    decimal_float<F> to_decimal(typename float_format<F>::bits_type fraction, int biased_exponent) noexcept
+    {
+      using format = float_format<F>;
+      using bits = typename format::bits_type;
+      constexpr int bias = format::exponent_bias + format::significand_bits;
+
+      bits c;
+      int q;
+      if (biased_exponent != 0)
+      {
+        c = fraction | (bits(1) << format::significand_bits);
+        q = biased_exponent - bias;
+        // small integers are their own shortest form
+        if (q <= 0 && -q <= format::significand_bits && (c & ((bits(1) << -q) - 1)) == 0)
+        {
+          return {static_cast<bits>(c >> -q), 0};
+        }
+      }
+      else
+      {
+        c = fraction;
+        q = 1 - bias;
+      }
+
+      bool even = (c & 1) == 0;
+      bool lower_closer = fraction == 0 && biased_exponent > 1;
+      bits cbl = 4 * c - 2 + lower_closer;
+      bits cb = 4 * c;
+      bits cbr = 4 * c + 2;
+
+      // floor(log10(2^q)), or of 3/4 2^q when the lower neighbour is closer
+      int k = (q * 1262611 - (lower_closer ? 524031 : 0)) >> 22;
+      int h = q + floor_log2_pow10(-k) + 1;
+
+      bits vbl, vb, vbr;
+      if constexpr (sizeof(bits) == 8)
+      {
+        uint128 g = pow10_rounded_up(-k);
+        vbl = round_to_odd(g, cbl << h);
+        vb = round_to_odd(g, cb << h);
+        vbr = round_to_odd(g, cbr << h);
+      }
+      else
+      {
+        // the top 64 bits, rounded up, are enough for float
+        std::uint64_t g = pow10_significands[-k - pow10_table_min].hi + 1;
+        vbl = round_to_odd(g, cbl << h);
+        vb = round_to_odd(g, cb << h);
+        vbr = round_to_odd(g, cbr << h);
+      }
+
+      bits lower = vbl + !even;
+      bits upper = vbr - !even;
+
+      bits s = vb / 4;
+      if (s >= 10)
+      {
+        // one digit fewer, if exactly one candidate lies in the interval
+        bits sp = s / 10;
+        bool up_inside = lower <= 40 * sp;
+        bool wp_inside = 40 * sp + 40 <= upper;
+        if (up_inside != wp_inside) return {static_cast<bits>(sp + wp_inside), k + 1};
+      }
+
+      bool u_inside = lower <= 4 * s;
+      bool w_inside = 4 * s + 4 <= upper;
+      if (u_inside != w_inside) return {static_cast<bits>(s + w_inside), k};
+
+      // both neighbours round trip; take the nearer one, ties to even
+      bits mid = 4 * s + 2;
+      bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+      return {static_cast<bits>(s + round_up), k};
+    }
+
+    // format significand * 10^exponent in the shorter of fixed and
+    // scientific notation, fixed on a tie, as std::to_chars does. fixed
+    // notation of a large integral value prints its exact digits, like
+    // printf's %f, so integer is that value when it has trailing digits
+    // beyond the shortest ones, and zero otherwise
+    inline to_chars_result write_decimal(char* first, char* last, std::uint64_t significand, int exponent, uint128 integer) noexcept
+    {
+      while (significand >= 10 && significand % 10 == 0)
+      {
+        significand /= 10;
+        ++exponent;
+      }
+      int n = count_digits(significand);
+      int scientific_exponent = exponent + n - 1;
+      int magnitude = scientific_exponent < 0 ? -scientific_exponent : scientific_exponent;
+      int scientific_length = n + (n > 1) + 2 + (magnitude >= 100 ? 3 : 2);
+      int fixed_length = exponent >= 0 ? n + exponent
+        : scientific_exponent >= 0 ? n + 1
+        : n + 1 - scientific_exponent;
+
+      if (fixed_length <= scientific_length)
+      {
+        if (exponent > 0 && integer != 0)
+        {
+          // the value needs at most 80 bits here, so it splits in two words
+          constexpr std::uint64_t base = 10000000000000000000ull;
+          std::uint64_t high = static_cast<std::uint64_t>(integer / base);
+          std::uint64_t low = static_cast<std::uint64_t>(integer % base);
+          int length = high ? count_digits(high) + 19 : count_digits(low);
+          if (last - first < length) return {last, std::errc::value_too_large};
+          if (high)
+          {
+            write_digits(first + length - 19, high);
+            std::memset(first + length - 19, '0', 19);
+          }
+          write_digits(first + length, low);
+          return {first + length, std::errc{}};
+        }
+        if (last - first < fixed_length) return {last, std::errc::value_too_large};
+        if (exponent >= 0)
+        {
+          write_digits(first + n, significand);
+          std::memset(first + n, '0', static_cast<size_t>(exponent));
+        }
+        else if (scientific_exponent >= 0)
+        {
+          // digits before the point, then the point moved into place
+          int whole = scientific_exponent + 1;
+          write_digits(first + n + 1, significand);
+          std::memmove(first, first + 1, static_cast<size_t>(whole));
+          first[whole] = '.';
+        }
+        else
+        {
+          first[0] = '0';
+          first[1] = '.';
+          std::memset(first + 2, '0', static_cast<size_t>(-scientific_exponent - 1));
+          write_digits(first + fixed_length, significand);
+        }
+        return {first + fixed_length, std::errc{}};
+      }
+
+      if (last - first < scientific_length) return {last, std::errc::value_too_large};
+      write_digits(first + n + (n > 1), significand);
+      if (n > 1)
+      {
+        first[0] = first[1];
+        first[1] = '.';
+      }
+      char* p = first + n + (n > 1);
+      *p++ = 'e';
+      *p++ = scientific_exponent < 0 ? '-' : '+';
+      if (magnitude >= 100)
+      {
+        *p++ = static_cast<char>('0' + magnitude / 100);
+        magnitude %= 100;
+      }
+      std::memcpy(p, digit_pairs + 2 * magnitude, 2);
+      return {p + 2, std::errc{}};
+    }
+
+    template<typename F>
+    to_chars_result float_to_chars(char* first, char* last, F value) noexcept
+    {
+      using format = float_format<F>;
+      using bits = typename format::bits_type;
+      bits raw = std::bit_cast<bits>(value);
+      bits fraction = raw & ((bits(1) << format::significand_bits) - 1);
+      int biased_exponent = static_cast<int>((raw >> format::significand_bits) & format::infinite_exponent);
+      bool negative = (raw >> (sizeof(bits) * 8 - 1)) != 0;
+
+      // assemble in a local buffer so a short output range fails cleanly
+      char buffer[max_chars<F>];
+      char* p = buffer;
+      if (negative) *p++ = '-';
+      if (biased_exponent == format::infinite_exponent)
+      {
+        std::memcpy(p, fraction == 0 ? "inf" : "nan", 3);
+        p += 3;
+      }
+      else if (biased_exponent == 0 && fraction == 0)
+      {
+        *p++ = '0';
+      }
+      else
+      {
+        decimal_float<F> d = to_decimal<F>(fraction, biased_exponent);
+        // values of 2^(significand_bits + 1) and up are integers; fixed
+        // notation is only chosen for them below 10^24, well inside 128 bits
+        int q = biased_exponent - format::exponent_bias - format::significand_bits;
+        uint128 integer = 0;
+        if (q > 0 && q < 64) integer = static_cast<uint128>(fraction | (bits(1) << format::significand_bits)) << q;
+        p = write_decimal(p, buffer + sizeof(buffer), d.significand, d.exponent, integer).ptr;
+      }
+      size_t length = static_cast<size_t>(p - buffer);
+      if (static_cast<size_t>(last - first) < length) return {last, std::errc::value_too_large};
+      std::memcpy(first, buffer, length);
+      return {first + length, std::errc{}};
+    }
+
+    // w * 10^q rounded to the nearest F, by the eisel-lemire algorithm: one
+    // (rarely two) 64 x 64 bit multiplies by the tabled power of ten give
+    // enough bits to round correctly for any w (mushtak and lemire, 2023).
+    // returns the biased exponent and the fraction field
+    template<typename F>
+    float_fields compute_float(int q, std::uint64_t w) noexcept
+    {
+      using format = float_format<F>;
+      constexpr int mantissa_bits = format::significand_bits;
+      constexpr int min_exponent = -format::exponent_bias;
+
+      if (w == 0 || q < format::min_decimal_exponent) return {0, 0};
+      if (q > format::max_decimal_exponent) return {0, format::infinite_exponent};
+
+      int lz = std::countl_zero(w);
+      w <<= lz;
+
+      // the table holds 10^q rounded down except for q in [-27, -1], where
+      // the algorithm wants it rounded up
+      const uint64_pair& entry = pow10_significands[q - pow10_table_min];
+      uint128 power = ((static_cast<uint128>(entry.hi) << 64) | entry.lo) + (q >= -27 && q < 0);
+
+      // the high product settles the answer unless its low bits are all
+      // ones, when a carry from the low product could still reach them
+      uint128 first = static_cast<uint128>(w) * static_cast<std::uint64_t>(power >> 64);
+      constexpr std::uint64_t precision_mask = ~std::uint64_t(0) >> (mantissa_bits + 3);
+      std::uint64_t high = static_cast<std::uint64_t>(first >> 64);
+      std::uint64_t low = static_cast<std::uint64_t>(first);
+      if ((high & precision_mask) == precision_mask)
+      {
+        uint128 second = static_cast<uint128>(w) * static_cast<std::uint64_t>(power);
+        std::uint64_t carry_in = static_cast<std::uint64_t>(second >> 64);
+        low += carry_in;
+        if (low < carry_in) ++high;
+      }
+
+      int upper_bit = static_cast<int>(high >> 63);
+      int shift = upper_bit + 64 - mantissa_bits - 3;
+      std::uint64_t mantissa = high >> shift;
+      int power2 = (((152170 + 65536) * q) >> 16) + 63 + upper_bit - lz - min_exponent;
+
+      if (power2 <= 0)
+      {
+        // subnormal, or zero once more than 64 bits fall below the range
+        if (-power2 + 1 >= 64) return {0, 0};
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        // rounding up may have carried into the smallest normal exponent
+        power2 = mantissa < (std::uint64_t(1) << mantissa_bits) ? 0 : 1;
+        return {mantissa & ((std::uint64_t(1) << mantissa_bits) - 1), power2};
+      }
+
+      // exactly halfway only if everything shifted out was zero; then round
+      // to even rather than up
+      if (low <= 1 && q >= format::min_round_to_even && q <= format::max_round_to_even && (mantissa & 3) == 1 && (mantissa << shift) == high)
+      {
+        mantissa &= ~std::uint64_t(1);
+      }
+
+      mantissa += mantissa & 1;
+      mantissa >>= 1;
+      if (mantissa >= (std::uint64_t(2) << mantissa_bits))
+      {
+        mantissa = std::uint64_t(1) << mantissa_bits;
+        ++power2;
+      }
+      mantissa &= ~(std::uint64_t(1) << mantissa_bits);
+      if (power2 >= format::infinite_exponent) return {0, format::infinite_exponent};
+      return {mantissa, power2};
+    }
+
+    template<typename F>
+    F assemble_float(float_fields fields, bool negative) noexcept
+    {
+      using format = float_format<F>;
+      using bits = typename format::bits_type;
+      bits raw = static_cast<bits>(fields.fraction) | (static_cast<bits>(fields.exponent) << format::significand_bits);
+      if (negative) raw |= bits(1) << (sizeof(bits) * 8 - 1);
+      return std::bit_cast<F>(raw);
+    }
+
+    // case insensitive match of the lowercase word at p
+    inline bool match_word(const char* p, const char* last, const char* word, size_t length) noexcept
+    {
+      if (static_cast<size_t>(last - p) < length) return false;
+      for (size_t i = 0; i < length; ++i)
+      {
+        if ((p[i] | 0x20) != word[i]) return false;
+      }
+      return true;
+    }
+
+    // fixed capacity unsigned integer for the exact comparison below;
+    // 768 digits scaled by the largest powers of two and five involved
+    // stay well under its 8192 bits
+    struct big_integer {
+      static constexpr int capacity = 128;
+      std::uint64_t limbs[capacity];
+      int size = 0;
+
+      explicit big_integer(std::uint64_t value) noexcept
+      {
+        if (value != 0) limbs[size++] = value;
+      }
+
+      void multiply(std::uint64_t m) noexcept
+      {
+        std::uint64_t carry = 0;
+        for (int i = 0; i < size; ++i)
+        {
+          uint128 product = static_cast<uint128>(limbs[i]) * m + carry;
+          limbs[i] = static_cast<std::uint64_t>(product);
+          carry = static_cast<std::uint64_t>(product >> 64);
+        }
+        if (carry != 0 && size < capacity) limbs[size++] = carry;
+      }
+
+      void add(std::uint64_t a) noexcept
+      {
+        for (int i = 0; a != 0 && i < size; ++i)
+        {
+          limbs[i] += a;
+          a = limbs[i] < a;
+        }
+        if (a != 0 && size < capacity) limbs[size++] = a;
+      }
+
+      void multiply_pow5(int n) noexcept
+      {
+        constexpr std::uint64_t pow5_27 = 7450580596923828125ull;
+        for (; n >= 27; n -= 27) multiply(pow5_27);
+        std::uint64_t rest = 1;
+        for (; n > 0; --n) rest *= 5;
+        multiply(rest);
+      }
+
+      void shift_left(int bits) noexcept
+      {
+        if (size == 0 || bits == 0) return;
+        int words = bits / 64;
+        int rest = bits % 64;
+        int new_size = size + words + 1 < capacity ? size + words + 1 : capacity;
+        for (int i = new_size - 1; i >= words; --i)
+        {
+          int from = i - words;
+          std::uint64_t high = from < size ? limbs[from] << rest : 0;
+          std::uint64_t low = (rest != 0 && from >= 1 && from - 1 < size) ? limbs[from - 1] >> (64 - rest) : 0;
+          limbs[i] = high | low;
+        }
+        for (int i = 0; i < words && i < new_size; ++i) limbs[i] = 0;
+        size = new_size;
+        while (size > 0 && limbs[size - 1] == 0) --size;
+      }
+
+      friend int compare(const big_integer& a, const big_integer& b) noexcept
+      {
+        if (a.size != b.size) return a.size < b.size ? -1 : 1;
+        for (int i = a.size - 1; i >= 0; --i)
+        {
+          if (a.limbs[i] != b.limbs[i]) return a.limbs[i] < b.limbs[i] ? -1 : 1;
+        }
+        return 0;
+      }
+    };
+
+    // sign of the exact decimal value of the digits [s, significand_end)
+    // (the point, if any, between integer_end and fraction_begin) times
+    // 10^exponent, minus h * 2^e. the halfway point between two adjacent
+    // doubles has at most 767 significant digits, so 768 digits and
+    // whether any later digit is nonzero settle the comparison
+    inline int compare_decimal(const char* s, const char* integer_end, const char* fraction_begin,
+                               const char* significand_end, std::int64_t exponent, std::uint64_t h, int e) noexcept
+    {
+      constexpr int max_digits = 768;
+      big_integer left(0);
+      std::uint64_t chunk = 0;
+      std::uint64_t scale = 1;
+      int taken = 0;
+      for (; s != significand_end && taken < max_digits; ++s)
+      {
+        if (*s == '.') continue;
+        chunk = chunk * 10 + static_cast<unsigned>(*s - '0');
+        scale *= 10;
+        ++taken;
+        if (scale == 10000000000000000000ull)
+        {
+          left.multiply(scale);
+          left.add(chunk);
+          chunk = 0;
+          scale = 1;
+        }
+      }
+      left.multiply(scale);
+      left.add(chunk);
+      std::int64_t e10 = s <= integer_end ? exponent + (integer_end - s) : exponent - (s - fraction_begin);
+      bool nonzero_rest = false;
+      for (; s != significand_end; ++s) nonzero_rest |= *s != '0' && *s != '.';
+
+      // digits * 2^e10 * 5^e10 against h * 2^e, scaled to integers
+      big_integer right(h);
+      if (e10 >= 0) left.multiply_pow5(static_cast<int>(e10));
+      else right.multiply_pow5(static_cast<int>(-e10));
+      std::int64_t shift = e10 - e;
+      if (shift > 0) left.shift_left(static_cast<int>(shift));
+      else right.shift_left(static_cast<int>(-shift));
+      int c = compare(left, right);
+      return c == 0 && nonzero_rest ? 1 : c;
+    }
+
+    template<typename F>
+    from_chars_result float_from_chars(const char* first, const char* last, F& value) noexcept
+    {
+      using format = float_format<F>;
+      const char* p = first;
+      bool negative = p != last && *p == '-';
+      p += negative;
+      if (p == last) return {first, std::errc::invalid_argument};
+
+      if (!is_digit(*p) && *p != '.')
+      {
+        if (match_word(p, last, "inf", 3))
+        {
+          p += match_word(p, last, "infinity", 8) ? 8 : 3;
+          value = negative ? -std::numeric_limits<F>::infinity() : std::numeric_limits<F>::infinity();
+          return {p, std::errc{}};
+        }
+        if (match_word(p, last, "nan", 3))
+        {
+          p += 3;
+          // optional nan(chars)
+          if (p != last && *p == '(')
+          {
+            const char* q = p + 1;
+            while (q != last && (is_digit(*q) || ((*q | 0x20) >= 'a' && (*q | 0x20) <= 'z') || *q == '_')) ++q;
+            if (q != last && *q == ')') p = q + 1;
+          }
+          value = negative ? -std::numeric_limits<F>::quiet_NaN() : std::numeric_limits<F>::quiet_NaN();
+          return {p, std::errc{}};
+        }
+        return {first, std::errc::invalid_argument};
+      }
+
+      // significand digits; w wraps past 19 digits, which is handled below
+      std::uint64_t w = 0;
+      const char* integer_begin = p;
+      p = parse_digits(p, last, w);
+      const char* integer_end = p;
+      const char* fraction_begin = p;
+      const char* fraction_end = p;
+      if (p != last && *p == '.')
+      {
+        fraction_begin = p + 1;
+        p = fraction_end = parse_digits(fraction_begin, last, w);
+      }
+      std::int64_t integer_digits = integer_end - integer_begin;
+      std::int64_t fraction_digits = fraction_end - fraction_begin;
+      if (integer_digits + fraction_digits == 0) return {first, std::errc::invalid_argument};
+      const char* significand_end = p;
+
+      // exponent; an 'e' without digits is not part of the number
+      std::int64_t exponent = 0;
+      if (p != last && (*p | 0x20) == 'e')
+      {
+        const char* q = p + 1;
+        bool negative_exponent = q != last && *q == '-';
+        if (q != last && (*q == '-' || *q == '+')) ++q;
+        if (q != last && is_digit(*q))
+        {
+          for (; q != last && is_digit(*q); ++q)
+          {
+            if (exponent < 0x10000000) exponent = exponent * 10 + (*q - '0');
+          }
+          if (negative_exponent) exponent = -exponent;
+          p = q;
+        }
+      }
+
+      std::int64_t q = exponent - fraction_digits;
+      bool truncated = false;
+      const char* significant_begin = integer_begin;
+      if (integer_digits + fraction_digits > 19)
+      {
+        // count significant digits, without leading zeros
+        const char* s = integer_begin;
+        while (s != significand_end && (*s == '0' || *s == '.')) ++s;
+        std::int64_t significant = significand_end - s - (s < integer_end && fraction_begin != integer_end);
+        if (significant > 19)
+        {
+          // keep the first 19 significant digits and scale for the rest
+          truncated = true;
+          significant_begin = s;
+          w = 0;
+          int taken = 0;
+          for (; taken < 19; ++s)
+          {
+            if (*s == '.') continue;
+            w = w * 10 + static_cast<unsigned>(*s - '0');
+            ++taken;
+          }
+          q = s <= integer_end ? exponent + (integer_end - s) : exponent - (s - fraction_begin);
+        }
+      }
+      if (q < -100000) q = -100000;
+      if (q > 100000) q = 100000;
+
+      F result = F(0);
+      if (!truncated && q >= -format::max_exact_pow10 && q <= format::max_exact_pow10 && w <= (std::uint64_t(1) << (format::significand_bits + 1)))
+      {
+        // clinger's fast path: w and 10^|q| are exact, so one correctly
+        // rounded multiply or divide gives the answer
+        constexpr F exact_pow10[] = {
+          F(1e0), F(1e1), F(1e2), F(1e3), F(1e4), F(1e5), F(1e6), F(1e7), F(1e8), F(1e9), F(1e10), F(1e11),
+          F(1e12), F(1e13), F(1e14), F(1e15), F(1e16), F(1e17), F(1e18), F(1e19), F(1e20), F(1e21), F(1e22)
+        };
+        result = static_cast<F>(w);
+        result = q < 0 ? result / exact_pow10[-q] : result * exact_pow10[q];
+        if (negative) result = -result;
+      }
+      else
+      {
+        float_fields fields = compute_float<F>(static_cast<int>(q), w);
+        if (truncated)
+        {
+          // the dropped digits put the value between w and w + 1; when
+          // those round differently, the value is compared exactly with
+          // the point halfway between the two candidates
+          float_fields above = compute_float<F>(static_cast<int>(q), w + 1);
+          if (above.fraction != fields.fraction || above.exponent != fields.exponent)
+          {
+            constexpr int bias = format::exponent_bias + format::significand_bits;
+            std::uint64_t m = fields.exponent == 0 ? fields.fraction : fields.fraction | (std::uint64_t(1) << format::significand_bits);
+            int e = (fields.exponent == 0 ? 1 : fields.exponent) - bias;
+            int c = compare_decimal(significant_begin, integer_end, fraction_begin, significand_end, exponent, 2 * m + 1, e - 1);
+            if (c > 0 || (c == 0 && (m & 1))) fields = above;
+          }
+        }
+        result = assemble_float<F>(fields, negative);
+        if (w != 0 && (result == F(0) || result == std::numeric_limits<F>::infinity() || result == -std::numeric_limits<F>::infinity()))
+        {
+          return {p, std::errc::result_out_of_range};
+        }
+      }
+      value = result;
+      return {p, std::errc{}};
+    }
+  }
+
+  // decimal text of an integer, two digits per step from a pair table
+  template<typename Int>
+    requires detail::is_charconv_integer_v<Int>
+  to_chars_result to_chars(char* first, char* last, Int value) noexcept
+  {
+    using unsigned_type = std::make_unsigned_t<Int>;
+    unsigned_type magnitude = static_cast<unsigned_type>(value);
+    if constexpr (std::is_signed_v<Int>)
+    {
+      if (value < 0)
+      {
+        if (first == last) return {last, std::errc::value_too_large};
+        *first++ = '-';
+        magnitude = static_cast<unsigned_type>(unsigned_type(0) - magnitude);
+      }
+    }
+    int n = detail::count_digits(magnitude);
+    if (last - first < n) return {last, std::errc::value_too_large};
+    detail::write_digits(first + n, magnitude);
+    return {first + n, std::errc{}};
+  }
+
+  // shortest round trip text of a float or double
+  template<typename F>
+    requires detail::is_charconv_float_v<F>
+  to_chars_result to_chars(char* first, char* last, F value) noexcept
+  {
+    return detail::float_to_chars(first, last, value);
+  }
+
+  // parse an optionally signed decimal integer; out of range values leave
+  // value untouched and report result_out_of_range
+  template<typename Int>
+    requires detail::is_charconv_integer_v<Int>
+  from_chars_result from_chars(const char* first, const char* last, Int& value) noexcept
+  {
+    using unsigned_type = std::make_unsigned_t<Int>;
+    const char* p = first;
+    bool negative = false;
+    if constexpr (std::is_signed_v<Int>)
+    {
+      negative = p != last && *p == '-';
+      p += negative;
+    }
+    const char* digits = p;
+    while (p != last && *p == '0') ++p;
+    const char* significant = p;
+    std::uint64_t x = 0;
+    p = detail::parse_digits(p, last, x);
+    if (p == digits) return {first, std::errc::invalid_argument};
+
+    // 19 digits always fit in 64 bits; a 20th needs checking
+    std::ptrdiff_t n = p - significant;
+    bool overflow = n > 20;
+    if (n == 20)
+    {
+      x = 0;
+      detail::parse_digits(significant, significant + 19, x);
+      overflow = __builtin_mul_overflow(x, 10, &x) || __builtin_add_overflow(x, static_cast<unsigned>(significant[19] - '0'), &x);
+    }
+
+    constexpr std::uint64_t max_magnitude = std::numeric_limits<unsigned_type>::max();
+    if constexpr (std::is_signed_v<Int>)
+    {
+      std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<Int>::max()) + negative;
+      if (overflow || x > limit) return {p, std::errc::result_out_of_range};
+      value = static_cast<Int>(negative ? unsigned_type(0) - static_cast<unsigned_type>(x) : static_cast<unsigned_type>(x));
+    }
+    else
+    {
+      if (overflow || x > max_magnitude) return {p, std::errc::result_out_of_range};
+      value = static_cast<Int>(x);
+    }
+    return {p, std::errc{}};
+  }
+
+  // parse decimal fixed or scientific text, inf or nan into the nearest
+  // float or double; the first 19 significant digits decide the result
+  // unless the value sits on a rounding boundary, when the rare input with
+  // more digits is compared exactly against the boundary
+  template<typename F>
+    requires detail::is_charconv_float_v<F>
+  from_chars_result from_chars(const char* first, const char* last, F& value) noexcept
+  {
+    return detail::float_from_chars(first, last, value);
+  }
+}
+
+#endif
@@ -0,0 +1,358 @@
+#ifndef KARLS_STANDARD_LIBRARY_CIRCULAR_BUFFER_HPP
+#define KARLS_STANDARD_LIBRARY_CIRCULAR_BUFFER_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "array.hpp"
+#include <compare>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace karls_standard_library {
+  // what a push into a full circular buffer does
+  enum class overflow_mode {
+    reject,      // the push fails and returns false
+    overwrite    // the element at the opposite end is dropped
+  };
+
+  namespace detail {
+    // random access iterator over the logical positions of a ring
+    template<typename Ring, typename U>
+    class ring_iterator {
+    private:
+      Ring* ring_;
+      size_t index_;
+
+      template<typename, typename> friend class ring_iterator;
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = std::remove_const_t<U>;
+      using difference_type = ptrdiff_t;
+      using pointer = U*;
+      using reference = U&;
+
+      ring_iterator() noexcept : ring_(nullptr), index_(0) {}
+      ring_iterator(Ring* ring, size_t index) noexcept : ring_(ring), index_(index) {}
+      template<typename R, typename V>
+        requires std::is_const_v<U> && (!std::is_const_v<V>)
+      ring_iterator(const ring_iterator<R, V>& other) noexcept : ring_(other.ring_), index_(other.index_) {}
+
+      reference operator*() const noexcept { return (*ring_)[index_]; }
+      pointer operator->() const noexcept { return &(*ring_)[index_]; }
+      reference operator[](difference_type n) const noexcept { return (*ring_)[index_ + n]; }
+
+      ring_iterator& operator++() noexcept { ++index_; return *this; }
+      ring_iterator operator++(int) noexcept { ring_iterator temp = *this; ++index_; return temp; }
+      ring_iterator& operator--() noexcept { --index_; return *this; }
+      ring_iterator operator--(int) noexcept { ring_iterator temp = *this; --index_; return temp; }
+      ring_iterator& operator+=(difference_type n) noexcept { index_ += n; return *this; }
+      ring_iterator& operator-=(difference_type n) noexcept { index_ -= n; return *this; }
+      friend ring_iterator operator+(ring_iterator it, difference_type n) noexcept { return it += n; }
+      friend ring_iterator operator+(difference_type n, ring_iterator it) noexcept { return it += n; }
+      friend ring_iterator operator-(ring_iterator it, difference_type n) noexcept { return it -= n; }
+      friend difference_type operator-(const ring_iterator& a, const ring_iterator& b) noexcept
+      {
+        return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+      }
+
+      bool operator==(const ring_iterator& other) const noexcept { return index_ == other.index_; }
+      auto operator<=>(const ring_iterator& other) const noexcept { return index_ <=> other.index_; }
+    };
+
+    // the operations shared by circular_buffer and static_circular_buffer;
+    // Derived provides slots() and capacity()
+    template<typename Derived, typename T>
+    class ring_core {
+    protected:
+      size_t head_;
+      size_t size_;
+      overflow_mode mode_;
+
+      explicit ring_core(overflow_mode mode) noexcept : head_(0), size_(0), mode_(mode) {}
+
+      T* slots() noexcept { return static_cast<Derived*>(this)->slots(); }
+      const T* slots() const noexcept { return static_cast<const Derived*>(this)->slots(); }
+      size_t cap() const noexcept { return static_cast<const Derived*>(this)->capacity(); }
+
+      // physical slot of logical position i, for i < 2 * capacity
+      size_t wrap(size_t i) const noexcept
+      {
+        i += head_;
+        return i >= cap() ? i - cap() : i;
+      }
+
+      template<typename Other>
+      void copy_from(const Other& other)
+      {
+        for (size_t i = 0; i < other.size(); ++i) emplace_back(other[i]);
+      }
+
+      template<typename Other>
+      void move_from(Other& other)
+      {
+        for (size_t i = 0; i < other.size(); ++i) emplace_back(karls_standard_library::move(other[i]));
+        other.clear();
+      }
+    public:
+      using value_type = T;
+      using size_type = size_t;
+      using reference = T&;
+      using const_reference = const T&;
+      using iterator = ring_iterator<Derived, T>;
+      using const_iterator = ring_iterator<const Derived, const T>;
+
+      // capacity functions
+      bool empty() const noexcept { return size_ == 0; }
+      bool full() const noexcept { return size_ == cap(); }
+      size_t size() const noexcept { return size_; }
+      overflow_mode mode() const noexcept { return mode_; }
+      void set_mode(overflow_mode mode) noexcept { mode_ = mode; }
+
+      // element access
+      T& operator[](size_t index) noexcept { return slots()[wrap(index)]; }
+      const T& operator[](size_t index) const noexcept { return slots()[wrap(index)]; }
+      T& at(size_t index)
+      {
+        if (index >= size_) throw std::out_of_range("Index out of bounds");
+        return (*this)[index];
+      }
+      const T& at(size_t index) const
+      {
+        if (index >= size_) throw std::out_of_range("Index out of bounds");
+        return (*this)[index];
+      }
+      T& front() noexcept { return slots()[head_]; }
+      const T& front() const noexcept { return slots()[head_]; }
+      T& back() noexcept { return (*this)[size_ - 1]; }
+      const T& back() const noexcept { return (*this)[size_ - 1]; }
+
+      // the contents as at most two contiguous pieces, oldest first;
+      // array_two is empty unless the contents wrap around the end
+      std::span<T> array_one() noexcept
+      {
+        return {slots() + head_, head_ + size_ <= cap() ? size_ : cap() - head_};
+      }
+      std::span<const T> array_one() const noexcept
+      {
+        return {slots() + head_, head_ + size_ <= cap() ? size_ : cap() - head_};
+      }
+      std::span<T> array_two() noexcept
+      {
+        return {slots(), head_ + size_ <= cap() ? 0 : head_ + size_ - cap()};
+      }
+      std::span<const T> array_two() const noexcept
+      {
+        return {slots(), head_ + size_ <= cap() ? 0 : head_ + size_ - cap()};
+      }
+
+      // iterators
+      iterator begin() noexcept { return iterator(static_cast<Derived*>(this), 0); }
+      iterator end() noexcept { return iterator(static_cast<Derived*>(this), size_); }
+      const_iterator begin() const noexcept { return const_iterator(static_cast<const Derived*>(this), 0); }
+      const_iterator end() const noexcept { return const_iterator(static_cast<const Derived*>(this), size_); }
+      const_iterator cbegin() const noexcept { return begin(); }
+      const_iterator cend() const noexcept { return end(); }
+
+      // modifiers
+      // append at the back; when full, either fail or drop the front
+      template<typename... Args>
+      bool emplace_back(Args&&... args)
+      {
+        if (cap() == 0) return false;
+        if (full())
+        {
+          if (mode_ == overflow_mode::reject) return false;
+          T value(karls_standard_library::forward<Args>(args)...);
+          front() = karls_standard_library::move(value);
+          head_ = wrap(1);
+          return true;
+        }
+        std::construct_at(slots() + wrap(size_), karls_standard_library::forward<Args>(args)...);
+        ++size_;
+        return true;
+      }
+      bool push_back(const T& value) { return emplace_back(value); }
+      bool push_back(T&& value) { return emplace_back(karls_standard_library::move(value)); }
+
+      // prepend at the front; when full, either fail or drop the back
+      template<typename... Args>
+      bool emplace_front(Args&&... args)
+      {
+        if (cap() == 0) return false;
+        size_t slot = head_ == 0 ? cap() - 1 : head_ - 1;
+        if (full())
+        {
+          if (mode_ == overflow_mode::reject) return false;
+          T value(karls_standard_library::forward<Args>(args)...);
+          slots()[slot] = karls_standard_library::move(value);
+          head_ = slot;
+          return true;
+        }
+        std::construct_at(slots() + slot, karls_standard_library::forward<Args>(args)...);
+        head_ = slot;
+        ++size_;
+        return true;
+      }
+      bool push_front(const T& value) { return emplace_front(value); }
+      bool push_front(T&& value) { return emplace_front(karls_standard_library::move(value)); }
+
+      void pop_front() noexcept
+      {
+        if (size_ == 0) return;
+        std::destroy_at(slots() + head_);
+        head_ = wrap(1);
+        --size_;
+      }
+
+      void pop_back() noexcept
+      {
+        if (size_ == 0) return;
+        std::destroy_at(slots() + wrap(size_ - 1));
+        --size_;
+      }
+
+      void clear() noexcept
+      {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+          for (size_t i = 0; i < size_; ++i) std::destroy_at(slots() + wrap(i));
+        }
+        head_ = 0;
+        size_ = 0;
+      }
+    };
+  }
+
+  // fixed capacity ring chosen at run time; it allocates once, in the
+  // constructor, and push / pop at either end are O(1)
+  template<typename T>
+  class circular_buffer : public detail::ring_core<circular_buffer<T>, T> {
+  private:
+    using core = detail::ring_core<circular_buffer<T>, T>;
+    friend core;
+
+    T* data_;
+    size_t capacity_;
+  public:
+    // default constructor; a buffer with no capacity
+    circular_buffer() noexcept : core(overflow_mode::reject), data_(nullptr), capacity_(0) {}
+
+    explicit circular_buffer(size_t capacity, overflow_mode mode = overflow_mode::reject) :
+      core(mode), data_(capacity ? std::allocator<T>().allocate(capacity) : nullptr), capacity_(capacity) {}
+
+    // destructor
+    ~circular_buffer()
+    {
+      this->clear();
+      if (data_) std::allocator<T>().deallocate(data_, capacity_);
+    }
+
+    // copy constructor
+    circular_buffer(const circular_buffer& other) : circular_buffer(other.capacity_, other.mode_)
+    {
+      this->copy_from(other);
+    }
+
+    // copy assignment operator
+    circular_buffer& operator=(const circular_buffer& other)
+    {
+      if (this != &other)
+      {
+        circular_buffer temp(other);
+        swap(temp);
+      }
+      return *this;
+    }
+
+    // move constructor; takes the other buffer's storage
+    circular_buffer(circular_buffer&& other) noexcept : circular_buffer() { swap(other); }
+
+    // move assignment operator
+    circular_buffer& operator=(circular_buffer&& other) noexcept
+    {
+      if (this != &other)
+      {
+        circular_buffer temp(karls_standard_library::move(other));
+        swap(temp);
+      }
+      return *this;
+    }
+
+    size_t capacity() const noexcept { return capacity_; }
+    T* slots() noexcept { return data_; }
+    const T* slots() const noexcept { return data_; }
+
+    void swap(circular_buffer& other) noexcept
+    {
+      karls_standard_library::swap(data_, other.data_);
+      karls_standard_library::swap(capacity_, other.capacity_);
+      karls_standard_library::swap(this->head_, other.head_);
+      karls_standard_library::swap(this->size_, other.size_);
+      karls_standard_library::swap(this->mode_, other.mode_);
+    }
+  };
+
+  // circular buffer with its N slots stored inline in an array
+  template<typename T, size_t N>
+  class static_circular_buffer : public detail::ring_core<static_circular_buffer<T, N>, T> {
+  private:
+    using core = detail::ring_core<static_circular_buffer<T, N>, T>;
+    friend core;
+
+    static_assert(N > 0, "a static_circular_buffer needs at least one slot");
+
+    alignas(T) array<unsigned char, N * sizeof(T)> storage_;
+  public:
+    // default constructor
+    explicit static_circular_buffer(overflow_mode mode = overflow_mode::reject) noexcept : core(mode) {}
+
+    // destructor
+    ~static_circular_buffer() { this->clear(); }
+
+    // copy constructor
+    static_circular_buffer(const static_circular_buffer& other) : static_circular_buffer(other.mode_)
+    {
+      this->copy_from(other);
+    }
+
+    // copy assignment operator
+    static_circular_buffer& operator=(const static_circular_buffer& other)
+    {
+      if (this != &other)
+      {
+        this->clear();
+        this->mode_ = other.mode_;
+        this->copy_from(other);
+      }
+      return *this;
+    }
+
+    // move constructor; moves the elements, leaving other empty
+    static_circular_buffer(static_circular_buffer&& other) : static_circular_buffer(other.mode_)
+    {
+      this->move_from(other);
+    }
+
+    // move assignment operator
+    static_circular_buffer& operator=(static_circular_buffer&& other)
+    {
+      if (this != &other)
+      {
+        this->clear();
+        this->mode_ = other.mode_;
+        this->move_from(other);
+      }
+      return *this;
+    }
+
+    static constexpr size_t capacity() noexcept { return N; }
+    T* slots() noexcept { return std::launder(reinterpret_cast<T*>(storage_.data())); }
+    const T* slots() const noexcept { return std::launder(reinterpret_cast<const T*>(storage_.data())); }
+  };
+}
+
+#endif
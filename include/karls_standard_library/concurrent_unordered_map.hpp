@@ -0,0 +1,383 @@
+#ifndef KARLS_STANDARD_LIBRARY_CONCURRENT_UNORDERED_MAP_HPP
+#define KARLS_STANDARD_LIBRARY_CONCURRENT_UNORDERED_MAP_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "algorithm.hpp"
+#include "functional.hpp"
+#include <shared_mutex>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+namespace karls_standard_library {
+  namespace detail {
+    // open addressing table with linear probing and backward shift erase;
+    // a byte per slot holds an occupancy bit and seven hash bits so most
+    // mismatches are rejected without touching the slot itself
+    template<typename K, typename V, typename KeyEqual>
+    class flat_table {
+    public:
+      struct slot {
+        size_t hash;
+        K key;
+        V value;
+      };
+    private:
+      static constexpr size_t min_capacity = 16;
+
+      unsigned char* ctrl_;
+      slot* slots_;
+      size_t capacity_;
+      size_t size_;
+
+      // the low bits pick the home slot and the map picks the shard from
+      // the top bits, so the tag comes from the middle of the hash where
+      // it stays independent of both
+      static unsigned char tag(size_t h) noexcept
+      {
+        return static_cast<unsigned char>(((h >> (4 * sizeof(size_t))) & 0x7f) | 0x80);
+      }
+
+      void allocate(size_t capacity)
+      {
+        ctrl_ = new unsigned char[capacity]();
+        slots_ = static_cast<slot*>(operator new(capacity * sizeof(slot), std::align_val_t(alignof(slot))));
+        capacity_ = capacity;
+      }
+
+      void dealloc() noexcept
+      {
+        if (ctrl_ == nullptr) return;
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+          if (ctrl_[i]) slots_[i].~slot();
+        }
+        delete[] ctrl_;
+        operator delete(slots_, std::align_val_t(alignof(slot)));
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+      }
+
+      void rehash(size_t capacity)
+      {
+        unsigned char* old_ctrl = ctrl_;
+        slot* old_slots = slots_;
+        size_t old_capacity = capacity_;
+        allocate(capacity);
+        size_t mask = capacity_ - 1;
+        for (size_t i = 0; i < old_capacity; ++i)
+        {
+          if (!old_ctrl[i]) continue;
+          slot& s = old_slots[i];
+          size_t j = s.hash & mask;
+          while (ctrl_[j]) j = (j + 1) & mask;
+          ctrl_[j] = old_ctrl[i];
+          new(&slots_[j]) slot{s.hash, move(s.key), move(s.value)};
+          s.~slot();
+        }
+        delete[] old_ctrl;
+        operator delete(old_slots, std::align_val_t(alignof(slot)));
+      }
+    public:
+      flat_table() noexcept : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0) {}
+      ~flat_table() { dealloc(); }
+
+      flat_table(const flat_table& other) = delete;
+      flat_table& operator=(const flat_table& other) = delete;
+
+      size_t size() const noexcept { return size_; }
+
+      slot* find(const K& key, size_t h) const
+      {
+        if (size_ == 0) return nullptr;
+        size_t mask = capacity_ - 1;
+        unsigned char t = tag(h);
+        for (size_t i = h & mask; ctrl_[i]; i = (i + 1) & mask)
+        {
+          if (ctrl_[i] == t && slots_[i].hash == h && KeyEqual{}(slots_[i].key, key))
+          {
+            return &slots_[i];
+          }
+        }
+        return nullptr;
+      }
+
+      // slot for key, constructing it from key and args if absent; inserted
+      // tells whether a new slot was created
+      template<typename KK, typename... Args>
+      slot* try_emplace(KK&& key, size_t h, bool& inserted, Args&&... args)
+      {
+        if (slot* s = find(key, h))
+        {
+          inserted = false;
+          return s;
+        }
+        if (4 * (size_ + 1) > 3 * capacity_)
+        {
+          rehash(capacity_ == 0 ? min_capacity : 2 * capacity_);
+        }
+        size_t mask = capacity_ - 1;
+        size_t i = h & mask;
+        while (ctrl_[i]) i = (i + 1) & mask;
+        new(&slots_[i]) slot{h, K(forward<KK>(key)), V(forward<Args>(args)...)};
+        ctrl_[i] = tag(h);
+        ++size_;
+        inserted = true;
+        return &slots_[i];
+      }
+
+      bool erase(const K& key, size_t h)
+      {
+        slot* s = find(key, h);
+        if (s == nullptr) return false;
+        size_t mask = capacity_ - 1;
+        size_t hole = static_cast<size_t>(s - slots_);
+        s->~slot();
+        ctrl_[hole] = 0;
+        --size_;
+
+        // shift later members of the probe run back so lookups never need
+        // tombstones
+        for (size_t j = (hole + 1) & mask; ctrl_[j]; j = (j + 1) & mask)
+        {
+          size_t home = slots_[j].hash & mask;
+          if (((j - home) & mask) >= ((j - hole) & mask))
+          {
+            new(&slots_[hole]) slot{slots_[j].hash, move(slots_[j].key), move(slots_[j].value)};
+            ctrl_[hole] = ctrl_[j];
+            slots_[j].~slot();
+            ctrl_[j] = 0;
+            hole = j;
+          }
+        }
+        return true;
+      }
+
+      template<typename F>
+      void for_each(F& f)
+      {
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+          if (ctrl_[i]) f(static_cast<const K&>(slots_[i].key), slots_[i].value);
+        }
+      }
+
+      void clear() noexcept
+      {
+        dealloc();
+        size_ = 0;
+      }
+    };
+  }
+
+  // hash map safe to share between threads
+  //
+  // keys are spread over a power of two number of shards by the top bits
+  // of their hash; each shard is a flat open addressing table behind its
+  // own reader/writer lock on its own cache line, so threads working on
+  // different keys rarely meet on the same lock. values are never handed
+  // out by reference: lookups copy them out or run a callback under the
+  // shard lock.
+  template<typename K, typename V, typename Hash = hash<K>, typename KeyEqual = equal_to<K>>
+  class concurrent_unordered_map {
+  public:
+    using key_type = K;
+    using mapped_type = V;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using size_type = size_t;
+  private:
+    using table = detail::flat_table<K, V, KeyEqual>;
+
+    struct alignas(cache_line_size) shard {
+      mutable std::shared_mutex mutex;
+      table map;
+    };
+
+    shard* shards_;
+    size_t shard_count_;
+    size_t shard_shift_;
+
+    static size_t hash_of(const K& key)
+    {
+      size_t h = Hash{}(key);
+      if constexpr (!is_avalanching_v<Hash>) h = hash_int(h);
+      return h;
+    }
+
+    shard& shard_for(size_t h) const noexcept
+    {
+      return shards_[shard_count_ == 1 ? 0 : h >> shard_shift_];
+    }
+  public:
+    // default number of shards
+    static constexpr size_t default_shard_count = 64;
+
+    // shard_count is rounded up to a power of two
+    explicit concurrent_unordered_map(size_t shard_count = default_shard_count) :
+      shards_(nullptr), shard_count_(1), shard_shift_(8 * sizeof(size_t))
+    {
+      while (shard_count_ < shard_count)
+      {
+        shard_count_ *= 2;
+        --shard_shift_;
+      }
+      shards_ = new shard[shard_count_];
+    }
+
+    // destructor
+    ~concurrent_unordered_map() { delete[] shards_; }
+
+    // shards hold locks and stay in place
+    concurrent_unordered_map(const concurrent_unordered_map& other) = delete;
+    concurrent_unordered_map& operator=(const concurrent_unordered_map& other) = delete;
+
+    // copy of the value stored for key, if any
+    std::optional<V> find(const K& key) const
+    {
+      size_t h = hash_of(key);
+      shard& s = shard_for(h);
+      std::shared_lock<std::shared_mutex> lock(s.mutex);
+      if (auto* slot = s.map.find(key, h)) return slot->value;
+      return std::nullopt;
+    }
+
+    bool contains(const K& key) const
+    {
+      size_t h = hash_of(key);
+      shard& s = shard_for(h);
+      std::shared_lock<std::shared_mutex> lock(s.mutex);
+      return s.map.find(key, h) != nullptr;
+    }
+
+    // call f(const V&) under a shared lock if key is present
+    template<typename F>
+    bool visit(const K& key, F f) const
+    {
+      size_t h = hash_of(key);
+      shard& s = shard_for(h);
+      std::shared_lock<std::shared_mutex> lock(s.mutex);
+      auto* slot = s.map.find(key, h);
+      if (slot == nullptr) return false;
+      f(static_cast<const V&>(slot->value));
+      return true;
+    }
+
+    // insert key -> value if key is absent; true if inserted
+    template<typename KK, typename VV>
+    bool insert(KK&& key, VV&& value)
+    {
+      size_t h = hash_of(key);
+      shard& s = shard_for(h);
+      std::unique_lock<std::shared_mutex> lock(s.mutex);
+      bool inserted;
+      s.map.try_emplace(forward<KK>(key), h, inserted, forward<VV>(value));
+      return inserted;
+    }
+
+    // insert key -> value or overwrite the existing value; true if inserted
+    template<typename KK, typename VV>
+    bool insert_or_assign(KK&& key, VV&& value)
+    {
+      size_t h = hash_of(key);
+      shard& s = shard_for(h);
+      std::unique_lock<std::shared_mutex> lock(s.mutex);
+      if (auto* slot = s.map.find(key, h))
+      {
+        slot->value = forward<VV>(value);
+        return false;
+      }
+      bool inserted;
+      s.map.try_emplace(forward<KK>(key), h, inserted, forward<VV>(value));
+      return true;
+    }
+
+    // call f(V&) under an exclusive lock if key is present
+    template<typename F>
+    bool update(const K& key, F f)
+    {
+      size_t h = hash_of(key);
+      shard& s = shard_for(h);
+      std::unique_lock<std::shared_mutex> lock(s.mutex);
+      auto* slot = s.map.find(key, h);
+      if (slot == nullptr) return false;
+      f(slot->value);
+      return true;
+    }
+
+    // call f(V&) on the value for key, inserting V(args...) first if absent
+    template<typename KK, typename F, typename... Args>
+    void upsert(KK&& key, F f, Args&&... args)
+    {
+      size_t h = hash_of(key);
+      shard& s = shard_for(h);
+      std::unique_lock<std::shared_mutex> lock(s.mutex);
+      bool inserted;
+      auto* slot = s.map.try_emplace(forward<KK>(key), h, inserted, forward<Args>(args)...);
+      f(slot->value);
+    }
+
+    // remove key; true if it was present
+    bool erase(const K& key)
+    {
+      size_t h = hash_of(key);
+      shard& s = shard_for(h);
+      std::unique_lock<std::shared_mutex> lock(s.mutex);
+      return s.map.erase(key, h);
+    }
+
+    // number of shards; each can be walked independently and in parallel
+    size_t shard_count() const noexcept { return shard_count_; }
+
+    // call f(const K&, V&) for every element of one shard under its lock
+    template<typename F>
+    void for_each_in_shard(size_t index, F f)
+    {
+      shard& s = shards_[index];
+      std::unique_lock<std::shared_mutex> lock(s.mutex);
+      s.map.for_each(f);
+    }
+
+    // call f(index) once per shard, e.g. to hand the shards to workers that
+    // then use for_each_in_shard
+    template<typename F>
+    void for_each_shard(F f)
+    {
+      for (size_t i = 0; i < shard_count_; ++i) f(i);
+    }
+
+    // call f(const K&, V&) for every element, one shard at a time
+    template<typename F>
+    void for_each(F f)
+    {
+      for (size_t i = 0; i < shard_count_; ++i) for_each_in_shard(i, f);
+    }
+
+    // observers; a snapshot that may be stale while writers are active
+    size_t size() const
+    {
+      size_t total = 0;
+      for (size_t i = 0; i < shard_count_; ++i)
+      {
+        std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+        total += shards_[i].map.size();
+      }
+      return total;
+    }
+    bool empty() const { return size() == 0; }
+
+    void clear()
+    {
+      for (size_t i = 0; i < shard_count_; ++i)
+      {
+        std::unique_lock<std::shared_mutex> lock(shards_[i].mutex);
+        shards_[i].map.clear();
+      }
+    }
+  };
+}
+
+#endif
@@ -21,6 +21,9 @@ namespace karls_standard_library {
     void* ptr;
   };
 
+  // distance that keeps independently written data off the same cache line
+  constexpr size_t cache_line_size = 64;
+
   // byte type
   enum class byte : unsigned char {};
 }
@@ -3,11 +3,14 @@
 
 #include "cstddef.hpp"
 #include "algorithm.hpp"
+#include <type_traits>
 
 namespace karls_standard_library {
   // string functions
   inline constexpr size_t strlen(const char* str)
   {
+    // the builtin folds for literals, so callers see the real length
+    if (!std::is_constant_evaluated()) return __builtin_strlen(str);
     const char* start = str;
     while (*str) ++str;
     return str - start;
@@ -28,7 +31,7 @@ namespace karls_standard_library {
     }
     return dest;
   }
-  inline int strcmp(const char* lhs, const char* rhs)
+  inline constexpr int strcmp(const char* lhs, const char* rhs)
   {
     while (*lhs && *rhs && *lhs == *rhs)
     {
@@ -0,0 +1,107 @@
+#ifndef KARLS_STANDARD_LIBRARY_FIXED_STRING_HPP
+#define KARLS_STANDARD_LIBRARY_FIXED_STRING_HPP
+
+#include "cstddef.hpp"
+#include "algorithm.hpp"
+#include "functional.hpp"
+#include "string_view.hpp"
+#include <ostream>
+
+namespace karls_standard_library {
+  // string of exactly N chars stored inline with a null terminator
+  //
+  // every member is public and the type is structural, so a fixed_string
+  // can be passed as a non-type template parameter:
+  //   template<fixed_string Name> struct opcode { ... };
+  //   opcode<"add"> add;
+  template<size_t N>
+  struct fixed_string {
+    using value_type = char;
+    using size_type = size_t;
+    using iterator = const char*;
+    using const_iterator = const char*;
+
+    char chars[N + 1];
+
+    // default constructor; N null chars
+    constexpr fixed_string() noexcept : chars() {}
+
+    // string literal constructor
+    constexpr fixed_string(const char (&str)[N + 1]) noexcept : chars()
+    {
+      for (size_t i = 0; i < N; ++i) chars[i] = str[i];
+    }
+
+    // element access
+    constexpr const char& operator[](size_t index) const noexcept { return chars[index]; }
+    constexpr const char* data() const noexcept { return chars; }
+    constexpr const char* c_str() const noexcept { return chars; }
+
+    // iterator functions
+    constexpr const_iterator begin() const noexcept { return chars; }
+    constexpr const_iterator end() const noexcept { return chars + N; }
+
+    // capacity functions
+    static constexpr size_t size() noexcept { return N; }
+    static constexpr size_t length() noexcept { return N; }
+    static constexpr bool empty() noexcept { return N == 0; }
+
+    // conversions
+    constexpr string_view view() const noexcept { return string_view(chars, N); }
+    constexpr operator string_view() const noexcept { return view(); }
+
+    // equality / comparison, also between different lengths
+    template<size_t M>
+    constexpr bool operator==(const fixed_string<M>& other) const noexcept
+    {
+      return view() == other.view();
+    }
+    template<size_t M>
+    constexpr auto operator<=>(const fixed_string<M>& other) const noexcept
+    {
+      return view() <=> other.view();
+    }
+  };
+
+  // deduce the length from a string literal, dropping its terminator
+  template<size_t N>
+  fixed_string(const char (&)[N]) -> fixed_string<N - 1>;
+
+  // concatenation
+  template<size_t N, size_t M>
+  constexpr fixed_string<N + M> operator+(const fixed_string<N>& lhs, const fixed_string<M>& rhs) noexcept
+  {
+    fixed_string<N + M> result;
+    for (size_t i = 0; i < N; ++i) result.chars[i] = lhs.chars[i];
+    for (size_t i = 0; i < M; ++i) result.chars[N + i] = rhs.chars[i];
+    return result;
+  }
+
+  // hash of the chars; equal to hash<string_view> of the same text
+  template<size_t N>
+  struct hash<fixed_string<N>> {
+    using is_avalanching = void;
+    size_t operator()(const fixed_string<N>& str) const noexcept
+    {
+      return hash_bytes(str.data(), N);
+    }
+  };
+
+  // non-member function for output stream
+  template<size_t N>
+  std::ostream& operator<<(std::ostream& os, const fixed_string<N>& str)
+  {
+    return os << str.view();
+  }
+
+  inline namespace literals {
+    // "text"_fs is a fixed_string usable in constant expressions
+    template<fixed_string S>
+    constexpr auto operator""_fs() noexcept
+    {
+      return S;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef KARLS_STANDARD_LIBRARY_FORMAT_HPP
+#define KARLS_STANDARD_LIBRARY_FORMAT_HPP
+
+#include "cstddef.hpp"
+#include "string.hpp"
+#include "string_view.hpp"
+#include "fixed_string.hpp"
+#include "charconv.hpp"
+#include <concepts>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace karls_standard_library {
+  // formatter<T> prints a T for format and format_to. a specialisation
+  // provides either
+  //   size_t size(const T&) const            upper bound on the chars written
+  //   char* write(char* out, const T&) const  write them, return the end
+  // so the whole message is reserved once and written in place, or, for
+  // output whose length is not known up front,
+  //   void append(string& out, const T&) const
+  // anything convertible to string_view is printed as text.
+  template<typename T>
+  struct formatter;
+
+  template<typename T>
+    requires detail::is_charconv_integer_v<T>
+  struct formatter<T> {
+    constexpr size_t size(T) const noexcept { return max_chars<T>; }
+    char* write(char* out, T value) const noexcept { return to_chars(out, out + max_chars<T>, value).ptr; }
+  };
+
+  // shortest round trip text, as to_chars
+  template<typename T>
+    requires detail::is_charconv_float_v<T>
+  struct formatter<T> {
+    constexpr size_t size(T) const noexcept { return max_chars<T>; }
+    char* write(char* out, T value) const noexcept { return to_chars(out, out + max_chars<T>, value).ptr; }
+  };
+
+  template<>
+  struct formatter<char> {
+    constexpr size_t size(char) const noexcept { return 1; }
+    char* write(char* out, char c) const noexcept
+    {
+      *out = c;
+      return out + 1;
+    }
+  };
+
+  template<>
+  struct formatter<bool> {
+    constexpr size_t size(bool value) const noexcept { return value ? 4 : 5; }
+    char* write(char* out, bool value) const noexcept
+    {
+      std::memcpy(out, value ? "true" : "false", size(value));
+      return out + size(value);
+    }
+  };
+
+  template<>
+  struct formatter<string_view> {
+    constexpr size_t size(string_view sv) const noexcept { return sv.size(); }
+    char* write(char* out, string_view sv) const noexcept
+    {
+      if (!sv.empty()) std::memcpy(out, sv.data(), sv.size());
+      return out + sv.size();
+    }
+  };
+
+  namespace detail {
+    template<typename T>
+    concept sized_formattable = requires(const formatter<T>& f, const T& value, char* out) {
+      { f.size(value) } -> std::convertible_to<size_t>;
+      { f.write(out, value) } -> std::same_as<char*>;
+    };
+
+    template<typename T>
+    concept appending_formattable = requires(const formatter<T>& f, const T& value, string& out) {
+      f.append(out, value);
+    };
+
+    // text arguments become string_views, so their length is taken once
+    template<typename T>
+    constexpr decltype(auto) format_arg(const T& value) noexcept
+    {
+      if constexpr (std::is_convertible_v<const T&, string_view> && !std::is_same_v<T, string_view>) return string_view(value);
+      else return (value);
+    }
+
+    template<typename T>
+    using format_arg_t = std::remove_cvref_t<decltype(format_arg(std::declval<const T&>()))>;
+
+    // reached only while parsing a bad format string at compile time, so
+    // the message shows up in the compiler's error
+    inline void format_string_error(const char*) {}
+
+    // a format string split at its {} placeholders: the literal text with
+    // {{ and }} collapsed, and the text offset at which each argument goes
+    template<size_t N>
+    struct format_spec {
+      char text[N + 1];
+      size_t text_size;
+      size_t splits[N + 1];
+      size_t args;
+    };
+
+    template<size_t N>
+    consteval format_spec<N> parse_format(const fixed_string<N>& fmt)
+    {
+      format_spec<N> spec{};
+      for (size_t i = 0; i < N; ++i)
+      {
+        char c = fmt[i];
+        bool doubled = i + 1 < N && fmt[i + 1] == c;
+        if (c == '{' && i + 1 < N && fmt[i + 1] == '}')
+        {
+          spec.splits[spec.args++] = spec.text_size;
+          ++i;
+        }
+        else if ((c == '{' || c == '}') && !doubled)
+        {
+          format_string_error(c == '{' ? "format: only {} placeholders are supported; write {{ for a literal {" : "format: unmatched }; write }} for a literal }");
+        }
+        else
+        {
+          spec.text[spec.text_size++] = c;
+          i += (c == '{' || c == '}');
+        }
+      }
+      return spec;
+    }
+
+    template<fixed_string Fmt>
+    inline constexpr format_spec<Fmt.size()> format_spec_v = parse_format(Fmt);
+
+    // the literal text in front of argument I, or after the last one
+    template<fixed_string Fmt, size_t I>
+    constexpr string_view format_text() noexcept
+    {
+      constexpr const auto& spec = format_spec_v<Fmt>;
+      constexpr size_t begin = I == 0 ? 0 : spec.splits[I - 1];
+      constexpr size_t end = I == spec.args ? spec.text_size : spec.splits[I];
+      return string_view(spec.text + begin, end - begin);
+    }
+
+    template<fixed_string Fmt, size_t I>
+    char* write_format_text(char* out) noexcept
+    {
+      constexpr string_view text = format_text<Fmt, I>();
+      if constexpr (text.size() > 0) std::memcpy(out, text.data(), text.size());
+      return out + text.size();
+    }
+
+    template<typename T>
+    void append_format_arg(string& out, const T& value)
+    {
+      formatter<T> f;
+      if constexpr (sized_formattable<T>)
+      {
+        size_t old_size = out.size();
+        out.resize_and_overwrite(old_size + f.size(value), [&](char* p, size_t) {
+          return static_cast<size_t>(f.write(p + old_size, value) - p);
+        });
+      }
+      else
+      {
+        f.append(out, value);
+      }
+    }
+
+    template<fixed_string Fmt, typename... Args>
+    void format_append(string& out, const Args&... args)
+    {
+      constexpr size_t text_size = format_spec_v<Fmt>.text_size;
+      if constexpr ((sized_formattable<Args> && ...))
+      {
+        // one reservation for the whole message, then straight writes
+        size_t old_size = out.size();
+        size_t bound = text_size + (size_t(0) + ... + formatter<Args>{}.size(args));
+        out.resize_and_overwrite(old_size + bound, [&](char* p, size_t) {
+          char* w = p + old_size;
+          [&]<size_t... I>(std::index_sequence<I...>) {
+            ((w = write_format_text<Fmt, I>(w), w = formatter<Args>{}.write(w, args)), ...);
+          }(std::index_sequence_for<Args...>{});
+          w = write_format_text<Fmt, sizeof...(Args)>(w);
+          return static_cast<size_t>(w - p);
+        });
+      }
+      else
+      {
+        // reserve what is known, then append piece by piece
+        size_t bound = text_size;
+        ([&] { if constexpr (sized_formattable<Args>) bound += formatter<Args>{}.size(args); }(), ...);
+        out.reserve(out.size() + bound);
+        [&]<size_t... I>(std::index_sequence<I...>) {
+          ((out.append(format_text<Fmt, I>()), append_format_arg(out, args)), ...);
+        }(std::index_sequence_for<Args...>{});
+        out.append(format_text<Fmt, sizeof...(Args)>());
+      }
+    }
+  }
+
+  // append the formatted message to out. Fmt is parsed at compile time:
+  // {} takes the next argument, {{ and }} are literal braces, and a
+  // placeholder count that differs from the argument count does not compile
+  template<fixed_string Fmt, typename... Args>
+    requires (detail::format_spec_v<Fmt>.args == sizeof...(Args))
+  string& format_to(string& out, const Args&... args)
+  {
+    static_assert(((detail::sized_formattable<detail::format_arg_t<Args>> || detail::appending_formattable<detail::format_arg_t<Args>>) && ...),
+                  "format: an argument type has no formatter specialisation");
+    detail::format_append<Fmt>(out, detail::format_arg(args)...);
+    return out;
+  }
+
+  // the formatted message as a new string, allocated once
+  template<fixed_string Fmt, typename... Args>
+    requires (detail::format_spec_v<Fmt>.args == sizeof...(Args))
+  string format(const Args&... args)
+  {
+    string result;
+    format_to<Fmt>(result, args...);
+    return result;
+  }
+}
+
+#endif
@@ -0,0 +1,314 @@
+#ifndef KARLS_STANDARD_LIBRARY_FROZEN_MAP_HPP
+#define KARLS_STANDARD_LIBRARY_FROZEN_MAP_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "array.hpp"
+#include "vector.hpp"
+#include "functional.hpp"
+#include "string_view.hpp"
+#include "fixed_string.hpp"
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace karls_standard_library {
+  namespace detail {
+    // little endian load of 4 / 8 bytes that also works in constant
+    // evaluation; at run time it is a single unaligned load
+    template<typename U>
+    constexpr U frozen_read(const char* p) noexcept
+    {
+      if (!std::is_constant_evaluated() && std::endian::native == std::endian::little)
+      {
+        U v;
+        __builtin_memcpy(&v, p, sizeof(U));
+        return v;
+      }
+      U v = 0;
+      for (size_t i = 0; i < sizeof(U); ++i)
+      {
+        v |= static_cast<U>(static_cast<unsigned char>(p[i])) << (8 * i);
+      }
+      return v;
+    }
+
+    // seeded byte hash computing the same value at compile and run time;
+    // wyhash shaped, one 128 bit multiply per 16 bytes plus one to finish
+    constexpr u64 frozen_hash_bytes(const char* p, size_t len, u64 seed) noexcept
+    {
+      u64 h = seed ^ (len * hash_secret[0]);
+      size_t rest = len;
+      for (; rest > 16; rest -= 16, p += 16)
+      {
+        h = hash_mix(frozen_read<u64>(p) ^ hash_secret[1], frozen_read<u64>(p + 8) ^ h);
+      }
+      u64 a = 0, b = 0;
+      if (rest > 8)
+      {
+        a = frozen_read<u64>(p);
+        b = frozen_read<u64>(p + rest - 8);
+      }
+      else if (rest >= 4)
+      {
+        a = (static_cast<u64>(frozen_read<std::uint32_t>(p)) << 32) | frozen_read<std::uint32_t>(p + rest - 4);
+      }
+      else if (rest > 0)
+      {
+        a = (static_cast<u64>(static_cast<unsigned char>(p[0])) << 16)
+          | (static_cast<u64>(static_cast<unsigned char>(p[rest >> 1])) << 8)
+          | static_cast<unsigned char>(p[rest - 1]);
+      }
+      return hash_mix(a ^ hash_secret[1] ^ len, b ^ h ^ hash_secret[2]);
+    }
+  }
+
+  // seeded hash used by the frozen containers; unlike hash<T> it must be
+  // constexpr, and must give the same answer at compile and run time
+  template<typename T>
+  struct frozen_hash {
+    constexpr std::uint64_t operator()(const T& value, std::uint64_t seed) const noexcept
+      requires std::is_integral_v<T> || std::is_enum_v<T>
+    {
+      return detail::hash_mix(static_cast<std::uint64_t>(value) ^ seed, detail::hash_secret[1]);
+    }
+  };
+
+  template<>
+  struct frozen_hash<string_view> {
+    constexpr std::uint64_t operator()(string_view sv, std::uint64_t seed) const noexcept
+    {
+      return detail::frozen_hash_bytes(sv.data(), sv.size(), seed);
+    }
+  };
+
+  template<size_t M>
+  struct frozen_hash<fixed_string<M>> {
+    constexpr std::uint64_t operator()(const fixed_string<M>& str, std::uint64_t seed) const noexcept
+    {
+      return detail::frozen_hash_bytes(str.data(), M, seed);
+    }
+  };
+
+  namespace detail {
+    // marks a displacement that holds a slot index instead of a seed
+    inline constexpr std::uint32_t pmh_direct = 0x80000000u;
+
+    // map x onto [0, n) with a multiply instead of a division
+    constexpr size_t pmh_reduce(u64 x, size_t n) noexcept
+    {
+      return static_cast<size_t>(((x >> 32) * n) >> 32);
+    }
+
+    constexpr u64 pmh_rehash(u64 h, std::uint32_t d) noexcept
+    {
+      return hash_mix(h ^ d, hash_secret[3]);
+    }
+
+    // minimal perfect hash over N keys in the hash and displace (chd) style
+    //
+    // a key's hash picks a bucket; the bucket's displacement either names
+    // the key's slot directly (single key buckets) or is mixed into the
+    // hash to pick it. slots are 0..N-1 with no gaps.
+    template<size_t N>
+    struct perfect_hash {
+      static constexpr size_t bucket_count = N <= 2 ? 1 : std::bit_ceil(N) / 2;
+
+      u64 seed;
+      array<std::uint32_t, bucket_count> displacement;
+
+      constexpr size_t slot(u64 h) const noexcept
+      {
+        std::uint32_t d = displacement[h & (bucket_count - 1)];
+        return (d & pmh_direct) ? (d & ~pmh_direct) : pmh_reduce(pmh_rehash(h, d), N);
+      }
+    };
+
+    // find a perfect hash for keys; slots[i] receives the slot of keys[i].
+    // throws std::invalid_argument on duplicate keys, which turns into a
+    // compile error when the table is built in a constant expression
+    template<size_t N, typename Key, typename Hasher>
+    constexpr perfect_hash<N> build_perfect_hash(const Key* keys, array<size_t, N>& slots)
+    {
+      static_assert(N < pmh_direct, "too many keys");
+      constexpr size_t buckets = perfect_hash<N>::bucket_count;
+      constexpr std::uint32_t max_displacement = static_cast<std::uint32_t>(min<size_t>(64 * N + 1024, pmh_direct - 1));
+
+      perfect_hash<N> ph{};
+      vector<u64> hashes(N);
+      vector<size_t> start(buckets + 1);
+      vector<size_t> members(N);
+      vector<size_t> order(buckets);
+      vector<char> used(N);
+      vector<size_t> placed(N);
+
+      for (u64 attempt = 0;; ++attempt)
+      {
+        ph.seed = hash_mix(attempt ^ hash_secret[2], hash_secret[3]);
+        for (size_t i = 0; i < N; ++i) hashes[i] = Hasher{}(keys[i], ph.seed);
+
+        // group keys by bucket with a counting sort
+        for (size_t b = 0; b <= buckets; ++b) start[b] = 0;
+        for (size_t i = 0; i < N; ++i) ++start[(hashes[i] & (buckets - 1)) + 1];
+        for (size_t b = 0; b < buckets; ++b) start[b + 1] += start[b];
+        for (size_t b = 0; b < buckets; ++b) order[b] = start[b];
+        for (size_t i = 0; i < N; ++i) members[order[hashes[i] & (buckets - 1)]++] = i;
+
+        // place big buckets first while most slots are still free
+        size_t largest = 0;
+        for (size_t b = 0; b < buckets; ++b) largest = max(largest, start[b + 1] - start[b]);
+        size_t count = 0;
+        for (size_t size = largest; size > 0; --size)
+        {
+          for (size_t b = 0; b < buckets; ++b)
+          {
+            if (start[b + 1] - start[b] == size) order[count++] = b;
+          }
+        }
+
+        for (size_t i = 0; i < N; ++i) used[i] = 0;
+        for (size_t b = 0; b < buckets; ++b) ph.displacement[b] = 0;
+        bool ok = true;
+        size_t free_slot = 0;
+        for (size_t k = 0; k < count && ok; ++k)
+        {
+          size_t b = order[k];
+          size_t first = start[b];
+          size_t size = start[b + 1] - first;
+          if (size == 1)
+          {
+            while (used[free_slot]) ++free_slot;
+            used[free_slot] = 1;
+            slots[members[first]] = free_slot;
+            ph.displacement[b] = pmh_direct | static_cast<std::uint32_t>(free_slot);
+            continue;
+          }
+
+          for (size_t x = first; x < start[b + 1] && ok; ++x)
+          {
+            for (size_t y = first; y < x; ++y)
+            {
+              if (hashes[members[x]] != hashes[members[y]]) continue;
+              if (keys[members[x]] == keys[members[y]]) throw std::invalid_argument("duplicate key");
+              ok = false;
+            }
+          }
+
+          bool found = false;
+          for (std::uint32_t d = 1; ok && !found && d < max_displacement; ++d)
+          {
+            size_t n = 0;
+            for (; n < size; ++n)
+            {
+              size_t s = pmh_reduce(pmh_rehash(hashes[members[first + n]], d), N);
+              if (used[s]) break;
+              used[s] = 1;
+              placed[n] = s;
+            }
+            if (n == size)
+            {
+              found = true;
+              ph.displacement[b] = d;
+              for (size_t j = 0; j < size; ++j) slots[members[first + j]] = placed[j];
+            }
+            else
+            {
+              for (size_t j = 0; j < n; ++j) used[placed[j]] = 0;
+            }
+          }
+          ok = ok && found;
+        }
+        if (ok) return ph;
+      }
+    }
+  }
+
+  // immutable map whose perfect hash is computed from its initializer,
+  // normally at compile time:
+  //
+  //   constexpr auto opcodes = make_frozen_map<string_view, int>({
+  //     {"add", 1}, {"sub", 2}, {"mul", 3}
+  //   });
+  //
+  // a lookup hashes the key once, reads one displacement and compares one
+  // stored key. keys and values live in separate arrays indexed by slot.
+  template<typename Key, typename Value, size_t N, typename Hasher = frozen_hash<Key>>
+  class frozen_map {
+  public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using size_type = size_t;
+
+    static_assert(N > 0, "a frozen_map needs at least one key");
+  private:
+    detail::perfect_hash<N> hash_;
+    array<Key, N> keys_;
+    array<Value, N> values_;
+  public:
+    // build from key / value pairs; duplicate keys are an error
+    constexpr frozen_map(const Pair<Key, Value> (&items)[N]) : hash_(), keys_(), values_()
+    {
+      array<Key, N> input;
+      for (size_t i = 0; i < N; ++i) input[i] = items[i].first;
+      array<size_t, N> slots;
+      hash_ = detail::build_perfect_hash<N, Key, Hasher>(input.data(), slots);
+      for (size_t i = 0; i < N; ++i)
+      {
+        keys_[slots[i]] = items[i].first;
+        values_[slots[i]] = items[i].second;
+      }
+    }
+
+    // slot of key in keys() / values(), npos if absent
+    constexpr size_t index_of(const Key& key) const noexcept
+    {
+      size_t slot = hash_.slot(Hasher{}(key, hash_.seed));
+      return keys_[slot] == key ? slot : npos;
+    }
+
+    // lookup
+    constexpr const Value* find(const Key& key) const noexcept
+    {
+      size_t slot = index_of(key);
+      return slot == npos ? nullptr : &values_[slot];
+    }
+    constexpr bool contains(const Key& key) const noexcept { return index_of(key) != npos; }
+    constexpr size_t count(const Key& key) const noexcept { return contains(key) ? 1 : 0; }
+    constexpr const Value& at(const Key& key) const
+    {
+      size_t slot = index_of(key);
+      if (slot == npos) throw std::out_of_range("key not found");
+      return values_[slot];
+    }
+    constexpr const Value& value_or(const Key& key, const Value& fallback) const noexcept
+    {
+      size_t slot = index_of(key);
+      return slot == npos ? fallback : values_[slot];
+    }
+
+    // capacity functions
+    static constexpr size_t size() noexcept { return N; }
+    static constexpr bool empty() noexcept { return false; }
+
+    // contents in slot order
+    constexpr const array<Key, N>& keys() const noexcept { return keys_; }
+    constexpr const array<Value, N>& values() const noexcept { return values_; }
+
+    // call f(key, value) for every entry in slot order
+    template<typename F>
+    constexpr void for_each(F f) const
+    {
+      for (size_t i = 0; i < N; ++i) f(keys_[i], values_[i]);
+    }
+  };
+
+  // deduce N from a braced list of pairs
+  template<typename Key, typename Value, typename Hasher = frozen_hash<Key>, size_t N>
+  constexpr frozen_map<Key, Value, N, Hasher> make_frozen_map(const Pair<Key, Value> (&items)[N])
+  {
+    return frozen_map<Key, Value, N, Hasher>(items);
+  }
+}
+
+#endif
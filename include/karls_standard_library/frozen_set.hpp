@@ -0,0 +1,59 @@
+#ifndef KARLS_STANDARD_LIBRARY_FROZEN_SET_HPP
+#define KARLS_STANDARD_LIBRARY_FROZEN_SET_HPP
+
+#include "frozen_map.hpp"
+
+namespace karls_standard_library {
+  // immutable set with a perfect hash computed from its initializer;
+  // membership is one hash, one displacement read and one compare
+  template<typename Key, size_t N, typename Hasher = frozen_hash<Key>>
+  class frozen_set {
+  public:
+    using key_type = Key;
+    using value_type = Key;
+    using size_type = size_t;
+    using const_iterator = const Key*;
+
+    static_assert(N > 0, "a frozen_set needs at least one key");
+  private:
+    detail::perfect_hash<N> hash_;
+    array<Key, N> keys_;
+  public:
+    // build from keys; duplicates are an error
+    constexpr frozen_set(const Key (&keys)[N]) : hash_(), keys_()
+    {
+      array<size_t, N> slots;
+      hash_ = detail::build_perfect_hash<N, Key, Hasher>(keys, slots);
+      for (size_t i = 0; i < N; ++i) keys_[slots[i]] = keys[i];
+    }
+
+    // slot of key in keys(), npos if absent; a dense id for the key
+    constexpr size_t index_of(const Key& key) const noexcept
+    {
+      size_t slot = hash_.slot(Hasher{}(key, hash_.seed));
+      return keys_[slot] == key ? slot : npos;
+    }
+
+    // lookup
+    constexpr bool contains(const Key& key) const noexcept { return index_of(key) != npos; }
+    constexpr size_t count(const Key& key) const noexcept { return contains(key) ? 1 : 0; }
+
+    // capacity functions
+    static constexpr size_t size() noexcept { return N; }
+    static constexpr bool empty() noexcept { return false; }
+
+    // keys in slot order
+    constexpr const array<Key, N>& keys() const noexcept { return keys_; }
+    constexpr const_iterator begin() const noexcept { return keys_.begin(); }
+    constexpr const_iterator end() const noexcept { return keys_.end(); }
+  };
+
+  // deduce N from a braced list of keys
+  template<typename Key, typename Hasher = frozen_hash<Key>, size_t N>
+  constexpr frozen_set<Key, N, Hasher> make_frozen_set(const Key (&keys)[N])
+  {
+    return frozen_set<Key, N, Hasher>(keys);
+  }
+}
+
+#endif
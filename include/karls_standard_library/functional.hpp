@@ -1,6 +1,18 @@
 #ifndef KARLS_STANDARD_LIBRARY_FUNCTIONAL_HPP
 #define KARLS_STANDARD_LIBRARY_FUNCTIONAL_HPP
 
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <limits>
+#include <functional>
+#include <new>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace karls_standard_library {
   // less than operator wrapper
   template<typename T>
@@ -33,6 +45,622 @@ namespace karls_standard_library {
       return lhs != rhs;
     }
   };
+
+  // hashing
+  //
+  // hash<T> is specialized here for arithmetic, enum and pointer types and
+  // next to each container for the library types. hash values are only
+  // meant for in-memory tables and are not stable between builds.
+  //
+  // a hash that declares `using is_avalanching = void;` promises every
+  // output bit depends on every input bit, so tables can use its result
+  // directly instead of mixing it again.
+  template<typename T>
+  struct hash;
+
+  // true when H produces well mixed output
+  template<typename H>
+  inline constexpr bool is_avalanching_v = requires { typename H::is_avalanching; };
+
+  namespace detail {
+    using u64 = std::uint64_t;
+
+    // 64x64 -> 128 bit multiply; a receives the low and b the high half
+    inline constexpr void hash_mum(u64& a, u64& b) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+      __uint128_t r = static_cast<__uint128_t>(a) * b;
+      a = static_cast<u64>(r);
+      b = static_cast<u64>(r >> 64);
+#else
+      u64 ha = a >> 32, la = a & 0xffffffffu, hb = b >> 32, lb = b & 0xffffffffu;
+      u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+      u64 t = rl + (rm0 << 32);
+      u64 c = t < rl;
+      u64 lo = t + (rm1 << 32);
+      c += lo < t;
+      a = lo;
+      b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+    }
+
+    // multiply and fold the halves with xor, the core of wyhash
+    inline constexpr u64 hash_mix(u64 a, u64 b) noexcept
+    {
+      hash_mum(a, b);
+      return a ^ b;
+    }
+
+    inline constexpr u64 hash_secret[4] = {
+      0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+      0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+    };
+
+    inline u64 read8(const unsigned char* p) noexcept
+    {
+      u64 v;
+      std::memcpy(&v, p, 8);
+      return v;
+    }
+    inline u64 read4(const unsigned char* p) noexcept
+    {
+      std::uint32_t v;
+      std::memcpy(&v, p, 4);
+      return v;
+    }
+
+    // wyhash over len bytes; fast for short and medium inputs
+    inline u64 wyhash(const unsigned char* p, size_t len, u64 seed) noexcept
+    {
+      const u64* secret = hash_secret;
+      seed ^= hash_mix(seed ^ secret[0], secret[1]);
+      u64 a, b;
+      if (len <= 16)
+      {
+        if (len >= 4)
+        {
+          a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+          b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+        }
+        else if (len > 0)
+        {
+          a = (static_cast<u64>(p[0]) << 16) | (static_cast<u64>(p[len >> 1]) << 8) | p[len - 1];
+          b = 0;
+        }
+        else
+        {
+          a = b = 0;
+        }
+      }
+      else
+      {
+        size_t i = len;
+        if (i > 48)
+        {
+          u64 see1 = seed, see2 = seed;
+          do
+          {
+            seed = hash_mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+            see1 = hash_mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+            see2 = hash_mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+            p += 48;
+            i -= 48;
+          } while (i > 48);
+          seed ^= see1 ^ see2;
+        }
+        while (i > 16)
+        {
+          seed = hash_mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+          i -= 16;
+          p += 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+      }
+      a ^= secret[1];
+      b ^= seed;
+      hash_mum(a, b);
+      return hash_mix(a ^ secret[0] ^ len, b ^ secret[1]);
+    }
+
+#if defined(__AVX2__)
+    // splitmix64 sequence used as the sliding key of the avx2 long input path
+    struct stripe_key {
+      u64 lanes[24];
+
+      constexpr stripe_key() : lanes()
+      {
+        u64 x = 0x9e3779b97f4a7c15ull;
+        for (size_t i = 0; i < 24; ++i)
+        {
+          x += 0x9e3779b97f4a7c15ull;
+          u64 z = x;
+          z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+          z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+          lanes[i] = z ^ (z >> 31);
+        }
+      }
+    };
+    inline constexpr stripe_key hash_stripe_key{};
+
+    // number of 64 byte stripes accumulated between scrambles
+    inline constexpr size_t stripes_per_block = 16;
+    inline constexpr size_t stripe_bytes = 64;
+
+    // xxh3 style accumulation of whole stripes into eight 64 bit lanes
+    // held in two registers; each lane adds its neighbour's input word and
+    // the 32x32 bit product of its own word mixed with a sliding key
+    inline void accumulate(u64* acc, const unsigned char* p, size_t count) noexcept
+    {
+      const u64* key = hash_stripe_key.lanes;
+      size_t stripe = 0;
+      __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc));
+      __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4));
+      const __m256i prime = _mm256_set1_epi64x(0x9e3779b1u);
+      for (size_t n = 0; n < count; ++n, p += stripe_bytes)
+      {
+        const u64* k = key + stripe;
+        __m256i d0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i d1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        __m256i m0 = _mm256_xor_si256(d0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k)));
+        __m256i m1 = _mm256_xor_si256(d1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k + 4)));
+        a0 = _mm256_add_epi64(a0, _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2)));
+        a1 = _mm256_add_epi64(a1, _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2)));
+        a0 = _mm256_add_epi64(a0, _mm256_mul_epu32(m0, _mm256_srli_epi64(m0, 32)));
+        a1 = _mm256_add_epi64(a1, _mm256_mul_epu32(m1, _mm256_srli_epi64(m1, 32)));
+
+        // scramble: acc = (acc ^ (acc >> 47) ^ key) * prime
+        if (++stripe == stripes_per_block)
+        {
+          const u64* s = key + stripes_per_block;
+          a0 = _mm256_xor_si256(a0, _mm256_srli_epi64(a0, 47));
+          a1 = _mm256_xor_si256(a1, _mm256_srli_epi64(a1, 47));
+          a0 = _mm256_xor_si256(a0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+          a1 = _mm256_xor_si256(a1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 4)));
+          a0 = _mm256_add_epi64(_mm256_mul_epu32(a0, prime),
+                                _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a0, 32), prime), 32));
+          a1 = _mm256_add_epi64(_mm256_mul_epu32(a1, prime),
+                                _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a1, 32), prime), 32));
+          stripe = 0;
+        }
+      }
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), a0);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4), a1);
+    }
+
+    // long inputs: accumulate 64 byte stripes in parallel lanes, then
+    // fold the lanes and hash the tail with wyhash
+    inline u64 long_hash(const unsigned char* p, size_t len, u64 seed) noexcept
+    {
+      u64 acc[8] = {
+        hash_secret[0] ^ seed, hash_secret[1], hash_secret[2], hash_secret[3],
+        hash_secret[0], hash_secret[1] ^ seed, hash_secret[2], hash_secret[3]
+      };
+      size_t stripes = len / stripe_bytes;
+      accumulate(acc, p, stripes);
+
+      u64 h = len * 0x9e3779b97f4a7c15ull;
+      for (size_t i = 0; i < 8; i += 2)
+      {
+        h += hash_mix(acc[i] ^ hash_secret[i / 2], acc[i + 1] ^ hash_stripe_key.lanes[i]);
+      }
+      size_t tail = len - stripes * stripe_bytes;
+      return wyhash(p + len - tail, tail, h);
+    }
+
+    inline constexpr size_t long_hash_threshold = 1024;
+#endif
+  }
+
+  // hash len bytes starting at data
+  inline size_t hash_bytes(const void* data, size_t len, std::uint64_t seed = 0) noexcept
+  {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+#if defined(__AVX2__)
+    if (len >= detail::long_hash_threshold) return static_cast<size_t>(detail::long_hash(p, len, seed));
+#endif
+    return static_cast<size_t>(detail::wyhash(p, len, seed));
+  }
+
+  // strong 64 bit mixer for a single word
+  inline size_t hash_int(std::uint64_t x) noexcept
+  {
+    return static_cast<size_t>(detail::hash_mix(x ^ detail::hash_secret[0], detail::hash_secret[1]));
+  }
+
+  // fold the hash h of another value into seed
+  inline size_t hash_combine(size_t seed, size_t h) noexcept
+  {
+    return static_cast<size_t>(detail::hash_mix(seed ^ detail::hash_secret[2], h ^ detail::hash_secret[3]));
+  }
+
+  // integral and enum types
+  template<typename T>
+  requires std::is_integral_v<T> || std::is_enum_v<T>
+  struct hash<T> {
+    using is_avalanching = void;
+    size_t operator()(T value) const noexcept
+    {
+      return hash_int(static_cast<std::uint64_t>(value));
+    }
+  };
+
+  // floating point; 0.0 and -0.0 compare equal so they hash equal. the x87
+  // 80 bit long double keeps its value in the low 10 bytes and the rest is
+  // padding with whatever the last store left there
+  template<typename T>
+  requires std::is_floating_point_v<T>
+  struct hash<T> {
+    using is_avalanching = void;
+    static constexpr size_t value_bytes =
+      std::numeric_limits<T>::digits == 64 && std::numeric_limits<T>::max_exponent == 16384 ? 10 : sizeof(T);
+
+    size_t operator()(T value) const noexcept
+    {
+      if (value == T{}) return hash_int(0);
+      return hash_bytes(&value, value_bytes);
+    }
+  };
+
+  // pointers hash their address
+  template<typename T>
+  struct hash<T*> {
+    using is_avalanching = void;
+    size_t operator()(T* ptr) const noexcept
+    {
+      return hash_int(reinterpret_cast<std::uintptr_t>(ptr));
+    }
+  };
+
+  template<>
+  struct hash<nullptr_t> {
+    using is_avalanching = void;
+    size_t operator()(nullptr_t) const noexcept { return hash_int(0); }
+  };
+
+  // hash a range of elements; contiguous runs of types whose value is
+  // exactly their bytes are hashed in one pass over memory
+  template<typename T>
+  size_t hash_range(const T* first, size_t count) noexcept
+  {
+    if constexpr (std::has_unique_object_representations_v<T>)
+    {
+      return hash_bytes(first, count * sizeof(T));
+    }
+    else
+    {
+      size_t h = hash_int(count);
+      for (size_t i = 0; i < count; ++i)
+      {
+        h = hash_combine(h, hash<T>{}(first[i]));
+      }
+      return h;
+    }
+  }
+
+  // hash combining the hashes of both members
+  template<typename T1, typename T2>
+  struct hash<Pair<T1, T2>> {
+    size_t operator()(const Pair<T1, T2>& p) const noexcept
+    {
+      return hash_combine(hash<T1>{}(p.first), hash<T2>{}(p.second));
+    }
+  };
+
+  // type erased callables
+  //
+  // function and move_only_function keep callables of up to InlineSize
+  // bytes inside the object itself and only allocate for larger ones.
+  // function_ref never owns or allocates; it is two pointers wide.
+  namespace detail {
+    // invoke f with args, converting the result to R
+    template<typename R, typename F, typename... Args>
+    R invoke_r(F& f, Args&&... args)
+    {
+      if constexpr (std::is_void_v<R>)
+      {
+        std::invoke(f, forward<Args>(args)...);
+      }
+      else
+      {
+        return std::invoke(f, forward<Args>(args)...);
+      }
+    }
+
+    // storage and dispatch shared by function and move_only_function
+    template<bool Copyable, size_t InlineSize, typename R, typename... Args>
+    class function_base {
+    protected:
+      static_assert(InlineSize >= sizeof(void*), "inline storage must hold a pointer");
+
+      struct vtable {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*copy)(void* dst, const void* src);
+        void (*destroy)(void* storage) noexcept;
+      };
+
+      // callables stored in place must fit, be suitably aligned and move
+      // without throwing so the wrapper's own move can be noexcept
+      template<typename F>
+      static constexpr bool stored_inline =
+        sizeof(F) <= InlineSize &&
+        alignof(F) <= alignof(max_align_t) &&
+        std::is_nothrow_move_constructible_v<F>;
+
+      template<typename F>
+      static F* target(void* storage) noexcept
+      {
+        if constexpr (stored_inline<F>) return std::launder(static_cast<F*>(storage));
+        else return *static_cast<F**>(storage);
+      }
+
+      template<typename F>
+      static R invoke_impl(void* storage, Args&&... args)
+      {
+        return invoke_r<R>(*target<F>(storage), forward<Args>(args)...);
+      }
+      template<typename F>
+      static void move_impl(void* dst, void* src) noexcept
+      {
+        if constexpr (stored_inline<F>)
+        {
+          F* from = target<F>(src);
+          new(dst) F(move(*from));
+          from->~F();
+        }
+        else
+        {
+          *static_cast<F**>(dst) = *static_cast<F**>(src);
+        }
+      }
+      template<typename F>
+      static void copy_impl(void* dst, const void* src)
+      {
+        if constexpr (Copyable)
+        {
+          F* from = target<F>(const_cast<void*>(src));
+          if constexpr (stored_inline<F>) new(dst) F(*from);
+          else *static_cast<F**>(dst) = new F(*from);
+        }
+      }
+      template<typename F>
+      static void destroy_impl(void* storage) noexcept
+      {
+        if constexpr (stored_inline<F>) target<F>(storage)->~F();
+        else delete target<F>(storage);
+      }
+
+      template<typename F>
+      static constexpr vtable vtable_for = {
+        &invoke_impl<F>, &move_impl<F>, Copyable ? &copy_impl<F> : nullptr, &destroy_impl<F>
+      };
+
+      // the empty state has its own table so calls need no null check
+      static R invoke_empty(void*, Args&&...) { throw std::bad_function_call(); }
+      static void move_empty(void*, void*) noexcept {}
+      static void copy_empty(void*, const void*) {}
+      static void destroy_empty(void*) noexcept {}
+      static constexpr vtable empty_vtable = {
+        &invoke_empty, &move_empty, &copy_empty, &destroy_empty
+      };
+
+      alignas(max_align_t) unsigned char storage_[InlineSize];
+      const vtable* vtable_;
+
+      function_base() noexcept : vtable_(&empty_vtable) {}
+
+      template<typename F>
+      void emplace(F&& f)
+      {
+        using D = std::decay_t<F>;
+        using P = std::remove_cvref_t<F>;
+        if constexpr (std::is_pointer_v<P> || std::is_member_pointer_v<P>)
+        {
+          if (f == nullptr) return;
+        }
+        if constexpr (stored_inline<D>) new(storage_) D(forward<F>(f));
+        else *reinterpret_cast<D**>(storage_) = new D(forward<F>(f));
+        vtable_ = &vtable_for<D>;
+      }
+
+      void reset() noexcept
+      {
+        vtable_->destroy(storage_);
+        vtable_ = &empty_vtable;
+      }
+
+      void move_from(function_base& other) noexcept
+      {
+        other.vtable_->move(storage_, other.storage_);
+        vtable_ = exchange(other.vtable_, &empty_vtable);
+      }
+
+      void copy_from(const function_base& other)
+      {
+        other.vtable_->copy(storage_, other.storage_);
+        vtable_ = other.vtable_;
+      }
+
+      ~function_base() { vtable_->destroy(storage_); }
+    public:
+      // invoke the stored callable; throws std::bad_function_call if empty
+      R operator()(Args... args) const
+      {
+        return vtable_->invoke(const_cast<unsigned char*>(storage_), forward<Args>(args)...);
+      }
+
+      explicit operator bool() const noexcept { return vtable_ != &empty_vtable; }
+      bool operator==(nullptr_t) const noexcept { return !*this; }
+
+      // true if f would be held without a heap allocation
+      template<typename F>
+      static constexpr bool fits_inline() noexcept { return stored_inline<std::decay_t<F>>; }
+    };
+  }
+
+  // default inline storage; fits a lambda capturing three pointers
+  inline constexpr size_t function_inline_size = 3 * sizeof(void*);
+
+  template<typename Signature, size_t InlineSize = function_inline_size>
+  class function;
+
+  // copyable type erased callable with small buffer storage
+  template<typename R, typename... Args, size_t InlineSize>
+  class function<R(Args...), InlineSize> : public detail::function_base<true, InlineSize, R, Args...> {
+  private:
+    using base = detail::function_base<true, InlineSize, R, Args...>;
+  public:
+    using result_type = R;
+
+    // default and null constructors
+    function() noexcept = default;
+    function(nullptr_t) noexcept {}
+
+    // store a copy of any callable with a compatible signature
+    template<typename F>
+    requires (!std::is_same_v<std::decay_t<F>, function> &&
+              std::is_copy_constructible_v<std::decay_t<F>> &&
+              std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    function(F&& f) { this->emplace(forward<F>(f)); }
+
+    // copy constructor and assignment operator
+    function(const function& other) { this->copy_from(other); }
+    function& operator=(const function& other)
+    {
+      if (this != &other)
+      {
+        function temp(other);
+        swap(temp);
+      }
+      return *this;
+    }
+
+    // move constructor and assignment operator
+    function(function&& other) noexcept { this->move_from(other); }
+    function& operator=(function&& other) noexcept
+    {
+      if (this != &other)
+      {
+        this->reset();
+        this->move_from(other);
+      }
+      return *this;
+    }
+
+    function& operator=(nullptr_t) noexcept
+    {
+      this->reset();
+      return *this;
+    }
+
+    void swap(function& other) noexcept
+    {
+      function temp(move(other));
+      other = move(*this);
+      *this = move(temp);
+    }
+  };
+
+  template<typename Signature, size_t InlineSize = function_inline_size>
+  class move_only_function;
+
+  // move only type erased callable; accepts non-copyable callables and
+  // never allocates for ones that fit in InlineSize bytes
+  template<typename R, typename... Args, size_t InlineSize>
+  class move_only_function<R(Args...), InlineSize> : public detail::function_base<false, InlineSize, R, Args...> {
+  public:
+    using result_type = R;
+
+    // default and null constructors
+    move_only_function() noexcept = default;
+    move_only_function(nullptr_t) noexcept {}
+
+    // take ownership of any callable with a compatible signature
+    template<typename F>
+    requires (!std::is_same_v<std::decay_t<F>, move_only_function> &&
+              std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    move_only_function(F&& f) { this->emplace(forward<F>(f)); }
+
+    // explicitly delete copy constructor and copy assignment
+    move_only_function(const move_only_function& other) = delete;
+    move_only_function& operator=(const move_only_function& other) = delete;
+
+    // move constructor and assignment operator
+    move_only_function(move_only_function&& other) noexcept { this->move_from(other); }
+    move_only_function& operator=(move_only_function&& other) noexcept
+    {
+      if (this != &other)
+      {
+        this->reset();
+        this->move_from(other);
+      }
+      return *this;
+    }
+
+    move_only_function& operator=(nullptr_t) noexcept
+    {
+      this->reset();
+      return *this;
+    }
+
+    void swap(move_only_function& other) noexcept
+    {
+      move_only_function temp(move(other));
+      other = move(*this);
+      *this = move(temp);
+    }
+  };
+
+  template<typename Signature>
+  class function_ref;
+
+  // non-owning reference to a callable; the referenced object must outlive
+  // the function_ref. calling it is a single indirect call.
+  template<typename R, typename... Args>
+  class function_ref<R(Args...)> {
+  private:
+    union bound {
+      void* object;
+      void (*function)();
+    };
+
+    bound bound_;
+    R (*invoke_)(bound, Args&&...);
+  public:
+    // refer to a callable object
+    template<typename F>
+    requires (!std::is_same_v<std::remove_cvref_t<F>, function_ref> &&
+              !std::is_function_v<std::remove_pointer_t<std::remove_cvref_t<F>>> &&
+              std::is_invocable_r_v<R, std::remove_reference_t<F>&, Args...>)
+    function_ref(F&& f) noexcept
+    {
+      bound_.object = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+      invoke_ = [](bound b, Args&&... args) -> R {
+        using T = std::remove_reference_t<F>;
+        return detail::invoke_r<R>(*static_cast<T*>(b.object), forward<Args>(args)...);
+      };
+    }
+
+    // refer to a free function
+    template<typename F>
+    requires (std::is_function_v<F> && std::is_invocable_r_v<R, F&, Args...>)
+    function_ref(F* f) noexcept
+    {
+      bound_.function = reinterpret_cast<void (*)()>(f);
+      invoke_ = [](bound b, Args&&... args) -> R {
+        return detail::invoke_r<R>(*reinterpret_cast<F*>(b.function), forward<Args>(args)...);
+      };
+    }
+
+    function_ref(const function_ref& other) noexcept = default;
+    function_ref& operator=(const function_ref& other) noexcept = default;
+
+    R operator()(Args... args) const
+    {
+      return invoke_(bound_, forward<Args>(args)...);
+    }
+  };
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+#ifndef KARLS_STANDARD_LIBRARY_HEAP_HPP
+#define KARLS_STANDARD_LIBRARY_HEAP_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "functional.hpp"
+#include <iterator>
+
+namespace karls_standard_library {
+  // heap algorithms over random access ranges for a D-ary max heap (the
+  // largest element by comp is at the front), D = 4 by default. the four
+  // children of a node share a cache line for most element types, so a
+  // 4-ary heap does half the levels of a binary one for the same misses.
+  namespace detail {
+    struct heap_no_tracking {
+      constexpr void operator()(ptrdiff_t) const noexcept {}
+    };
+
+    // move first[hole] towards the root; moved(i) is told every index that
+    // received an element
+    template<size_t D, typename It, typename Compare, typename Moved>
+    constexpr ptrdiff_t heap_sift_up(It first, ptrdiff_t hole, Compare& comp, Moved& moved)
+    {
+      auto value = karls_standard_library::move(first[hole]);
+      while (hole > 0)
+      {
+        ptrdiff_t parent = (hole - 1) / static_cast<ptrdiff_t>(D);
+        if (!comp(first[parent], value)) break;
+        first[hole] = karls_standard_library::move(first[parent]);
+        moved(hole);
+        hole = parent;
+      }
+      first[hole] = karls_standard_library::move(value);
+      moved(hole);
+      return hole;
+    }
+
+    // fill the hole at first[hole] with value, moving it towards the
+    // leaves of the heap [first, first + len)
+    template<size_t D, typename It, typename T, typename Compare, typename Moved>
+    constexpr ptrdiff_t heap_place_down(It first, ptrdiff_t len, ptrdiff_t hole, T&& value, Compare& comp, Moved& moved)
+    {
+      constexpr ptrdiff_t d = static_cast<ptrdiff_t>(D);
+      for (;;)
+      {
+        ptrdiff_t child = d * hole + 1;
+        ptrdiff_t best = child;
+        if (child + d <= len)
+        {
+          // full set of children, the common case; unrolled by the compiler
+          for (ptrdiff_t c = 1; c < d; ++c)
+          {
+            if (comp(first[best], first[child + c])) best = child + c;
+          }
+        }
+        else
+        {
+          if (child >= len) break;
+          for (ptrdiff_t c = child + 1; c < len; ++c)
+          {
+            if (comp(first[best], first[c])) best = c;
+          }
+        }
+        if (!comp(value, first[best])) break;
+        first[hole] = karls_standard_library::move(first[best]);
+        moved(hole);
+        hole = best;
+      }
+      first[hole] = karls_standard_library::move(value);
+      moved(hole);
+      return hole;
+    }
+
+    // move first[hole] towards the leaves of the heap [first, first + len)
+    template<size_t D, typename It, typename Compare, typename Moved>
+    constexpr ptrdiff_t heap_sift_down(It first, ptrdiff_t len, ptrdiff_t hole, Compare& comp, Moved& moved)
+    {
+      auto value = karls_standard_library::move(first[hole]);
+      return heap_place_down<D>(first, len, hole, karls_standard_library::move(value), comp, moved);
+    }
+
+    // floyd's bottom up construction, O(n)
+    template<size_t D, typename It, typename Compare, typename Moved>
+    constexpr void heap_make(It first, ptrdiff_t len, Compare& comp, Moved& moved)
+    {
+      if (len < 2) return;
+      for (ptrdiff_t i = (len - 2) / static_cast<ptrdiff_t>(D) + 1; i-- > 0;)
+      {
+        heap_sift_down<D>(first, len, i, comp, moved);
+      }
+    }
+  }
+
+  template<typename It>
+  using heap_default_compare = less<typename std::iterator_traits<It>::value_type>;
+
+  // add *(last - 1) to the heap [first, last - 1)
+  template<size_t D = 4, typename It, typename Compare = heap_default_compare<It>>
+  constexpr void push_heap(It first, It last, Compare comp = Compare{})
+  {
+    detail::heap_no_tracking moved;
+    if (last - first > 1) detail::heap_sift_up<D>(first, last - first - 1, comp, moved);
+  }
+
+  // move the top of the heap to *(last - 1) and make [first, last - 1) a heap
+  template<size_t D = 4, typename It, typename Compare = heap_default_compare<It>>
+  constexpr void pop_heap(It first, It last, Compare comp = Compare{})
+  {
+    ptrdiff_t len = last - first;
+    if (len < 2) return;
+    auto value = karls_standard_library::move(first[len - 1]);
+    first[len - 1] = karls_standard_library::move(first[0]);
+    detail::heap_no_tracking moved;
+    detail::heap_place_down<D>(first, len - 1, 0, karls_standard_library::move(value), comp, moved);
+  }
+
+  // rearrange [first, last) into a heap in O(n)
+  template<size_t D = 4, typename It, typename Compare = heap_default_compare<It>>
+  constexpr void make_heap(It first, It last, Compare comp = Compare{})
+  {
+    detail::heap_no_tracking moved;
+    detail::heap_make<D>(first, last - first, comp, moved);
+  }
+
+  // sort a heap into ascending order
+  template<size_t D = 4, typename It, typename Compare = heap_default_compare<It>>
+  constexpr void sort_heap(It first, It last, Compare comp = Compare{})
+  {
+    for (; last - first > 1; --last) pop_heap<D>(first, last, comp);
+  }
+
+  // true if [first, last) is a heap
+  template<size_t D = 4, typename It, typename Compare = heap_default_compare<It>>
+  constexpr bool is_heap(It first, It last, Compare comp = Compare{})
+  {
+    ptrdiff_t len = last - first;
+    for (ptrdiff_t i = 1; i < len; ++i)
+    {
+      if (comp(first[(i - 1) / static_cast<ptrdiff_t>(D)], first[i])) return false;
+    }
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,394 @@
+#ifndef KARLS_STANDARD_LIBRARY_HIVE_HPP
+#define KARLS_STANDARD_LIBRARY_HIVE_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "algorithm.hpp"
+#include "vector.hpp"
+#include <cstdint>
+#include <memory>
+
+namespace karls_standard_library {
+  namespace detail {
+    // one block of hive storage
+    //
+    // slots [0, end) have held an element at some point. erased slots form
+    // runs, and the skipfield stores the length of each run in its first
+    // and last slot (a jump counting skipfield), 0 for live slots, so
+    // iteration steps over a whole run with one add. free_runs holds the
+    // first slot of every run; entries that a later merge made stale are
+    // dropped when they are found.
+    template<typename T>
+    struct hive_block {
+      T* elements;
+      std::uint16_t* skipfield;
+      hive_block* next;
+      hive_block* prev;
+      hive_block* next_free;   // blocks that have erased slots
+      hive_block* prev_free;
+      vector<std::uint16_t> free_runs;
+      std::uint16_t capacity;
+      std::uint16_t end;
+      std::uint16_t size;
+      bool has_free;
+
+      explicit hive_block(std::uint16_t cap) :
+        elements(std::allocator<T>().allocate(cap)), skipfield(nullptr),
+        next(nullptr), prev(nullptr), next_free(nullptr), prev_free(nullptr),
+        capacity(cap), end(0), size(0), has_free(false)
+      {
+        try
+        {
+          skipfield = new std::uint16_t[cap]();
+        }
+        catch (...)
+        {
+          std::allocator<T>().deallocate(elements, cap);
+          throw;
+        }
+      }
+
+      ~hive_block()
+      {
+        for (std::uint16_t i = skipfield[0]; i < end; i += skipfield[i])
+        {
+          std::destroy_at(elements + i);
+          if (++i == end) break;
+        }
+        delete[] skipfield;
+        std::allocator<T>().deallocate(elements, capacity);
+      }
+
+      hive_block(const hive_block&) = delete;
+      hive_block& operator=(const hive_block&) = delete;
+
+      // first slot of a run that can be reused, or capacity if none
+      std::uint16_t take_free_run() noexcept
+      {
+        while (!free_runs.empty())
+        {
+          // a run start has a live slot before it and its length at both
+          // of its ends; a stale entry fails one of the two
+          std::uint16_t s = free_runs.back();
+          std::uint16_t run = s < end ? skipfield[s] : 0;
+          if (run != 0 && s + run <= end && skipfield[s + run - 1] == run && (s == 0 || skipfield[s - 1] == 0)) return s;
+          free_runs.pop_back();
+        }
+        return capacity;
+      }
+
+      // mark slot i, the first slot of its run, as live again
+      void reuse(std::uint16_t i) noexcept
+      {
+        std::uint16_t run = skipfield[i];
+        skipfield[i] = 0;
+        if (run > 1)
+        {
+          skipfield[i + 1] = run - 1;
+          skipfield[i + run - 1] = run - 1;
+          free_runs.back() = i + 1;
+        }
+        else
+        {
+          free_runs.pop_back();
+        }
+      }
+
+      // mark live slot i as erased, merging it with neighbouring runs
+      void erase(std::uint16_t i)
+      {
+        bool left = i > 0 && skipfield[i - 1] != 0;
+        bool right = i + 1 < end && skipfield[i + 1] != 0;
+        if (left && right)
+        {
+          std::uint16_t start = i - skipfield[i - 1];
+          std::uint16_t run = skipfield[start] + 1 + skipfield[i + 1];
+          skipfield[start] = run;
+          skipfield[start + run - 1] = run;
+          // i + 1 is still in free_runs; a nonzero slot before it marks
+          // that entry stale
+          skipfield[i] = run;
+        }
+        else if (left)
+        {
+          std::uint16_t start = i - skipfield[i - 1];
+          std::uint16_t run = skipfield[start] + 1;
+          skipfield[start] = run;
+          skipfield[i] = run;
+        }
+        else
+        {
+          // a new run starting at i, possibly absorbing the run after it
+          free_runs.push_back(i);
+          std::uint16_t run = right ? skipfield[i + 1] + 1 : 1;
+          skipfield[i] = run;
+          skipfield[i + run - 1] = run;
+        }
+      }
+    };
+  }
+
+  // unordered container that never moves its elements
+  //
+  // elements live in a list of blocks whose capacity doubles from 8 up to
+  // 8192. erasing leaves a hole that iteration steps over via the
+  // skipfield and that a later insert fills, so pointers and iterators to
+  // other elements stay valid across any insert or erase. a block that
+  // becomes empty is freed.
+  template<typename T>
+  class hive {
+  public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    static constexpr std::uint16_t min_block_capacity = 8;
+    static constexpr std::uint16_t max_block_capacity = 8192;
+  private:
+    using block = detail::hive_block<T>;
+
+    block* head_;
+    block* tail_;
+    block* free_head_;   // blocks with erased slots
+    size_t size_;
+    size_t capacity_;
+
+    template<typename U>
+    class hive_iterator {
+    private:
+      block* block_;
+      std::uint16_t index_;
+
+      friend class hive;
+    public:
+      using value_type = T;
+      using pointer = U*;
+      using reference = U&;
+      using difference_type = ptrdiff_t;
+
+      hive_iterator() noexcept : block_(nullptr), index_(0) {}
+      hive_iterator(block* b, std::uint16_t index) noexcept : block_(b), index_(index) {}
+      operator hive_iterator<const T>() const noexcept { return {block_, index_}; }
+
+      reference operator*() const noexcept { return block_->elements[index_]; }
+      pointer operator->() const noexcept { return block_->elements + index_; }
+
+      hive_iterator& operator++() noexcept
+      {
+        ++index_;
+        if (index_ < block_->end) index_ += block_->skipfield[index_];
+        if (index_ == block_->end)
+        {
+          block_ = block_->next;
+          index_ = block_ ? block_->skipfield[0] : 0;
+        }
+        return *this;
+      }
+      hive_iterator operator++(int) noexcept
+      {
+        hive_iterator temp = *this;
+        ++*this;
+        return temp;
+      }
+
+      bool operator==(const hive_iterator& other) const noexcept
+      {
+        return block_ == other.block_ && index_ == other.index_;
+      }
+      bool operator!=(const hive_iterator& other) const noexcept { return !(*this == other); }
+    };
+
+    void link_free(block* b) noexcept
+    {
+      b->has_free = true;
+      b->prev_free = nullptr;
+      b->next_free = free_head_;
+      if (free_head_) free_head_->prev_free = b;
+      free_head_ = b;
+    }
+
+    void unlink_free(block* b) noexcept
+    {
+      if (!b->has_free) return;
+      b->has_free = false;
+      if (b->prev_free) b->prev_free->next_free = b->next_free;
+      else free_head_ = b->next_free;
+      if (b->next_free) b->next_free->prev_free = b->prev_free;
+    }
+
+    void free_block(block* b) noexcept
+    {
+      unlink_free(b);
+      if (b->prev) b->prev->next = b->next;
+      else head_ = b->next;
+      if (b->next) b->next->prev = b->prev;
+      else tail_ = b->prev;
+      capacity_ -= b->capacity;
+      delete b;
+    }
+
+    block* append_block()
+    {
+      std::uint16_t cap = tail_ ? min<std::uint16_t>(tail_->capacity * 2, max_block_capacity) : min_block_capacity;
+      block* b = new block(cap);
+      b->prev = tail_;
+      if (tail_) tail_->next = b;
+      else head_ = b;
+      tail_ = b;
+      capacity_ += cap;
+      return b;
+    }
+  public:
+    using iterator = hive_iterator<T>;
+    using const_iterator = hive_iterator<const T>;
+
+    // default constructor
+    hive() noexcept : head_(nullptr), tail_(nullptr), free_head_(nullptr), size_(0), capacity_(0) {}
+
+    // destructor
+    ~hive() { clear(); }
+
+    // copy constructor
+    hive(const hive& other) : hive()
+    {
+      for (const T& value : other) insert(value);
+    }
+
+    // copy assignment operator
+    hive& operator=(const hive& other)
+    {
+      if (this != &other)
+      {
+        hive temp(other);
+        swap(temp);
+      }
+      return *this;
+    }
+
+    // move constructor
+    hive(hive&& other) noexcept : hive() { swap(other); }
+
+    // move assignment operator
+    hive& operator=(hive&& other) noexcept
+    {
+      if (this != &other)
+      {
+        clear();
+        swap(other);
+      }
+      return *this;
+    }
+
+    // capacity functions
+    bool empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+
+    // iterators
+    iterator begin() noexcept { return head_ ? iterator(head_, head_->skipfield[0]) : end(); }
+    iterator end() noexcept { return iterator(); }
+    const_iterator begin() const noexcept { return head_ ? const_iterator(head_, head_->skipfield[0]) : end(); }
+    const_iterator end() const noexcept { return const_iterator(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // modifiers
+    // construct an element, reusing an erased slot if there is one
+    template<typename... Args>
+    iterator emplace(Args&&... args)
+    {
+      while (free_head_)
+      {
+        block* b = free_head_;
+        std::uint16_t i = b->take_free_run();
+        if (i == b->capacity)
+        {
+          unlink_free(b);
+          continue;
+        }
+        std::construct_at(b->elements + i, karls_standard_library::forward<Args>(args)...);
+        b->reuse(i);
+        if (b->free_runs.empty()) unlink_free(b);
+        ++b->size;
+        ++size_;
+        return iterator(b, i);
+      }
+
+      block* b = tail_;
+      if (!b || b->end == b->capacity) b = append_block();
+      std::uint16_t i = b->end;
+      try
+      {
+        std::construct_at(b->elements + i, karls_standard_library::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+        if (b->size == 0) free_block(b);
+        throw;
+      }
+      b->skipfield[i] = 0;
+      ++b->end;
+      ++b->size;
+      ++size_;
+      return iterator(b, i);
+    }
+    iterator insert(const T& value) { return emplace(value); }
+    iterator insert(T&& value) { return emplace(karls_standard_library::move(value)); }
+
+    // erase the element at pos; returns the iterator after it
+    iterator erase(const_iterator pos)
+    {
+      block* b = pos.block_;
+      std::uint16_t i = pos.index_;
+      iterator next(b, i);
+      ++next;
+      std::destroy_at(b->elements + i);
+      --size_;
+      if (--b->size == 0)
+      {
+        free_block(b);
+        return next;
+      }
+      b->erase(i);
+      if (!b->has_free) link_free(b);
+      return next;
+    }
+
+    // destroy every element and free every block
+    void clear() noexcept
+    {
+      while (head_)
+      {
+        block* next = head_->next;
+        delete head_;
+        head_ = next;
+      }
+      tail_ = nullptr;
+      free_head_ = nullptr;
+      size_ = 0;
+      capacity_ = 0;
+    }
+
+    // iterator to the element at p, or end() if p is not in this hive
+    iterator get_iterator(const T* p) noexcept
+    {
+      for (block* b = head_; b; b = b->next)
+      {
+        if (p >= b->elements && p < b->elements + b->end) return iterator(b, static_cast<std::uint16_t>(p - b->elements));
+      }
+      return end();
+    }
+
+    void swap(hive& other) noexcept
+    {
+      karls_standard_library::swap(head_, other.head_);
+      karls_standard_library::swap(tail_, other.tail_);
+      karls_standard_library::swap(free_head_, other.free_head_);
+      karls_standard_library::swap(size_, other.size_);
+      karls_standard_library::swap(capacity_, other.capacity_);
+    }
+  };
+}
+
+#endif
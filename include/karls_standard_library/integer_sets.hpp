@@ -0,0 +1,232 @@
+#ifndef KARLS_STANDARD_LIBRARY_INTEGER_SETS_HPP
+#define KARLS_STANDARD_LIBRARY_INTEGER_SETS_HPP
+
+#include "cstddef.hpp"
+#include "algorithm.hpp"
+#include "vector.hpp"
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// set operations on strictly increasing uint32_t ranges, such as the
+// posting lists of an inverted index
+//
+// the general algorithms in algorithm.hpp handle any element type and
+// duplicates; these kernels rely on the elements being distinct and
+// choose between a branch free merge, an avx2 block intersection and
+// galloping search depending on how different the two sizes are
+namespace karls_standard_library {
+  namespace detail {
+    // galloping wins once one list is this many times longer than the
+    // other; the block kernel keeps up with it to a much larger ratio than
+    // the scalar merge does
+#if defined(__AVX2__)
+    inline constexpr size_t galloping_ratio = 128;
+#else
+    inline constexpr size_t galloping_ratio = 8;
+#endif
+
+    // merge intersection; each step advances one or both lists by
+    // comparison results instead of branching on them
+    template<bool Write>
+    constexpr size_t intersect_scalar(const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size, uint32_t* out) noexcept
+    {
+      size_t i = 0;
+      size_t j = 0;
+      size_t count = 0;
+      while (i < a_size && j < b_size)
+      {
+        uint32_t x = a[i];
+        uint32_t y = b[j];
+        // count < min(a_size, b_size) here, since every match uses up an
+        // element of both lists
+        if constexpr (Write) out[count] = x;
+        count += (x == y);
+        i += (x <= y);
+        j += (y <= x);
+      }
+      return count;
+    }
+
+    // for each element of the short list, gallop forward through the long
+    // one: double the step until it passes the element, then binary search
+    // the last step. cost is O(small * log(large / small))
+    template<bool Write>
+    constexpr size_t intersect_galloping(const uint32_t* small, size_t small_size, const uint32_t* large, size_t large_size, uint32_t* out) noexcept
+    {
+      size_t count = 0;
+      size_t low = 0;
+      for (size_t i = 0; i < small_size && low < large_size; ++i)
+      {
+        uint32_t x = small[i];
+        if (large[low] < x)
+        {
+          size_t step = 1;
+          while (low + step < large_size && large[low + step] < x)
+          {
+            low += step;
+            step *= 2;
+          }
+          size_t high = (low + step < large_size) ? low + step : large_size;
+          low = static_cast<size_t>(karls_standard_library::lower_bound(large + low + 1, large + high, x) - large);
+          if (low == large_size) break;
+        }
+        if (large[low] == x)
+        {
+          if constexpr (Write) out[count] = x;
+          ++count;
+          ++low;
+        }
+      }
+      return count;
+    }
+
+#if defined(__AVX2__)
+    // for each 8 bit lane mask, the indices of the set lanes packed to the
+    // front, one byte each
+    struct compress_table {
+      uint64_t lanes[256];
+
+      constexpr compress_table() : lanes()
+      {
+        for (unsigned mask = 0; mask < 256; ++mask)
+        {
+          uint64_t packed = 0;
+          unsigned k = 0;
+          for (unsigned lane = 0; lane < 8; ++lane)
+          {
+            if (mask & (1u << lane)) packed |= uint64_t(lane) << (8 * k++);
+          }
+          lanes[mask] = packed;
+        }
+      }
+    };
+    inline constexpr compress_table intersect_compress_table{};
+
+    // shuffle-compare intersection: compare a block of 8 from each list
+    // all against all (the second block in its 8 rotations), keep the
+    // matching lanes of the first, then advance whichever block ends
+    // lower. one branch per 8 elements instead of one per element
+    template<bool Write>
+    inline size_t intersect_avx2(const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size, uint32_t* out) noexcept
+    {
+      const size_t capacity = a_size < b_size ? a_size : b_size;
+      const size_t a_blocks = a_size & ~size_t(7);
+      const size_t b_blocks = b_size & ~size_t(7);
+      const __m256i rotate1 = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+      const __m256i rotate2 = _mm256_setr_epi32(2, 3, 4, 5, 6, 7, 0, 1);
+      const __m256i rotate3 = _mm256_setr_epi32(3, 4, 5, 6, 7, 0, 1, 2);
+      const __m256i rotate4 = _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3);
+      const __m256i rotate5 = _mm256_setr_epi32(5, 6, 7, 0, 1, 2, 3, 4);
+      const __m256i rotate6 = _mm256_setr_epi32(6, 7, 0, 1, 2, 3, 4, 5);
+      const __m256i rotate7 = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+
+      size_t i = 0;
+      size_t j = 0;
+      size_t count = 0;
+      while (i < a_blocks && j < b_blocks)
+      {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i m01 = _mm256_or_si256(_mm256_cmpeq_epi32(va, vb),
+                                      _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate1)));
+        __m256i m23 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate2)),
+                                      _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate3)));
+        __m256i m45 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate4)),
+                                      _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate5)));
+        __m256i m67 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate6)),
+                                      _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate7)));
+        __m256i matches = _mm256_or_si256(_mm256_or_si256(m01, m23), _mm256_or_si256(m45, m67));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(matches)));
+
+        if constexpr (Write)
+        {
+          if (count + 8 <= capacity)
+          {
+            __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(intersect_compress_table.lanes + mask));
+            __m256i kept = _mm256_permutevar8x32_epi32(va, _mm256_cvtepu8_epi32(packed));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + count), kept);
+          }
+          else
+          {
+            // near the end of the output, write only the matches
+            size_t k = count;
+            for (unsigned m = mask; m != 0; m &= m - 1) out[k++] = a[i + static_cast<size_t>(std::countr_zero(m))];
+          }
+        }
+        count += static_cast<size_t>(std::popcount(mask));
+
+        uint32_t a_last = a[i + 7];
+        uint32_t b_last = b[j + 7];
+        i += (a_last <= b_last) ? 8 : 0;
+        j += (b_last <= a_last) ? 8 : 0;
+      }
+      return count + intersect_scalar<Write>(a + i, a_size - i, b + j, b_size - j, Write ? out + count : nullptr);
+    }
+#endif
+
+    template<bool Write>
+    constexpr size_t intersect(const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size, uint32_t* out) noexcept
+    {
+      if (a_size > b_size)
+      {
+        // keep the short list first, so galloping searches the long one;
+        // the output holds its elements either way
+        const uint32_t* t = a;
+        a = b;
+        b = t;
+        size_t n = a_size;
+        a_size = b_size;
+        b_size = n;
+      }
+      if (a_size == 0) return 0;
+      if (a_size * galloping_ratio < b_size) return intersect_galloping<Write>(a, a_size, b, b_size, out);
+#if defined(__AVX2__)
+      if (!std::is_constant_evaluated()) return intersect_avx2<Write>(a, a_size, b, b_size, out);
+#endif
+      return intersect_scalar<Write>(a, a_size, b, b_size, out);
+    }
+  }
+
+  // write the elements common to a and b to out, in order, and return how
+  // many there are. out needs room for min(a_size, b_size) elements
+  constexpr size_t intersect_sorted(const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size, uint32_t* out) noexcept
+  {
+    return detail::intersect<true>(a, a_size, b, b_size, out);
+  }
+
+  inline vector<uint32_t> intersect_sorted(const vector<uint32_t>& a, const vector<uint32_t>& b)
+  {
+    vector<uint32_t> result;
+    size_t capacity = a.size() < b.size() ? a.size() : b.size();
+    if (capacity == 0) return result;
+    result.resize(capacity);
+    size_t count = intersect_sorted(a.data(), a.size(), b.data(), b.size(), result.data());
+    if (count == 0) result.clear();
+    else result.resize(count);
+    return result;
+  }
+
+  // sizes of the set operations, without writing any output
+
+  constexpr size_t intersection_size(const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) noexcept
+  {
+    return detail::intersect<false>(a, a_size, b, b_size, nullptr);
+  }
+
+  constexpr size_t union_size(const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) noexcept
+  {
+    return a_size + b_size - intersection_size(a, a_size, b, b_size);
+  }
+
+  // elements of a that are not in b
+  constexpr size_t difference_size(const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size) noexcept
+  {
+    return a_size - intersection_size(a, a_size, b, b_size);
+  }
+}
+
+#endif
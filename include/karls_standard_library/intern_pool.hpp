@@ -0,0 +1,280 @@
+#ifndef KARLS_STANDARD_LIBRARY_INTERN_POOL_HPP
+#define KARLS_STANDARD_LIBRARY_INTERN_POOL_HPP
+
+#include "cstddef.hpp"
+#include "cstring.hpp"
+#include "utility.hpp"
+#include "algorithm.hpp"
+#include "functional.hpp"
+#include "string_view.hpp"
+#include "string.hpp"
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <ostream>
+
+namespace karls_standard_library {
+  // arena resident header of an interned string; the chars and a null
+  // terminator follow it in the same block
+  struct intern_entry {
+    size_t hash;
+    size_t size;
+
+    const char* chars() const noexcept { return reinterpret_cast<const char*>(this + 1); }
+  };
+
+  // one pointer wide handle to a string owned by an intern_pool; handles
+  // from the same pool are equal exactly when their text is equal
+  class interned_string {
+  private:
+    const intern_entry* entry_;
+
+    friend class intern_pool;
+    explicit interned_string(const intern_entry* entry) noexcept : entry_(entry) {}
+  public:
+    // default constructor; a null handle that views an empty string
+    constexpr interned_string() noexcept : entry_(nullptr) {}
+
+    // element access
+    const char* data() const noexcept { return entry_ ? entry_->chars() : ""; }
+    const char* c_str() const noexcept { return data(); }
+    char operator[](size_t index) const noexcept { return data()[index]; }
+
+    // capacity functions
+    bool empty() const noexcept { return size() == 0; }
+    size_t size() const noexcept { return entry_ ? entry_->size : 0; }
+    size_t length() const noexcept { return size(); }
+
+    // hash computed once when the string was interned; equal to
+    // hash<string_view> of the text
+    size_t hash() const noexcept { return entry_ ? entry_->hash : 0; }
+
+    // conversions
+    string_view view() const noexcept { return string_view(data(), size()); }
+    operator string_view() const noexcept { return view(); }
+    string str() const { return string(data(), size()); }
+    explicit operator bool() const noexcept { return entry_ != nullptr; }
+
+    // equality is a pointer comparison
+    constexpr bool operator==(const interned_string& other) const noexcept
+    {
+      return entry_ == other.entry_;
+    }
+  };
+
+  // precomputed hash of the interned text
+  template<>
+  struct hash<interned_string> {
+    using is_avalanching = void;
+    size_t operator()(interned_string s) const noexcept { return s.hash(); }
+  };
+
+  // non-member function for output stream
+  inline std::ostream& operator<<(std::ostream& os, interned_string s)
+  {
+    return os << s.view();
+  }
+
+  // thread safe table mapping text to interned_string handles
+  //
+  // lookups of already interned text never lock: readers probe an open
+  // addressing table of atomic entry pointers. inserts take a mutex, copy
+  // the text into arena chunks and publish the entry with a release store.
+  // when the table grows the old one is kept alive until the pool dies so
+  // concurrent readers never touch freed memory.
+  class intern_pool {
+  private:
+    struct arena_chunk {
+      arena_chunk* next;
+      size_t used;
+      size_t capacity;
+
+      char* bytes() noexcept { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    struct table {
+      table* retired;
+      size_t capacity;
+
+      std::atomic<const intern_entry*>* slots() noexcept
+      {
+        return reinterpret_cast<std::atomic<const intern_entry*>*>(this + 1);
+      }
+    };
+
+    static constexpr size_t chunk_size = 64 * 1024;
+    static constexpr size_t initial_capacity = 256;
+
+    std::atomic<table*> table_;
+    std::atomic<size_t> size_;
+    std::atomic<size_t> string_bytes_;
+    arena_chunk* chunks_;
+    size_t arena_bytes_;
+    size_t table_bytes_;
+    mutable std::mutex mutex_;
+
+    static bool matches(const intern_entry* e, size_t h, string_view sv) noexcept
+    {
+      return e->hash == h && e->size == sv.size() && memcmp(e->chars(), sv.data(), sv.size()) == 0;
+    }
+
+    static table* make_table(size_t capacity)
+    {
+      void* mem = operator new(sizeof(table) + capacity * sizeof(std::atomic<const intern_entry*>));
+      table* t = new(mem) table{nullptr, capacity};
+      for (size_t i = 0; i < capacity; ++i)
+      {
+        new(&t->slots()[i]) std::atomic<const intern_entry*>(nullptr);
+      }
+      return t;
+    }
+
+    static const intern_entry* probe(table* t, size_t h, string_view sv) noexcept
+    {
+      size_t mask = t->capacity - 1;
+      for (size_t i = h & mask;; i = (i + 1) & mask)
+      {
+        const intern_entry* e = t->slots()[i].load(std::memory_order_acquire);
+        if (e == nullptr) return nullptr;
+        if (matches(e, h, sv)) return e;
+      }
+    }
+
+    // place e into the first free slot; caller holds the mutex
+    static void place(table* t, const intern_entry* e) noexcept
+    {
+      size_t mask = t->capacity - 1;
+      size_t i = e->hash & mask;
+      while (t->slots()[i].load(std::memory_order_relaxed) != nullptr)
+      {
+        i = (i + 1) & mask;
+      }
+      t->slots()[i].store(e, std::memory_order_release);
+    }
+
+    // bump allocate n bytes aligned for intern_entry; caller holds the mutex
+    char* allocate(size_t n)
+    {
+      n = (n + alignof(intern_entry) - 1) & ~(alignof(intern_entry) - 1);
+      if (chunks_ == nullptr || chunks_->capacity - chunks_->used < n)
+      {
+        size_t cap = max(chunk_size, n);
+        void* mem = operator new(sizeof(arena_chunk) + cap);
+        chunks_ = new(mem) arena_chunk{chunks_, 0, cap};
+        arena_bytes_ += sizeof(arena_chunk) + cap;
+      }
+      char* p = chunks_->bytes() + chunks_->used;
+      chunks_->used += n;
+      return p;
+    }
+
+    // double the table and publish it; caller holds the mutex
+    void grow(table* old)
+    {
+      table* t = make_table(2 * old->capacity);
+      for (size_t i = 0; i < old->capacity; ++i)
+      {
+        const intern_entry* e = old->slots()[i].load(std::memory_order_relaxed);
+        if (e) place(t, e);
+      }
+      t->retired = old;
+      table_bytes_ += sizeof(table) + t->capacity * sizeof(std::atomic<const intern_entry*>);
+      table_.store(t, std::memory_order_release);
+    }
+  public:
+    // default constructor
+    intern_pool() :
+      table_(make_table(initial_capacity)), size_(0), string_bytes_(0),
+      chunks_(nullptr), arena_bytes_(0),
+      table_bytes_(sizeof(table) + initial_capacity * sizeof(std::atomic<const intern_entry*>)) {}
+
+    // destructor; invalidates every handle the pool gave out
+    ~intern_pool()
+    {
+      table* t = table_.load(std::memory_order_relaxed);
+      while (t)
+      {
+        table* next = t->retired;
+        operator delete(t);
+        t = next;
+      }
+      while (chunks_)
+      {
+        arena_chunk* next = chunks_->next;
+        operator delete(chunks_);
+        chunks_ = next;
+      }
+    }
+
+    // handles point into the pool so it can be neither copied nor moved
+    intern_pool(const intern_pool& other) = delete;
+    intern_pool& operator=(const intern_pool& other) = delete;
+
+    // handle for sv, interning a copy of it if it is not in the pool yet
+    interned_string intern(string_view sv)
+    {
+      size_t h = hash_bytes(sv.data(), sv.size());
+      if (const intern_entry* e = probe(table_.load(std::memory_order_acquire), h, sv))
+      {
+        return interned_string(e);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      table* t = table_.load(std::memory_order_relaxed);
+      if (const intern_entry* e = probe(t, h, sv)) return interned_string(e);
+
+      char* mem = allocate(sizeof(intern_entry) + sv.size() + 1);
+      intern_entry* e = new(mem) intern_entry{h, sv.size()};
+      char* chars = mem + sizeof(intern_entry);
+      memcpy(chars, sv.data(), sv.size());
+      chars[sv.size()] = '\0';
+
+      size_t count = size_.load(std::memory_order_relaxed) + 1;
+      if (2 * count > t->capacity)
+      {
+        grow(t);
+        t = table_.load(std::memory_order_relaxed);
+      }
+      place(t, e);
+      size_.store(count, std::memory_order_relaxed);
+      string_bytes_.fetch_add(sv.size(), std::memory_order_relaxed);
+      return interned_string(e);
+    }
+
+    // handle for sv if it was already interned, a null handle otherwise
+    interned_string find(string_view sv) const noexcept
+    {
+      size_t h = hash_bytes(sv.data(), sv.size());
+      return interned_string(probe(table_.load(std::memory_order_acquire), h, sv));
+    }
+
+    // number of distinct strings interned
+    size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // total length of all interned strings
+    size_t string_bytes() const noexcept { return string_bytes_.load(std::memory_order_relaxed); }
+
+    // bytes held by the pool: arena chunks plus current and retired tables
+    size_t memory_usage() const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return arena_bytes_ + table_bytes_;
+    }
+
+    // process wide pool
+    static intern_pool& global()
+    {
+      static intern_pool pool;
+      return pool;
+    }
+  };
+
+  // intern sv in the process wide pool
+  inline interned_string intern(string_view sv)
+  {
+    return intern_pool::global().intern(sv);
+  }
+}
+
+#endif
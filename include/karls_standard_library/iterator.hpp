@@ -0,0 +1,341 @@
+#ifndef KARLS_STANDARD_LIBRARY_ITERATOR_HPP
+#define KARLS_STANDARD_LIBRARY_ITERATOR_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include <compare>
+#include <concepts>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace karls_standard_library {
+  // the standard iterator traits and concepts; the standard algorithms
+  // dispatch on these, so the library's iterators model them rather than
+  // a parallel set
+  using std::iterator_traits;
+  using std::input_iterator_tag;
+  using std::output_iterator_tag;
+  using std::forward_iterator_tag;
+  using std::bidirectional_iterator_tag;
+  using std::random_access_iterator_tag;
+  using std::contiguous_iterator_tag;
+
+  using std::input_iterator;
+  using std::output_iterator;
+  using std::forward_iterator;
+  using std::bidirectional_iterator;
+  using std::random_access_iterator;
+  using std::contiguous_iterator;
+
+  namespace detail {
+    // the strongest standard tag that It models, as a tag type
+    template<typename It>
+    using iterator_concept_t =
+      std::conditional_t<std::random_access_iterator<It>, std::random_access_iterator_tag,
+      std::conditional_t<std::bidirectional_iterator<It>, std::bidirectional_iterator_tag,
+      std::conditional_t<std::forward_iterator<It>, std::forward_iterator_tag, std::input_iterator_tag>>>;
+
+    // It's legacy category, capped at random access as adaptors require
+    template<typename It>
+    using capped_iterator_category_t =
+      std::conditional_t<std::derived_from<typename std::iterator_traits<It>::iterator_category, std::random_access_iterator_tag>,
+                         std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+  }
+
+  // iterator over contiguous storage, as used by vector and string: a
+  // pointer wrapped with the container as a tag, so iterators of different
+  // containers do not mix. T is const for const_iterator, and an iterator
+  // converts to the matching const_iterator
+  template<typename T, typename Container>
+  class pointer_iterator {
+  public:
+    using iterator_concept = std::contiguous_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using element_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+  private:
+    T* ptr_;
+  public:
+    constexpr pointer_iterator() noexcept : ptr_(nullptr) {}
+    constexpr pointer_iterator(T* ptr) noexcept : ptr_(ptr) {}
+    template<typename U>
+      requires (std::is_same_v<const U, T> && !std::is_same_v<U, T>)
+    constexpr pointer_iterator(const pointer_iterator<U, Container>& other) noexcept : ptr_(other.base()) {}
+
+    // the underlying pointer
+    constexpr T* base() const noexcept { return ptr_; }
+
+    constexpr reference operator*() const noexcept { return *ptr_; }
+    constexpr pointer operator->() const noexcept { return ptr_; }
+    constexpr reference operator[](difference_type n) const noexcept { return ptr_[n]; }
+
+    constexpr pointer_iterator& operator++() noexcept { ++ptr_; return *this; }
+    constexpr pointer_iterator operator++(int) noexcept { return pointer_iterator(ptr_++); }
+    constexpr pointer_iterator& operator--() noexcept { --ptr_; return *this; }
+    constexpr pointer_iterator operator--(int) noexcept { return pointer_iterator(ptr_--); }
+    constexpr pointer_iterator& operator+=(difference_type n) noexcept { ptr_ += n; return *this; }
+    constexpr pointer_iterator& operator-=(difference_type n) noexcept { ptr_ -= n; return *this; }
+
+    friend constexpr pointer_iterator operator+(pointer_iterator it, difference_type n) noexcept { return it += n; }
+    friend constexpr pointer_iterator operator+(difference_type n, pointer_iterator it) noexcept { return it += n; }
+    friend constexpr pointer_iterator operator-(pointer_iterator it, difference_type n) noexcept { return it -= n; }
+    friend constexpr difference_type operator-(const pointer_iterator& a, const pointer_iterator& b) noexcept { return a.ptr_ - b.ptr_; }
+
+    // also compares an iterator with a const_iterator, through the conversion
+    friend constexpr bool operator==(const pointer_iterator& a, const pointer_iterator& b) noexcept { return a.ptr_ == b.ptr_; }
+    friend constexpr std::strong_ordering operator<=>(const pointer_iterator& a, const pointer_iterator& b) noexcept { return a.ptr_ <=> b.ptr_; }
+  };
+
+  // walks a bidirectional range backwards; base() is one past the element
+  // the iterator refers to
+  template<typename It>
+  class reverse_iterator {
+  public:
+    using iterator_type = It;
+    using iterator_concept = std::conditional_t<std::random_access_iterator<It>, std::random_access_iterator_tag, std::bidirectional_iterator_tag>;
+    using iterator_category = detail::capped_iterator_category_t<It>;
+    using value_type = std::iter_value_t<It>;
+    using difference_type = std::iter_difference_t<It>;
+    using pointer = typename std::iterator_traits<It>::pointer;
+    using reference = std::iter_reference_t<It>;
+  private:
+    It current_;
+
+    template<typename> friend class reverse_iterator;
+  public:
+    constexpr reverse_iterator() : current_() {}
+    constexpr explicit reverse_iterator(It it) : current_(it) {}
+    template<typename U>
+      requires (!std::is_same_v<U, It> && std::convertible_to<const U&, It>)
+    constexpr reverse_iterator(const reverse_iterator<U>& other) : current_(other.current_) {}
+
+    constexpr It base() const { return current_; }
+
+    constexpr reference operator*() const
+    {
+      It temp = current_;
+      return *--temp;
+    }
+    constexpr pointer operator->() const
+      requires (std::is_pointer_v<It> || requires(const It it) { it.operator->(); })
+    {
+      It temp = current_;
+      --temp;
+      if constexpr (std::is_pointer_v<It>) return temp;
+      else return temp.operator->();
+    }
+    constexpr reference operator[](difference_type n) const
+      requires std::random_access_iterator<It>
+    {
+      return current_[-n - 1];
+    }
+
+    constexpr reverse_iterator& operator++() { --current_; return *this; }
+    constexpr reverse_iterator operator++(int) { reverse_iterator temp = *this; --current_; return temp; }
+    constexpr reverse_iterator& operator--() { ++current_; return *this; }
+    constexpr reverse_iterator operator--(int) { reverse_iterator temp = *this; ++current_; return temp; }
+    constexpr reverse_iterator& operator+=(difference_type n) requires std::random_access_iterator<It> { current_ -= n; return *this; }
+    constexpr reverse_iterator& operator-=(difference_type n) requires std::random_access_iterator<It> { current_ += n; return *this; }
+    constexpr reverse_iterator operator+(difference_type n) const requires std::random_access_iterator<It> { return reverse_iterator(current_ - n); }
+    constexpr reverse_iterator operator-(difference_type n) const requires std::random_access_iterator<It> { return reverse_iterator(current_ + n); }
+
+    friend constexpr reverse_iterator operator+(difference_type n, const reverse_iterator& it)
+      requires std::random_access_iterator<It>
+    {
+      return reverse_iterator(it.current_ - n);
+    }
+
+    friend constexpr std::iter_rvalue_reference_t<It> iter_move(const reverse_iterator& it)
+    {
+      It temp = it.current_;
+      return std::ranges::iter_move(--temp);
+    }
+  };
+
+  // comparisons are those of the bases, reversed
+  template<typename It1, typename It2>
+  constexpr bool operator==(const reverse_iterator<It1>& a, const reverse_iterator<It2>& b)
+    requires requires { { a.base() == b.base() } -> std::convertible_to<bool>; }
+  {
+    return a.base() == b.base();
+  }
+
+  template<typename It1, std::three_way_comparable_with<It1> It2>
+  constexpr std::compare_three_way_result_t<It1, It2> operator<=>(const reverse_iterator<It1>& a, const reverse_iterator<It2>& b)
+  {
+    return b.base() <=> a.base();
+  }
+
+  template<typename It1, typename It2>
+  constexpr auto operator-(const reverse_iterator<It1>& a, const reverse_iterator<It2>& b) -> decltype(b.base() - a.base())
+  {
+    return b.base() - a.base();
+  }
+
+  template<typename It>
+  constexpr reverse_iterator<It> make_reverse_iterator(It it)
+  {
+    return reverse_iterator<It>(it);
+  }
+
+  // dereferences to an rvalue, so algorithms that copy from it move instead
+  template<typename It>
+  class move_iterator {
+  public:
+    using iterator_type = It;
+    using iterator_concept = detail::iterator_concept_t<It>;
+    using iterator_category = detail::capped_iterator_category_t<It>;
+    using value_type = std::iter_value_t<It>;
+    using difference_type = std::iter_difference_t<It>;
+    using pointer = It;
+    using reference = std::iter_rvalue_reference_t<It>;
+  private:
+    It current_;
+
+    template<typename> friend class move_iterator;
+  public:
+    constexpr move_iterator() : current_() {}
+    constexpr explicit move_iterator(It it) : current_(karls_standard_library::move(it)) {}
+    template<typename U>
+      requires (!std::is_same_v<U, It> && std::convertible_to<const U&, It>)
+    constexpr move_iterator(const move_iterator<U>& other) : current_(other.current_) {}
+
+    constexpr const It& base() const& noexcept { return current_; }
+    constexpr It base() && { return karls_standard_library::move(current_); }
+
+    constexpr reference operator*() const { return std::ranges::iter_move(current_); }
+    constexpr reference operator[](difference_type n) const
+      requires std::random_access_iterator<It>
+    {
+      return std::ranges::iter_move(current_ + n);
+    }
+
+    constexpr move_iterator& operator++() { ++current_; return *this; }
+    constexpr move_iterator operator++(int) { move_iterator temp = *this; ++current_; return temp; }
+    constexpr move_iterator& operator--() requires std::bidirectional_iterator<It> { --current_; return *this; }
+    constexpr move_iterator operator--(int) requires std::bidirectional_iterator<It> { move_iterator temp = *this; --current_; return temp; }
+    constexpr move_iterator& operator+=(difference_type n) requires std::random_access_iterator<It> { current_ += n; return *this; }
+    constexpr move_iterator& operator-=(difference_type n) requires std::random_access_iterator<It> { current_ -= n; return *this; }
+    constexpr move_iterator operator+(difference_type n) const requires std::random_access_iterator<It> { return move_iterator(current_ + n); }
+    constexpr move_iterator operator-(difference_type n) const requires std::random_access_iterator<It> { return move_iterator(current_ - n); }
+
+    friend constexpr move_iterator operator+(difference_type n, const move_iterator& it)
+      requires std::random_access_iterator<It>
+    {
+      return move_iterator(it.current_ + n);
+    }
+
+    friend constexpr reference iter_move(const move_iterator& it) { return std::ranges::iter_move(it.current_); }
+  };
+
+  template<typename It1, typename It2>
+  constexpr bool operator==(const move_iterator<It1>& a, const move_iterator<It2>& b)
+    requires requires { { a.base() == b.base() } -> std::convertible_to<bool>; }
+  {
+    return a.base() == b.base();
+  }
+
+  template<typename It1, std::three_way_comparable_with<It1> It2>
+  constexpr std::compare_three_way_result_t<It1, It2> operator<=>(const move_iterator<It1>& a, const move_iterator<It2>& b)
+  {
+    return a.base() <=> b.base();
+  }
+
+  template<typename It1, typename It2>
+  constexpr auto operator-(const move_iterator<It1>& a, const move_iterator<It2>& b) -> decltype(a.base() - b.base())
+  {
+    return a.base() - b.base();
+  }
+
+  template<typename It>
+  constexpr move_iterator<It> make_move_iterator(It it)
+  {
+    return move_iterator<It>(karls_standard_library::move(it));
+  }
+
+  // output iterator that appends to a container with push_back
+  template<typename Container>
+  class back_insert_iterator {
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+    using container_type = Container;
+  private:
+    Container* container_;
+  public:
+    constexpr explicit back_insert_iterator(Container& c) noexcept : container_(&c) {}
+
+    constexpr back_insert_iterator& operator=(const typename Container::value_type& value)
+    {
+      container_->push_back(value);
+      return *this;
+    }
+    constexpr back_insert_iterator& operator=(typename Container::value_type&& value)
+    {
+      container_->push_back(karls_standard_library::move(value));
+      return *this;
+    }
+
+    // assignment through the iterator does the work; these are no-ops
+    constexpr back_insert_iterator& operator*() noexcept { return *this; }
+    constexpr back_insert_iterator& operator++() noexcept { return *this; }
+    constexpr back_insert_iterator operator++(int) noexcept { return *this; }
+  };
+
+  template<typename Container>
+  constexpr back_insert_iterator<Container> back_inserter(Container& c) noexcept
+  {
+    return back_insert_iterator<Container>(c);
+  }
+
+  // iterator arithmetic; O(1) for random access iterators
+  template<typename It>
+  constexpr std::iter_difference_t<It> distance(It first, It last)
+  {
+    if constexpr (std::random_access_iterator<It>) return last - first;
+    else
+    {
+      std::iter_difference_t<It> n = 0;
+      for (; first != last; ++first) ++n;
+      return n;
+    }
+  }
+
+  template<typename It>
+  constexpr void advance(It& it, std::iter_difference_t<It> n)
+  {
+    if constexpr (std::random_access_iterator<It>) it += n;
+    else if constexpr (std::bidirectional_iterator<It>)
+    {
+      for (; n > 0; --n) ++it;
+      for (; n < 0; ++n) --it;
+    }
+    else
+    {
+      for (; n > 0; --n) ++it;
+    }
+  }
+
+  template<typename It>
+  constexpr It next(It it, std::iter_difference_t<It> n = 1)
+  {
+    karls_standard_library::advance(it, n);
+    return it;
+  }
+
+  template<typename It>
+  constexpr It prev(It it, std::iter_difference_t<It> n = 1)
+  {
+    karls_standard_library::advance(it, -n);
+    return it;
+  }
+}
+
+#endif
@@ -3,16 +3,43 @@
 
 #include "memory.hpp"
 #include "vector.hpp"
+#include "soa_vector.hpp"
 #include "array.hpp"
+#include "bitset.hpp"
 #include "list.hpp"
+#include "slot_map.hpp"
+#include "hive.hpp"
+#include "priority_queue.hpp"
+#include "circular_buffer.hpp"
+#if defined(__unix__) || defined(__APPLE__)
+#include "mmap_vector.hpp"
+#endif
 #include "deque.hpp"
 #include "set.hpp"
 #include "unordered_set.hpp"
 #include "map.hpp"
 #include "unordered_map.hpp"
 #include "string.hpp"
+#include "string_view.hpp"
+#include "fixed_string.hpp"
+#include "string_builder.hpp"
+#include "charconv.hpp"
+#include "format.hpp"
+#include "rope.hpp"
+#include "intern_pool.hpp"
+#include "frozen_map.hpp"
+#include "frozen_set.hpp"
+#include "ring_buffer.hpp"
+#include "concurrent_unordered_map.hpp"
+#include "thread_pool.hpp"
 #include "algorithm.hpp"
+#include "heap.hpp"
 #include "iterator.hpp"
+#include "ranges.hpp"
+#include "integer_sets.hpp"
+#include "static_search_index.hpp"
+#include "utf8.hpp"
 #include "utility.hpp"
+#include "serialization.hpp"
 
 #endif
\ No newline at end of file
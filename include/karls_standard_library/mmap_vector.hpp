@@ -0,0 +1,319 @@
+#ifndef KARLS_STANDARD_LIBRARY_MMAP_VECTOR_HPP
+#define KARLS_STANDARD_LIBRARY_MMAP_VECTOR_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace karls_standard_library {
+  enum class mmap_mode {
+    read_only,    // the file must exist; the mapping is not writable
+    read_write    // the file is created if missing and can grow
+  };
+
+  // access pattern hints forwarded to madvise
+  enum class mmap_advice {
+    normal,
+    sequential,
+    random,
+    willneed,     // start reading the range in now
+    hugepage      // back the range with transparent huge pages where supported
+  };
+
+  namespace detail {
+    [[noreturn]] inline void throw_mmap_error(const char* what)
+    {
+      throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    inline size_t mmap_page_size() noexcept
+    {
+      static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+      return page;
+    }
+  }
+
+  // array of trivially copyable records living in a memory mapped file
+  //
+  // opening maps the file instead of reading it, so it costs the same for
+  // any file size and pages are read on first touch. the read api matches
+  // vector. in read_write mode the vector can grow: the file is extended
+  // with ftruncate and the mapping with mremap, capacity doubling as in
+  // vector, and the file is cut back to size() when it is closed.
+  template<typename T>
+  class mmap_vector {
+  public:
+    static_assert(std::is_trivially_copyable_v<T>, "mmap_vector needs trivially copyable records");
+
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+  private:
+    int fd_;
+    T* data_;
+    size_t size_;
+    size_t capacity_;
+    mmap_mode mode_;
+
+    size_t mapped_bytes() const noexcept { return capacity_ * sizeof(T); }
+
+    void map(size_t capacity)
+    {
+      if (capacity == 0) return;
+      int prot = mode_ == mmap_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+      void* p = ::mmap(nullptr, capacity * sizeof(T), prot, MAP_SHARED, fd_, 0);
+      if (p == MAP_FAILED) detail::throw_mmap_error("mmap_vector: mmap");
+      data_ = static_cast<T*>(p);
+      capacity_ = capacity;
+    }
+
+    void unmap() noexcept
+    {
+      if (data_) ::munmap(data_, mapped_bytes());
+      data_ = nullptr;
+      capacity_ = 0;
+    }
+
+    void require_writable() const
+    {
+      if (mode_ != mmap_mode::read_write) throw std::logic_error("mmap_vector is read only");
+    }
+  public:
+    // default constructor; no file is open
+    mmap_vector() noexcept : fd_(-1), data_(nullptr), size_(0), capacity_(0), mode_(mmap_mode::read_only) {}
+
+    // map the file at path
+    explicit mmap_vector(const char* path, mmap_mode mode = mmap_mode::read_only) : mmap_vector()
+    {
+      open(path, mode);
+    }
+
+    // destructor; unmaps and trims the file to size()
+    ~mmap_vector() { close(); }
+
+    mmap_vector(const mmap_vector&) = delete;
+    mmap_vector& operator=(const mmap_vector&) = delete;
+
+    // move constructor
+    mmap_vector(mmap_vector&& other) noexcept : mmap_vector() { swap(other); }
+
+    // move assignment operator
+    mmap_vector& operator=(mmap_vector&& other) noexcept
+    {
+      if (this != &other)
+      {
+        close();
+        swap(other);
+      }
+      return *this;
+    }
+
+    void open(const char* path, mmap_mode mode = mmap_mode::read_only)
+    {
+      close();
+      mode_ = mode;
+      int flags = mode == mmap_mode::read_only ? O_RDONLY : O_RDWR | O_CREAT;
+      fd_ = ::open(path, flags | O_CLOEXEC, 0644);
+      if (fd_ < 0) detail::throw_mmap_error("mmap_vector: open");
+
+      struct stat info;
+      if (::fstat(fd_, &info) != 0)
+      {
+        int error = errno;
+        close();
+        errno = error;
+        detail::throw_mmap_error("mmap_vector: fstat");
+      }
+      size_t bytes = static_cast<size_t>(info.st_size);
+      if (bytes % sizeof(T) != 0)
+      {
+        close();
+        throw std::runtime_error("mmap_vector: file size is not a multiple of the record size");
+      }
+      try
+      {
+        map(bytes / sizeof(T));
+      }
+      catch (...)
+      {
+        close();
+        throw;
+      }
+      size_ = capacity_;
+    }
+
+    // unmap and close; a writable file is trimmed to size() first
+    void close() noexcept
+    {
+      if (fd_ < 0) return;
+      bool writable = mode_ == mmap_mode::read_write;
+      unmap();
+      if (writable)
+      {
+        // best effort; close has no way to report a failure
+        int trimmed = ::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T)));
+        (void)trimmed;
+      }
+      ::close(fd_);
+      fd_ = -1;
+      size_ = 0;
+    }
+
+    bool is_open() const noexcept { return fd_ >= 0; }
+    mmap_mode mode() const noexcept { return mode_; }
+
+    // capacity functions
+    bool empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+
+    // element access
+    T& operator[](size_t index) noexcept { return data_[index]; }
+    const T& operator[](size_t index) const noexcept { return data_[index]; }
+    T& at(size_t index)
+    {
+      if (index >= size_) throw std::out_of_range("Index out of bounds");
+      return data_[index];
+    }
+    const T& at(size_t index) const
+    {
+      if (index >= size_) throw std::out_of_range("Index out of bounds");
+      return data_[index];
+    }
+    T& front() noexcept { return data_[0]; }
+    const T& front() const noexcept { return data_[0]; }
+    T& back() noexcept { return data_[size_ - 1]; }
+    const T& back() const noexcept { return data_[size_ - 1]; }
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    // iterators
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+    const_iterator cbegin() const noexcept { return data_; }
+    const_iterator cend() const noexcept { return data_ + size_; }
+
+    // modifiers, read_write mode only
+    // grow the file and the mapping to hold new_cap records
+    void reserve(size_t new_cap)
+    {
+      require_writable();
+      if (capacity_ >= new_cap) return;
+      size_t new_bytes = new_cap * sizeof(T);
+      if (::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) detail::throw_mmap_error("mmap_vector: ftruncate");
+      if (!data_)
+      {
+        map(new_cap);
+        return;
+      }
+#if defined(__linux__)
+      void* p = ::mremap(data_, mapped_bytes(), new_bytes, MREMAP_MAYMOVE);
+      if (p == MAP_FAILED) detail::throw_mmap_error("mmap_vector: mremap");
+      data_ = static_cast<T*>(p);
+      capacity_ = new_cap;
+#else
+      unmap();
+      map(new_cap);
+#endif
+    }
+
+    void push_back(const T& value)
+    {
+      require_writable();
+      if (size_ == capacity_)
+      {
+        // value may live in the mapping, which growing can move or unmap
+        T copy = value;
+        // start at one page so small records do not remap on every push
+        size_t first = detail::mmap_page_size() / sizeof(T);
+        reserve(capacity_ == 0 ? (first ? first : 1) : 2 * capacity_);
+        data_[size_++] = copy;
+        return;
+      }
+      data_[size_++] = value;
+    }
+
+    void pop_back()
+    {
+      require_writable();
+      if (size_ > 0) --size_;
+    }
+
+    // grow with zero filled records, or shrink
+    void resize(size_t count)
+    {
+      require_writable();
+      if (count > capacity_) reserve(count);
+      if (count > size_) __builtin_memset(static_cast<void*>(data_ + size_), 0, (count - size_) * sizeof(T));
+      size_ = count;
+    }
+
+    void clear()
+    {
+      require_writable();
+      size_ = 0;
+    }
+
+    // hint how [first, first + count) will be read; hints are advisory,
+    // so false (the kernel refused or lacks the feature) is not an error
+    bool advise(mmap_advice advice, size_t first = 0, size_t count = npos) const noexcept
+    {
+      if (!data_ || first >= capacity_) return false;
+      count = count > capacity_ - first ? capacity_ - first : count;
+      // madvise wants a page aligned start
+      size_t page = detail::mmap_page_size();
+      size_t begin = (first * sizeof(T)) & ~(page - 1);
+      size_t end = (first + count) * sizeof(T);
+      int flag = MADV_NORMAL;
+      switch (advice)
+      {
+        case mmap_advice::normal: flag = MADV_NORMAL; break;
+        case mmap_advice::sequential: flag = MADV_SEQUENTIAL; break;
+        case mmap_advice::random: flag = MADV_RANDOM; break;
+        case mmap_advice::willneed: flag = MADV_WILLNEED; break;
+        case mmap_advice::hugepage:
+#if defined(MADV_HUGEPAGE)
+          flag = MADV_HUGEPAGE;
+          break;
+#else
+          return false;
+#endif
+      }
+      char* base = reinterpret_cast<char*>(const_cast<T*>(data_));
+      return ::madvise(base + begin, end - begin, flag) == 0;
+    }
+
+    // write dirty pages back to the file; blocks unless async is set
+    void flush(bool async = false) const
+    {
+      if (!data_ || mode_ != mmap_mode::read_write) return;
+      if (::msync(const_cast<T*>(data_), mapped_bytes(), async ? MS_ASYNC : MS_SYNC) != 0)
+      {
+        detail::throw_mmap_error("mmap_vector: msync");
+      }
+    }
+
+    void swap(mmap_vector& other) noexcept
+    {
+      karls_standard_library::swap(fd_, other.fd_);
+      karls_standard_library::swap(data_, other.data_);
+      karls_standard_library::swap(size_, other.size_);
+      karls_standard_library::swap(capacity_, other.capacity_);
+      karls_standard_library::swap(mode_, other.mode_);
+    }
+  };
+}
+
+#endif
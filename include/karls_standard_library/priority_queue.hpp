@@ -0,0 +1,244 @@
+#ifndef KARLS_STANDARD_LIBRARY_PRIORITY_QUEUE_HPP
+#define KARLS_STANDARD_LIBRARY_PRIORITY_QUEUE_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "functional.hpp"
+#include "vector.hpp"
+#include "heap.hpp"
+#include <stdexcept>
+
+namespace karls_standard_library {
+  // priority queue over a D-ary heap stored in a vector; top() is the
+  // largest element by Compare, so greater<T> gives a min queue
+  template<typename T, typename Compare = less<T>, size_t Arity = 4>
+  class priority_queue {
+  public:
+    using value_type = T;
+    using size_type = size_t;
+    using value_compare = Compare;
+
+    static_assert(Arity >= 2, "a heap needs at least two children per node");
+  private:
+    vector<T> heap_;
+    Compare comp_;
+  public:
+    // default constructor
+    priority_queue() : heap_(), comp_() {}
+    explicit priority_queue(const Compare& comp) : heap_(), comp_(comp) {}
+
+    // build from a range in O(n)
+    template<typename It>
+    priority_queue(It first, It last, const Compare& comp = Compare{}) : heap_(), comp_(comp)
+    {
+      for (; first != last; ++first) heap_.push_back(*first);
+      make_heap<Arity>(heap_.data(), heap_.data() + heap_.size(), comp_);
+    }
+
+    // capacity functions
+    bool empty() const noexcept { return heap_.empty(); }
+    size_t size() const noexcept { return heap_.size(); }
+    void reserve(size_t new_cap) { heap_.reserve(new_cap); }
+
+    // element access
+    const T& top() const noexcept { return heap_.front(); }
+
+    // modifiers
+    template<typename... Args>
+    void emplace(Args&&... args)
+    {
+      heap_.emplace_back(karls_standard_library::forward<Args>(args)...);
+      push_heap<Arity>(heap_.data(), heap_.data() + heap_.size(), comp_);
+    }
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(karls_standard_library::move(value)); }
+
+    // the last element fills the hole left by the top
+    void pop()
+    {
+      T last = karls_standard_library::move(heap_.back());
+      heap_.pop_back();
+      if (heap_.empty()) return;
+      detail::heap_no_tracking moved;
+      detail::heap_place_down<Arity>(heap_.data(), static_cast<ptrdiff_t>(heap_.size()), 0, karls_standard_library::move(last), comp_, moved);
+    }
+
+    // remove and return the top element
+    T take()
+    {
+      T value = karls_standard_library::move(heap_.front());
+      pop();
+      return value;
+    }
+
+    void clear() noexcept { heap_.clear(); }
+
+    // the underlying heap, in heap order
+    const vector<T>& container() const noexcept { return heap_; }
+  };
+
+  // priority queue whose entries can be changed or removed through the
+  // handle push returned, as needed by dijkstra style decrease key.
+  //
+  // the heap holds (value, handle) nodes and a side table maps every live
+  // handle to its node's position, so any entry is found in O(1) and
+  // restored in O(log n). handles of removed entries are reused.
+  template<typename T, typename Compare = less<T>, size_t Arity = 4>
+  class indexed_priority_queue {
+  public:
+    using value_type = T;
+    using size_type = size_t;
+    using value_compare = Compare;
+    using handle = size_t;
+
+    static_assert(Arity >= 2, "a heap needs at least two children per node");
+  private:
+    struct node {
+      T value;
+      handle id;
+    };
+
+    struct node_compare {
+      Compare& comp;
+      bool operator()(const node& a, const node& b) const { return comp(a.value, b.value); }
+    };
+
+    // keeps position_ in step with the heap as nodes move
+    struct track {
+      indexed_priority_queue* queue;
+      void operator()(ptrdiff_t i) const noexcept
+      {
+        queue->position_[queue->heap_[i].id] = static_cast<size_t>(i);
+      }
+    };
+
+    vector<node> heap_;
+    vector<size_t> position_;   // heap index of each handle, npos if free
+    vector<handle> free_;
+    Compare comp_;
+
+    void sift_up(size_t i)
+    {
+      node_compare comp{comp_};
+      track moved{this};
+      detail::heap_sift_up<Arity>(heap_.data(), static_cast<ptrdiff_t>(i), comp, moved);
+    }
+
+    void sift_down(size_t i)
+    {
+      node_compare comp{comp_};
+      track moved{this};
+      detail::heap_sift_down<Arity>(heap_.data(), static_cast<ptrdiff_t>(heap_.size()), static_cast<ptrdiff_t>(i), comp, moved);
+    }
+
+    // move the node at i up or down to where it belongs
+    void restore(size_t i)
+    {
+      if (i > 0 && comp_(heap_[(i - 1) / Arity].value, heap_[i].value)) sift_up(i);
+      else sift_down(i);
+    }
+
+    void check(handle h) const
+    {
+      if (!contains(h)) throw std::out_of_range("invalid priority queue handle");
+    }
+  public:
+    // default constructor
+    indexed_priority_queue() : comp_() {}
+    explicit indexed_priority_queue(const Compare& comp) : comp_(comp) {}
+
+    // capacity functions
+    bool empty() const noexcept { return heap_.empty(); }
+    size_t size() const noexcept { return heap_.size(); }
+    void reserve(size_t new_cap)
+    {
+      heap_.reserve(new_cap);
+      position_.reserve(new_cap);
+    }
+
+    // element access
+    const T& top() const noexcept { return heap_.front().value; }
+    handle top_handle() const noexcept { return heap_.front().id; }
+    bool contains(handle h) const noexcept { return h < position_.size() && position_[h] != npos; }
+    const T& value(handle h) const
+    {
+      check(h);
+      return heap_[position_[h]].value;
+    }
+
+    // modifiers
+    handle push(T value)
+    {
+      handle h;
+      if (!free_.empty())
+      {
+        h = free_.back();
+        free_.pop_back();
+      }
+      else
+      {
+        h = position_.size();
+        position_.push_back(npos);
+      }
+      position_[h] = heap_.size();
+      heap_.emplace_back(node{karls_standard_library::move(value), h});
+      sift_up(heap_.size() - 1);
+      return h;
+    }
+
+    void pop() { erase(top_handle()); }
+
+    // remove and return the top element
+    T take()
+    {
+      T value = karls_standard_library::move(heap_.front().value);
+      pop();
+      return value;
+    }
+
+    // give h a value that compares no lower than its current one, moving
+    // it towards the top (a smaller key in a greater<T> min queue)
+    void decrease_key(handle h, T value)
+    {
+      check(h);
+      size_t i = position_[h];
+      heap_[i].value = karls_standard_library::move(value);
+      sift_up(i);
+    }
+
+    // give h any new value
+    void update(handle h, T value)
+    {
+      check(h);
+      size_t i = position_[h];
+      heap_[i].value = karls_standard_library::move(value);
+      restore(i);
+    }
+
+    // remove the entry for h; h becomes invalid
+    void erase(handle h)
+    {
+      check(h);
+      size_t i = position_[h];
+      size_t last = heap_.size() - 1;
+      if (i != last)
+      {
+        heap_[i] = karls_standard_library::move(heap_[last]);
+        position_[heap_[i].id] = i;
+      }
+      heap_.pop_back();
+      position_[h] = npos;
+      free_.push_back(h);
+      if (i != last) restore(i);
+    }
+
+    void clear() noexcept
+    {
+      heap_.clear();
+      position_.clear();
+      free_.clear();
+    }
+  };
+}
+
+#endif
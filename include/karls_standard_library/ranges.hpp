@@ -0,0 +1,1088 @@
+#ifndef KARLS_STANDARD_LIBRARY_RANGES_HPP
+#define KARLS_STANDARD_LIBRARY_RANGES_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// lazy views over any range: nothing is copied or allocated, each element
+// is computed as the view is iterated. views are std::ranges::view types,
+// so they also work with the standard range algorithms and adaptors
+//
+//   auto total = 0;
+//   for (int x : v | views::filter(odd) | views::transform(square) | views::take(10))
+//     total += x;
+//   vector<int> firsts = v | views::take(3) | to<vector>();
+namespace karls_standard_library {
+  namespace detail {
+    template<bool Const, typename T>
+    using maybe_const_t = std::conditional_t<Const, const T, T>;
+
+    // It's legacy category, capped at Cap
+    template<typename It, typename Cap>
+    using category_at_most_t =
+      std::conditional_t<std::derived_from<typename std::iterator_traits<It>::iterator_category, Cap>,
+                         Cap, typename std::iterator_traits<It>::iterator_category>;
+
+    // holds a view's function object; views must be assignable, and a
+    // lambda with captures is not, so assignment rebuilds the value
+    template<typename T>
+    class movable_box {
+    private:
+      std::optional<T> value_;
+    public:
+      constexpr movable_box() requires std::default_initializable<T> : value_(std::in_place) {}
+      constexpr explicit movable_box(const T& value) : value_(value) {}
+      constexpr explicit movable_box(T&& value) : value_(karls_standard_library::move(value)) {}
+      movable_box(const movable_box&) = default;
+      movable_box(movable_box&&) = default;
+
+      constexpr movable_box& operator=(const movable_box& other) requires std::copy_constructible<T>
+      {
+        if (this != &other)
+        {
+          if (other.value_) value_.emplace(*other.value_);
+          else value_.reset();
+        }
+        return *this;
+      }
+      constexpr movable_box& operator=(movable_box&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+      {
+        if (this != &other)
+        {
+          if (other.value_) value_.emplace(karls_standard_library::move(*other.value_));
+          else value_.reset();
+        }
+        return *this;
+      }
+
+      constexpr T& operator*() noexcept { return *value_; }
+      constexpr const T& operator*() const noexcept { return *value_; }
+    };
+
+    // assignable function objects, such as lambdas without captures, are
+    // stored as they are
+    template<typename T>
+      requires std::copyable<T>
+    class movable_box<T> {
+    private:
+      [[no_unique_address]] T value_ = T();
+    public:
+      constexpr movable_box() requires std::default_initializable<T> = default;
+      constexpr explicit movable_box(const T& value) : value_(value) {}
+      constexpr explicit movable_box(T&& value) : value_(karls_standard_library::move(value)) {}
+
+      constexpr T& operator*() noexcept { return value_; }
+      constexpr const T& operator*() const noexcept { return value_; }
+    };
+
+    // a partially applied adaptor: r | c is c(r), and c | d composes into
+    // a closure applying c then d
+    template<typename F>
+    struct adaptor_closure {
+      [[no_unique_address]] F fun;
+
+      template<std::ranges::viewable_range R>
+        requires std::invocable<const F&, R>
+      constexpr auto operator()(R&& r) const
+      {
+        return fun(karls_standard_library::forward<R>(r));
+      }
+
+      template<std::ranges::viewable_range R>
+        requires std::invocable<const F&, R>
+      friend constexpr auto operator|(R&& r, const adaptor_closure& c)
+      {
+        return c.fun(karls_standard_library::forward<R>(r));
+      }
+
+      template<typename G>
+      friend constexpr auto operator|(adaptor_closure c, adaptor_closure<G> d)
+      {
+        auto composed = [c = karls_standard_library::move(c), d = karls_standard_library::move(d)]<typename R>(R&& r) {
+          return d(c(karls_standard_library::forward<R>(r)));
+        };
+        return adaptor_closure<decltype(composed)>{karls_standard_library::move(composed)};
+      }
+    };
+
+    template<typename F>
+    constexpr adaptor_closure<F> make_closure(F fun)
+    {
+      return adaptor_closure<F>{karls_standard_library::move(fun)};
+    }
+  }
+
+  // a view of a range owned elsewhere, such as a vector or string
+  template<std::ranges::range R>
+    requires std::is_object_v<R>
+  class ref_view : public std::ranges::view_interface<ref_view<R>> {
+  private:
+    R* r_;
+  public:
+    constexpr ref_view(R& r) noexcept : r_(std::addressof(r)) {}
+
+    constexpr R& base() const noexcept { return *r_; }
+    constexpr std::ranges::iterator_t<R> begin() const { return std::ranges::begin(*r_); }
+    constexpr std::ranges::sentinel_t<R> end() const { return std::ranges::end(*r_); }
+    constexpr auto size() const requires std::ranges::sized_range<R> { return std::ranges::size(*r_); }
+    constexpr auto data() const requires std::ranges::contiguous_range<R> { return std::ranges::data(*r_); }
+  };
+
+  // a view that owns a range moved into it, so a pipeline can start from
+  // a temporary container
+  template<std::ranges::range R>
+    requires std::movable<R>
+  class owning_view : public std::ranges::view_interface<owning_view<R>> {
+  private:
+    R r_ = R();
+  public:
+    owning_view() requires std::default_initializable<R> = default;
+    constexpr owning_view(R&& r) : r_(karls_standard_library::move(r)) {}
+    owning_view(owning_view&&) = default;
+    owning_view& operator=(owning_view&&) = default;
+
+    constexpr R& base() & noexcept { return r_; }
+    constexpr const R& base() const& noexcept { return r_; }
+
+    constexpr std::ranges::iterator_t<R> begin() { return std::ranges::begin(r_); }
+    constexpr std::ranges::sentinel_t<R> end() { return std::ranges::end(r_); }
+    constexpr auto begin() const requires std::ranges::range<const R> { return std::ranges::begin(r_); }
+    constexpr auto end() const requires std::ranges::range<const R> { return std::ranges::end(r_); }
+
+    constexpr auto size() requires std::ranges::sized_range<R> { return std::ranges::size(r_); }
+    constexpr auto size() const requires std::ranges::sized_range<const R> { return std::ranges::size(r_); }
+    constexpr auto data() requires std::ranges::contiguous_range<R> { return std::ranges::data(r_); }
+    constexpr auto data() const requires std::ranges::contiguous_range<const R> { return std::ranges::data(r_); }
+  };
+
+  namespace detail {
+    struct all_fn {
+      template<std::ranges::viewable_range R>
+      constexpr auto operator()(R&& r) const
+      {
+        if constexpr (std::ranges::view<std::decay_t<R>>) return std::decay_t<R>(karls_standard_library::forward<R>(r));
+        else if constexpr (std::is_lvalue_reference_v<R>) return ref_view<std::remove_reference_t<R>>(r);
+        else return owning_view<std::remove_cvref_t<R>>(karls_standard_library::move(r));
+      }
+    };
+  }
+
+  namespace views {
+    // r itself if it is a view, else a view referring to or owning it
+    inline constexpr detail::adaptor_closure<detail::all_fn> all{};
+  }
+
+  template<std::ranges::viewable_range R>
+  using all_t = decltype(views::all(std::declval<R>()));
+
+  // the elements of V satisfying Pred
+  template<std::ranges::input_range V, std::indirect_unary_predicate<std::ranges::iterator_t<V>> Pred>
+    requires std::ranges::view<V> && std::is_object_v<Pred>
+  class filter_view : public std::ranges::view_interface<filter_view<V, Pred>> {
+  private:
+    V base_ = V();
+    [[no_unique_address]] detail::movable_box<Pred> pred_;
+
+    class iterator {
+    public:
+      using iterator_concept =
+        std::conditional_t<std::ranges::bidirectional_range<V>, std::bidirectional_iterator_tag,
+        std::conditional_t<std::ranges::forward_range<V>, std::forward_iterator_tag, std::input_iterator_tag>>;
+      using iterator_category = detail::category_at_most_t<std::ranges::iterator_t<V>, std::bidirectional_iterator_tag>;
+      using value_type = std::ranges::range_value_t<V>;
+      using difference_type = std::ranges::range_difference_t<V>;
+    private:
+      std::ranges::iterator_t<V> current_ = std::ranges::iterator_t<V>();
+      filter_view* parent_ = nullptr;
+    public:
+      iterator() requires std::default_initializable<std::ranges::iterator_t<V>> = default;
+      constexpr iterator(filter_view& parent, std::ranges::iterator_t<V> current) :
+        current_(karls_standard_library::move(current)), parent_(std::addressof(parent)) {}
+
+      constexpr const std::ranges::iterator_t<V>& base() const& noexcept { return current_; }
+
+      constexpr std::ranges::range_reference_t<V> operator*() const { return *current_; }
+
+      constexpr iterator& operator++()
+      {
+        current_ = parent_->find_next(karls_standard_library::move(++current_));
+        return *this;
+      }
+      constexpr auto operator++(int)
+      {
+        if constexpr (std::ranges::forward_range<V>)
+        {
+          iterator temp = *this;
+          ++*this;
+          return temp;
+        }
+        else ++*this;
+      }
+      constexpr iterator& operator--() requires std::ranges::bidirectional_range<V>
+      {
+        do --current_;
+        while (!std::invoke(*parent_->pred_, *current_));
+        return *this;
+      }
+      constexpr iterator operator--(int) requires std::ranges::bidirectional_range<V>
+      {
+        iterator temp = *this;
+        --*this;
+        return temp;
+      }
+
+      friend constexpr bool operator==(const iterator& a, const iterator& b)
+        requires std::equality_comparable<std::ranges::iterator_t<V>>
+      {
+        return a.current_ == b.current_;
+      }
+
+      friend constexpr std::ranges::range_rvalue_reference_t<V> iter_move(const iterator& it)
+      {
+        return std::ranges::iter_move(it.current_);
+      }
+    };
+
+    class sentinel {
+    private:
+      std::ranges::sentinel_t<V> end_ = std::ranges::sentinel_t<V>();
+    public:
+      sentinel() = default;
+      constexpr explicit sentinel(std::ranges::sentinel_t<V> end) : end_(end) {}
+
+      friend constexpr bool operator==(const iterator& it, const sentinel& s) { return it.base() == s.end_; }
+    };
+
+    // the first element at or after it that satisfies the predicate
+    constexpr std::ranges::iterator_t<V> find_next(std::ranges::iterator_t<V> it)
+    {
+      auto last = std::ranges::end(base_);
+      while (it != last && !std::invoke(*pred_, *it)) ++it;
+      return it;
+    }
+  public:
+    filter_view() requires std::default_initializable<V> && std::default_initializable<Pred> = default;
+    constexpr filter_view(V base, Pred pred) :
+      base_(karls_standard_library::move(base)), pred_(karls_standard_library::move(pred)) {}
+
+    constexpr V base() const& requires std::copy_constructible<V> { return base_; }
+    constexpr const Pred& pred() const { return *pred_; }
+
+    // not cached, so the first call is linear in the number of elements
+    // skipped; iterating a view once costs the same as a hand written loop
+    constexpr iterator begin() { return iterator(*this, find_next(std::ranges::begin(base_))); }
+
+    constexpr auto end()
+    {
+      if constexpr (std::ranges::common_range<V>) return iterator(*this, std::ranges::end(base_));
+      else return sentinel(std::ranges::end(base_));
+    }
+  };
+
+  template<typename R, typename Pred>
+  filter_view(R&&, Pred) -> filter_view<all_t<R>, Pred>;
+
+  // the elements of V passed through F
+  template<std::ranges::input_range V, std::move_constructible F>
+    requires std::ranges::view<V> && std::is_object_v<F> &&
+             std::regular_invocable<F&, std::ranges::range_reference_t<V>>
+  class transform_view : public std::ranges::view_interface<transform_view<V, F>> {
+  private:
+    V base_ = V();
+    [[no_unique_address]] detail::movable_box<F> fun_;
+
+    template<bool Const>
+    class iterator {
+    private:
+      using parent_type = detail::maybe_const_t<Const, transform_view>;
+      using base_type = detail::maybe_const_t<Const, V>;
+      using base_iterator = std::ranges::iterator_t<base_type>;
+      using result_type = std::invoke_result_t<detail::maybe_const_t<Const, F>&, std::ranges::range_reference_t<base_type>>;
+    public:
+      using iterator_concept = detail::iterator_concept_t<base_iterator>;
+      using iterator_category =
+        std::conditional_t<std::is_lvalue_reference_v<result_type>,
+                           detail::category_at_most_t<base_iterator, std::random_access_iterator_tag>,
+                           std::input_iterator_tag>;
+      using value_type = std::remove_cvref_t<result_type>;
+      using difference_type = std::ranges::range_difference_t<base_type>;
+    private:
+      base_iterator current_ = base_iterator();
+      parent_type* parent_ = nullptr;
+
+      friend class iterator<!Const>;
+    public:
+      iterator() requires std::default_initializable<base_iterator> = default;
+      constexpr iterator(parent_type& parent, base_iterator current) :
+        current_(karls_standard_library::move(current)), parent_(std::addressof(parent)) {}
+      constexpr iterator(iterator<!Const> other)
+        requires Const && std::convertible_to<std::ranges::iterator_t<V>, base_iterator>
+        : current_(karls_standard_library::move(other.current_)), parent_(other.parent_) {}
+
+      constexpr const base_iterator& base() const& noexcept { return current_; }
+
+      constexpr decltype(auto) operator*() const { return std::invoke(*parent_->fun_, *current_); }
+      constexpr decltype(auto) operator[](difference_type n) const
+        requires std::ranges::random_access_range<base_type>
+      {
+        return std::invoke(*parent_->fun_, current_[n]);
+      }
+
+      constexpr iterator& operator++() { ++current_; return *this; }
+      constexpr auto operator++(int)
+      {
+        if constexpr (std::ranges::forward_range<base_type>)
+        {
+          iterator temp = *this;
+          ++current_;
+          return temp;
+        }
+        else ++current_;
+      }
+      constexpr iterator& operator--() requires std::ranges::bidirectional_range<base_type> { --current_; return *this; }
+      constexpr iterator operator--(int) requires std::ranges::bidirectional_range<base_type>
+      {
+        iterator temp = *this;
+        --current_;
+        return temp;
+      }
+      constexpr iterator& operator+=(difference_type n) requires std::ranges::random_access_range<base_type> { current_ += n; return *this; }
+      constexpr iterator& operator-=(difference_type n) requires std::ranges::random_access_range<base_type> { current_ -= n; return *this; }
+
+      friend constexpr iterator operator+(iterator it, difference_type n) requires std::ranges::random_access_range<base_type> { return it += n; }
+      friend constexpr iterator operator+(difference_type n, iterator it) requires std::ranges::random_access_range<base_type> { return it += n; }
+      friend constexpr iterator operator-(iterator it, difference_type n) requires std::ranges::random_access_range<base_type> { return it -= n; }
+      friend constexpr difference_type operator-(const iterator& a, const iterator& b)
+        requires std::sized_sentinel_for<base_iterator, base_iterator>
+      {
+        return a.current_ - b.current_;
+      }
+
+      friend constexpr bool operator==(const iterator& a, const iterator& b)
+        requires std::equality_comparable<base_iterator>
+      {
+        return a.current_ == b.current_;
+      }
+      friend constexpr auto operator<=>(const iterator& a, const iterator& b)
+        requires std::ranges::random_access_range<base_type> && std::three_way_comparable<base_iterator>
+      {
+        return a.current_ <=> b.current_;
+      }
+
+      friend constexpr decltype(auto) iter_move(const iterator& it)
+      {
+        if constexpr (std::is_lvalue_reference_v<result_type>) return karls_standard_library::move(*it);
+        else return *it;
+      }
+    };
+
+    template<bool Const>
+    class sentinel {
+    private:
+      using base_type = detail::maybe_const_t<Const, V>;
+
+      std::ranges::sentinel_t<base_type> end_ = std::ranges::sentinel_t<base_type>();
+    public:
+      sentinel() = default;
+      constexpr explicit sentinel(std::ranges::sentinel_t<base_type> end) : end_(end) {}
+
+      friend constexpr bool operator==(const iterator<Const>& it, const sentinel& s) { return it.base() == s.end_; }
+    };
+
+    template<typename Self>
+    static constexpr auto begin_of(Self& self)
+    {
+      return iterator<std::is_const_v<Self>>(self, std::ranges::begin(self.base_));
+    }
+
+    template<typename Self>
+    static constexpr auto end_of(Self& self)
+    {
+      constexpr bool is_const = std::is_const_v<Self>;
+      if constexpr (std::ranges::common_range<detail::maybe_const_t<is_const, V>>)
+        return iterator<is_const>(self, std::ranges::end(self.base_));
+      else return sentinel<is_const>(std::ranges::end(self.base_));
+    }
+  public:
+    transform_view() requires std::default_initializable<V> && std::default_initializable<F> = default;
+    constexpr transform_view(V base, F fun) :
+      base_(karls_standard_library::move(base)), fun_(karls_standard_library::move(fun)) {}
+
+    constexpr V base() const& requires std::copy_constructible<V> { return base_; }
+
+    constexpr auto begin() { return begin_of(*this); }
+    constexpr auto begin() const
+      requires std::ranges::range<const V> && std::regular_invocable<const F&, std::ranges::range_reference_t<const V>>
+    {
+      return begin_of(*this);
+    }
+    constexpr auto end() { return end_of(*this); }
+    constexpr auto end() const
+      requires std::ranges::range<const V> && std::regular_invocable<const F&, std::ranges::range_reference_t<const V>>
+    {
+      return end_of(*this);
+    }
+
+    constexpr auto size() requires std::ranges::sized_range<V> { return std::ranges::size(base_); }
+    constexpr auto size() const requires std::ranges::sized_range<const V> { return std::ranges::size(base_); }
+  };
+
+  template<typename R, typename F>
+  transform_view(R&&, F) -> transform_view<all_t<R>, F>;
+
+  // the first count elements of V, or all of them if there are fewer
+  template<std::ranges::view V>
+  class take_view : public std::ranges::view_interface<take_view<V>> {
+  private:
+    V base_ = V();
+    std::ranges::range_difference_t<V> count_ = 0;
+
+    template<bool Const>
+    class sentinel {
+    private:
+      using base_type = detail::maybe_const_t<Const, V>;
+
+      std::ranges::sentinel_t<base_type> end_ = std::ranges::sentinel_t<base_type>();
+    public:
+      sentinel() = default;
+      constexpr explicit sentinel(std::ranges::sentinel_t<base_type> end) : end_(end) {}
+
+      friend constexpr bool operator==(const std::counted_iterator<std::ranges::iterator_t<base_type>>& it, const sentinel& s)
+      {
+        return it.count() == 0 || it.base() == s.end_;
+      }
+    };
+
+    template<typename Self>
+    static constexpr auto size_of(Self& self)
+    {
+      auto n = std::ranges::size(self.base_);
+      return karls_standard_library::min(n, static_cast<decltype(n)>(self.count_));
+    }
+
+    // a sized random access base is cut down to a plain iterator pair;
+    // anything else counts down as it goes
+    template<typename Self>
+    static constexpr auto begin_of(Self& self)
+    {
+      using base_type = detail::maybe_const_t<std::is_const_v<Self>, V>;
+      if constexpr (std::ranges::sized_range<base_type>)
+      {
+        if constexpr (std::ranges::random_access_range<base_type>) return std::ranges::begin(self.base_);
+        else
+        {
+          auto n = static_cast<std::ranges::range_difference_t<base_type>>(size_of(self));
+          return std::counted_iterator(std::ranges::begin(self.base_), n);
+        }
+      }
+      else return std::counted_iterator(std::ranges::begin(self.base_), self.count_);
+    }
+
+    template<typename Self>
+    static constexpr auto end_of(Self& self)
+    {
+      using base_type = detail::maybe_const_t<std::is_const_v<Self>, V>;
+      if constexpr (std::ranges::sized_range<base_type>)
+      {
+        if constexpr (std::ranges::random_access_range<base_type>)
+          return std::ranges::begin(self.base_) + static_cast<std::ranges::range_difference_t<base_type>>(size_of(self));
+        else return std::default_sentinel;
+      }
+      else return sentinel<std::is_const_v<Self>>(std::ranges::end(self.base_));
+    }
+  public:
+    take_view() requires std::default_initializable<V> = default;
+    constexpr take_view(V base, std::ranges::range_difference_t<V> count) :
+      base_(karls_standard_library::move(base)), count_(count) {}
+
+    constexpr V base() const& requires std::copy_constructible<V> { return base_; }
+
+    constexpr auto begin() { return begin_of(*this); }
+    constexpr auto begin() const requires std::ranges::range<const V> { return begin_of(*this); }
+    constexpr auto end() { return end_of(*this); }
+    constexpr auto end() const requires std::ranges::range<const V> { return end_of(*this); }
+
+    constexpr auto size() requires std::ranges::sized_range<V> { return size_of(*this); }
+    constexpr auto size() const requires std::ranges::sized_range<const V> { return size_of(*this); }
+  };
+
+  template<typename R>
+  take_view(R&&, std::ranges::range_difference_t<R>) -> take_view<all_t<R>>;
+
+  // all but the first count elements of V
+  template<std::ranges::view V>
+  class drop_view : public std::ranges::view_interface<drop_view<V>> {
+  private:
+    V base_ = V();
+    std::ranges::range_difference_t<V> count_ = 0;
+
+    template<typename Self>
+    static constexpr auto size_of(Self& self)
+    {
+      auto n = std::ranges::size(self.base_);
+      auto dropped = static_cast<decltype(n)>(self.count_);
+      return n < dropped ? static_cast<decltype(n)>(0) : n - dropped;
+    }
+  public:
+    drop_view() requires std::default_initializable<V> = default;
+    constexpr drop_view(V base, std::ranges::range_difference_t<V> count) :
+      base_(karls_standard_library::move(base)), count_(count) {}
+
+    constexpr V base() const& requires std::copy_constructible<V> { return base_; }
+
+    // constant time for random access bases, else linear in count
+    constexpr auto begin() { return std::ranges::next(std::ranges::begin(base_), count_, std::ranges::end(base_)); }
+    constexpr auto begin() const requires std::ranges::range<const V>
+    {
+      return std::ranges::next(std::ranges::begin(base_), count_, std::ranges::end(base_));
+    }
+    constexpr auto end() { return std::ranges::end(base_); }
+    constexpr auto end() const requires std::ranges::range<const V> { return std::ranges::end(base_); }
+
+    constexpr auto size() requires std::ranges::sized_range<V> { return size_of(*this); }
+    constexpr auto size() const requires std::ranges::sized_range<const V> { return size_of(*this); }
+  };
+
+  template<typename R>
+  drop_view(R&&, std::ranges::range_difference_t<R>) -> drop_view<all_t<R>>;
+
+  // V split into consecutive subranges of count elements; the last chunk
+  // holds whatever is left over
+  template<std::ranges::view V>
+    requires std::ranges::forward_range<V>
+  class chunk_view : public std::ranges::view_interface<chunk_view<V>> {
+  private:
+    V base_ = V();
+    std::ranges::range_difference_t<V> count_ = 1;
+
+    template<bool Const>
+    class iterator {
+    private:
+      using base_type = detail::maybe_const_t<Const, V>;
+      using base_iterator = std::ranges::iterator_t<base_type>;
+    public:
+      using iterator_concept = std::forward_iterator_tag;
+      using iterator_category = std::input_iterator_tag;
+      using value_type = std::ranges::subrange<base_iterator>;
+      using difference_type = std::ranges::range_difference_t<base_type>;
+    private:
+      base_iterator current_ = base_iterator();
+      std::ranges::sentinel_t<base_type> end_ = std::ranges::sentinel_t<base_type>();
+      difference_type count_ = 0;
+    public:
+      iterator() = default;
+      constexpr iterator(base_iterator current, std::ranges::sentinel_t<base_type> end, difference_type count) :
+        current_(karls_standard_library::move(current)), end_(end), count_(count) {}
+
+      constexpr base_iterator base() const { return current_; }
+
+      constexpr value_type operator*() const { return value_type(current_, std::ranges::next(current_, count_, end_)); }
+
+      constexpr iterator& operator++()
+      {
+        current_ = std::ranges::next(current_, count_, end_);
+        return *this;
+      }
+      constexpr iterator operator++(int)
+      {
+        iterator temp = *this;
+        ++*this;
+        return temp;
+      }
+
+      friend constexpr bool operator==(const iterator& a, const iterator& b) { return a.current_ == b.current_; }
+      friend constexpr bool operator==(const iterator& it, std::default_sentinel_t) { return it.current_ == it.end_; }
+    };
+
+    template<typename Self>
+    static constexpr auto size_of(Self& self)
+    {
+      auto n = std::ranges::size(self.base_);
+      auto count = static_cast<decltype(n)>(self.count_);
+      return (n + count - 1) / count;
+    }
+  public:
+    chunk_view() requires std::default_initializable<V> = default;
+    constexpr chunk_view(V base, std::ranges::range_difference_t<V> count) :
+      base_(karls_standard_library::move(base)), count_(count) {}
+
+    constexpr V base() const& requires std::copy_constructible<V> { return base_; }
+
+    constexpr iterator<false> begin() { return iterator<false>(std::ranges::begin(base_), std::ranges::end(base_), count_); }
+    constexpr iterator<true> begin() const requires std::ranges::forward_range<const V>
+    {
+      return iterator<true>(std::ranges::begin(base_), std::ranges::end(base_), count_);
+    }
+    constexpr std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    constexpr auto size() requires std::ranges::sized_range<V> { return size_of(*this); }
+    constexpr auto size() const requires std::ranges::sized_range<const V> { return size_of(*this); }
+  };
+
+  template<typename R>
+  chunk_view(R&&, std::ranges::range_difference_t<R>) -> chunk_view<all_t<R>>;
+
+  // the elements of several ranges side by side, as tuples of references;
+  // stops at the end of the shortest
+  template<std::ranges::input_range... Vs>
+    requires (sizeof...(Vs) > 0) && (std::ranges::view<Vs> && ...)
+  class zip_view : public std::ranges::view_interface<zip_view<Vs...>> {
+  private:
+    std::tuple<Vs...> views_;
+
+    template<bool Const>
+    static constexpr bool all_random_access_sized =
+      ((std::ranges::random_access_range<detail::maybe_const_t<Const, Vs>> &&
+        std::ranges::sized_range<detail::maybe_const_t<Const, Vs>>) && ...);
+
+    template<bool Const>
+    class iterator {
+    private:
+      template<typename V>
+      using base_type = detail::maybe_const_t<Const, V>;
+
+      std::tuple<std::ranges::iterator_t<base_type<Vs>>...> current_;
+
+      // all iterators advance in lockstep, so the first one stands in for
+      // the position of the whole tuple
+      constexpr const auto& lead() const noexcept { return std::get<0>(current_); }
+
+      friend class zip_view;
+    public:
+      using iterator_concept =
+        std::conditional_t<(std::ranges::random_access_range<base_type<Vs>> && ...), std::random_access_iterator_tag,
+        std::conditional_t<(std::ranges::bidirectional_range<base_type<Vs>> && ...), std::bidirectional_iterator_tag,
+        std::conditional_t<(std::ranges::forward_range<base_type<Vs>> && ...), std::forward_iterator_tag, std::input_iterator_tag>>>;
+      using iterator_category = std::input_iterator_tag;
+      using value_type = std::tuple<std::ranges::range_value_t<base_type<Vs>>...>;
+      using difference_type = std::common_type_t<std::ranges::range_difference_t<base_type<Vs>>...>;
+
+      iterator() = default;
+      constexpr explicit iterator(std::tuple<std::ranges::iterator_t<base_type<Vs>>...> current) :
+        current_(karls_standard_library::move(current)) {}
+
+      constexpr const auto& base() const& noexcept { return current_; }
+
+      constexpr auto operator*() const
+      {
+        return std::apply([](const auto&... it) {
+          return std::tuple<std::iter_reference_t<std::remove_cvref_t<decltype(it)>>...>(*it...);
+        }, current_);
+      }
+      constexpr auto operator[](difference_type n) const requires (std::ranges::random_access_range<base_type<Vs>> && ...)
+      {
+        return *(*this + n);
+      }
+
+      constexpr iterator& operator++()
+      {
+        std::apply([](auto&... it) { (++it, ...); }, current_);
+        return *this;
+      }
+      constexpr auto operator++(int)
+      {
+        if constexpr ((std::ranges::forward_range<base_type<Vs>> && ...))
+        {
+          iterator temp = *this;
+          ++*this;
+          return temp;
+        }
+        else ++*this;
+      }
+      constexpr iterator& operator--() requires (std::ranges::bidirectional_range<base_type<Vs>> && ...)
+      {
+        std::apply([](auto&... it) { (--it, ...); }, current_);
+        return *this;
+      }
+      constexpr iterator operator--(int) requires (std::ranges::bidirectional_range<base_type<Vs>> && ...)
+      {
+        iterator temp = *this;
+        --*this;
+        return temp;
+      }
+      constexpr iterator& operator+=(difference_type n) requires (std::ranges::random_access_range<base_type<Vs>> && ...)
+      {
+        std::apply([n](auto&... it) { ((it += static_cast<std::iter_difference_t<std::remove_cvref_t<decltype(it)>>>(n)), ...); }, current_);
+        return *this;
+      }
+      constexpr iterator& operator-=(difference_type n) requires (std::ranges::random_access_range<base_type<Vs>> && ...)
+      {
+        return *this += -n;
+      }
+
+      friend constexpr iterator operator+(iterator it, difference_type n)
+        requires (std::ranges::random_access_range<base_type<Vs>> && ...)
+      {
+        return it += n;
+      }
+      friend constexpr iterator operator+(difference_type n, iterator it)
+        requires (std::ranges::random_access_range<base_type<Vs>> && ...)
+      {
+        return it += n;
+      }
+      friend constexpr iterator operator-(iterator it, difference_type n)
+        requires (std::ranges::random_access_range<base_type<Vs>> && ...)
+      {
+        return it -= n;
+      }
+      friend constexpr difference_type operator-(const iterator& a, const iterator& b)
+        requires (std::sized_sentinel_for<std::ranges::iterator_t<base_type<Vs>>, std::ranges::iterator_t<base_type<Vs>>> && ...)
+      {
+        return static_cast<difference_type>(a.lead() - b.lead());
+      }
+
+      friend constexpr bool operator==(const iterator& a, const iterator& b)
+        requires (std::equality_comparable<std::ranges::iterator_t<base_type<Vs>>> && ...)
+      {
+        return a.lead() == b.lead();
+      }
+      friend constexpr auto operator<=>(const iterator& a, const iterator& b)
+        requires (std::ranges::random_access_range<base_type<Vs>> && ...)
+      {
+        return a.lead() <=> b.lead();
+      }
+
+      friend constexpr auto iter_move(const iterator& it)
+      {
+        return std::apply([](const auto&... i) {
+          return std::tuple<std::iter_rvalue_reference_t<std::remove_cvref_t<decltype(i)>>...>(std::ranges::iter_move(i)...);
+        }, it.current_);
+      }
+    };
+
+    template<bool Const>
+    class sentinel {
+    private:
+      std::tuple<std::ranges::sentinel_t<detail::maybe_const_t<Const, Vs>>...> end_;
+
+      template<size_t... I>
+      static constexpr bool any_equal(const iterator<Const>& it, const sentinel& s, std::index_sequence<I...>)
+      {
+        return ((std::get<I>(it.base()) == std::get<I>(s.end_)) || ...);
+      }
+    public:
+      sentinel() = default;
+      constexpr explicit sentinel(std::tuple<std::ranges::sentinel_t<detail::maybe_const_t<Const, Vs>>...> end) :
+        end_(karls_standard_library::move(end)) {}
+
+      friend constexpr bool operator==(const iterator<Const>& it, const sentinel& s)
+      {
+        return any_equal(it, s, std::index_sequence_for<Vs...>());
+      }
+    };
+
+    template<typename Self>
+    static constexpr auto size_of(Self& self)
+    {
+      return std::apply([](auto&... v) {
+        using size_type = std::make_unsigned_t<std::common_type_t<decltype(std::ranges::size(v))...>>;
+        size_type n = std::numeric_limits<size_type>::max();
+        ((n = karls_standard_library::min(n, static_cast<size_type>(std::ranges::size(v)))), ...);
+        return n;
+      }, self.views_);
+    }
+
+    template<typename Self>
+    static constexpr auto begin_of(Self& self)
+    {
+      return iterator<std::is_const_v<Self>>(std::apply([](auto&... v) { return std::tuple(std::ranges::begin(v)...); }, self.views_));
+    }
+
+    // with random access sized ranges end is a plain iterator, so the zip
+    // is a common range and the loop compares one iterator, not all
+    template<typename Self>
+    static constexpr auto end_of(Self& self)
+    {
+      constexpr bool is_const = std::is_const_v<Self>;
+      if constexpr (all_random_access_sized<is_const>)
+      {
+        using difference_type = typename iterator<is_const>::difference_type;
+        return begin_of(self) + static_cast<difference_type>(size_of(self));
+      }
+      else return sentinel<is_const>(std::apply([](auto&... v) { return std::tuple(std::ranges::end(v)...); }, self.views_));
+    }
+  public:
+    zip_view() = default;
+    constexpr explicit zip_view(Vs... views) : views_(karls_standard_library::move(views)...) {}
+
+    constexpr auto begin() { return begin_of(*this); }
+    constexpr auto begin() const requires (std::ranges::range<const Vs> && ...) { return begin_of(*this); }
+    constexpr auto end() { return end_of(*this); }
+    constexpr auto end() const requires (std::ranges::range<const Vs> && ...) { return end_of(*this); }
+
+    constexpr auto size() requires (std::ranges::sized_range<Vs> && ...) { return size_of(*this); }
+    constexpr auto size() const requires (std::ranges::sized_range<const Vs> && ...) { return size_of(*this); }
+  };
+
+  template<typename... Rs>
+  zip_view(Rs&&...) -> zip_view<all_t<Rs>...>;
+
+  // the elements of V paired with their index, as tuples (index, element)
+  template<std::ranges::view V>
+  class enumerate_view : public std::ranges::view_interface<enumerate_view<V>> {
+  private:
+    V base_ = V();
+
+    template<bool Const>
+    class iterator {
+    private:
+      using base_type = detail::maybe_const_t<Const, V>;
+      using base_iterator = std::ranges::iterator_t<base_type>;
+    public:
+      using iterator_concept = detail::iterator_concept_t<base_iterator>;
+      using iterator_category = std::input_iterator_tag;
+      using difference_type = std::ranges::range_difference_t<base_type>;
+      using value_type = std::tuple<difference_type, std::ranges::range_value_t<base_type>>;
+    private:
+      base_iterator current_ = base_iterator();
+      difference_type index_ = 0;
+    public:
+      iterator() requires std::default_initializable<base_iterator> = default;
+      constexpr iterator(base_iterator current, difference_type index) :
+        current_(karls_standard_library::move(current)), index_(index) {}
+
+      constexpr const base_iterator& base() const& noexcept { return current_; }
+      constexpr difference_type index() const noexcept { return index_; }
+
+      constexpr auto operator*() const
+      {
+        return std::tuple<difference_type, std::ranges::range_reference_t<base_type>>(index_, *current_);
+      }
+      constexpr auto operator[](difference_type n) const requires std::ranges::random_access_range<base_type>
+      {
+        return std::tuple<difference_type, std::ranges::range_reference_t<base_type>>(index_ + n, current_[n]);
+      }
+
+      constexpr iterator& operator++()
+      {
+        ++current_;
+        ++index_;
+        return *this;
+      }
+      constexpr auto operator++(int)
+      {
+        if constexpr (std::ranges::forward_range<base_type>)
+        {
+          iterator temp = *this;
+          ++*this;
+          return temp;
+        }
+        else ++*this;
+      }
+      constexpr iterator& operator--() requires std::ranges::bidirectional_range<base_type>
+      {
+        --current_;
+        --index_;
+        return *this;
+      }
+      constexpr iterator operator--(int) requires std::ranges::bidirectional_range<base_type>
+      {
+        iterator temp = *this;
+        --*this;
+        return temp;
+      }
+      constexpr iterator& operator+=(difference_type n) requires std::ranges::random_access_range<base_type>
+      {
+        current_ += n;
+        index_ += n;
+        return *this;
+      }
+      constexpr iterator& operator-=(difference_type n) requires std::ranges::random_access_range<base_type>
+      {
+        current_ -= n;
+        index_ -= n;
+        return *this;
+      }
+
+      friend constexpr iterator operator+(iterator it, difference_type n) requires std::ranges::random_access_range<base_type> { return it += n; }
+      friend constexpr iterator operator+(difference_type n, iterator it) requires std::ranges::random_access_range<base_type> { return it += n; }
+      friend constexpr iterator operator-(iterator it, difference_type n) requires std::ranges::random_access_range<base_type> { return it -= n; }
+      friend constexpr difference_type operator-(const iterator& a, const iterator& b) noexcept { return a.index_ - b.index_; }
+
+      friend constexpr bool operator==(const iterator& a, const iterator& b)
+        requires std::equality_comparable<base_iterator>
+      {
+        return a.current_ == b.current_;
+      }
+      friend constexpr std::strong_ordering operator<=>(const iterator& a, const iterator& b) noexcept { return a.index_ <=> b.index_; }
+
+      friend constexpr auto iter_move(const iterator& it)
+      {
+        return std::tuple<difference_type, std::ranges::range_rvalue_reference_t<base_type>>(it.index_, std::ranges::iter_move(it.current_));
+      }
+    };
+
+    template<bool Const>
+    class sentinel {
+    private:
+      using base_type = detail::maybe_const_t<Const, V>;
+
+      std::ranges::sentinel_t<base_type> end_ = std::ranges::sentinel_t<base_type>();
+    public:
+      sentinel() = default;
+      constexpr explicit sentinel(std::ranges::sentinel_t<base_type> end) : end_(end) {}
+
+      friend constexpr bool operator==(const iterator<Const>& it, const sentinel& s) { return it.base() == s.end_; }
+    };
+
+    template<typename Self>
+    static constexpr auto end_of(Self& self)
+    {
+      constexpr bool is_const = std::is_const_v<Self>;
+      using base_type = detail::maybe_const_t<is_const, V>;
+      if constexpr (std::ranges::common_range<base_type> && std::ranges::sized_range<base_type>)
+      {
+        using difference_type = std::ranges::range_difference_t<base_type>;
+        return iterator<is_const>(std::ranges::end(self.base_), static_cast<difference_type>(std::ranges::size(self.base_)));
+      }
+      else return sentinel<is_const>(std::ranges::end(self.base_));
+    }
+  public:
+    enumerate_view() requires std::default_initializable<V> = default;
+    constexpr explicit enumerate_view(V base) : base_(karls_standard_library::move(base)) {}
+
+    constexpr V base() const& requires std::copy_constructible<V> { return base_; }
+
+    constexpr iterator<false> begin() { return iterator<false>(std::ranges::begin(base_), 0); }
+    constexpr iterator<true> begin() const requires std::ranges::range<const V> { return iterator<true>(std::ranges::begin(base_), 0); }
+    constexpr auto end() { return end_of(*this); }
+    constexpr auto end() const requires std::ranges::range<const V> { return end_of(*this); }
+
+    constexpr auto size() requires std::ranges::sized_range<V> { return std::ranges::size(base_); }
+    constexpr auto size() const requires std::ranges::sized_range<const V> { return std::ranges::size(base_); }
+  };
+
+  template<typename R>
+  enumerate_view(R&&) -> enumerate_view<all_t<R>>;
+
+  namespace detail {
+    // adaptors taking an argument: f(r, arg) builds the view, f(arg) is
+    // a closure waiting for the range
+    template<template<typename...> class View>
+    struct argument_adaptor {
+      template<std::ranges::viewable_range R, typename Arg>
+      constexpr auto operator()(R&& r, Arg&& arg) const
+      {
+        return View(views::all(karls_standard_library::forward<R>(r)), karls_standard_library::forward<Arg>(arg));
+      }
+
+      template<typename Arg>
+      constexpr auto operator()(Arg&& arg) const
+      {
+        return make_closure([arg = karls_standard_library::forward<Arg>(arg)]<typename R>(R&& r) {
+          return View(views::all(karls_standard_library::forward<R>(r)), arg);
+        });
+      }
+    };
+
+    // adaptors taking a count, converted to the range's difference type
+    template<template<typename...> class View>
+    struct count_adaptor {
+      template<std::ranges::viewable_range R>
+      constexpr auto operator()(R&& r, std::ranges::range_difference_t<R> count) const
+      {
+        return View(views::all(karls_standard_library::forward<R>(r)), count);
+      }
+
+      constexpr auto operator()(ptrdiff_t count) const
+      {
+        return make_closure([count]<typename R>(R&& r) {
+          return View(views::all(karls_standard_library::forward<R>(r)), static_cast<std::ranges::range_difference_t<R>>(count));
+        });
+      }
+    };
+
+    struct zip_fn {
+      template<std::ranges::viewable_range... Rs>
+        requires (sizeof...(Rs) > 0)
+      constexpr auto operator()(Rs&&... rs) const
+      {
+        return zip_view<all_t<Rs>...>(views::all(karls_standard_library::forward<Rs>(rs))...);
+      }
+    };
+
+    struct enumerate_fn {
+      template<std::ranges::viewable_range R>
+      constexpr auto operator()(R&& r) const
+      {
+        return enumerate_view<all_t<R>>(views::all(karls_standard_library::forward<R>(r)));
+      }
+    };
+  }
+
+  namespace views {
+    inline constexpr detail::argument_adaptor<filter_view> filter{};
+    inline constexpr detail::argument_adaptor<transform_view> transform{};
+    inline constexpr detail::count_adaptor<take_view> take{};
+    inline constexpr detail::count_adaptor<drop_view> drop{};
+    inline constexpr detail::count_adaptor<chunk_view> chunk{};
+    inline constexpr detail::zip_fn zip{};
+    inline constexpr detail::adaptor_closure<detail::enumerate_fn> enumerate{};
+  }
+
+  namespace detail {
+    template<typename C, typename R>
+    constexpr C materialize(R&& r)
+    {
+      C c;
+      // one allocation when the size is known up front
+      if constexpr (std::ranges::sized_range<R> && requires(C& c, size_t n) { c.reserve(n); })
+      {
+        c.reserve(static_cast<size_t>(std::ranges::size(r)));
+      }
+      for (auto&& value : r)
+      {
+        if constexpr (requires { c.push_back(value); }) c.push_back(value);
+        else
+        {
+          typename C::value_type element(value);
+          c.push_back(element);
+        }
+      }
+      return c;
+    }
+  }
+
+  // copy a range into a new container, as in to<vector<int>>(r) or
+  // r | to<vector>(), which takes the element type from the range
+  template<typename C, std::ranges::input_range R>
+  constexpr C to(R&& r)
+  {
+    return detail::materialize<C>(karls_standard_library::forward<R>(r));
+  }
+
+  template<template<typename...> class C, std::ranges::input_range R>
+  constexpr auto to(R&& r)
+  {
+    return detail::materialize<C<std::ranges::range_value_t<R>>>(karls_standard_library::forward<R>(r));
+  }
+
+  template<typename C>
+  constexpr auto to()
+  {
+    return detail::make_closure([]<typename R>(R&& r) { return karls_standard_library::to<C>(karls_standard_library::forward<R>(r)); });
+  }
+
+  template<template<typename...> class C>
+  constexpr auto to()
+  {
+    return detail::make_closure([]<typename R>(R&& r) { return karls_standard_library::to<C>(karls_standard_library::forward<R>(r)); });
+  }
+}
+
+template<typename R>
+inline constexpr bool std::ranges::enable_borrowed_range<karls_standard_library::ref_view<R>> = true;
+
+#endif
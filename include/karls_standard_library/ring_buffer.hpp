@@ -0,0 +1,399 @@
+#ifndef KARLS_STANDARD_LIBRARY_RING_BUFFER_HPP
+#define KARLS_STANDARD_LIBRARY_RING_BUFFER_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "algorithm.hpp"
+#include "array.hpp"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace karls_standard_library {
+  namespace detail {
+    // hint to the cpu that we are busy waiting
+    inline void cpu_relax() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+      _mm_pause();
+#endif
+    }
+  }
+
+  // wait free single producer / single consumer queue over fixed storage
+  //
+  // the producer owns tail_ and the consumer owns head_; each sits on its
+  // own cache line next to the owner's cached copy of the other index, so
+  // the shared lines are only touched when the cached view runs out.
+  template<typename T, size_t N>
+  class spsc_ring {
+  public:
+    using value_type = T;
+    using size_type = size_t;
+
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>,
+                  "elements live in an array and are move assigned in and out");
+  private:
+    static constexpr size_t mask = N - 1;
+
+    alignas(cache_line_size) std::atomic<size_t> head_;
+    size_t cached_tail_;
+    alignas(cache_line_size) std::atomic<size_t> tail_;
+    size_t cached_head_;
+    alignas(cache_line_size) array<T, N> buffer_;
+
+    // free slots as seen by the producer, refreshing the cache if needed
+    size_t free_slots(size_t tail, size_t wanted) noexcept
+    {
+      size_t free = N - (tail - cached_head_);
+      if (free < wanted)
+      {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        free = N - (tail - cached_head_);
+      }
+      return free;
+    }
+
+    // filled slots as seen by the consumer, refreshing the cache if needed
+    size_t filled_slots(size_t head, size_t wanted) noexcept
+    {
+      size_t filled = cached_tail_ - head;
+      if (filled < wanted)
+      {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        filled = cached_tail_ - head;
+      }
+      return filled;
+    }
+  public:
+    // default constructor
+    spsc_ring() : head_(0), cached_tail_(0), tail_(0), cached_head_(0) {}
+
+    // the indices are shared with other threads; rings stay in place
+    spsc_ring(const spsc_ring& other) = delete;
+    spsc_ring& operator=(const spsc_ring& other) = delete;
+
+    // producer: append value, false if the ring is full
+    bool try_push(const T& value)
+    {
+      size_t tail = tail_.load(std::memory_order_relaxed);
+      if (free_slots(tail, 1) == 0) return false;
+      buffer_[tail & mask] = value;
+      tail_.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+    bool try_push(T&& value)
+    {
+      size_t tail = tail_.load(std::memory_order_relaxed);
+      if (free_slots(tail, 1) == 0) return false;
+      buffer_[tail & mask] = move(value);
+      tail_.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    // producer: append up to count values from first, publishing them with
+    // a single store; returns the number appended
+    size_t push_n(const T* first, size_t count)
+    {
+      size_t tail = tail_.load(std::memory_order_relaxed);
+      size_t n = min(count, free_slots(tail, count));
+      for (size_t i = 0; i < n; ++i)
+      {
+        buffer_[(tail + i) & mask] = first[i];
+      }
+      if (n > 0) tail_.store(tail + n, std::memory_order_release);
+      return n;
+    }
+
+    // consumer: move the oldest value into out, false if the ring is empty
+    bool try_pop(T& out)
+    {
+      size_t head = head_.load(std::memory_order_relaxed);
+      if (filled_slots(head, 1) == 0) return false;
+      out = move(buffer_[head & mask]);
+      head_.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    // consumer: move up to count values into out; returns the number taken
+    size_t pop_n(T* out, size_t count)
+    {
+      size_t head = head_.load(std::memory_order_relaxed);
+      size_t n = min(count, filled_slots(head, count));
+      for (size_t i = 0; i < n; ++i)
+      {
+        out[i] = move(buffer_[(head + i) & mask]);
+      }
+      if (n > 0) head_.store(head + n, std::memory_order_release);
+      return n;
+    }
+
+    // observers; exact only when called from a quiescent ring
+    size_t size() const noexcept
+    {
+      size_t tail = tail_.load(std::memory_order_acquire);
+      size_t head = head_.load(std::memory_order_acquire);
+      return tail > head ? tail - head : 0;
+    }
+    bool empty() const noexcept { return size() == 0; }
+    static constexpr size_t capacity() noexcept { return N; }
+  };
+
+  // lock free bounded multi producer / multi consumer queue
+  //
+  // every cell carries a sequence number telling which lap of the ring it
+  // is ready for (dmitry vyukov's bounded queue): producers claim a cell
+  // by advancing tail_ with a cas and publish it by bumping its sequence,
+  // consumers do the same with head_.
+  template<typename T, size_t N>
+  class mpmc_ring {
+  public:
+    using value_type = T;
+    using size_type = size_t;
+
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>,
+                  "elements live in an array and are move assigned in and out");
+  private:
+    static constexpr size_t mask = N - 1;
+
+    struct cell {
+      std::atomic<size_t> sequence;
+      T value;
+    };
+
+    alignas(cache_line_size) std::atomic<size_t> head_;
+    alignas(cache_line_size) std::atomic<size_t> tail_;
+    alignas(cache_line_size) array<cell, N> buffer_;
+
+    // claim up to count consecutive cells ready at lap offset, starting from
+    // index; returns the first claimed position and sets count to the number
+    // claimed (zero when none are ready)
+    static size_t claim(std::atomic<size_t>& index, array<cell, N>& buffer, size_t offset, size_t& count)
+    {
+      size_t pos = index.load(std::memory_order_relaxed);
+      while (true)
+      {
+        size_t ready = 0;
+        while (ready < count)
+        {
+          size_t seq = buffer[(pos + ready) & mask].sequence.load(std::memory_order_acquire);
+          if (seq != pos + ready + offset) break;
+          ++ready;
+        }
+        if (ready == 0)
+        {
+          size_t seq = buffer[pos & mask].sequence.load(std::memory_order_acquire);
+          std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (pos + offset));
+          if (diff < 0)
+          {
+            count = 0;
+            return pos;
+          }
+          pos = index.load(std::memory_order_relaxed);
+          continue;
+        }
+        if (index.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed))
+        {
+          count = ready;
+          return pos;
+        }
+      }
+    }
+  public:
+    // default constructor
+    mpmc_ring() : head_(0), tail_(0)
+    {
+      for (size_t i = 0; i < N; ++i)
+      {
+        buffer_[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    // the indices are shared with other threads; rings stay in place
+    mpmc_ring(const mpmc_ring& other) = delete;
+    mpmc_ring& operator=(const mpmc_ring& other) = delete;
+
+    // append value, false if the ring is full
+    bool try_push(const T& value)
+    {
+      T temp(value);
+      return try_push(move(temp));
+    }
+    bool try_push(T&& value)
+    {
+      size_t count = 1;
+      size_t pos = claim(tail_, buffer_, 0, count);
+      if (count == 0) return false;
+      cell& c = buffer_[pos & mask];
+      c.value = move(value);
+      c.sequence.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+
+    // append up to count values from first; consecutive free cells are
+    // claimed with a single cas. returns the number appended
+    size_t push_n(const T* first, size_t count)
+    {
+      size_t done = 0;
+      while (done < count)
+      {
+        size_t n = count - done;
+        size_t pos = claim(tail_, buffer_, 0, n);
+        if (n == 0) break;
+        for (size_t i = 0; i < n; ++i)
+        {
+          cell& c = buffer_[(pos + i) & mask];
+          c.value = first[done + i];
+          c.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        done += n;
+      }
+      return done;
+    }
+
+    // move the oldest value into out, false if the ring is empty
+    bool try_pop(T& out)
+    {
+      size_t count = 1;
+      size_t pos = claim(head_, buffer_, 1, count);
+      if (count == 0) return false;
+      cell& c = buffer_[pos & mask];
+      out = move(c.value);
+      c.sequence.store(pos + N, std::memory_order_release);
+      return true;
+    }
+
+    // move up to count values into out; returns the number taken
+    size_t pop_n(T* out, size_t count)
+    {
+      size_t done = 0;
+      while (done < count)
+      {
+        size_t n = count - done;
+        size_t pos = claim(head_, buffer_, 1, n);
+        if (n == 0) break;
+        for (size_t i = 0; i < n; ++i)
+        {
+          cell& c = buffer_[(pos + i) & mask];
+          out[done + i] = move(c.value);
+          c.sequence.store(pos + i + N, std::memory_order_release);
+        }
+        done += n;
+      }
+      return done;
+    }
+
+    // observers; approximate while other threads are active
+    size_t size() const noexcept
+    {
+      size_t tail = tail_.load(std::memory_order_acquire);
+      size_t head = head_.load(std::memory_order_acquire);
+      return tail > head ? tail - head : 0;
+    }
+    bool empty() const noexcept { return size() == 0; }
+    static constexpr size_t capacity() noexcept { return N; }
+  };
+
+  // adds blocking push and pop to spsc_ring or mpmc_ring
+  //
+  // a blocked thread spins briefly and then sleeps in atomic::wait (a futex
+  // on linux) on a counter the other side bumps after every successful
+  // operation. the bump and waiter check are only paid by the blocking
+  // calls; the try_ functions stay the plain lock free ones.
+  template<typename Ring>
+  class blocking_ring {
+  public:
+    using value_type = typename Ring::value_type;
+    using size_type = size_t;
+  private:
+    static constexpr int spin_limit = 128;
+
+    Ring ring_;
+    alignas(cache_line_size) std::atomic<std::uint32_t> pushes_;
+    std::atomic<std::uint32_t> pop_waiters_;
+    alignas(cache_line_size) std::atomic<std::uint32_t> pops_;
+    std::atomic<std::uint32_t> push_waiters_;
+
+    static void signal(std::atomic<std::uint32_t>& events, std::atomic<std::uint32_t>& waiters)
+    {
+      events.fetch_add(1, std::memory_order_seq_cst);
+      if (waiters.load(std::memory_order_seq_cst) != 0) events.notify_one();
+    }
+
+    // run attempt until it succeeds, sleeping on events between tries
+    template<typename F>
+    static void block_until(F attempt, std::atomic<std::uint32_t>& events, std::atomic<std::uint32_t>& waiters)
+    {
+      for (int spins = 0;; ++spins)
+      {
+        std::uint32_t seen = events.load(std::memory_order_seq_cst);
+        if (attempt()) return;
+        if (spins < spin_limit)
+        {
+          detail::cpu_relax();
+          continue;
+        }
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        if (!attempt())
+        {
+          events.wait(seen, std::memory_order_seq_cst);
+          waiters.fetch_sub(1, std::memory_order_relaxed);
+          continue;
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+  public:
+    // default constructor
+    blocking_ring() : pushes_(0), pop_waiters_(0), pops_(0), push_waiters_(0) {}
+
+    // append value, waiting for space if the ring is full
+    void push(value_type value)
+    {
+      block_until([&]() { return ring_.try_push(move(value)); }, pops_, push_waiters_);
+      signal(pushes_, pop_waiters_);
+    }
+
+    // take the oldest value, waiting for one if the ring is empty
+    value_type pop()
+    {
+      value_type out{};
+      block_until([&]() { return ring_.try_pop(out); }, pushes_, pop_waiters_);
+      signal(pops_, push_waiters_);
+      return out;
+    }
+
+    // non-blocking variants that still wake blocked threads
+    bool try_push(value_type value)
+    {
+      if (!ring_.try_push(move(value))) return false;
+      signal(pushes_, pop_waiters_);
+      return true;
+    }
+    bool try_pop(value_type& out)
+    {
+      if (!ring_.try_pop(out)) return false;
+      signal(pops_, push_waiters_);
+      return true;
+    }
+
+    size_t size() const noexcept { return ring_.size(); }
+    bool empty() const noexcept { return ring_.empty(); }
+    static constexpr size_t capacity() noexcept { return Ring::capacity(); }
+  };
+
+  // blocking queues over the lock free rings
+  template<typename T, size_t N>
+  using blocking_spsc_ring = blocking_ring<spsc_ring<T, N>>;
+
+  template<typename T, size_t N>
+  using blocking_mpmc_ring = blocking_ring<mpmc_ring<T, N>>;
+}
+
+#endif
@@ -0,0 +1,419 @@
+#ifndef KARLS_STANDARD_LIBRARY_ROPE_HPP
+#define KARLS_STANDARD_LIBRARY_ROPE_HPP
+
+#include "cstddef.hpp"
+#include "cstring.hpp"
+#include "utility.hpp"
+#include "algorithm.hpp"
+#include "string_view.hpp"
+#include "string.hpp"
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <ostream>
+
+namespace karls_standard_library {
+  // immutable, reference counted tree node of a rope; leaves store their
+  // chars directly after the header in the same allocation
+  struct rope_node {
+    std::atomic<size_t> refs;
+    size_t size;
+    size_t height;
+    rope_node* left;
+    rope_node* right;
+
+    bool is_leaf() const noexcept { return left == nullptr; }
+    char* chars() noexcept { return reinterpret_cast<char*>(this + 1); }
+    const char* chars() const noexcept { return reinterpret_cast<const char*>(this + 1); }
+  };
+
+  // owning handle to a rope_node
+  class rope_ref {
+  private:
+    rope_node* node_;
+
+    static void release(rope_node* n) noexcept
+    {
+      while (n && n->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        rope_node* right = n->right;
+        release(n->left);
+        n->~rope_node();
+        operator delete(n);
+        n = right;
+      }
+    }
+  public:
+    rope_ref() noexcept : node_(nullptr) {}
+    explicit rope_ref(rope_node* n) noexcept : node_(n) {}
+    ~rope_ref() { release(node_); }
+
+    rope_ref(const rope_ref& other) noexcept : node_(other.node_)
+    {
+      if (node_) node_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    rope_ref& operator=(const rope_ref& other) noexcept
+    {
+      rope_ref temp(other);
+      swap(temp);
+      return *this;
+    }
+    rope_ref(rope_ref&& other) noexcept : node_(exchange(other.node_, nullptr)) {}
+    rope_ref& operator=(rope_ref&& other) noexcept
+    {
+      rope_ref temp(move(other));
+      swap(temp);
+      return *this;
+    }
+
+    void swap(rope_ref& other) noexcept
+    {
+      rope_node* temp = node_;
+      node_ = other.node_;
+      other.node_ = temp;
+    }
+
+    // give up ownership without touching the reference count
+    rope_node* release() noexcept { return exchange(node_, nullptr); }
+
+    rope_node* get() const noexcept { return node_; }
+    rope_node* operator->() const noexcept { return node_; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+  };
+
+  // balanced tree of string pieces; concatenation, substr, insert and
+  // erase are O(log n) and copies share structure instead of chars
+  class rope {
+  public:
+    using value_type = char;
+    using size_type = size_t;
+
+    // largest number of chars stored in a single leaf
+    static constexpr size_t leaf_size = 512;
+  private:
+    rope_ref root_;
+
+    explicit rope(rope_ref root) noexcept : root_(move(root)) {}
+
+    static size_t size_of(const rope_ref& n) noexcept { return n ? n->size : 0; }
+    static size_t height_of(const rope_ref& n) noexcept { return n ? n->height : 0; }
+    static rope_ref share(rope_node* n) noexcept
+    {
+      if (n) n->refs.fetch_add(1, std::memory_order_relaxed);
+      return rope_ref(n);
+    }
+
+    static rope_ref make_leaf(const char* str, size_t count)
+    {
+      void* mem = operator new(sizeof(rope_node) + count);
+      rope_node* n = new(mem) rope_node{{1}, count, 0, nullptr, nullptr};
+      memcpy(n->chars(), str, count);
+      return rope_ref(n);
+    }
+
+    // single leaf holding the chars of leaves l and r
+    static rope_ref merge_leaves(const rope_ref& l, const rope_ref& r)
+    {
+      void* mem = operator new(sizeof(rope_node) + l->size + r->size);
+      rope_node* n = new(mem) rope_node{{1}, l->size + r->size, 0, nullptr, nullptr};
+      memcpy(n->chars(), l->chars(), l->size);
+      memcpy(n->chars() + l->size, r->chars(), r->size);
+      return rope_ref(n);
+    }
+
+    // concatenation node over two non-empty children
+    static rope_ref make_node(rope_ref l, rope_ref r)
+    {
+      void* mem = operator new(sizeof(rope_node));
+      size_t h = max(l->height, r->height) + 1;
+      rope_node* n = new(mem) rope_node{{1}, l->size + r->size, h, nullptr, nullptr};
+      n->left = l.release();
+      n->right = r.release();
+      return rope_ref(n);
+    }
+
+    // build a perfectly balanced tree over count chars
+    static rope_ref build(const char* str, size_t count)
+    {
+      if (count == 0) return rope_ref();
+      if (count <= leaf_size) return make_leaf(str, count);
+      size_t half = count / 2;
+      return make_node(build(str, half), build(str + half, count - half));
+    }
+
+    // node over l and r whose heights differ by at most two, rotated
+    // back into avl shape
+    static rope_ref balance(rope_ref l, rope_ref r)
+    {
+      size_t hl = l->height;
+      size_t hr = r->height;
+      if (hl > hr + 1)
+      {
+        rope_ref ll = share(l->left);
+        rope_ref lr = share(l->right);
+        if (ll->height >= lr->height)
+        {
+          return make_node(move(ll), make_node(move(lr), move(r)));
+        }
+        rope_ref lrl = share(lr->left);
+        rope_ref lrr = share(lr->right);
+        return make_node(make_node(move(ll), move(lrl)), make_node(move(lrr), move(r)));
+      }
+      if (hr > hl + 1)
+      {
+        rope_ref rl = share(r->left);
+        rope_ref rr = share(r->right);
+        if (rr->height >= rl->height)
+        {
+          return make_node(make_node(move(l), move(rl)), move(rr));
+        }
+        rope_ref rll = share(rl->left);
+        rope_ref rlr = share(rl->right);
+        return make_node(make_node(move(l), move(rll)), make_node(move(rlr), move(rr)));
+      }
+      return make_node(move(l), move(r));
+    }
+
+    // try to fold the small leaf r into the rightmost leaf of l
+    static rope_ref absorb_right(const rope_ref& l, const rope_ref& r)
+    {
+      if (l->is_leaf())
+      {
+        if (l->size + r->size > leaf_size) return rope_ref();
+        return merge_leaves(l, r);
+      }
+      rope_ref right = absorb_right(share(l->right), r);
+      if (!right) return rope_ref();
+      return make_node(share(l->left), move(right));
+    }
+
+    // try to fold the small leaf l into the leftmost leaf of r
+    static rope_ref absorb_left(const rope_ref& l, const rope_ref& r)
+    {
+      if (r->is_leaf())
+      {
+        if (l->size + r->size > leaf_size) return rope_ref();
+        return merge_leaves(l, r);
+      }
+      rope_ref left = absorb_left(l, share(r->left));
+      if (!left) return rope_ref();
+      return make_node(move(left), share(r->right));
+    }
+
+    // avl join; O(|height(l) - height(r)|)
+    static rope_ref join(rope_ref l, rope_ref r)
+    {
+      if (!l) return r;
+      if (!r) return l;
+      if (r->is_leaf() && r->size < leaf_size)
+      {
+        if (rope_ref merged = absorb_right(l, r)) return merged;
+      }
+      if (l->is_leaf() && l->size < leaf_size)
+      {
+        if (rope_ref merged = absorb_left(l, r)) return merged;
+      }
+      return join_nodes(move(l), move(r));
+    }
+
+    static rope_ref join_nodes(rope_ref l, rope_ref r)
+    {
+      if (l->height > r->height + 1)
+      {
+        return balance(share(l->left), join_nodes(share(l->right), move(r)));
+      }
+      if (r->height > l->height + 1)
+      {
+        return balance(join_nodes(move(l), share(r->left)), share(r->right));
+      }
+      return make_node(move(l), move(r));
+    }
+
+    // split n into the first pos chars and the rest; left and right
+    // must not alias n
+    static void split(const rope_ref& n, size_t pos, rope_ref& left, rope_ref& right)
+    {
+      if (!n || pos == 0)
+      {
+        left = rope_ref();
+        right = n;
+        return;
+      }
+      if (pos >= n->size)
+      {
+        left = n;
+        right = rope_ref();
+        return;
+      }
+      if (n->is_leaf())
+      {
+        left = make_leaf(n->chars(), pos);
+        right = make_leaf(n->chars() + pos, n->size - pos);
+        return;
+      }
+      rope_ref l = share(n->left);
+      rope_ref r = share(n->right);
+      if (pos < l->size)
+      {
+        rope_ref rest;
+        split(l, pos, left, rest);
+        right = join(move(rest), move(r));
+      }
+      else
+      {
+        rope_ref rest;
+        split(r, pos - l->size, rest, right);
+        left = join(move(l), move(rest));
+      }
+    }
+
+    template<typename F>
+    static void visit(const rope_node* n, F& f)
+    {
+      while (n)
+      {
+        if (n->is_leaf())
+        {
+          f(string_view(n->chars(), n->size));
+          return;
+        }
+        visit(n->left, f);
+        n = n->right;
+      }
+    }
+  public:
+    // default constructor
+    rope() noexcept = default;
+
+    // construct from any contiguous run of chars
+    rope(string_view sv) : root_(build(sv.data(), sv.size())) {}
+    rope(const char* str) : rope(string_view(str)) {}
+    rope(const string& str) : rope(string_view(str)) {}
+
+    // copies share the underlying tree
+    rope(const rope& other) = default;
+    rope& operator=(const rope& other) = default;
+    rope(rope&& other) noexcept = default;
+    rope& operator=(rope&& other) noexcept = default;
+
+    // capacity functions
+    bool empty() const noexcept { return !root_; }
+    size_t size() const noexcept { return size_of(root_); }
+    size_t length() const noexcept { return size_of(root_); }
+    size_t height() const noexcept { return height_of(root_); }
+
+    // element access; O(log n)
+    char operator[](size_t index) const noexcept
+    {
+      const rope_node* n = root_.get();
+      while (!n->is_leaf())
+      {
+        if (index < n->left->size)
+        {
+          n = n->left;
+        }
+        else
+        {
+          index -= n->left->size;
+          n = n->right;
+        }
+      }
+      return n->chars()[index];
+    }
+    char at(size_t index) const
+    {
+      if (index >= size()) throw std::out_of_range("index out of bounds");
+      return (*this)[index];
+    }
+
+    // modifiers
+    void clear() noexcept { root_ = rope_ref(); }
+
+    rope& append(const rope& other)
+    {
+      rope_ref tail = other.root_;
+      root_ = join(move(root_), move(tail));
+      return *this;
+    }
+    rope& append(string_view sv)
+    {
+      root_ = join(move(root_), build(sv.data(), sv.size()));
+      return *this;
+    }
+    rope& append(const char* str) { return append(string_view(str)); }
+    rope& append(const string& str) { return append(string_view(str)); }
+    rope& operator+=(const rope& other) { return append(other); }
+    rope& operator+=(string_view sv) { return append(sv); }
+    rope& operator+=(const char* str) { return append(string_view(str)); }
+    rope& operator+=(const string& str) { return append(string_view(str)); }
+    rope& operator+=(char c) { return append(string_view(&c, 1)); }
+
+    // insert other before position pos
+    rope& insert(size_t pos, const rope& other)
+    {
+      if (pos > size()) throw std::out_of_range("position out of bounds");
+      rope_ref left, right;
+      split(root_, pos, left, right);
+      root_ = join(join(move(left), other.root_), move(right));
+      return *this;
+    }
+    rope& insert(size_t pos, string_view sv) { return insert(pos, rope(sv)); }
+    rope& insert(size_t pos, const char* str) { return insert(pos, rope(str)); }
+    rope& insert(size_t pos, const string& str) { return insert(pos, rope(str)); }
+
+    // remove up to count chars starting at pos
+    rope& erase(size_t pos, size_t count = npos)
+    {
+      if (pos > size()) throw std::out_of_range("position out of bounds");
+      rope_ref left, rest, middle, right;
+      split(root_, pos, left, rest);
+      split(rest, min(count, size_of(rest)), middle, right);
+      root_ = join(move(left), move(right));
+      return *this;
+    }
+
+    // rope of at most count chars starting at pos, sharing leaves
+    rope substr(size_t pos = 0, size_t count = npos) const
+    {
+      if (pos > size()) throw std::out_of_range("position out of bounds");
+      rope_ref left, rest, middle, right;
+      split(root_, pos, left, rest);
+      split(rest, min(count, size_of(rest)), middle, right);
+      return rope(move(middle));
+    }
+
+    // call f with a string_view of every leaf in order
+    template<typename F>
+    void for_each_chunk(F f) const
+    {
+      visit(root_.get(), f);
+    }
+
+    // flatten into a string with a single allocation
+    string str() const
+    {
+      string result;
+      result.reserve(size());
+      for_each_chunk([&result](string_view sv) { result.append(sv); });
+      return result;
+    }
+
+    void swap(rope& other) noexcept { root_.swap(other.root_); }
+
+    // concatenation
+    friend rope operator+(rope lhs, const rope& rhs)
+    {
+      lhs.append(rhs);
+      return lhs;
+    }
+  };
+
+  // non-member function for output stream
+  inline std::ostream& operator<<(std::ostream& os, const rope& r)
+  {
+    r.for_each_chunk([&os](string_view sv) { os << sv; });
+    return os;
+  }
+}
+
+#endif
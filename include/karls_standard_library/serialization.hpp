@@ -0,0 +1,467 @@
+#ifndef KARLS_STANDARD_LIBRARY_SERIALIZATION_HPP
+#define KARLS_STANDARD_LIBRARY_SERIALIZATION_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+#include "array.hpp"
+#include "string.hpp"
+#include "string_view.hpp"
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace karls_standard_library {
+  // binary archive format
+  //
+  // a vector or array of trivially copyable elements is written as a
+  // block: a 16 byte header followed by the elements as one memcpy, the
+  // payload aligned for the element type. a string is a 64 bit length and
+  // its bytes. a container of anything else is a nested block: the header,
+  // a table of count + 1 offsets, then each element, so element i can be
+  // found without reading the ones before it. a Pair is its two members
+  // one after the other, and any other trivially copyable value is its
+  // aligned bytes.
+  //
+  // all alignment is relative to the start of the buffer, so a buffer that
+  // starts 16 byte aligned (any heap allocation or file mapping) can be
+  // read in place: view<T>() returns spans and string_views that point
+  // into it instead of copying.
+
+  // element type tag stored in block headers; specialise for records
+  // whose layout should be checked more strictly than by size
+  template<typename T>
+  struct serialization_tag {
+    static constexpr std::uint32_t value =
+      std::is_same_v<T, bool> ? 'b' :
+      std::is_same_v<T, char> ? 'c' :
+      std::is_floating_point_v<T> ? 'f' :
+      std::is_enum_v<T> ? 'e' :
+      std::is_signed_v<T> ? 'i' :
+      std::is_unsigned_v<T> ? 'u' : 'r';
+  };
+
+  namespace detail {
+    enum class block_kind : std::uint8_t {
+      contiguous = 1,
+      nested = 2
+    };
+
+    struct block_header {
+      std::uint32_t tag;
+      std::uint16_t element_size;
+      std::uint8_t endian;
+      block_kind kind;
+      std::uint64_t count;
+    };
+    static_assert(sizeof(block_header) == 16);
+
+    inline constexpr std::uint8_t native_endian = std::endian::native == std::endian::little ? 1 : 2;
+    inline constexpr size_t block_alignment = 16;
+
+    constexpr size_t align_up(size_t n, size_t alignment) noexcept
+    {
+      return (n + alignment - 1) & ~(alignment - 1);
+    }
+
+    [[noreturn]] inline void throw_format_error(const char* what)
+    {
+      throw std::runtime_error(what);
+    }
+  }
+
+  template<typename T, typename Enable = void>
+  struct serializer;
+
+  // appends values to a growing byte buffer
+  class binary_writer {
+  private:
+    vector<unsigned char> buffer_;
+  public:
+    binary_writer() = default;
+
+    size_t size() const noexcept { return buffer_.size(); }
+    const unsigned char* data() const noexcept { return buffer_.data(); }
+    const vector<unsigned char>& buffer() const noexcept { return buffer_; }
+    vector<unsigned char> take() noexcept { return karls_standard_library::move(buffer_); }
+
+    void write_bytes(const void* bytes, size_t count)
+    {
+      size_t at = buffer_.size();
+      buffer_.resize(at + count);
+      if (count) __builtin_memcpy(buffer_.data() + at, bytes, count);
+    }
+
+    // pad with zeros up to a multiple of alignment
+    void align(size_t alignment)
+    {
+      size_t target = detail::align_up(buffer_.size(), alignment);
+      if (target != buffer_.size()) buffer_.resize(target, 0);
+    }
+
+    // overwrite bytes written earlier, for offset tables
+    void patch(size_t position, const void* bytes, size_t count) noexcept
+    {
+      __builtin_memcpy(buffer_.data() + position, bytes, count);
+    }
+
+    template<typename T>
+    void write(const T& value) { serializer<T>::write(*this, value); }
+  };
+
+  // reads values from [data, data + size); all views point into that range
+  class binary_reader {
+  private:
+    const unsigned char* base_;
+    size_t end_;
+    size_t pos_;
+  public:
+    binary_reader(const void* data, size_t size) noexcept :
+      base_(static_cast<const unsigned char*>(data)), end_(size), pos_(0) {}
+
+    // the sub range [position, end) of the same buffer
+    binary_reader(const binary_reader& parent, size_t position, size_t end) noexcept :
+      base_(parent.base_), end_(end), pos_(position) {}
+
+    size_t position() const noexcept { return pos_; }
+    size_t remaining() const noexcept { return end_ - pos_; }
+    const unsigned char* base() const noexcept { return base_; }
+
+    // the next count bytes, throwing if the input is too short
+    const unsigned char* read_bytes(size_t count)
+    {
+      if (count > end_ - pos_) throw std::out_of_range("serialization: truncated input");
+      const unsigned char* p = base_ + pos_;
+      pos_ += count;
+      return p;
+    }
+
+    void align(size_t alignment)
+    {
+      size_t target = detail::align_up(pos_, alignment);
+      if (target > end_) throw std::out_of_range("serialization: truncated input");
+      pos_ = target;
+    }
+
+    // copy out a trivially copyable value
+    template<typename T>
+    T read_raw()
+    {
+      T value;
+      __builtin_memcpy(static_cast<void*>(&value), read_bytes(sizeof(T)), sizeof(T));
+      return value;
+    }
+
+    // read a block header and check it describes T elements
+    template<typename T>
+    detail::block_header read_header(detail::block_kind kind)
+    {
+      align(detail::block_alignment);
+      auto header = read_raw<detail::block_header>();
+      if (header.endian != detail::native_endian) detail::throw_format_error("serialization: endianness mismatch");
+      if (header.kind != kind) detail::throw_format_error("serialization: unexpected block kind");
+      if (kind == detail::block_kind::contiguous &&
+          (header.tag != serialization_tag<T>::value || header.element_size != sizeof(T)))
+      {
+        detail::throw_format_error("serialization: element type mismatch");
+      }
+      return header;
+    }
+
+    // owning copy of the next value
+    template<typename T>
+    T read() { return serializer<T>::read(*this); }
+
+    // zero copy view of the next value
+    template<typename T>
+    auto view() { return serializer<T>::view(*this); }
+  };
+
+  // view of a nested block; element i is decoded on access
+  template<typename T>
+  class sequence_view {
+  private:
+    binary_reader reader_;       // spans the element area
+    const unsigned char* offsets_;
+    size_t count_;
+
+    std::uint64_t offset(size_t i) const noexcept
+    {
+      std::uint64_t value;
+      __builtin_memcpy(&value, offsets_ + i * sizeof(value), sizeof(value));
+      return value;
+    }
+  public:
+    sequence_view() noexcept : reader_(nullptr, 0), offsets_(nullptr), count_(0) {}
+    sequence_view(const binary_reader& reader, const unsigned char* offsets, size_t count) noexcept :
+      reader_(reader), offsets_(offsets), count_(count) {}
+
+    size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+
+    // reader over the bytes of element i; offsets are clamped to the
+    // element area so a corrupt table reads as truncated input
+    binary_reader element(size_t i) const noexcept
+    {
+      std::uint64_t total = reader_.remaining();
+      std::uint64_t last = offset(i + 1) < total ? offset(i + 1) : total;
+      std::uint64_t first = offset(i) < last ? offset(i) : last;
+      return binary_reader(reader_, reader_.position() + first, reader_.position() + last);
+    }
+
+    auto operator[](size_t i) const
+    {
+      binary_reader in = element(i);
+      return serializer<T>::view(in);
+    }
+    auto at(size_t i) const
+    {
+      if (i >= count_) throw std::out_of_range("Index out of bounds");
+      return (*this)[i];
+    }
+  };
+
+  namespace detail {
+    template<typename T>
+    struct is_serial_container : std::false_type {};
+    template<typename T>
+    struct is_serial_container<vector<T>> : std::true_type {};
+    template<typename T, size_t N>
+    struct is_serial_container<array<T, N>> : std::true_type {};
+    template<typename T1, typename T2>
+    struct is_serial_container<Pair<T1, T2>> : std::true_type {};
+    template<>
+    struct is_serial_container<string> : std::true_type {};
+
+    // a value written as its raw bytes rather than by a container serializer
+    template<typename T>
+    inline constexpr bool is_plain_serializable_v = std::is_trivially_copyable_v<T> && !is_serial_container<T>::value;
+
+    template<typename T>
+    void write_contiguous(binary_writer& out, const T* items, size_t count)
+    {
+      static_assert(sizeof(T) < 65536, "element too large for a block header");
+      out.align(block_alignment);
+      block_header header{serialization_tag<T>::value, static_cast<std::uint16_t>(sizeof(T)), native_endian, block_kind::contiguous, count};
+      out.write_bytes(&header, sizeof(header));
+      out.align(alignof(T));
+      out.write_bytes(items, count * sizeof(T));
+    }
+
+    template<typename T>
+    std::span<const T> view_contiguous(binary_reader& in)
+    {
+      auto header = in.read_header<T>(block_kind::contiguous);
+      in.align(alignof(T));
+      if (header.count > in.remaining() / sizeof(T)) throw std::out_of_range("serialization: truncated input");
+      const unsigned char* p = in.read_bytes(header.count * sizeof(T));
+      if (reinterpret_cast<std::uintptr_t>(p) % alignof(T) != 0) throw_format_error("serialization: misaligned buffer");
+      return std::span<const T>(reinterpret_cast<const T*>(p), header.count);
+    }
+
+    template<typename T>
+    void write_nested(binary_writer& out, const T* items, size_t count)
+    {
+      out.align(block_alignment);
+      block_header header{0, 0, native_endian, block_kind::nested, count};
+      out.write_bytes(&header, sizeof(header));
+      size_t table = out.size();
+      vector<unsigned char> zeros((count + 1) * sizeof(std::uint64_t), 0);
+      out.write_bytes(zeros.data(), zeros.size());
+      // elements start block aligned so their own alignment survives
+      out.align(block_alignment);
+      size_t start = out.size();
+      for (size_t i = 0; i <= count; ++i)
+      {
+        std::uint64_t offset = out.size() - start;
+        out.patch(table + i * sizeof(offset), &offset, sizeof(offset));
+        if (i < count) out.write(items[i]);
+        if (i < count) out.align(block_alignment);
+      }
+    }
+
+    template<typename T>
+    sequence_view<T> view_nested(binary_reader& in, size_t expected = npos)
+    {
+      auto header = in.read_header<T>(block_kind::nested);
+      if (expected != npos && header.count != expected) throw_format_error("serialization: length mismatch");
+      if (header.count + 1 > in.remaining() / sizeof(std::uint64_t)) throw std::out_of_range("serialization: truncated input");
+      const unsigned char* offsets = in.read_bytes((header.count + 1) * sizeof(std::uint64_t));
+      in.align(block_alignment);
+      std::uint64_t total;
+      __builtin_memcpy(&total, offsets + header.count * sizeof(total), sizeof(total));
+      size_t start = in.position();
+      in.read_bytes(total);
+      return sequence_view<T>(binary_reader(in, start, start + total), offsets, header.count);
+    }
+  }
+
+  // trivially copyable values: aligned raw bytes
+  template<typename T>
+  struct serializer<T, std::enable_if_t<detail::is_plain_serializable_v<T>>> {
+    static void write(binary_writer& out, const T& value)
+    {
+      out.align(alignof(T));
+      out.write_bytes(&value, sizeof(T));
+    }
+    static T read(binary_reader& in)
+    {
+      in.align(alignof(T));
+      return in.read_raw<T>();
+    }
+    static T view(binary_reader& in) { return read(in); }
+  };
+
+  // strings: length and bytes
+  template<>
+  struct serializer<string> {
+    static void write(binary_writer& out, const string& value)
+    {
+      std::uint64_t length = value.size();
+      out.align(alignof(std::uint64_t));
+      out.write_bytes(&length, sizeof(length));
+      out.write_bytes(value.data(), value.size());
+    }
+    static string_view view(binary_reader& in)
+    {
+      in.align(alignof(std::uint64_t));
+      auto length = in.read_raw<std::uint64_t>();
+      if (length > in.remaining()) throw std::out_of_range("serialization: truncated input");
+      const char* chars = reinterpret_cast<const char*>(in.read_bytes(length));
+      return string_view(chars, length);
+    }
+    static string read(binary_reader& in)
+    {
+      string_view chars = view(in);
+      return string(chars.data(), chars.size());
+    }
+  };
+
+  // vectors: a contiguous block for trivially copyable elements, a nested
+  // block otherwise
+  template<typename T>
+  struct serializer<vector<T>> {
+    static void write(binary_writer& out, const vector<T>& value)
+    {
+      if constexpr (detail::is_plain_serializable_v<T>) detail::write_contiguous(out, value.data(), value.size());
+      else detail::write_nested(out, value.data(), value.size());
+    }
+    static auto view(binary_reader& in)
+    {
+      if constexpr (detail::is_plain_serializable_v<T>) return detail::view_contiguous<T>(in);
+      else return detail::view_nested<T>(in);
+    }
+    static vector<T> read(binary_reader& in)
+    {
+      vector<T> result;
+      if constexpr (detail::is_plain_serializable_v<T>)
+      {
+        std::span<const T> items = detail::view_contiguous<T>(in);
+        result.resize(items.size());
+        if (!items.empty()) __builtin_memcpy(static_cast<void*>(result.data()), items.data(), items.size_bytes());
+      }
+      else
+      {
+        sequence_view<T> items = detail::view_nested<T>(in);
+        result.reserve(items.size());
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+          binary_reader element = items.element(i);
+          result.emplace_back(serializer<T>::read(element));
+        }
+      }
+      return result;
+    }
+  };
+
+  // arrays: as vectors, with the length checked against N
+  template<typename T, size_t N>
+  struct serializer<array<T, N>> {
+    static void write(binary_writer& out, const array<T, N>& value)
+    {
+      if constexpr (detail::is_plain_serializable_v<T>) detail::write_contiguous(out, value.data(), N);
+      else detail::write_nested(out, value.data(), N);
+    }
+    static auto view(binary_reader& in)
+    {
+      if constexpr (detail::is_plain_serializable_v<T>)
+      {
+        std::span<const T> items = detail::view_contiguous<T>(in);
+        if (items.size() != N) detail::throw_format_error("serialization: length mismatch");
+        return items;
+      }
+      else
+      {
+        return detail::view_nested<T>(in, N);
+      }
+    }
+    static array<T, N> read(binary_reader& in)
+    {
+      array<T, N> result;
+      if constexpr (detail::is_plain_serializable_v<T>)
+      {
+        std::span<const T> items = view(in);
+        __builtin_memcpy(static_cast<void*>(result.data()), items.data(), items.size_bytes());
+      }
+      else
+      {
+        vector<T> items = serializer<vector<T>>::read(in);
+        if (items.size() != N) detail::throw_format_error("serialization: length mismatch");
+        for (size_t i = 0; i < N; ++i) result[i] = karls_standard_library::move(items[i]);
+      }
+      return result;
+    }
+  };
+
+  // pairs: first then second
+  template<typename T1, typename T2>
+  struct serializer<Pair<T1, T2>> {
+    static void write(binary_writer& out, const Pair<T1, T2>& value)
+    {
+      out.write(value.first);
+      out.write(value.second);
+    }
+    static auto view(binary_reader& in)
+    {
+      auto first = in.view<T1>();
+      auto second = in.view<T2>();
+      return Pair<decltype(first), decltype(second)>(first, second);
+    }
+    static Pair<T1, T2> read(binary_reader& in)
+    {
+      T1 first = in.read<T1>();
+      T2 second = in.read<T2>();
+      return Pair<T1, T2>(karls_standard_library::move(first), karls_standard_library::move(second));
+    }
+  };
+
+  // serialize value into a new buffer
+  template<typename T>
+  vector<unsigned char> serialize(const T& value)
+  {
+    binary_writer out;
+    out.write(value);
+    return out.take();
+  }
+
+  // owning copy of a T serialized at the start of [data, data + size)
+  template<typename T>
+  T deserialize(const void* data, size_t size)
+  {
+    binary_reader in(data, size);
+    return in.read<T>();
+  }
+
+  // view of a T serialized at the start of [data, data + size); it points
+  // into the buffer, which must outlive it
+  template<typename T>
+  auto deserialize_view(const void* data, size_t size)
+  {
+    binary_reader in(data, size);
+    return in.view<T>();
+  }
+}
+
+#endif
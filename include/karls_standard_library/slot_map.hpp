@@ -0,0 +1,179 @@
+#ifndef KARLS_STANDARD_LIBRARY_SLOT_MAP_HPP
+#define KARLS_STANDARD_LIBRARY_SLOT_MAP_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+#include <cstdint>
+#include <stdexcept>
+
+namespace karls_standard_library {
+  // generational handle to a slot_map element; a handle goes stale when
+  // its element is erased and never matches whatever reuses the slot
+  struct slot_handle {
+    static constexpr std::uint32_t null_index = static_cast<std::uint32_t>(-1);
+
+    std::uint32_t index = null_index;
+    std::uint32_t generation = 0;
+
+    constexpr bool is_null() const noexcept { return index == null_index; }
+    constexpr bool operator==(const slot_handle& other) const noexcept = default;
+  };
+
+  // container handing out stable handles to densely packed values
+  //
+  // values live contiguously in insertion order apart from erasures, which
+  // move the last value into the hole. a handle names a slot; the slot
+  // records where its value currently is and a generation that is odd
+  // while the slot is in use. insert, erase and lookup are O(1).
+  template<typename T>
+  class slot_map {
+  public:
+    using value_type = T;
+    using size_type = size_t;
+    using handle = slot_handle;
+    using iterator = T*;
+    using const_iterator = const T*;
+  private:
+    struct slot {
+      std::uint32_t target;     // dense index while in use, next free slot otherwise
+      std::uint32_t generation;
+    };
+
+    vector<slot> slots_;
+    vector<T> values_;
+    vector<std::uint32_t> owners_;   // slot of each dense value
+    std::uint32_t free_head_;
+
+    // take a free slot for the value just appended to values_
+    handle acquire()
+    {
+      std::uint32_t index;
+      if (free_head_ != handle::null_index)
+      {
+        index = free_head_;
+        free_head_ = slots_[index].target;
+      }
+      else
+      {
+        if (slots_.size() >= handle::null_index) throw std::length_error("slot_map is full");
+        index = static_cast<std::uint32_t>(slots_.size());
+        slots_.push_back(slot{0, 0});
+      }
+      slot& s = slots_[index];
+      s.target = static_cast<std::uint32_t>(values_.size() - 1);
+      ++s.generation;
+      return handle{index, s.generation};
+    }
+
+    void release(std::uint32_t index) noexcept
+    {
+      slot& s = slots_[index];
+      ++s.generation;
+      s.target = free_head_;
+      free_head_ = index;
+    }
+  public:
+    // default constructor
+    slot_map() : free_head_(handle::null_index) {}
+
+    // capacity functions
+    bool empty() const noexcept { return values_.empty(); }
+    size_t size() const noexcept { return values_.size(); }
+    size_t capacity() const noexcept { return values_.capacity(); }
+
+    void reserve(size_t new_cap)
+    {
+      slots_.reserve(new_cap);
+      values_.reserve(new_cap);
+      owners_.reserve(new_cap);
+    }
+
+    // modifiers
+    template<typename... Args>
+    handle emplace(Args&&... args)
+    {
+      values_.emplace_back(karls_standard_library::forward<Args>(args)...);
+      handle h;
+      try
+      {
+        owners_.reserve(values_.size());
+        h = acquire();
+      }
+      catch (...)
+      {
+        values_.pop_back();
+        throw;
+      }
+      owners_.push_back(h.index);
+      return h;
+    }
+    handle insert(const T& value) { return emplace(value); }
+    handle insert(T&& value) { return emplace(karls_standard_library::move(value)); }
+
+    // erase the element h refers to; false if h is stale
+    bool erase(handle h)
+    {
+      if (!contains(h)) return false;
+      std::uint32_t hole = slots_[h.index].target;
+      std::uint32_t last = static_cast<std::uint32_t>(values_.size() - 1);
+      if (hole != last)
+      {
+        values_[hole] = karls_standard_library::move(values_[last]);
+        owners_[hole] = owners_[last];
+        slots_[owners_[hole]].target = hole;
+      }
+      values_.pop_back();
+      owners_.pop_back();
+      release(h.index);
+      return true;
+    }
+
+    // erase every element; all outstanding handles go stale
+    void clear() noexcept
+    {
+      for (size_t i = 0; i < owners_.size(); ++i) release(owners_[i]);
+      values_.clear();
+      owners_.clear();
+    }
+
+    // lookup
+    bool contains(handle h) const noexcept
+    {
+      return h.index < slots_.size() && slots_[h.index].generation == h.generation && (h.generation & 1);
+    }
+    T* find(handle h) noexcept { return contains(h) ? &values_[slots_[h.index].target] : nullptr; }
+    const T* find(handle h) const noexcept { return contains(h) ? &values_[slots_[h.index].target] : nullptr; }
+    T& at(handle h)
+    {
+      if (!contains(h)) throw std::out_of_range("stale slot_map handle");
+      return values_[slots_[h.index].target];
+    }
+    const T& at(handle h) const
+    {
+      if (!contains(h)) throw std::out_of_range("stale slot_map handle");
+      return values_[slots_[h.index].target];
+    }
+
+    // unchecked lookup; h must be live
+    T& operator[](handle h) noexcept { return values_[slots_[h.index].target]; }
+    const T& operator[](handle h) const noexcept { return values_[slots_[h.index].target]; }
+
+    // handle of the value at position index of the dense array
+    handle handle_at(size_t index) const noexcept
+    {
+      std::uint32_t owner = owners_[index];
+      return handle{owner, slots_[owner].generation};
+    }
+
+    // dense iteration; order changes when elements are erased
+    T* data() noexcept { return values_.data(); }
+    const T* data() const noexcept { return values_.data(); }
+    iterator begin() noexcept { return values_.data(); }
+    iterator end() noexcept { return values_.data() + values_.size(); }
+    const_iterator begin() const noexcept { return values_.data(); }
+    const_iterator end() const noexcept { return values_.data() + values_.size(); }
+  };
+}
+
+#endif
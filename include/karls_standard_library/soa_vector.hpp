@@ -0,0 +1,401 @@
+#ifndef KARLS_STANDARD_LIBRARY_SOA_VECTOR_HPP
+#define KARLS_STANDARD_LIBRARY_SOA_VECTOR_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace karls_standard_library {
+  // generic row of a soa_vector: holds one value (or reference) per column
+  // and is tuple-like, so rows can be taken apart with structured bindings
+  template<typename... Ts>
+  struct soa_row {
+    std::tuple<Ts...> fields;
+
+    constexpr soa_row(Ts... values) : fields(karls_standard_library::forward<Ts>(values)...) {}
+
+    template<size_t I>
+    constexpr decltype(auto) get() noexcept { return std::get<I>(fields); }
+    template<size_t I>
+    constexpr decltype(auto) get() const noexcept { return std::get<I>(fields); }
+  };
+
+  template<size_t I, typename... Ts>
+  constexpr decltype(auto) get(soa_row<Ts...>& row) noexcept { return row.template get<I>(); }
+  template<size_t I, typename... Ts>
+  constexpr decltype(auto) get(const soa_row<Ts...>& row) noexcept { return row.template get<I>(); }
+  template<size_t I, typename... Ts>
+  constexpr decltype(auto) get(soa_row<Ts...>&& row) noexcept { return row.template get<I>(); }
+
+  // vector of records stored as one array per field (struct of arrays)
+  //
+  // all columns share one size and capacity and live in a single block,
+  // each starting on its own cache line, so a loop over one field streams
+  // only that field. growth and relocation follow vector: capacity
+  // doubles starting at 1, and elements are moved if that cannot throw
+  // and copied otherwise.
+  //
+  // Row names the fields for element access. v[i] returns
+  // Row<Fields&...>{column 0 [i], column 1 [i], ...}, so with
+  //
+  //   template<typename Id, typename Price>
+  //   struct trade { Id id; Price price; };
+  //   basic_soa_vector<trade, int, double> v;
+  //
+  // v[i].price is a double& into the price column.
+  template<template<typename...> class Row, typename... Fields>
+  class basic_soa_vector {
+  public:
+    static_assert(sizeof...(Fields) > 0, "a soa_vector needs at least one field");
+
+    using size_type = size_t;
+    using value_type = Row<Fields...>;
+    using reference = Row<Fields&...>;
+    using const_reference = Row<const Fields&...>;
+
+    template<size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    static constexpr size_t field_count = sizeof...(Fields);
+    static constexpr size_t column_alignment = cache_line_size;
+  private:
+    using indices = std::index_sequence_for<Fields...>;
+
+    void* block_;
+    void* columns_[field_count];
+    size_t size_;
+    size_t capacity_;
+
+    static constexpr size_t align_up(size_t n) noexcept
+    {
+      return (n + column_alignment - 1) & ~(column_alignment - 1);
+    }
+
+    static size_t block_bytes(size_t capacity) noexcept
+    {
+      return (align_up(capacity * sizeof(Fields)) + ...);
+    }
+
+    template<size_t I>
+    field_type<I>* column_ptr() const noexcept { return static_cast<field_type<I>*>(columns_[I]); }
+
+    // allocate a block for capacity rows and point columns at it
+    static void* allocate(size_t capacity, void** columns)
+    {
+      void* block = operator new(block_bytes(capacity), std::align_val_t(column_alignment));
+      char* p = static_cast<char*>(block);
+      size_t i = 0;
+      ((columns[i++] = p, p += align_up(capacity * sizeof(Fields))), ...);
+      return block;
+    }
+
+    static void deallocate(void* block) noexcept
+    {
+      if (block) operator delete(block, std::align_val_t(column_alignment));
+    }
+
+    template<size_t... I>
+    void destroy_range(size_t first, size_t last, std::index_sequence<I...>) noexcept
+    {
+      (std::destroy(column_ptr<I>() + first, column_ptr<I>() + last), ...);
+    }
+
+    // columns are moved on growth only if no column's move can throw;
+    // otherwise a throw in a later column would leave earlier ones moved from
+    static constexpr bool nothrow_relocate = (std::is_nothrow_move_constructible_v<Fields> && ...);
+
+    // move (or copy, see nothrow_relocate) every column into new_columns.
+    // the originals are left in place; if a copy throws, everything built
+    // in new_columns is destroyed and this vector is unchanged
+    template<size_t... I>
+    void relocate(void** new_columns, std::index_sequence<I...>)
+    {
+      size_t built_columns = 0;
+      size_t built = 0;
+      auto column = [&](auto index) {
+        constexpr size_t C = decltype(index)::value;
+        using T = field_type<C>;
+        T* from = column_ptr<C>();
+        T* to = static_cast<T*>(new_columns[C]);
+        for (built = 0; built < size_; ++built)
+        {
+          if constexpr (nothrow_relocate || !std::is_copy_constructible_v<T>)
+          {
+            std::construct_at(to + built, karls_standard_library::move(from[built]));
+          }
+          else
+          {
+            std::construct_at(to + built, from[built]);
+          }
+        }
+        ++built_columns;
+      };
+      try
+      {
+        (column(std::integral_constant<size_t, I>{}), ...);
+      }
+      catch (...)
+      {
+        auto undo = [&](auto index) {
+          constexpr size_t C = decltype(index)::value;
+          field_type<C>* to = static_cast<field_type<C>*>(new_columns[C]);
+          if (C < built_columns) std::destroy(to, to + size_);
+          else if (C == built_columns) std::destroy(to, to + built);
+        };
+        (undo(std::integral_constant<size_t, I>{}), ...);
+        throw;
+      }
+    }
+
+    void reallocate(size_t new_cap)
+    {
+      void* new_columns[field_count];
+      void* new_block = allocate(new_cap, new_columns);
+      try
+      {
+        relocate(new_columns, indices{});
+      }
+      catch (...)
+      {
+        deallocate(new_block);
+        throw;
+      }
+      if (block_) destroy_range(0, size_, indices{});
+      deallocate(block_);
+      block_ = new_block;
+      for (size_t i = 0; i < field_count; ++i) columns_[i] = new_columns[i];
+      capacity_ = new_cap;
+    }
+
+    void grow_if_full()
+    {
+      if (size_ == capacity_) reserve((capacity_ == 0) ? 1 : 2 * capacity_);
+    }
+
+    template<size_t... I>
+    reference row(size_t index, std::index_sequence<I...>) const noexcept
+    {
+      return reference{column_ptr<I>()[index]...};
+    }
+    template<size_t... I>
+    const_reference const_row(size_t index, std::index_sequence<I...>) const noexcept
+    {
+      return const_reference{column_ptr<I>()[index]...};
+    }
+
+    // build the fields of row index column by column; if one throws, the
+    // fields already built are destroyed before the exception leaves
+    template<size_t... I, typename... Args>
+    void construct_row(size_t index, std::index_sequence<I...>, Args&&... args)
+    {
+      size_t built = 0;
+      try
+      {
+        ((std::construct_at(column_ptr<I>() + index, karls_standard_library::forward<Args>(args)), ++built), ...);
+      }
+      catch (...)
+      {
+        ((I < built ? std::destroy_at(column_ptr<I>() + index) : void()), ...);
+        throw;
+      }
+    }
+
+    // copy every column of other; if a copy throws, the columns already
+    // copied are destroyed (uninitialized_copy cleans up its own column)
+    template<size_t... I>
+    void copy_from(const basic_soa_vector& other, std::index_sequence<I...>)
+    {
+      size_t built = 0;
+      try
+      {
+        ((std::uninitialized_copy(other.column_ptr<I>(), other.column_ptr<I>() + other.size_, column_ptr<I>()), ++built), ...);
+      }
+      catch (...)
+      {
+        ((I < built ? std::destroy(column_ptr<I>(), column_ptr<I>() + other.size_) : void()), ...);
+        throw;
+      }
+    }
+  public:
+    // default constructor
+    basic_soa_vector() noexcept : block_(nullptr), columns_(), size_(0), capacity_(0) {}
+
+    // destructor
+    ~basic_soa_vector()
+    {
+      clear();
+      deallocate(block_);
+    }
+
+    // copy constructor
+    basic_soa_vector(const basic_soa_vector& other) : basic_soa_vector()
+    {
+      if (other.size_ == 0) return;
+      block_ = allocate(other.size_, columns_);
+      capacity_ = other.size_;
+      copy_from(other, indices{});
+      size_ = other.size_;
+    }
+
+    // copy assignment operator
+    basic_soa_vector& operator=(const basic_soa_vector& other)
+    {
+      if (this != &other)
+      {
+        basic_soa_vector temp(other);
+        swap(temp);
+      }
+      return *this;
+    }
+
+    // move constructor
+    basic_soa_vector(basic_soa_vector&& other) noexcept : basic_soa_vector() { swap(other); }
+
+    // move assignment operator
+    basic_soa_vector& operator=(basic_soa_vector&& other) noexcept
+    {
+      if (this != &other)
+      {
+        basic_soa_vector temp(karls_standard_library::move(other));
+        swap(temp);
+      }
+      return *this;
+    }
+
+    // capacity functions
+    bool empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+
+    void reserve(size_t new_cap)
+    {
+      if (capacity_ >= new_cap) return;
+      reallocate(new_cap);
+    }
+
+    // remove unused capacity
+    void shrink_to_fit()
+    {
+      if (size_ == capacity_) return;
+      if (size_ == 0)
+      {
+        deallocate(block_);
+        block_ = nullptr;
+        for (size_t i = 0; i < field_count; ++i) columns_[i] = nullptr;
+        capacity_ = 0;
+        return;
+      }
+      reallocate(size_);
+    }
+
+    // row access through a proxy of references
+    reference operator[](size_t index) noexcept { return row(index, indices{}); }
+    const_reference operator[](size_t index) const noexcept { return const_row(index, indices{}); }
+    reference at(size_t index)
+    {
+      if (index >= size_) throw std::out_of_range("Index out of bounds");
+      return (*this)[index];
+    }
+    const_reference at(size_t index) const
+    {
+      if (index >= size_) throw std::out_of_range("Index out of bounds");
+      return (*this)[index];
+    }
+    reference front() noexcept { return (*this)[0]; }
+    reference back() noexcept { return (*this)[size_ - 1]; }
+
+    // single field access
+    template<size_t I>
+    field_type<I>& get(size_t index) noexcept { return column_ptr<I>()[index]; }
+    template<size_t I>
+    const field_type<I>& get(size_t index) const noexcept { return column_ptr<I>()[index]; }
+
+    // whole columns; each starts on a cache line boundary
+    template<size_t I>
+    field_type<I>* data() noexcept { return column_ptr<I>(); }
+    template<size_t I>
+    const field_type<I>* data() const noexcept { return column_ptr<I>(); }
+    template<size_t I>
+    std::span<field_type<I>> column() noexcept { return {column_ptr<I>(), size_}; }
+    template<size_t I>
+    std::span<const field_type<I>> column() const noexcept { return {column_ptr<I>(), size_}; }
+
+    // modifiers
+    // append a row built from one argument per field
+    template<typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+      static_assert(sizeof...(Args) == field_count, "one argument per field");
+      grow_if_full();
+      construct_row(size_, indices{}, karls_standard_library::forward<Args>(args)...);
+      return (*this)[size_++];
+    }
+    void push_back(const Fields&... values) { emplace_back(values...); }
+
+    void pop_back() noexcept
+    {
+      if (size_ > 0)
+      {
+        destroy_range(size_ - 1, size_, indices{});
+        --size_;
+      }
+    }
+
+    // remove all rows; capacity remains unchanged
+    void clear() noexcept
+    {
+      if (block_) destroy_range(0, size_, indices{});
+      size_ = 0;
+    }
+
+    // shrink, or grow with value initialized rows
+    void resize(size_t count)
+    {
+      if (count < size_)
+      {
+        destroy_range(count, size_, indices{});
+        size_ = count;
+        return;
+      }
+      reserve(count);
+      for (; size_ < count; ++size_) construct_row(size_, indices{}, Fields{}...);
+    }
+
+    void swap(basic_soa_vector& other) noexcept
+    {
+      karls_standard_library::swap(block_, other.block_);
+      karls_standard_library::swap(columns_, other.columns_);
+      karls_standard_library::swap(size_, other.size_);
+      karls_standard_library::swap(capacity_, other.capacity_);
+    }
+
+    // call f(row) for every row
+    template<typename F>
+    void for_each(F f)
+    {
+      for (size_t i = 0; i < size_; ++i) f((*this)[i]);
+    }
+  };
+
+  // soa_vector with tuple-like rows: v[i].get<0>(), auto [a, b] = v[i]
+  template<typename... Fields>
+  using soa_vector = basic_soa_vector<soa_row, Fields...>;
+}
+
+// tuple protocol for soa_row so structured bindings work
+template<typename... Ts>
+struct std::tuple_size<karls_standard_library::soa_row<Ts...>>
+  : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template<std::size_t I, typename... Ts>
+struct std::tuple_element<I, karls_standard_library::soa_row<Ts...>> {
+  using type = std::tuple_element_t<I, std::tuple<Ts...>>;
+};
+
+#endif
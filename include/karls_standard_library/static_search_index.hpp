@@ -0,0 +1,274 @@
+#ifndef KARLS_STANDARD_LIBRARY_STATIC_SEARCH_INDEX_HPP
+#define KARLS_STANDARD_LIBRARY_STATIC_SEARCH_INDEX_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace karls_standard_library {
+  namespace detail {
+    // number of keys in a node that are less than x, or with Inclusive
+    // not greater than x
+    template<bool Inclusive, typename T, size_t N>
+    inline size_t node_rank(const T* node, T x) noexcept
+    {
+#if defined(__AVX2__)
+      if constexpr (sizeof(T) * N == 64 && (sizeof(T) == 4 || sizeof(T) == 8))
+      {
+        // two 32 byte halves of one aligned node; greater[i] is key > x
+        // for the inclusive count and x > key otherwise
+        unsigned mask;
+        if constexpr (std::is_same_v<T, float>)
+        {
+          __m256 key = _mm256_set1_ps(x);
+          __m256 lo = _mm256_load_ps(node);
+          __m256 hi = _mm256_load_ps(node + 8);
+          constexpr int op = Inclusive ? _CMP_GT_OQ : _CMP_LT_OQ;
+          mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(lo, key, op)))
+               | static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(hi, key, op))) << 8;
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+          __m256d key = _mm256_set1_pd(x);
+          __m256d lo = _mm256_load_pd(node);
+          __m256d hi = _mm256_load_pd(node + 4);
+          constexpr int op = Inclusive ? _CMP_GT_OQ : _CMP_LT_OQ;
+          mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(lo, key, op)))
+               | static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(hi, key, op))) << 4;
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+          // avx2 only compares signed integers; unsigned keys are moved
+          // into signed order by flipping the top bit
+          const __m256i bias = _mm256_set1_epi32(std::is_signed_v<T> ? 0 : std::numeric_limits<int32_t>::min());
+          __m256i key = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int32_t>(x)), bias);
+          __m256i lo = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(node)), bias);
+          __m256i hi = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(node + 8)), bias);
+          __m256i lo_cmp = Inclusive ? _mm256_cmpgt_epi32(lo, key) : _mm256_cmpgt_epi32(key, lo);
+          __m256i hi_cmp = Inclusive ? _mm256_cmpgt_epi32(hi, key) : _mm256_cmpgt_epi32(key, hi);
+          mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(lo_cmp)))
+               | static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hi_cmp))) << 8;
+        }
+        else
+        {
+          const __m256i bias = _mm256_set1_epi64x(std::is_signed_v<T> ? 0 : std::numeric_limits<int64_t>::min());
+          __m256i key = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<int64_t>(x)), bias);
+          __m256i lo = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(node)), bias);
+          __m256i hi = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(node + 4)), bias);
+          __m256i lo_cmp = Inclusive ? _mm256_cmpgt_epi64(lo, key) : _mm256_cmpgt_epi64(key, lo);
+          __m256i hi_cmp = Inclusive ? _mm256_cmpgt_epi64(hi, key) : _mm256_cmpgt_epi64(key, hi);
+          mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(lo_cmp)))
+               | static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(hi_cmp))) << 4;
+        }
+        size_t count = static_cast<size_t>(std::popcount(mask));
+        return Inclusive ? N - count : count;
+      }
+#endif
+      size_t rank = 0;
+      for (size_t j = 0; j < N; ++j)
+      {
+        if constexpr (Inclusive) rank += !(x < node[j]);
+        else rank += (node[j] < x);
+      }
+      return rank;
+    }
+  }
+
+  // read only index over a sorted array, answering lower_bound and
+  // upper_bound queries with a few cache line loads
+  //
+  // the keys are laid out as a static b+ tree (an s+ tree): the leaves hold
+  // the sorted keys in order, node_size per cache line, and each level
+  // above holds, for every group of node_size + 1 nodes below, the first
+  // key of all but the first. a search ranks the query inside one node per
+  // level, comparing the whole node at once, so a lookup in n keys touches
+  // about log(n) / log(node_size + 1) cache lines instead of log2(n), and
+  // the loads do not depend on comparison branches
+  template<typename T>
+    requires std::is_arithmetic_v<T>
+  class static_search_index {
+  public:
+    using value_type = T;
+    using size_type = size_t;
+
+    // keys per node, filling one cache line
+    static constexpr size_t node_size = 64 / sizeof(T);
+  private:
+    static constexpr size_t fanout = node_size + 1;
+    static constexpr size_t max_levels = 32;
+    static constexpr size_t node_alignment = 64;
+
+    T* keys_ = nullptr;
+    size_t size_ = 0;
+    size_t total_ = 0;
+    size_t levels_ = 0;
+    // start of each level in keys_, leaves first
+    size_t offsets_[max_levels] = {};
+
+    // fills the keys past the end, and the separators of missing subtrees
+    static constexpr T padding() noexcept
+    {
+      if constexpr (std::numeric_limits<T>::has_infinity) return std::numeric_limits<T>::infinity();
+      else return std::numeric_limits<T>::max();
+    }
+
+    static T* allocate(size_t count)
+    {
+      return static_cast<T*>(operator new(count * sizeof(T), std::align_val_t(node_alignment)));
+    }
+
+    void dealloc() noexcept
+    {
+      if (keys_) operator delete(keys_, std::align_val_t(node_alignment));
+      keys_ = nullptr;
+    }
+
+    void build(const T* sorted, size_t n)
+    {
+      size_ = n;
+      if (n == 0) return;
+
+      size_t nodes[max_levels];
+      size_t count = (n + node_size - 1) / node_size;
+      do
+      {
+        nodes[levels_++] = count;
+        count = (count + fanout - 1) / fanout;
+      } while (nodes[levels_ - 1] > 1);
+
+      offsets_[0] = 0;
+      for (size_t h = 1; h < levels_; ++h) offsets_[h] = offsets_[h - 1] + nodes[h - 1] * node_size;
+      total_ = offsets_[levels_ - 1] + nodes[levels_ - 1] * node_size;
+      keys_ = allocate(total_);
+
+      std::memcpy(keys_, sorted, n * sizeof(T));
+      for (size_t i = n; i < nodes[0] * node_size; ++i) keys_[i] = padding();
+
+      // a node at level h - 1 spans stride leaf keys
+      size_t stride = node_size;
+      for (size_t h = 1; h < levels_; ++h)
+      {
+        T* level = keys_ + offsets_[h];
+        for (size_t node = 0; node < nodes[h]; ++node)
+        {
+          for (size_t j = 0; j < node_size; ++j)
+          {
+            size_t first = (node * fanout + j + 1) * stride;
+            level[node * node_size + j] = first < n ? sorted[first] : padding();
+          }
+        }
+        stride *= fanout;
+      }
+    }
+
+    // number of keys less than x, or with Inclusive not greater than x
+    template<bool Inclusive>
+    size_t rank(T x) const noexcept
+    {
+      size_t k = 0;
+      for (size_t h = levels_ - 1; h > 0; --h)
+      {
+        k = k * fanout + detail::node_rank<Inclusive, T, node_size>(keys_ + offsets_[h] + k * node_size, x);
+      }
+      size_t i = k * node_size + detail::node_rank<Inclusive, T, node_size>(keys_ + k * node_size, x);
+      return i < size_ ? i : size_;
+    }
+  public:
+    static_search_index() = default;
+
+    // index over n keys sorted in ascending order
+    static_search_index(const T* sorted, size_t n) { build(sorted, n); }
+    explicit static_search_index(const vector<T>& sorted) { build(sorted.data(), sorted.size()); }
+
+    ~static_search_index() { dealloc(); }
+
+    static_search_index(const static_search_index& other) :
+      size_(other.size_), total_(other.total_), levels_(other.levels_)
+    {
+      if (other.keys_)
+      {
+        keys_ = allocate(total_);
+        std::memcpy(keys_, other.keys_, total_ * sizeof(T));
+      }
+      for (size_t h = 0; h < max_levels; ++h) offsets_[h] = other.offsets_[h];
+    }
+
+    static_search_index& operator=(const static_search_index& other)
+    {
+      if (this != &other)
+      {
+        static_search_index temp(other);
+        swap(temp);
+      }
+      return *this;
+    }
+
+    static_search_index(static_search_index&& other) noexcept
+    {
+      swap(other);
+    }
+
+    static_search_index& operator=(static_search_index&& other) noexcept
+    {
+      if (this != &other)
+      {
+        static_search_index temp(karls_standard_library::move(other));
+        swap(temp);
+      }
+      return *this;
+    }
+
+    void swap(static_search_index& other) noexcept
+    {
+      karls_standard_library::swap(keys_, other.keys_);
+      karls_standard_library::swap(size_, other.size_);
+      karls_standard_library::swap(total_, other.total_);
+      karls_standard_library::swap(levels_, other.levels_);
+      for (size_t h = 0; h < max_levels; ++h) karls_standard_library::swap(offsets_[h], other.offsets_[h]);
+    }
+
+    // number of indexed keys
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    // bytes of key storage, including the inner levels and padding
+    size_t memory_usage() const noexcept { return total_ * sizeof(T); }
+
+    // the i-th smallest key
+    const T& operator[](size_t i) const noexcept { return keys_[i]; }
+
+    // position of the first key not less than x
+    size_t lower_bound(T x) const noexcept
+    {
+      if (size_ == 0) return 0;
+      return rank<false>(x);
+    }
+
+    // position of the first key greater than x
+    size_t upper_bound(T x) const noexcept
+    {
+      // nothing is greater than the padding, which the inclusive search
+      // would follow into missing subtrees
+      if (size_ == 0 || !(x < padding())) return size_;
+      return rank<true>(x);
+    }
+
+    // true if x is one of the keys
+    bool contains(T x) const noexcept
+    {
+      size_t i = lower_bound(x);
+      return i < size_ && keys_[i] == x;
+    }
+  };
+}
+
+#endif
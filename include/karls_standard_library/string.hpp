@@ -6,79 +6,101 @@
 #include "utility.hpp"
 #include "memory.hpp"
 #include "algorithm.hpp"
+#include "functional.hpp"
+#include "vector.hpp"
+#include "iterator.hpp"
+#include "string_view.hpp"
+#include "charconv.hpp"
 #include <stdexcept>
 #include <iostream>
+#include <streambuf>
+#include <locale>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 
 namespace karls_standard_library {
-  // custom iterator for string class
-  template<typename string>
-  class string_iterator {
-  public:
-    using value_type = char;
-    using pointer = value_type*;
-    using reference = value_type&;
-  private:
-    pointer ptr_;
-  public:
-    string_iterator(pointer ptr) : ptr_(ptr) {}
-
-    // increment operators
-    string_iterator& operator++() 
-    {
-      ptr_++;
-      return *this;
-    }
-    string_iterator operator++(int)
+  namespace detail {
+    // char copy / compare usable in constant evaluation; at run time they
+    // go straight to the compiler's memcpy / memcmp
+    constexpr void copy_chars(char* dest, const char* src, size_t count) noexcept
     {
-      string_iterator temp = *this;
-      ++(*this);
-      return temp;
+      if (std::is_constant_evaluated())
+      {
+        for (size_t i = 0; i < count; ++i) dest[i] = src[i];
+      }
+      else if (count > 0)
+      {
+        __builtin_memcpy(dest, src, count);
+      }
     }
-
-    // decrement operators
-    string_iterator& operator--() 
+    constexpr void fill_chars(char* dest, char c, size_t count) noexcept
     {
-      ptr_--;
-      return *this;
+      if (std::is_constant_evaluated())
+      {
+        for (size_t i = 0; i < count; ++i) dest[i] = c;
+      }
+      else if (count > 0)
+      {
+        __builtin_memset(dest, c, count);
+      }
     }
-    string_iterator operator--(int) 
+    constexpr bool equal_chars(const char* lhs, const char* rhs, size_t count) noexcept
     {
-      string_iterator temp = *this;
-      --(*this);
-      return temp;
+      if (std::is_constant_evaluated())
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          if (lhs[i] != rhs[i]) return false;
+        }
+        return true;
+      }
+      return count == 0 || __builtin_memcmp(lhs, rhs, count) == 0;
     }
+  }
 
-    reference operator[](size_t index) { return *(ptr_ + index); }
-    pointer operator->() { return ptr_; }
-    reference operator*() { return *ptr_; }
-    bool operator==(const string_iterator& other) const { return ptr_ == other.ptr_; }
-    bool operator!=(const string_iterator& other) const { return !(*this == other); }
-  };
+  // kept for code naming the old iterator type
+  template<typename string>
+  using string_iterator = pointer_iterator<char, string>;
 
+  // storage comes from std::allocator so strings can be built, compared
+  // and thrown away during constant evaluation
   class string { 
   public:
     using value_type = char;
     using size_type = size_t;
     using reference = char&;
     using const_reference = const value_type&;
-    using iterator = string_iterator<string>;
-    using const_iterator = const string_iterator<string>;
+    using iterator = pointer_iterator<char, string>;
+    using const_iterator = pointer_iterator<const char, string>;
+    using reverse_iterator = karls_standard_library::reverse_iterator<iterator>;
+    using const_reverse_iterator = karls_standard_library::reverse_iterator<const_iterator>;
   private:
     char* data_;
     size_t size_;
     size_t capacity_;
 
-    // delete char ptr and set capacity to 0
-    void dealloc() 
+    static constexpr char* allocate(size_t count)
     {
-      delete[] data_;
+      return std::allocator<char>{}.allocate(count);
+    }
+
+    constexpr void deallocate() noexcept
+    {
+      if (data_) std::allocator<char>{}.deallocate(data_, capacity_);
+    }
+
+    // free the buffer and set capacity to 0
+    constexpr void dealloc() 
+    {
+      deallocate();
       data_ = nullptr;
       capacity_ = 0;
     }
     
     // templated helper swap function
     template<typename T>
-    void swap(T& a, T& b)
+    constexpr void swap(T& a, T& b)
     {
       T temp = move(a);
       a = move(b);
@@ -86,73 +108,71 @@ namespace karls_standard_library {
     }
   public:
     // default constructor
-    string() : data_(nullptr), size_(0), capacity_(0) {}
+    constexpr string() : data_(nullptr), size_(0), capacity_(0) {}
     
     // destructor
-    ~string() 
+    constexpr ~string() 
     {
-      delete[] data_;
+      deallocate();
     }
 
     // cstring constructor
-    string(const char* str)
-      : data_(nullptr), size_(strlen(str)), capacity_(strlen(str) + 1)
+    constexpr string(const char* str)
+      : data_(nullptr), size_(strlen(str)), capacity_(0)
     {
       if (size_ > 0)
       {
-        data_ = new char[capacity_];
-        memcpy(data_, str, size_);
+        capacity_ = size_ + 1;
+        data_ = allocate(capacity_);
+        detail::copy_chars(data_, str, size_);
       }
     }
     // cstring fill constructor
-    string(const char* str, size_t count) :
+    constexpr string(const char* str, size_t count) :
       data_(nullptr), size_(count), capacity_(count)
       {
         if (count > 0 && str != nullptr)
         {
-          data_ = new char[capacity_];
-          memcpy(data_, str, size_);
+          data_ = allocate(capacity_);
+          detail::copy_chars(data_, str, size_);
         }
       }
     
     // fill constructor
-    string(size_t count, char c = char{}) :
+    constexpr string(size_t count, char c = char{}) :
       data_(nullptr), size_(count), capacity_(count)
       {
         if (size_ > 0) 
         {
-          data_ = new char[capacity_];
-          for (size_t i = 0; i < size_; ++i)
-          {
-            data_[i] = c;
-          }
+          data_ = allocate(capacity_);
+          detail::fill_chars(data_, c, size_);
         }
       }
     
     // initializer list constructor
-    string(std::initializer_list<char> init) : 
+    constexpr string(std::initializer_list<char> init) : 
       data_(nullptr), size_(init.size()), capacity_(init.size())
       {
         if (size_ > 0) 
         {
-          data_ = new char[capacity_];
-          std::uninitialized_copy(init.begin(), init.end(), data_);
+          data_ = allocate(capacity_);
+          detail::copy_chars(data_, init.begin(), size_);
         }
       }
 
     // copy constructor
-    string(const string& other) :
+    constexpr string(const string& other) :
       data_(nullptr), size_(other.size_), capacity_(other.capacity_)
       {
-        if (size_ > 0) 
+        if (capacity_ > 0) 
         {
-          data_ = new char[capacity_];
-          memcpy(data_, other.data_, size_);
+          data_ = allocate(capacity_);
+          detail::copy_chars(data_, other.data_, size_);
         }
       }
 
     // copy assignment operator
-    string& operator=(const string& other) 
+    constexpr string& operator=(const string& other) 
     {
       if (this != &other) 
       {
@@ -163,13 +183,13 @@ namespace karls_standard_library {
     }
 
     // move constructor
-    string(string&& other) :
+    constexpr string(string&& other) :
       data_(exchange(other.data_, nullptr)),
       size_(exchange(other.size_, 0)),
       capacity_(exchange(other.capacity_, 0)) {}
 
     // move assignment operator
-    string& operator=(string&& other) 
+    constexpr string& operator=(string&& other) 
     {
       if (this != &other) 
       { 
@@ -182,76 +202,83 @@ namespace karls_standard_library {
     }
 
     // element access functions
-    char& at(size_t index) 
+    constexpr char& at(size_t index) 
     {
       if (index >= size_) throw std::out_of_range("index out of bounds");
       return data_[index];
     }
-    const char& at(size_t index) const 
+    constexpr const char& at(size_t index) const 
     { 
       if (index >= size_) throw std::out_of_range("index out of bounds");
       return data_[index];
     }
-    char& operator[](size_t index) noexcept { return data_[index]; }
-    const char& operator[](size_t index) const noexcept { return data_[index]; }
-    char& front() noexcept { return data_[0]; }
-    const char& front() const noexcept { return data_[0]; }
-    char& back() noexcept { return data_[size_ - 1]; }
-    const char& back() const noexcept { return data_[size_ - 1]; }
-    char* data() noexcept { return data_; }
-    const char* data() const noexcept { return data_; }
+    constexpr char& operator[](size_t index) noexcept { return data_[index]; }
+    constexpr const char& operator[](size_t index) const noexcept { return data_[index]; }
+    constexpr char& front() noexcept { return data_[0]; }
+    constexpr const char& front() const noexcept { return data_[0]; }
+    constexpr char& back() noexcept { return data_[size_ - 1]; }
+    constexpr const char& back() const noexcept { return data_[size_ - 1]; }
+    constexpr char* data() noexcept { return data_; }
+    constexpr const char* data() const noexcept { return data_; }
+
+    // non-owning view of the contents
+    constexpr operator string_view() const noexcept { return string_view(data_, size_); }
     
     // iterator functions
-    iterator begin() { return data_; }
-    const_iterator begin() const { return data_; }
-    const_iterator cbegin() const { return data_; }
-    iterator end() { return data_ + size_; }
-    const_iterator end() const { return data_ + size_; }
-    const_iterator cend() { return data_ + size_; }
+    constexpr iterator begin() { return data_; }
+    constexpr const_iterator begin() const { return data_; }
+    constexpr const_iterator cbegin() const { return data_; }
+    constexpr iterator end() { return data_ + size_; }
+    constexpr const_iterator end() const { return data_ + size_; }
+    constexpr const_iterator cend() const { return data_ + size_; }
+    constexpr reverse_iterator rbegin() { return reverse_iterator(end()); }
+    constexpr const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    constexpr const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+    constexpr reverse_iterator rend() { return reverse_iterator(begin()); }
+    constexpr const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    constexpr const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
 
     // capacity functions
     constexpr bool empty() const noexcept { return size_ == 0; }
-    size_t size() const noexcept { return size_; }
-    size_t length() const noexcept { return size_; }
-    size_t capacity() const noexcept { return capacity_; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr size_t length() const noexcept { return size_; }
+    constexpr size_t capacity() const noexcept { return capacity_; }
 
     // reserve new capacity
-    void reserve(size_t new_cap) 
+    constexpr void reserve(size_t new_cap) 
     {
       if (capacity_ >= new_cap) return;
-      char* new_data = new char[new_cap];
-      for (size_t i = 0; i < size_; ++i) 
-      {
-        new_data[i] = data_[i];
-      }
-      delete[] data_;
+      char* new_data = allocate(new_cap);
+      detail::copy_chars(new_data, data_, size_);
+      deallocate();
       data_ = new_data;
       capacity_ = new_cap;
     }
 
     // decrease capacity to size
-    void shrink_to_fit() noexcept 
+    constexpr void shrink_to_fit() noexcept 
     {
       if (size_ == capacity_) return;
-      else if (size_ == 0) dealloc();
-      char* new_data = new char[size_];
-      for (size_t i = 0; i < size_; ++i) 
+      else if (size_ == 0)
       {
-        new_data[i] = data_[i];
+        dealloc();
+        return;
       }
-      delete[] data_;
+      char* new_data = allocate(size_);
+      detail::copy_chars(new_data, data_, size_);
+      deallocate();
       data_ = new_data;
       capacity_ = size_;
     }
 
     // modifiers
-    void clear() noexcept 
+    constexpr void clear() noexcept 
     {
       size_ = 0;
     }
 
     // append a single char to end of string
-    void push_back(char& c) 
+    constexpr void push_back(char& c) 
     {
       if (size_ == capacity_) 
       {
@@ -261,7 +288,7 @@ namespace karls_standard_library {
       data_[size_++] = c;
     }
     // pop last char from string
-    void pop_back() 
+    constexpr void pop_back() 
     {
       if (size_ > 0) 
       {
@@ -269,8 +296,8 @@ namespace karls_standard_library {
       }
     }
 
-    // append single char to end of string
-    string& append(size_t count, char c) 
+    // append count copies of c to end of string
+    constexpr string& append(size_t count, char c) 
     {
       size_t new_size = size_ + count;
       if (new_size > capacity_) 
@@ -278,15 +305,12 @@ namespace karls_standard_library {
         size_t new_cap = max(new_size, 2 * capacity_);
         reserve(new_cap);
       }
-      for (size_t i = 0; i < new_size; ++i) 
-      {
-        data_[i] = c;
-      }
+      detail::fill_chars(data_ + size_, c, count);
       size_ = new_size;
       return *this;
     }
     // append count chars from str to end of string object
-    string& append(const char* str, size_t count) 
+    constexpr string& append(const char* str, size_t count) 
     {
       size_t new_size = size_ + count;
       if (new_size > capacity_) 
@@ -294,65 +318,50 @@ namespace karls_standard_library {
         size_t new_cap = max(new_size, 2 * capacity_);
         reserve(new_cap);
       }
-      memcpy(data_ + size_, str, count);
+      detail::copy_chars(data_ + size_, str, count);
       size_ = new_size;
       return *this;
     }
     // append chars in str to end of string
-    string& append(const char* str) 
+    constexpr string& append(const char* str) 
     {
-      size_t new_size = size_ + strlen(str);
-      if (new_size > capacity_) 
-      {
-        size_t new_cap = max(new_size, 2 * capacity_);
-        reserve(new_cap);
-      }
-      memcpy(data_ + size_, str, strlen(str));
-      size_ = new_size;
-      return *this;
+      return append(str, strlen(str));
     }
     // append other string to end of string
-    string& append(const string& str) 
+    constexpr string& append(const string& str) 
     {
-      size_t new_size = size_ + str.size_;
-      if (new_size > capacity_) 
-      {
-        size_t new_cap = max(new_size, 2 * capacity_);
-        reserve(new_cap);
-      }
-      memcpy(data_ + size_, str.data_, str.size_);
-      size_ = new_size;
-      return *this;
+      return append(str.data_, str.size_);
+    }
+    // append chars viewed by sv to end of string
+    constexpr string& append(string_view sv)
+    {
+      return append(sv.data(), sv.size());
     }
     // append initializer list of chars to end of string
-    string& append(std::initializer_list<char> list) 
+    constexpr string& append(std::initializer_list<char> list) 
     {
-      size_t new_size = size_ + list.size();
-      if (new_size > capacity_) 
-      {
-        size_t new_cap = max(new_size, 2 * capacity_);
-        reserve(new_cap);
-      }
-      std::uninitialized_copy(list.begin(), list.end(), data_ + size_);
-      size_ = new_size;
+      return append(list.begin(), list.size());
+    }
+    // append the decimal text of a number, formatted in place by to_chars;
+    // floating point values get the shortest text that reads back exactly
+    template<typename T>
+      requires (detail::is_charconv_integer_v<T> || detail::is_charconv_float_v<T>)
+    string& append_number(T value)
+    {
+      size_t old_size = size_;
+      resize_and_overwrite(size_ + max_chars<T>, [old_size, value](char* p, size_t count) {
+        return static_cast<size_t>(to_chars(p + old_size, p + count, value).ptr - p);
+      });
       return *this;
     }
 
     // append another string object to end of string
-    string& operator+=(const string& str) 
+    constexpr string& operator+=(const string& str) 
     {
-      size_t new_size = size_ + str.size_;
-      if (new_size > capacity_)
-      {
-        size_t new_cap = max(2 * capacity_, new_size);
-        reserve(new_cap);
-      }
-      memcpy(data_ + size_, str.data_, str.size_);
-      size_ = new_size;
-      return *this;
+      return append(str.data_, str.size_);
     }
     // append char to end of string
-    string& operator+=(char c) 
+    constexpr string& operator+=(char c) 
     {
       if (size_ == capacity_) 
       {
@@ -363,75 +372,50 @@ namespace karls_standard_library {
       return *this;
     }
     // append all chars of const char pointer to string
-    string& operator+=(const char* str) 
+    constexpr string& operator+=(const char* str) 
     {
-      size_t new_size = size_ + strlen(str);
-      if (new_size > capacity_)
-      {
-        size_t new_cap = max(2 * capacity_, new_size);
-        reserve(new_cap);
-      }
-      memcpy(data_ + size_, str, strlen(str));
-      size_ = new_size;
-      return *this;
+      return append(str, strlen(str));
+    }
+    // append chars viewed by sv to end of string
+    constexpr string& operator+=(string_view sv)
+    {
+      return append(sv.data(), sv.size());
     }
     // append init list to end of string
-    string& operator+=(std::initializer_list<char> list) 
+    constexpr string& operator+=(std::initializer_list<char> list) 
     {
-      size_t new_size = size_ + list.size();
-      if (new_size > capacity_)
+      return append(list.begin(), list.size());
+    }
+
+    // replace every occurrence of a with b; inspired by python str replace
+    constexpr string& replace(const char* a, const char* b)
+    {
+      size_t n = strlen(a);
+      size_t m = strlen(b);
+      if (n == 0 || size_ < n) return *this;
+
+      string result;
+      result.reserve(size_);
+      for (size_t i = 0; i < size_;)
       {
-        size_t new_cap = max(2 * capacity_, new_size);
-        reserve(new_cap); 
+        if (i + n <= size_ && detail::equal_chars(data_ + i, a, n))
+        {
+          result.append(b, m);
+          i += n;
+        }
+        else
+        {
+          result += data_[i++];
+        }
       }
-      std::uninitialized_copy(list.begin(), list.end(), data_ + size_);
+      swap(result);
       return *this;
     }
 
-		// replace function inspired by python str replace
-		string& replace(const char* a, const char* b)
-		{
-			size_t n = strlen(a);
-			size_t m = strlen(b);
-			
-			size_t new_cap = capacity_;
-			size_t new_size;
-
-			if(m > n)
-			{
-				new_cap = (size_ / n + 1) * m;
-				reserve(new_cap);
-			}
-
-			char* new_data = new char[capacity_];
-			
-			for(size_t i{}; i < size_; ++i)
-			{
-				if(i <= size_ - n && substr(i, n) == a)
-				{
-					for(size_t j{}; j < m; ++j)
-					{
-						new_data[new_size++] = b[j]; 
-					}
-					i += n;
-				}
-				else
-				{
-					new_data[new_size++] = data_[i];
-					++i;
-				}
-			}
-			
-			delete[] data_;
-			data_ = new_data;
-			size_ = new_size;
-			return *this;
-		}
-
     // delegate resize function without speicifed value to other with default constructor
-    void resize(size_t count) { resize(count, char{}); }
+    constexpr void resize(size_t count) { resize(count, char{}); }
     // resize the string to count size; appends c to end if count > size
-    void resize(size_t count, char c) 
+    constexpr void resize(size_t count, char c) 
     {
       if (size_ == count) return;
       else if (size_ > count) 
@@ -440,17 +424,24 @@ namespace karls_standard_library {
       }
       else
       {
-        char* new_data = new char[count];
-        memcpy(new_data, data_, size_);
-        std::uninitialized_fill(new_data + size_, new_data + count, c);
-        delete[] data_;
-        data_ = new_data;
+        reserve(count);
+        detail::fill_chars(data_ + size_, c, count - size_);
         size_ = count;
       }
     }
     
+    // let op write the contents directly: op(data(), count) may overwrite
+    // any of the first count chars and returns the new size, at most count.
+    // growth is geometric, so repeated appends through it stay amortised O(1)
+    template<typename Op>
+    constexpr void resize_and_overwrite(size_t count, Op op)
+    {
+      if (count > capacity_) reserve(max(count, 2 * capacity_));
+      size_ = static_cast<size_t>(op(data_, count));
+    }
+
     // swap contents with other string
-    void swap(string& other)
+    constexpr void swap(string& other)
     {
       swap(data_, other.data_);
       swap(size_, other.size_);
@@ -458,7 +449,7 @@ namespace karls_standard_library {
     }
 
     // substring method
-    string substr(size_t pos = 0, size_t count = npos) const {
+    constexpr string substr(size_t pos = 0, size_t count = npos) const {
       if (size_ == 0) return string();
       else if (pos >= size_) throw std::out_of_range("position out of bounds");
       else if (count == 0) return string();
@@ -471,13 +462,13 @@ namespace karls_standard_library {
     constexpr bool operator==(const string& other) const noexcept
     {
       if (size_ != other.size_) return false;
-      return memcmp(data_, other.data_, size_) == 0;
+      return detail::equal_chars(data_, other.data_, size_);
     }
-    auto operator<=>(const string& other) const noexcept
+    constexpr auto operator<=>(const string& other) const noexcept
     {
       return lexicographical_compare_three_way(
         data_, data_ + size_,
-        other.data_, other.data_ + size_
+        other.data_, other.data_ + other.size_
       );
     }
 
@@ -486,59 +477,167 @@ namespace karls_standard_library {
     friend std::istream& operator>>(std::istream& is, string& str);
   };
 
-  // non-member function for output stream
+  // non-member function for output stream; writes the whole buffer at once
   inline std::ostream& operator<<(std::ostream& os, const string& str) 
   {
     if (str.data_ && str.size_ > 0) 
     {
-      for (size_t i = 0; i < str.size_; ++i) 
-      {
-        os << str.data_[i];
-      }
+      os.write(str.data_, static_cast<std::streamsize>(str.size_));
     }
     return os;
   }
+
+  // hash of the contents; equal to hash<string_view> of the same text
+  template<>
+  struct hash<string> {
+    using is_avalanching = void;
+    size_t operator()(const string& str) const noexcept
+    {
+      return hash_bytes(str.data(), str.size());
+    }
+  };
+
+  namespace detail {
+    // grants access to the get area of a streambuf so input can be copied
+    // out in chunks instead of one sbumpc() call per character
+    struct streambuf_access : std::streambuf {
+      static char* get_first(std::streambuf* buf)
+      {
+        return (buf->*&streambuf_access::gptr)();
+      }
+      static char* get_last(std::streambuf* buf)
+      {
+        return (buf->*&streambuf_access::egptr)();
+      }
+      static void advance(std::streambuf* buf, size_t n)
+      {
+        (buf->*&streambuf_access::gbump)(static_cast<int>(n));
+      }
+    };
+  }
+
   // non-member function for input stream
+  // reads a whitespace delimited token straight into the string's buffer
   inline std::istream& operator>>(std::istream& is, string& str) 
   {
-    char buffer[1000];
-    is >> buffer;
-    delete[] str.data_;
-    str.capacity_ = strlen(buffer);
-    str.size_ = str.capacity_;
-    if (str.size_ > 0) 
+    std::istream::sentry sentry(is);
+    if (!sentry) return is;
+
+    str.clear();
+    const std::ctype<char>& ct = std::use_facet<std::ctype<char>>(is.getloc());
+    std::streambuf* buf = is.rdbuf();
+    size_t limit = is.width() > 0 ? static_cast<size_t>(is.width()) : npos;
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    bool done = false;
+
+    while (!done && str.size_ < limit)
     {
-      str.data_ = new char[str.capacity_];
-      memcpy(str.data_, buffer, str.size_);
+      char* first = detail::streambuf_access::get_first(buf);
+      char* last = detail::streambuf_access::get_last(buf);
+      if (first == last)
+      {
+        // empty get area; let the streambuf refill or read a single char
+        int c = buf->sgetc();
+        if (c == std::char_traits<char>::eof())
+        {
+          state |= std::ios_base::eofbit;
+          break;
+        }
+        if (first != detail::streambuf_access::get_first(buf)) continue;
+        char ch = std::char_traits<char>::to_char_type(c);
+        if (ct.is(std::ctype_base::space, ch)) break;
+        str += ch;
+        buf->sbumpc();
+        continue;
+      }
+
+      if (static_cast<size_t>(last - first) > limit - str.size_)
+      {
+        last = first + (limit - str.size_);
+      }
+      const char* stop = ct.scan_is(std::ctype_base::space, first, last);
+      done = stop != last;
+      str.append(first, static_cast<size_t>(stop - first));
+      detail::streambuf_access::advance(buf, static_cast<size_t>(stop - first));
     }
-    else 
+
+    is.width(0);
+    if (str.size_ == 0) state |= std::ios_base::failbit;
+    if (state) is.setstate(state);
+    return is;
+  }
+
+  // read characters into str until delim is found; str keeps its capacity
+  // between calls so a line reading loop stops allocating once warmed up
+  inline std::istream& getline(std::istream& is, string& str, char delim = '\n')
+  {
+    std::istream::sentry sentry(is, true);
+    if (!sentry) return is;
+
+    str.clear();
+    std::streambuf* buf = is.rdbuf();
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    size_t extracted = 0;
+
+    while (true)
     {
-      str.data_ = nullptr;
+      char* first = detail::streambuf_access::get_first(buf);
+      char* last = detail::streambuf_access::get_last(buf);
+      if (first == last)
+      {
+        int c = buf->sgetc();
+        if (c == std::char_traits<char>::eof())
+        {
+          state |= std::ios_base::eofbit;
+          break;
+        }
+        if (first != detail::streambuf_access::get_first(buf)) continue;
+        buf->sbumpc();
+        ++extracted;
+        char ch = std::char_traits<char>::to_char_type(c);
+        if (ch == delim) break;
+        str += ch;
+        continue;
+      }
+
+      const char* stop = static_cast<const char*>(
+        std::memchr(first, delim, static_cast<size_t>(last - first))
+      );
+      if (stop == nullptr)
+      {
+        str.append(first, static_cast<size_t>(last - first));
+        extracted += static_cast<size_t>(last - first);
+        detail::streambuf_access::advance(buf, static_cast<size_t>(last - first));
+        continue;
+      }
+      str.append(first, static_cast<size_t>(stop - first));
+      extracted += static_cast<size_t>(stop - first) + 1;
+      detail::streambuf_access::advance(buf, static_cast<size_t>(stop - first) + 1);
+      break;
     }
+
+    if (extracted == 0) state |= std::ios_base::failbit;
+    if (state) is.setstate(state);
     return is;
   }
-	
-	// string split function to partition string by delimeter
-	// inspired from python
-	vector<string> split(std::string& s, char delim = ' ')
-	{
-		vector<string> result;
-		while(1)
-		{
-			pos = s.find(s.begin(), s.end(), delim);
-			if(pos == string::npos)
-			{
-				result.push_back(s);
-				break;
-			}
-			else
-			{
-				result.push_back(s.substr(0, end));
-				s = s.substr(end + 1);
-			}
-		}
-		return result;
-	}
+
+  // string split function to partition string by delimeter
+  // inspired from python
+  inline vector<string> split(const string& s, char delim = ' ')
+  {
+    vector<string> result;
+    size_t start = 0;
+    for (size_t i = 0; i < s.size(); ++i)
+    {
+      if (s[i] == delim)
+      {
+        result.push_back(string(s.data() + start, i - start));
+        start = i + 1;
+      }
+    }
+    result.push_back(string(s.data() + start, s.size() - start));
+    return result;
+  }
 }
 
 #endif
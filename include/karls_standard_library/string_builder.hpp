@@ -0,0 +1,191 @@
+#ifndef KARLS_STANDARD_LIBRARY_STRING_BUILDER_HPP
+#define KARLS_STANDARD_LIBRARY_STRING_BUILDER_HPP
+
+#include "cstddef.hpp"
+#include "cstring.hpp"
+#include "utility.hpp"
+#include "algorithm.hpp"
+#include "string_view.hpp"
+#include "string.hpp"
+#include <new>
+
+namespace karls_standard_library {
+  // collects appended pieces in a chain of chunks; nothing already written
+  // is ever moved, and str() produces the result with a single allocation
+  class string_builder {
+  private:
+    // chunk header, the chars follow it in the same allocation
+    struct chunk {
+      chunk* next;
+      size_t size;
+      size_t capacity;
+
+      char* chars() noexcept { return reinterpret_cast<char*>(this + 1); }
+      const char* chars() const noexcept { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    static constexpr size_t min_chunk_size = 256;
+    static constexpr size_t max_chunk_size = 1 << 20;
+
+    chunk* head_;
+    chunk* tail_;
+    size_t size_;
+
+    static chunk* make_chunk(size_t capacity)
+    {
+      void* mem = operator new(sizeof(chunk) + capacity);
+      return new(mem) chunk{nullptr, 0, capacity};
+    }
+
+    // append a new chunk able to hold at least n more chars
+    void grow(size_t n)
+    {
+      size_t cap = (tail_ == nullptr) ? min_chunk_size : min(2 * tail_->capacity, max_chunk_size);
+      chunk* c = make_chunk(max(cap, n));
+      if (tail_) tail_->next = c;
+      else head_ = c;
+      tail_ = c;
+    }
+
+    void dealloc() noexcept
+    {
+      while (head_)
+      {
+        chunk* next = head_->next;
+        operator delete(head_);
+        head_ = next;
+      }
+      tail_ = nullptr;
+      size_ = 0;
+    }
+  public:
+    // default constructor
+    string_builder() noexcept : head_(nullptr), tail_(nullptr), size_(0) {}
+
+    // reserve room for an expected total size up front
+    explicit string_builder(size_t expected) : string_builder()
+    {
+      if (expected > 0)
+      {
+        head_ = tail_ = make_chunk(expected);
+      }
+    }
+
+    // destructor
+    ~string_builder() { dealloc(); }
+
+    // builders own their chunks and are move only
+    string_builder(const string_builder& other) = delete;
+    string_builder& operator=(const string_builder& other) = delete;
+
+    // move constructor
+    string_builder(string_builder&& other) noexcept :
+      head_(exchange(other.head_, nullptr)),
+      tail_(exchange(other.tail_, nullptr)),
+      size_(exchange(other.size_, 0)) {}
+
+    // move assignment operator
+    string_builder& operator=(string_builder&& other) noexcept
+    {
+      if (this != &other)
+      {
+        dealloc();
+        head_ = exchange(other.head_, nullptr);
+        tail_ = exchange(other.tail_, nullptr);
+        size_ = exchange(other.size_, 0);
+      }
+      return *this;
+    }
+
+    // capacity functions
+    bool empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+
+    // append count chars from str; a piece larger than the free space
+    // fills the current chunk and spills the rest into one new chunk
+    string_builder& append(const char* str, size_t count)
+    {
+      size_ += count;
+      if (tail_ != nullptr)
+      {
+        size_t n = min(count, tail_->capacity - tail_->size);
+        memcpy(tail_->chars() + tail_->size, str, n);
+        tail_->size += n;
+        str += n;
+        count -= n;
+      }
+      if (count > 0)
+      {
+        grow(count);
+        memcpy(tail_->chars(), str, count);
+        tail_->size = count;
+      }
+      return *this;
+    }
+    string_builder& append(string_view sv) { return append(sv.data(), sv.size()); }
+    string_builder& append(const char* str) { return append(str, strlen(str)); }
+    string_builder& append(const string& str) { return append(str.data(), str.size()); }
+    string_builder& append(size_t count, char c)
+    {
+      size_ += count;
+      while (count > 0)
+      {
+        if (tail_ == nullptr || tail_->size == tail_->capacity) grow(count);
+        size_t n = min(count, tail_->capacity - tail_->size);
+        memset(tail_->chars() + tail_->size, c, n);
+        tail_->size += n;
+        count -= n;
+      }
+      return *this;
+    }
+
+    string_builder& operator+=(string_view sv) { return append(sv); }
+    string_builder& operator+=(const char* str) { return append(str); }
+    string_builder& operator+=(const string& str) { return append(str); }
+    string_builder& operator+=(char c)
+    {
+      if (tail_ == nullptr || tail_->size == tail_->capacity) grow(1);
+      tail_->chars()[tail_->size++] = c;
+      ++size_;
+      return *this;
+    }
+
+    // call f with a string_view of every chunk in order
+    template<typename F>
+    void for_each_chunk(F f) const
+    {
+      for (const chunk* c = head_; c != nullptr; c = c->next)
+      {
+        if (c->size > 0) f(string_view(c->chars(), c->size));
+      }
+    }
+
+    // copy the contents into a string sized exactly once
+    string str() const
+    {
+      string result;
+      result.reserve(size_);
+      for_each_chunk([&result](string_view sv) { result.append(sv); });
+      return result;
+    }
+
+    // drop the contents but keep the first chunk for reuse
+    void clear() noexcept
+    {
+      if (head_ == nullptr) return;
+      chunk* rest = head_->next;
+      while (rest)
+      {
+        chunk* next = rest->next;
+        operator delete(rest);
+        rest = next;
+      }
+      head_->next = nullptr;
+      head_->size = 0;
+      tail_ = head_;
+      size_ = 0;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef KARLS_STANDARD_LIBRARY_STRING_VIEW_HPP
+#define KARLS_STANDARD_LIBRARY_STRING_VIEW_HPP
+
+#include "cstddef.hpp"
+#include "cstring.hpp"
+#include "algorithm.hpp"
+#include "functional.hpp"
+#include <stdexcept>
+#include <ostream>
+
+namespace karls_standard_library {
+  // non-owning view over a contiguous run of chars
+  class string_view {
+  public:
+    using value_type = char;
+    using size_type = size_t;
+    using const_reference = const char&;
+    using const_pointer = const char*;
+    using iterator = const char*;
+    using const_iterator = const char*;
+  private:
+    const char* data_;
+    size_t size_;
+  public:
+    // default constructor
+    constexpr string_view() noexcept : data_(nullptr), size_(0) {}
+
+    // cstring constructor
+    constexpr string_view(const char* str) : data_(str), size_(strlen(str)) {}
+
+    // pointer and length constructor
+    constexpr string_view(const char* str, size_t count) noexcept
+      : data_(str), size_(count) {}
+
+    // element access
+    constexpr const char& operator[](size_t index) const noexcept { return data_[index]; }
+    constexpr const char& at(size_t index) const
+    {
+      if (index >= size_) throw std::out_of_range("index out of bounds");
+      return data_[index];
+    }
+    constexpr const char& front() const noexcept { return data_[0]; }
+    constexpr const char& back() const noexcept { return data_[size_ - 1]; }
+    constexpr const char* data() const noexcept { return data_; }
+
+    // iterator functions
+    constexpr const_iterator begin() const noexcept { return data_; }
+    constexpr const_iterator cbegin() const noexcept { return data_; }
+    constexpr const_iterator end() const noexcept { return data_ + size_; }
+    constexpr const_iterator cend() const noexcept { return data_ + size_; }
+
+    // capacity functions
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr size_t length() const noexcept { return size_; }
+
+    // modifiers
+    constexpr void remove_prefix(size_t n) noexcept
+    {
+      data_ += n;
+      size_ -= n;
+    }
+    constexpr void remove_suffix(size_t n) noexcept { size_ -= n; }
+
+    // view of at most count chars starting at pos
+    constexpr string_view substr(size_t pos = 0, size_t count = npos) const
+    {
+      if (pos > size_) throw std::out_of_range("position out of bounds");
+      size_t remaining = size_ - pos;
+      return string_view(data_ + pos, (count > remaining) ? remaining : count);
+    }
+
+    // equality / comparison
+    constexpr bool operator==(const string_view& other) const noexcept
+    {
+      if (size_ != other.size_) return false;
+      for (size_t i = 0; i < size_; ++i)
+      {
+        if (data_[i] != other.data_[i]) return false;
+      }
+      return true;
+    }
+    constexpr auto operator<=>(const string_view& other) const noexcept
+    {
+      return lexicographical_compare_three_way(
+        data_, data_ + size_,
+        other.data_, other.data_ + other.size_
+      );
+    }
+  };
+
+  // hash of the viewed chars; equal to hash<string> of the same text
+  template<>
+  struct hash<string_view> {
+    using is_avalanching = void;
+    size_t operator()(string_view sv) const noexcept
+    {
+      return hash_bytes(sv.data(), sv.size());
+    }
+  };
+
+  // non-member function for output stream
+  inline std::ostream& operator<<(std::ostream& os, string_view sv)
+  {
+    if (!sv.empty()) os.write(sv.data(), static_cast<std::streamsize>(sv.size()));
+    return os;
+  }
+}
+
+#endif
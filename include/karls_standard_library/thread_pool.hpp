@@ -0,0 +1,619 @@
+#ifndef KARLS_STANDARD_LIBRARY_THREAD_POOL_HPP
+#define KARLS_STANDARD_LIBRARY_THREAD_POOL_HPP
+
+#include "cstddef.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+#include "ring_buffer.hpp"
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace karls_standard_library {
+  class thread_pool;
+
+  namespace detail {
+    // unit of work queued in a pool; next links the injection queue
+    struct pool_task {
+      pool_task* next = nullptr;
+
+      virtual void run() = 0;
+      virtual ~pool_task() = default;
+    };
+
+    template<typename F>
+    struct callable_task final : pool_task {
+      F f;
+
+      explicit callable_task(F&& fn) : f(move(fn)) {}
+      void run() override { f(); }
+    };
+
+    template<typename F>
+    pool_task* make_task(F&& f)
+    {
+      return new callable_task<std::decay_t<F>>(std::decay_t<F>(forward<F>(f)));
+    }
+
+    // chase-lev work stealing deque of task pointers
+    //
+    // the owning worker pushes and pops at the bottom without locking;
+    // thieves take from the top with a single cas. the circular buffer
+    // doubles when full and old buffers are kept until the deque dies
+    // because a thief may still be reading one.
+    class work_stealing_deque {
+    private:
+      struct buffer {
+        std::int64_t capacity;
+        buffer* retired;
+
+        std::atomic<pool_task*>* slots() noexcept
+        {
+          return reinterpret_cast<std::atomic<pool_task*>*>(this + 1);
+        }
+        std::atomic<pool_task*>& at(std::int64_t i) noexcept
+        {
+          return slots()[i & (capacity - 1)];
+        }
+      };
+
+      static constexpr std::int64_t initial_capacity = 64;
+
+      alignas(cache_line_size) std::atomic<std::int64_t> top_;
+      alignas(cache_line_size) std::atomic<std::int64_t> bottom_;
+      std::atomic<buffer*> buffer_;
+
+      static buffer* make_buffer(std::int64_t capacity, buffer* retired)
+      {
+        void* mem = operator new(sizeof(buffer) + capacity * sizeof(std::atomic<pool_task*>));
+        buffer* b = new(mem) buffer{capacity, retired};
+        for (std::int64_t i = 0; i < capacity; ++i)
+        {
+          new(&b->slots()[i]) std::atomic<pool_task*>(nullptr);
+        }
+        return b;
+      }
+
+      buffer* grow(buffer* old, std::int64_t top, std::int64_t bottom)
+      {
+        buffer* b = make_buffer(2 * old->capacity, old);
+        for (std::int64_t i = top; i < bottom; ++i)
+        {
+          b->at(i).store(old->at(i).load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        buffer_.store(b, std::memory_order_release);
+        return b;
+      }
+    public:
+      work_stealing_deque() : top_(0), bottom_(0), buffer_(make_buffer(initial_capacity, nullptr)) {}
+
+      ~work_stealing_deque()
+      {
+        buffer* b = buffer_.load(std::memory_order_relaxed);
+        while (b)
+        {
+          buffer* next = b->retired;
+          operator delete(b);
+          b = next;
+        }
+      }
+
+      work_stealing_deque(const work_stealing_deque& other) = delete;
+      work_stealing_deque& operator=(const work_stealing_deque& other) = delete;
+
+      // owner only
+      void push(pool_task* task)
+      {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        buffer* a = buffer_.load(std::memory_order_relaxed);
+        if (b - t >= a->capacity) a = grow(a, t, b);
+        a->at(b).store(task, std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_release);
+      }
+
+      // owner only; newest task first
+      pool_task* pop()
+      {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        buffer* a = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_seq_cst);
+        if (t > b)
+        {
+          bottom_.store(b + 1, std::memory_order_relaxed);
+          return nullptr;
+        }
+        pool_task* task = a->at(b).load(std::memory_order_relaxed);
+        if (t == b)
+        {
+          // last task: race the thieves for it
+          if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+          {
+            task = nullptr;
+          }
+          bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+      }
+
+      // any thread; oldest task first, nullptr when empty or on a lost race
+      pool_task* steal()
+      {
+        std::int64_t t = top_.load(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_seq_cst);
+        if (t >= b) return nullptr;
+        buffer* a = buffer_.load(std::memory_order_acquire);
+        pool_task* task = a->at(t).load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+          return nullptr;
+        }
+        return task;
+      }
+
+      bool empty() const noexcept
+      {
+        return bottom_.load(std::memory_order_seq_cst) <= top_.load(std::memory_order_seq_cst);
+      }
+    };
+
+    // pool and index of the worker running on this thread, if any
+    struct worker_context {
+      thread_pool* pool = nullptr;
+      size_t index = 0;
+    };
+    inline thread_local worker_context current_worker;
+
+    // run one queued task of the pool owning this thread; false when the
+    // caller is not a worker or found nothing to do
+    inline bool help_current_pool();
+
+    // result slot shared by a submitted task and its future
+    template<typename T>
+    struct future_state {
+      using stored_type = std::conditional_t<std::is_void_v<T>, char, T>;
+
+      std::atomic<int> refs{2};
+      std::atomic<bool> ready{false};
+      std::optional<stored_type> value;
+      std::exception_ptr error;
+
+      void release() noexcept
+      {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+      }
+
+      void finish() noexcept
+      {
+        ready.store(true, std::memory_order_release);
+        ready.notify_all();
+        release();
+      }
+
+      // block until ready; workers keep running pool tasks meanwhile so a
+      // task waiting on another task cannot starve the pool
+      void wait() noexcept
+      {
+        while (!ready.load(std::memory_order_acquire))
+        {
+          if (current_worker.pool == nullptr) ready.wait(false, std::memory_order_acquire);
+          else if (!help_current_pool()) std::this_thread::yield();
+        }
+      }
+    };
+  }
+
+  // handle to the result of thread_pool::submit
+  template<typename T>
+  class future {
+  private:
+    detail::future_state<T>* state_;
+
+    friend class thread_pool;
+    explicit future(detail::future_state<T>* state) noexcept : state_(state) {}
+  public:
+    // default constructor
+    future() noexcept : state_(nullptr) {}
+
+    // destructor; dropping a future does not cancel its task
+    ~future()
+    {
+      if (state_) state_->release();
+    }
+
+    // move only
+    future(future&& other) noexcept : state_(other.state_) { other.state_ = nullptr; }
+    future& operator=(future&& other) noexcept
+    {
+      if (this != &other)
+      {
+        if (state_) state_->release();
+        state_ = other.state_;
+        other.state_ = nullptr;
+      }
+      return *this;
+    }
+    future(const future& other) = delete;
+    future& operator=(const future& other) = delete;
+
+    bool valid() const noexcept { return state_ != nullptr; }
+    bool ready() const noexcept { return state_->ready.load(std::memory_order_acquire); }
+    void wait() const noexcept { state_->wait(); }
+
+    // wait for the task and return its result, rethrowing what it threw;
+    // the future is empty afterwards
+    T get()
+    {
+      detail::future_state<T>* state = state_;
+      state_ = nullptr;
+      state->wait();
+      if (state->error)
+      {
+        std::exception_ptr error = state->error;
+        state->release();
+        std::rethrow_exception(error);
+      }
+      if constexpr (std::is_void_v<T>)
+      {
+        state->release();
+      }
+      else
+      {
+        T result = move(*state->value);
+        state->release();
+        return result;
+      }
+    }
+  };
+
+  // how workers are placed on cpus
+  enum class thread_affinity {
+    none,  // let the os schedule workers
+    pin    // pin worker i to cpu i modulo the number of cpus
+  };
+
+  // work stealing thread pool
+  //
+  // every worker owns a chase-lev deque. tasks spawned by a worker go to
+  // the bottom of its own deque and are run newest first, which keeps
+  // recursive splitting cache friendly; idle workers steal the oldest,
+  // usually biggest, tasks from the top of other deques. tasks from
+  // outside the pool enter through a shared injection queue. workers with
+  // nothing to do spin briefly and then sleep on an event counter.
+  class thread_pool {
+  private:
+    struct alignas(cache_line_size) worker {
+      detail::work_stealing_deque deque;
+      std::thread thread;
+    };
+
+    static constexpr int spin_limit = 64;
+
+    vector<worker*> workers_;
+    std::mutex injection_mutex_;
+    detail::pool_task* injection_head_;
+    detail::pool_task* injection_tail_;
+    std::atomic<size_t> injected_;
+    alignas(cache_line_size) std::atomic<std::uint32_t> events_;
+    std::atomic<std::uint32_t> sleepers_;
+    std::atomic<bool> stopping_;
+
+    friend bool detail::help_current_pool();
+
+    static void pin_to_cpu(size_t index)
+    {
+#if defined(__linux__)
+      unsigned cpus = std::thread::hardware_concurrency();
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(index % (cpus ? cpus : 1), &set);
+      pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+      (void)index;
+#endif
+    }
+
+    void inject(detail::pool_task* task)
+    {
+      std::lock_guard<std::mutex> lock(injection_mutex_);
+      if (injection_tail_) injection_tail_->next = task;
+      else injection_head_ = task;
+      injection_tail_ = task;
+      injected_.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    detail::pool_task* take_injected()
+    {
+      if (injected_.load(std::memory_order_seq_cst) == 0) return nullptr;
+      std::lock_guard<std::mutex> lock(injection_mutex_);
+      detail::pool_task* task = injection_head_;
+      if (task == nullptr) return nullptr;
+      injection_head_ = task->next;
+      if (injection_head_ == nullptr) injection_tail_ = nullptr;
+      injected_.fetch_sub(1, std::memory_order_relaxed);
+      return task;
+    }
+
+    void wake_one()
+    {
+      events_.fetch_add(1, std::memory_order_seq_cst);
+      if (sleepers_.load(std::memory_order_seq_cst) != 0) events_.notify_one();
+    }
+
+    // queue a task: on the caller's own deque when it is one of our
+    // workers, through the injection queue otherwise
+    void schedule(detail::pool_task* task)
+    {
+      if (detail::current_worker.pool == this)
+      {
+        workers_[detail::current_worker.index]->deque.push(task);
+      }
+      else
+      {
+        inject(task);
+      }
+      wake_one();
+    }
+
+    // next task for worker self: own deque, injection queue, then steal
+    detail::pool_task* find_task(size_t self)
+    {
+      if (detail::pool_task* task = workers_[self]->deque.pop()) return task;
+      if (detail::pool_task* task = take_injected()) return task;
+      size_t n = workers_.size();
+      for (size_t i = 1; i < n; ++i)
+      {
+        if (detail::pool_task* task = workers_[(self + i) % n]->deque.steal()) return task;
+      }
+      return nullptr;
+    }
+
+    bool has_work() const
+    {
+      if (injected_.load(std::memory_order_seq_cst) != 0) return true;
+      for (size_t i = 0; i < workers_.size(); ++i)
+      {
+        if (!workers_[i]->deque.empty()) return true;
+      }
+      return false;
+    }
+
+    static void execute(detail::pool_task* task)
+    {
+      task->run();
+      delete task;
+    }
+
+    void worker_loop(size_t self, thread_affinity affinity)
+    {
+      if (affinity == thread_affinity::pin) pin_to_cpu(self);
+      detail::current_worker = {this, self};
+      for (int idle = 0;;)
+      {
+        if (detail::pool_task* task = find_task(self))
+        {
+          execute(task);
+          idle = 0;
+          continue;
+        }
+        if (++idle < spin_limit)
+        {
+          detail::cpu_relax();
+          if (idle % 8 == 0) std::this_thread::yield();
+          continue;
+        }
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        std::uint32_t seen = events_.load(std::memory_order_seq_cst);
+        bool stop = stopping_.load(std::memory_order_seq_cst);
+        if (!has_work())
+        {
+          if (stop)
+          {
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            break;
+          }
+          events_.wait(seen, std::memory_order_seq_cst);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        idle = 0;
+      }
+      detail::current_worker = {};
+    }
+  public:
+    // start threads workers; zero means one per hardware thread
+    explicit thread_pool(size_t threads = 0, thread_affinity affinity = thread_affinity::none) :
+      injection_head_(nullptr), injection_tail_(nullptr), injected_(0),
+      events_(0), sleepers_(0), stopping_(false)
+    {
+      if (threads == 0) threads = std::thread::hardware_concurrency();
+      if (threads == 0) threads = 1;
+      workers_.reserve(threads);
+      for (size_t i = 0; i < threads; ++i) workers_.push_back(new worker());
+      for (size_t i = 0; i < threads; ++i)
+      {
+        workers_[i]->thread = std::thread([this, i, affinity]() { worker_loop(i, affinity); });
+      }
+    }
+
+    // destructor; runs every queued task, then joins the workers
+    ~thread_pool()
+    {
+      stopping_.store(true, std::memory_order_seq_cst);
+      events_.fetch_add(1, std::memory_order_seq_cst);
+      events_.notify_all();
+      for (size_t i = 0; i < workers_.size(); ++i) workers_[i]->thread.join();
+      for (size_t i = 0; i < workers_.size(); ++i) delete workers_[i];
+    }
+
+    thread_pool(const thread_pool& other) = delete;
+    thread_pool& operator=(const thread_pool& other) = delete;
+
+    // number of worker threads
+    size_t size() const noexcept { return workers_.size(); }
+
+    // run f() on the pool without tracking it; f must not throw
+    template<typename F>
+    void post(F&& f)
+    {
+      schedule(detail::make_task(forward<F>(f)));
+    }
+
+    // run f() on the pool; the future yields its result or exception
+    template<typename F>
+    auto submit(F&& f) -> future<std::invoke_result_t<std::decay_t<F>&>>
+    {
+      using result_type = std::invoke_result_t<std::decay_t<F>&>;
+      auto* state = new detail::future_state<result_type>();
+      schedule(detail::make_task([state, fn = std::decay_t<F>(forward<F>(f))]() mutable {
+        try
+        {
+          if constexpr (std::is_void_v<result_type>) fn();
+          else state->value.emplace(fn());
+        }
+        catch (...)
+        {
+          state->error = std::current_exception();
+        }
+        state->finish();
+      }));
+      return future<result_type>(state);
+    }
+
+    // call fn(i) for every i in [first, last), splitting the range in
+    // halves until pieces are at most grain long; returns when all calls
+    // are done and rethrows the first exception one of them threw
+    template<typename Index, typename F>
+    void parallel_for(Index first, Index last, Index grain, F fn);
+
+    // pool shared by the library; one worker per hardware thread
+    static thread_pool& global()
+    {
+      static thread_pool pool;
+      return pool;
+    }
+  };
+
+  // structured fork / join: tasks run on a pool and wait() returns once
+  // all of them finished, rethrowing the first exception any of them threw
+  class task_group {
+  private:
+    thread_pool& pool_;
+    std::atomic<size_t> pending_;
+    std::atomic<size_t> active_;
+    std::atomic<bool> failed_;
+    std::exception_ptr error_;
+  public:
+    explicit task_group(thread_pool& pool = thread_pool::global()) :
+      pool_(pool), pending_(0), active_(0), failed_(false) {}
+
+    // destructor; waits for outstanding tasks, dropping their exceptions
+    ~task_group()
+    {
+      try
+      {
+        wait();
+      }
+      catch (...)
+      {
+      }
+    }
+
+    task_group(const task_group& other) = delete;
+    task_group& operator=(const task_group& other) = delete;
+
+    thread_pool& pool() const noexcept { return pool_; }
+
+    // run f() as part of the group
+    template<typename F>
+    void run(F&& f)
+    {
+      active_.fetch_add(1, std::memory_order_relaxed);
+      pending_.fetch_add(1, std::memory_order_relaxed);
+      pool_.post([this, fn = std::decay_t<F>(forward<F>(f))]() mutable {
+        try
+        {
+          fn();
+        }
+        catch (...)
+        {
+          if (!failed_.exchange(true, std::memory_order_acq_rel)) error_ = std::current_exception();
+        }
+        // active_ is the task's last touch of the group, so a waiter that
+        // sees it reach zero may destroy the group
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) pending_.notify_all();
+        active_.fetch_sub(1, std::memory_order_release);
+      });
+    }
+
+    // wait for every task run so far; workers help run tasks meanwhile
+    void wait()
+    {
+      for (;;)
+      {
+        size_t pending = pending_.load(std::memory_order_acquire);
+        if (pending == 0) break;
+        if (detail::current_worker.pool == nullptr) pending_.wait(pending, std::memory_order_acquire);
+        else if (!detail::help_current_pool()) std::this_thread::yield();
+      }
+      while (active_.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+      if (failed_.load(std::memory_order_acquire))
+      {
+        failed_.store(false, std::memory_order_relaxed);
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+      }
+    }
+  };
+
+  template<typename Index, typename F>
+  void thread_pool::parallel_for(Index first, Index last, Index grain, F fn)
+  {
+    if (!(first < last)) return;
+    if (grain < Index(1)) grain = Index(1);
+    task_group group(*this);
+
+    // hand the upper half of the range to the pool and keep the lower one
+    auto split = [&group, grain, &fn](auto& self, Index lo, Index hi) -> void {
+      while (hi - lo > grain)
+      {
+        Index mid = lo + (hi - lo) / 2;
+        group.run([&self, mid, hi]() { self(self, mid, hi); });
+        hi = mid;
+      }
+      for (Index i = lo; i < hi; ++i) fn(i);
+    };
+    group.run([&split, first, last]() { split(split, first, last); });
+    group.wait();
+  }
+
+  // parallel_for on the shared pool
+  template<typename Index, typename F>
+  void parallel_for(Index first, Index last, Index grain, F fn)
+  {
+    thread_pool::global().parallel_for(first, last, grain, move(fn));
+  }
+
+  namespace detail {
+    inline bool help_current_pool()
+    {
+      thread_pool* pool = current_worker.pool;
+      if (pool == nullptr) return false;
+      pool_task* task = pool->find_task(current_worker.index);
+      if (task == nullptr) return false;
+      thread_pool::execute(task);
+      return true;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,598 @@
+#ifndef KARLS_STANDARD_LIBRARY_UTF8_HPP
+#define KARLS_STANDARD_LIBRARY_UTF8_HPP
+
+#include "cstddef.hpp"
+#include "string.hpp"
+#include "string_view.hpp"
+#include "vector.hpp"
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// utf-8 validation and transcoding, and ascii case folding, over string
+// data
+//
+// validation runs 64 bytes per step: each byte is classified with three
+// 16 entry table lookups on the nibbles of it and the byte before, whose
+// intersection flags every invalid two byte pattern, and one more check
+// makes sure the continuation bytes of three and four byte sequences are
+// where the lead byte says. pure ascii blocks skip all of it. transcoding
+// copies ascii runs 16 units at a time and decodes the rest one code point
+// at a time
+namespace karls_standard_library {
+  namespace utf8 {
+    // result of a transcoding call: with ec == errc{}, count is the number
+    // of code units written; with errc::illegal_byte_sequence it is the
+    // offset of the first input unit that does not start a valid sequence
+    struct transcode_result {
+      size_t count;
+      std::errc ec;
+    };
+  }
+
+  namespace detail {
+    // length of the valid utf-8 sequence at p, storing its code point in
+    // cp, or 0 if the bytes at p do not start one
+    constexpr size_t decode_utf8(const char* p, const char* end, char32_t& cp) noexcept
+    {
+      unsigned char c = static_cast<unsigned char>(p[0]);
+      if (c < 0x80)
+      {
+        cp = c;
+        return 1;
+      }
+      size_t length;
+      char32_t min;
+      if ((c & 0xe0) == 0xc0)
+      {
+        length = 2;
+        cp = c & 0x1f;
+        min = 0x80;
+      }
+      else if ((c & 0xf0) == 0xe0)
+      {
+        length = 3;
+        cp = c & 0x0f;
+        min = 0x800;
+      }
+      else if ((c & 0xf8) == 0xf0)
+      {
+        length = 4;
+        cp = c & 0x07;
+        min = 0x10000;
+      }
+      else return 0;
+      if (static_cast<size_t>(end - p) < length) return 0;
+      for (size_t i = 1; i < length; ++i)
+      {
+        unsigned char next = static_cast<unsigned char>(p[i]);
+        if ((next & 0xc0) != 0x80) return 0;
+        cp = (cp << 6) | (next & 0x3f);
+      }
+      // overlong forms, surrogates and values past the last code point
+      if (cp < min || cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff)) return 0;
+      return length;
+    }
+
+    // write cp, a valid scalar value, as utf-8 and return the length
+    constexpr size_t encode_utf8(char32_t cp, char* out) noexcept
+    {
+      if (cp < 0x80)
+      {
+        out[0] = static_cast<char>(cp);
+        return 1;
+      }
+      if (cp < 0x800)
+      {
+        out[0] = static_cast<char>(0xc0 | (cp >> 6));
+        out[1] = static_cast<char>(0x80 | (cp & 0x3f));
+        return 2;
+      }
+      if (cp < 0x10000)
+      {
+        out[0] = static_cast<char>(0xe0 | (cp >> 12));
+        out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+        out[2] = static_cast<char>(0x80 | (cp & 0x3f));
+        return 3;
+      }
+      out[0] = static_cast<char>(0xf0 | (cp >> 18));
+      out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3f));
+      out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+      out[3] = static_cast<char>(0x80 | (cp & 0x3f));
+      return 4;
+    }
+
+    constexpr bool validate_utf8_scalar(const char* p, size_t size) noexcept
+    {
+      const char* end = p + size;
+      while (p < end)
+      {
+        if (!std::is_constant_evaluated() && end - p >= 8)
+        {
+          // skip eight ascii bytes at once
+          uint64_t word;
+          __builtin_memcpy(&word, p, 8);
+          if ((word & 0x8080808080808080ull) == 0)
+          {
+            p += 8;
+            continue;
+          }
+        }
+        char32_t cp;
+        size_t length = decode_utf8(p, end, cp);
+        if (length == 0) return false;
+        p += length;
+      }
+      return true;
+    }
+
+    // decode the sequence at p, which is known to be valid
+    constexpr size_t decode_valid_utf8(const char* p, char32_t& cp) noexcept
+    {
+      auto bits = [p](size_t i, unsigned mask) { return static_cast<char32_t>(static_cast<unsigned char>(p[i]) & mask); };
+      unsigned char c = static_cast<unsigned char>(p[0]);
+      if (c < 0x80)
+      {
+        cp = c;
+        return 1;
+      }
+      if (c < 0xe0)
+      {
+        cp = bits(0, 0x1f) << 6 | bits(1, 0x3f);
+        return 2;
+      }
+      if (c < 0xf0)
+      {
+        cp = bits(0, 0x0f) << 12 | bits(1, 0x3f) << 6 | bits(2, 0x3f);
+        return 3;
+      }
+      cp = bits(0, 0x07) << 18 | bits(1, 0x3f) << 12 | bits(2, 0x3f) << 6 | bits(3, 0x3f);
+      return 4;
+    }
+
+    // utf-8 to utf-16 or utf-32. without Checked the input must already be
+    // known to be valid
+    template<bool Checked, typename Unit>
+    constexpr utf8::transcode_result utf8_to_units(const char* src, size_t size, Unit* out) noexcept
+    {
+      size_t i = 0;
+      size_t k = 0;
+      while (i < size)
+      {
+#if defined(__AVX2__)
+        if (!std::is_constant_evaluated())
+        {
+          for (; i + 16 <= size; i += 16, k += 16)
+          {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            if (_mm_movemask_epi8(v) != 0) break;
+            if constexpr (sizeof(Unit) == 2)
+            {
+              _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), _mm256_cvtepu8_epi16(v));
+            }
+            else
+            {
+              _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), _mm256_cvtepu8_epi32(v));
+              _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+            }
+          }
+        }
+#endif
+        // decode at least the block that stopped the ascii copy
+        size_t stop = size - i < 16 ? size : i + 16;
+        while (i < stop)
+        {
+          char32_t cp;
+          size_t length;
+          if constexpr (Checked)
+          {
+            length = decode_utf8(src + i, src + size, cp);
+            if (length == 0) return {i, std::errc::illegal_byte_sequence};
+          }
+          else length = decode_valid_utf8(src + i, cp);
+          if (sizeof(Unit) == 4 || cp < 0x10000) out[k++] = static_cast<Unit>(cp);
+          else
+          {
+            cp -= 0x10000;
+            out[k++] = static_cast<Unit>(0xd800 + (cp >> 10));
+            out[k++] = static_cast<Unit>(0xdc00 + (cp & 0x3ff));
+          }
+          i += length;
+        }
+      }
+      return {k, std::errc{}};
+    }
+
+#if defined(__AVX2__)
+    // the lookup validator: an error bit survives the and of the three
+    // tables only for byte pairs that are invalid in that way
+    class utf8_checker {
+      static constexpr char too_short = 1 << 0;           // lead byte or ascii after a lead byte
+      static constexpr char too_long = 1 << 1;            // continuation byte after ascii
+      static constexpr char overlong_3 = 1 << 2;          // e0 followed by 80..9f
+      static constexpr char too_large = 1 << 3;           // f4 followed by 90..bf, or f5..ff
+      static constexpr char surrogate = 1 << 4;           // ed followed by a0..bf
+      static constexpr char overlong_2 = 1 << 5;          // c0 or c1
+      static constexpr char too_large_1000 = 1 << 6;      // f5..ff followed by 80..8f
+      static constexpr char overlong_4 = 1 << 6;          // f0 followed by 80..8f
+      static constexpr char two_conts = static_cast<char>(1 << 7); // continuation after continuation
+      static constexpr char carry = too_short | too_long | two_conts;
+
+      __m256i error_ = _mm256_setzero_si256();
+      __m256i prev_input_ = _mm256_setzero_si256();
+      __m256i prev_incomplete_ = _mm256_setzero_si256();
+
+      // input shifted right by N bytes, with the last bytes of prev in front
+      template<int N>
+      static __m256i prev(__m256i input, __m256i prev_input) noexcept
+      {
+        return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+      }
+
+      static __m256i high_nibbles(__m256i v) noexcept
+      {
+        return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+      }
+
+      static __m256i special_cases(__m256i input, __m256i prev1) noexcept
+      {
+        const __m256i byte_1_high_table = _mm256_setr_epi8(
+          too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+          two_conts, two_conts, two_conts, two_conts,
+          too_short | overlong_2, too_short, too_short | overlong_3 | surrogate,
+          too_short | too_large | too_large_1000 | overlong_4,
+          too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+          two_conts, two_conts, two_conts, two_conts,
+          too_short | overlong_2, too_short, too_short | overlong_3 | surrogate,
+          too_short | too_large | too_large_1000 | overlong_4);
+        constexpr char large = carry | too_large | too_large_1000;
+        const __m256i byte_1_low_table = _mm256_setr_epi8(
+          carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2, carry, carry,
+          carry | too_large, large, large, large, large, large, large, large, large,
+          large | surrogate, large, large,
+          carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2, carry, carry,
+          carry | too_large, large, large, large, large, large, large, large, large,
+          large | surrogate, large, large);
+        constexpr char cont_80 = too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4;
+        constexpr char cont_90 = too_long | overlong_2 | two_conts | overlong_3 | too_large;
+        constexpr char cont_a0 = too_long | overlong_2 | two_conts | surrogate | too_large;
+        const __m256i byte_2_high_table = _mm256_setr_epi8(
+          too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+          cont_80, cont_90, cont_a0, cont_a0, too_short, too_short, too_short, too_short,
+          too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+          cont_80, cont_90, cont_a0, cont_a0, too_short, too_short, too_short, too_short);
+
+        __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, high_nibbles(prev1));
+        __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, _mm256_set1_epi8(0x0f)));
+        __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, high_nibbles(input));
+        return _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+      }
+
+      void check_bytes(__m256i input, __m256i prev_input) noexcept
+      {
+        __m256i prev1 = prev<1>(input, prev_input);
+        __m256i special = special_cases(input, prev1);
+        // third bytes of e0..ff leads and fourth bytes of f0..ff leads must
+        // be continuations; two_conts is set exactly there when they are
+        __m256i is_third = _mm256_subs_epu8(prev<2>(input, prev_input), _mm256_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+        __m256i is_fourth = _mm256_subs_epu8(prev<3>(input, prev_input), _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+        __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+        error_ = _mm256_or_si256(error_, _mm256_xor_si256(must_be_continuation, special));
+      }
+
+      // nonzero where a sequence starting in the last three bytes of the
+      // block runs past it
+      static __m256i incomplete(__m256i input) noexcept
+      {
+        const __m256i max_value = _mm256_setr_epi8(
+          -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+          -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+          static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1), static_cast<char>(0xc0 - 1));
+        return _mm256_subs_epu8(input, max_value);
+      }
+    public:
+      void check(const char* block) noexcept
+      {
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+        if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) == 0)
+        {
+          error_ = _mm256_or_si256(error_, prev_incomplete_);
+          return;
+        }
+        check_bytes(first, prev_input_);
+        check_bytes(second, first);
+        prev_incomplete_ = incomplete(second);
+        prev_input_ = second;
+      }
+
+      bool valid_at_end() noexcept
+      {
+        error_ = _mm256_or_si256(error_, prev_incomplete_);
+        return _mm256_testz_si256(error_, error_);
+      }
+    };
+
+    inline bool validate_utf8_avx2(const char* data, size_t size) noexcept
+    {
+      utf8_checker checker;
+      size_t i = 0;
+      for (; i + 64 <= size; i += 64) checker.check(data + i);
+      if (i < size)
+      {
+        // the tail, padded with ascii
+        char block[64];
+        __builtin_memset(block, ' ', 64);
+        __builtin_memcpy(block, data + i, size - i);
+        checker.check(block);
+      }
+      return checker.valid_at_end();
+    }
+#endif
+
+    // ascii case mapping; bit 0x20 is the only difference between the cases
+    template<char First>
+    constexpr void flip_case(char* data, size_t size) noexcept
+    {
+      size_t i = 0;
+#if defined(__AVX2__)
+      if (!std::is_constant_evaluated())
+      {
+        // signed compares, so bytes past 0x7f never match
+        const __m256i below = _mm256_set1_epi8(First - 1);
+        const __m256i above = _mm256_set1_epi8(First + 26);
+        const __m256i bit = _mm256_set1_epi8(0x20);
+        for (; i + 32 <= size; i += 32)
+        {
+          __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+          __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi8(v, below), _mm256_cmpgt_epi8(above, v));
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), _mm256_xor_si256(v, _mm256_and_si256(in_range, bit)));
+        }
+      }
+#endif
+      for (; i < size; ++i)
+      {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        if (static_cast<unsigned char>(c - First) < 26) data[i] = static_cast<char>(c ^ 0x20);
+      }
+    }
+
+    constexpr char ascii_lower(char c) noexcept
+    {
+      return (c >= 'A' && c <= 'Z') ? static_cast<char>(c | 0x20) : c;
+    }
+  }
+
+  namespace utf8 {
+    // true if data holds only complete, shortest form utf-8 sequences of
+    // scalar values
+    constexpr bool validate(const char* data, size_t size) noexcept
+    {
+#if defined(__AVX2__)
+      if (!std::is_constant_evaluated()) return detail::validate_utf8_avx2(data, size);
+#endif
+      return detail::validate_utf8_scalar(data, size);
+    }
+    constexpr bool validate(string_view text) noexcept { return validate(text.data(), text.size()); }
+
+    // number of code points in valid utf-8: the bytes that are not
+    // continuation bytes
+    constexpr size_t count_codepoints(const char* data, size_t size) noexcept
+    {
+      size_t count = 0;
+      size_t i = 0;
+#if defined(__AVX2__)
+      if (!std::is_constant_evaluated())
+      {
+        // continuation bytes are the signed values below -64
+        const __m256i threshold = _mm256_set1_epi8(-65);
+        for (; i + 32 <= size; i += 32)
+        {
+          __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+          count += static_cast<size_t>(std::popcount(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, threshold)))));
+        }
+      }
+#endif
+      for (; i < size; ++i) count += (static_cast<unsigned char>(data[i]) & 0xc0) != 0x80;
+      return count;
+    }
+    constexpr size_t count_codepoints(string_view text) noexcept { return count_codepoints(text.data(), text.size()); }
+
+    // utf-8 to utf-16; out needs room for size units. the input is
+    // validated first, so decoding needs no checks; the checked decoder
+    // only runs to find where invalid input goes wrong
+    constexpr transcode_result to_utf16(const char* src, size_t size, char16_t* out) noexcept
+    {
+      if (validate(src, size)) return detail::utf8_to_units<false>(src, size, out);
+      return detail::utf8_to_units<true>(src, size, out);
+    }
+
+    // utf-8 to utf-32; out needs room for size units
+    constexpr transcode_result to_utf32(const char* src, size_t size, char32_t* out) noexcept
+    {
+      if (validate(src, size)) return detail::utf8_to_units<false>(src, size, out);
+      return detail::utf8_to_units<true>(src, size, out);
+    }
+
+    // utf-16 to utf-8; out needs room for 3 * size bytes. unpaired
+    // surrogates are errors
+    constexpr transcode_result from_utf16(const char16_t* src, size_t size, char* out) noexcept
+    {
+      size_t i = 0;
+      size_t k = 0;
+      while (i < size)
+      {
+#if defined(__AVX2__)
+        if (!std::is_constant_evaluated())
+        {
+          const __m256i non_ascii = _mm256_set1_epi16(static_cast<short>(0xff80));
+          for (; i + 16 <= size; i += 16, k += 16)
+          {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            if (!_mm256_testz_si256(v, non_ascii)) break;
+            __m128i packed = _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), packed);
+          }
+        }
+#endif
+        size_t stop = size - i < 16 ? size : i + 16;
+        while (i < stop)
+        {
+          char32_t cp = src[i];
+          size_t length = 1;
+          if (cp >= 0xd800 && cp <= 0xdfff)
+          {
+            if (cp > 0xdbff || i + 1 == size || src[i + 1] < 0xdc00 || src[i + 1] > 0xdfff)
+            {
+              return {i, std::errc::illegal_byte_sequence};
+            }
+            cp = 0x10000 + ((cp - 0xd800) << 10) + (src[i + 1] - 0xdc00);
+            length = 2;
+          }
+          k += detail::encode_utf8(cp, out + k);
+          i += length;
+        }
+      }
+      return {k, std::errc{}};
+    }
+
+    // utf-32 to utf-8; out needs room for 4 * size bytes. surrogates and
+    // values past 10ffff are errors
+    constexpr transcode_result from_utf32(const char32_t* src, size_t size, char* out) noexcept
+    {
+      size_t i = 0;
+      size_t k = 0;
+      while (i < size)
+      {
+#if defined(__AVX2__)
+        if (!std::is_constant_evaluated())
+        {
+          const __m256i non_ascii = _mm256_set1_epi32(static_cast<int>(0xffffff80u));
+          for (; i + 8 <= size; i += 8, k += 8)
+          {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            if (!_mm256_testz_si256(v, non_ascii)) break;
+            __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + k), _mm_packus_epi16(words, words));
+          }
+        }
+#endif
+        size_t stop = size - i < 8 ? size : i + 8;
+        for (; i < stop; ++i)
+        {
+          char32_t cp = src[i];
+          if (cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff)) return {i, std::errc::illegal_byte_sequence};
+          k += detail::encode_utf8(cp, out + k);
+        }
+      }
+      return {k, std::errc{}};
+    }
+
+    // container versions; these throw std::invalid_argument on invalid input
+
+    inline vector<char16_t> to_utf16(string_view text)
+    {
+      vector<char16_t> result;
+      if (text.empty()) return result;
+      result.resize(text.size());
+      transcode_result r = to_utf16(text.data(), text.size(), result.data());
+      if (r.ec != std::errc{}) throw std::invalid_argument("invalid utf-8");
+      result.resize(r.count);
+      return result;
+    }
+
+    inline vector<char32_t> to_utf32(string_view text)
+    {
+      vector<char32_t> result;
+      if (text.empty()) return result;
+      result.resize(text.size());
+      transcode_result r = to_utf32(text.data(), text.size(), result.data());
+      if (r.ec != std::errc{}) throw std::invalid_argument("invalid utf-8");
+      result.resize(r.count);
+      return result;
+    }
+
+    inline string from_utf16(const vector<char16_t>& text)
+    {
+      string result;
+      transcode_result r{};
+      result.resize_and_overwrite(3 * text.size(), [&](char* out, size_t) {
+        r = from_utf16(text.data(), text.size(), out);
+        return r.ec == std::errc{} ? r.count : 0;
+      });
+      if (r.ec != std::errc{}) throw std::invalid_argument("invalid utf-16");
+      return result;
+    }
+
+    inline string from_utf32(const vector<char32_t>& text)
+    {
+      string result;
+      transcode_result r{};
+      result.resize_and_overwrite(4 * text.size(), [&](char* out, size_t) {
+        r = from_utf32(text.data(), text.size(), out);
+        return r.ec == std::errc{} ? r.count : 0;
+      });
+      if (r.ec != std::errc{}) throw std::invalid_argument("invalid utf-32");
+      return result;
+    }
+  }
+
+  // case mapping of the ascii letters only; other bytes, including every
+  // byte of a multibyte utf-8 sequence, are left alone
+  namespace ascii {
+    constexpr void to_lower(char* data, size_t size) noexcept { detail::flip_case<'A'>(data, size); }
+    constexpr void to_upper(char* data, size_t size) noexcept { detail::flip_case<'a'>(data, size); }
+
+    constexpr string& to_lower(string& s) noexcept
+    {
+      to_lower(s.data(), s.size());
+      return s;
+    }
+    constexpr string& to_upper(string& s) noexcept
+    {
+      to_upper(s.data(), s.size());
+      return s;
+    }
+
+    // equality ignoring ascii case
+    constexpr bool iequals(string_view a, string_view b) noexcept
+    {
+      if (a.size() != b.size()) return false;
+      const char* p = a.data();
+      const char* q = b.data();
+      size_t size = a.size();
+      size_t i = 0;
+#if defined(__AVX2__)
+      if (!std::is_constant_evaluated())
+      {
+        // setting bit 0x20 of the letters makes both sides lower case
+        const __m256i below = _mm256_set1_epi8('A' - 1);
+        const __m256i above = _mm256_set1_epi8('Z' + 1);
+        const __m256i bit = _mm256_set1_epi8(0x20);
+        auto lower = [&](__m256i v) {
+          __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, below), _mm256_cmpgt_epi8(above, v));
+          return _mm256_or_si256(v, _mm256_and_si256(upper, bit));
+        };
+        for (; i + 32 <= size; i += 32)
+        {
+          __m256i x = lower(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+          __m256i y = lower(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i)));
+          if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) != -1) return false;
+        }
+      }
+#endif
+      for (; i < size; ++i)
+      {
+        if (detail::ascii_lower(p[i]) != detail::ascii_lower(q[i])) return false;
+      }
+      return true;
+    }
+  }
+}
+
+#endif
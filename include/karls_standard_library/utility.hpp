@@ -1,6 +1,7 @@
 #ifndef KARLS_STANDARD_LIBRARY_UTILITY_HPP
 #define KARLS_STANDARD_LIBRARY_UTILITY_HPP
 
+#include "cstddef.hpp"
 #include <type_traits>
 #include <compare>
 
@@ -27,8 +28,8 @@ namespace karls_standard_library {
   constexpr T exchange(T& obj, U&& new_value) 
   noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable<U>::value)
   {
-    T old = move(obj);
-    obj = forward<U>(new_value);
+    T old = karls_standard_library::move(obj);
+    obj = karls_standard_library::forward<U>(new_value);
     return old;
   }
 
@@ -37,9 +38,9 @@ namespace karls_standard_library {
   constexpr void swap(T& a, T& b) 
   noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>)
   {
-    T temp = move(a);
-    a = move(b);
-    b = move(temp);
+    T temp = karls_standard_library::move(a);
+    a = karls_standard_library::move(b);
+    b = karls_standard_library::move(temp);
   }
 
   // array swap function
@@ -53,60 +54,46 @@ namespace karls_standard_library {
   }
 
   // pair implementation
+  //
+  // copy, move, assignment and destruction are all defaulted, so a Pair is
+  // trivially copyable (and containers relocate it with memcpy) whenever
+  // both members are
   template<typename T1, typename T2>
   struct Pair {
     // member variables
     T1 first;
     T2 second;
 
-    // default constructor
-    Pair() : first(T1{}), second(T2{}) {}
+    // default constructor; value initialises both members
+    constexpr Pair() requires (std::is_default_constructible_v<T1> && std::is_default_constructible_v<T2>)
+      : first(), second() {}
 
-    // perfect forwarding
+    // perfect forwarding; each member is constructed in place
     template<typename U1, typename U2>
-    Pair(U1&& x, U2&& y) 
-    {
-      first = forward<U1>(x);
-      second = forward<U2>(y);
-    }
-
-    // copy constructor
-    Pair(const Pair<T1, T2>& p) : first(p.first), second(p.second) {}
+      requires (std::is_constructible_v<T1, U1> && std::is_constructible_v<T2, U2>)
+    constexpr explicit(!std::is_convertible_v<U1, T1> || !std::is_convertible_v<U2, T2>)
+    Pair(U1&& x, U2&& y) : first(karls_standard_library::forward<U1>(x)), second(karls_standard_library::forward<U2>(y)) {}
 
-    // move constructor
-    Pair(Pair<T1, T2>&& p) : first(move(p.first)), second(move(p.second)) {}
+    // copy and move
+    constexpr Pair(const Pair&) = default;
+    constexpr Pair(Pair&&) = default;
+    constexpr Pair& operator=(const Pair&) = default;
+    constexpr Pair& operator=(Pair&&) = default;
 
     // converting copy constructor
     template<typename U1, typename U2>
-    Pair(const Pair<U1, U2>& p) : first(p.first), second(p.second) {}
+      requires (std::is_constructible_v<T1, const U1&> && std::is_constructible_v<T2, const U2&>)
+    constexpr Pair(const Pair<U1, U2>& p) : first(p.first), second(p.second) {}
 
     // converting move constructor
     template<typename U1, typename U2>
-    Pair(Pair<U1, U2>&& p) : first(move(p.first)), second(move(p.second)) {}
-
-    // copy assignment operator
-    Pair& operator=(const Pair<T1, T2>& p) 
-    {
-      if (this != &p) 
-      {
-        first = p.first;
-        second = p.second;
-      }
-      return *this;
-    }
-
-    // move assignment operator
-    Pair& operator=(Pair<T1, T2>&& p) noexcept 
-    {
-      first = move(p.first);
-      second = move(p.second);
-      return *this;
-    }
+      requires (std::is_constructible_v<T1, U1> && std::is_constructible_v<T2, U2>)
+    constexpr Pair(Pair<U1, U2>&& p) : first(karls_standard_library::forward<U1>(p.first)), second(karls_standard_library::forward<U2>(p.second)) {}
 
     // converting copy assignment operator
     template<typename U1, typename U2>
-    std::enable_if_t<!std::is_same_v<Pair<U1, U2>, Pair<T1, T2>>, Pair&>
-    operator=(const Pair<U1, U2>& p) 
+      requires (!std::is_same_v<Pair<U1, U2>, Pair<T1, T2>>)
+    constexpr Pair& operator=(const Pair<U1, U2>& p)
     {
       first = p.first;
       second = p.second;
@@ -115,63 +102,60 @@ namespace karls_standard_library {
 
     // converting move assignment operator
     template<typename U1, typename U2>
-    std::enable_if_t<!std::is_same_v<Pair<U1, U2>, Pair<T1, T2>>, Pair&>
-    operator=(Pair<U1, U2>&& p) 
+      requires (!std::is_same_v<Pair<U1, U2>, Pair<T1, T2>>)
+    constexpr Pair& operator=(Pair<U1, U2>&& p)
     {
-      first = move(p.first);
-      second = move(p.second);
+      first = karls_standard_library::forward<U1>(p.first);
+      second = karls_standard_library::forward<U2>(p.second);
       return *this;
     }
 
     // member swap
-    void swap(Pair& p) noexcept 
+    constexpr void swap(Pair& p)
+      noexcept(std::is_nothrow_swappable_v<T1> && std::is_nothrow_swappable_v<T2>)
     {
-      swap(first, p.first);
-      swap(second, p.second);
+      karls_standard_library::swap(first, p.first);
+      karls_standard_library::swap(second, p.second);
     }
 
-    // equality and comparison operators
+    // equality and comparison operators, lexicographic
     template<typename U1, typename U2>
-    bool operator==(const Pair<U1, U2>& p) 
+    constexpr bool operator==(const Pair<U1, U2>& p) const
     {
       return first == p.first && second == p.second;
     }
 
     template<typename U1, typename U2>
-    constexpr auto operator<=>(const Pair<U1, U2>& other)
+    constexpr std::common_comparison_category_t<std::compare_three_way_result_t<T1, U1>, std::compare_three_way_result_t<T2, U2>>
+    operator<=>(const Pair<U1, U2>& other) const
     {
       if (auto cmp = first <=> other.first; cmp != 0) return cmp;
       return second <=> other.second;
     }
   };
 
+  template<typename T1, typename T2>
+  Pair(T1, T2) -> Pair<T1, T2>;
+
+  // containers rely on pairs of trivial members staying trivial
+  static_assert(std::is_trivially_copyable_v<Pair<int, int>>);
+  static_assert(std::is_trivially_destructible_v<Pair<int, double>>);
+  static_assert(sizeof(Pair<int, int>) == 2 * sizeof(int));
+
   // make_pair non-member function
   template<typename T1, typename T2>
-  constexpr Pair<std::decay_t<T1>, std::decay_t<T2>> make_pair(T1&& x, T2&& y) 
+  constexpr Pair<std::decay_t<T1>, std::decay_t<T2>> make_pair(T1&& x, T2&& y)
   {
-    return Pair<std::decay_t<T1>, std::decay_t<T2>>(forward(x), forward(y));
+    return Pair<std::decay_t<T1>, std::decay_t<T2>>(karls_standard_library::forward<T1>(x), karls_standard_library::forward<T2>(y));
   }
 
   // non-member pair swap
-  template<typename T1, typename T2, typename U1, typename U2>
-  void swap(Pair<T1, T2>& lhs, Pair<U1, U2>& rhs) 
+  template<typename T1, typename T2>
+  constexpr void swap(Pair<T1, T2>& lhs, Pair<T1, T2>& rhs) noexcept(noexcept(lhs.swap(rhs)))
   {
     lhs.swap(rhs);
   }
 
-  // comparison functions
-  template<typename T1, typename T2, typename U1, typename U2>
-  bool operator==(const Pair<T1, T2>& lhs, const Pair<U1, U2>& rhs) 
-  {
-    return lhs==(rhs);
-  }
-
-  template<typename T1, typename T2, typename U1, typename U2>
-  constexpr auto operator<=>(const Pair<T1, T2>& lhs, const Pair<U1, U2>& rhs)
-  {
-    return lhs <=> rhs;
-  }
-
   // function objects
 
 
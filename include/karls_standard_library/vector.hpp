@@ -4,49 +4,19 @@
 #include <stdexcept>
 #include <memory>
 #include "utility.hpp"
+#include "functional.hpp"
+#include "iterator.hpp"
 
 namespace karls_standard_library {
+  // kept for code naming the old iterator type
   template<typename vector>
-  class vector_iterator {
-  public:
-    using value_type = typename vector::value_type;
-    using pointer = value_type*;
-    using reference = value_type&;
-    using difference_type = ptrdiff_t;
-  private:
-    pointer ptr_;
-  public:
-    vector_iterator(pointer ptr) : ptr_(ptr) {}
-
-    vector_iterator& operator++() {
-      ptr_++;
-      return *this;
-    }
-    vector_iterator operator++(int) {
-      vector_iterator temp = *this;
-      ++(*this);
-      return temp;
-    }
-
-    vector_iterator& operator--() {
-      ptr_--;
-      return *this;
-    }
-    vector_iterator operator--(int) {
-      vector_iterator temp = *this;
-      --(*this);
-      return temp;
-    }
-
-    reference operator[](size_t index) { return *(ptr_ + index); }
-    pointer operator->() { return ptr_; }
-    reference operator*() { return *ptr_; } 
-    bool operator==(const vector_iterator& other) const { return ptr_ == other.ptr_; }
-    bool operator!=(const vector_iterator& other) const { return !(*this == other); }
-  };
-
+  using vector_iterator = pointer_iterator<typename vector::value_type, vector>;
 
   // vector implementation
+  //
+  // storage comes from std::allocator and elements are built with
+  // std::construct_at, so a vector can also be used (and must be freed)
+  // during constant evaluation
   template<typename T>
   class vector {
   public:
@@ -55,16 +25,28 @@ namespace karls_standard_library {
     using difference_type = ptrdiff_t;
     using reference = T&;
     using const_reference = const value_type&;
-    using iterator = vector_iterator<vector<T>>;
-    using const_iterator = const vector_iterator<vector<T>>;
-
-    iterator begin() { return data_; }
-    const_iterator begin() const { return data_; }
-    const_iterator cbegin() const { return data_; }
-
-    iterator end() { return data_ + size_; }
-    const_iterator end() const { return data_ + size_; }
-    const_iterator cend() const { return data_ + size_; }
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = pointer_iterator<T, vector>;
+    using const_iterator = pointer_iterator<const T, vector>;
+    using reverse_iterator = karls_standard_library::reverse_iterator<iterator>;
+    using const_reverse_iterator = karls_standard_library::reverse_iterator<const_iterator>;
+
+    constexpr iterator begin() { return data_; }
+    constexpr const_iterator begin() const { return data_; }
+    constexpr const_iterator cbegin() const { return data_; }
+
+    constexpr iterator end() { return data_ + size_; }
+    constexpr const_iterator end() const { return data_ + size_; }
+    constexpr const_iterator cend() const { return data_ + size_; }
+
+    constexpr reverse_iterator rbegin() { return reverse_iterator(end()); }
+    constexpr const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    constexpr const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+
+    constexpr reverse_iterator rend() { return reverse_iterator(begin()); }
+    constexpr const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    constexpr const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
   private:
     T* data_;
     size_t size_;
@@ -72,64 +54,94 @@ namespace karls_standard_library {
 
     // helper swap function
     template<typename U>
-    void swap(U& a, U& b)
+    constexpr void swap(U& a, U& b)
     {
       U temp = a;
       a = b;
       b = temp;
     }
 
-    void dealloc() {
-      if (data_) {
-        operator delete[](data_);
-        data_ = nullptr;
-      }
+    static constexpr T* allocate(size_t count)
+    {
+      return std::allocator<T>{}.allocate(count);
+    }
+
+    constexpr void deallocate()
+    {
+      if (data_) std::allocator<T>{}.deallocate(data_, capacity_);
+    }
+
+    constexpr void dealloc() {
+      deallocate();
+      data_ = nullptr;
       capacity_ = 0;
     }
+
+    // move (or copy, if moving may throw) the elements into new_data and
+    // destroy the originals
+    constexpr void relocate(T* new_data) {
+      // trivially copyable elements move as one block of bytes
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        if (!std::is_constant_evaluated()) {
+          if (size_ > 0) __builtin_memcpy(static_cast<void*>(new_data), static_cast<const void*>(data_), size_ * sizeof(T));
+          return;
+        }
+      }
+      for (size_t i = 0; i < size_; ++i) {
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+          std::construct_at(new_data + i, karls_standard_library::move(data_[i]));
+        }
+        else {
+          std::construct_at(new_data + i, data_[i]);
+        }
+        std::destroy_at(data_ + i);
+      }
+    }
   public:
     // default constructor
-    vector() : data_(nullptr), size_(0), capacity_(0) {}
+    constexpr vector() : data_(nullptr), size_(0), capacity_(0) {}
 
     // destructor
-    ~vector()
+    constexpr ~vector()
     {
       clear();
       dealloc();
     }
 
     // initial size and capacity, optional initial value
-    explicit vector(size_t count, const T& value = T{}) :
+    constexpr explicit vector(size_t count, const T& value = T{}) :
       data_(nullptr), size_(count), capacity_(count)
     {
       if (count > 0)
       {
-        data_ = static_cast<T*>(operator new[](count * sizeof(T)));
-        std::uninitialized_fill_n(data_, count, value);
+        data_ = allocate(count);
+        for (size_t i = 0; i < count; ++i) std::construct_at(data_ + i, value);
       }
     }
 
     // list initialization
-    vector(std::initializer_list<T> init) :
+    constexpr vector(std::initializer_list<T> init) :
       data_(nullptr), size_(init.size()), capacity_(init.size())
     {
       if (size_ > 0) {
-        data_ = static_cast<T*>(operator new[](capacity_ * sizeof(T)));
-        std::uninitialized_copy(init.begin(), init.end(), data_);
+        data_ = allocate(capacity_);
+        T* out = data_;
+        for (const T& value : init) std::construct_at(out++, value);
       }
     }
 
     // copy constructor
-    vector(const vector& other) : 
+    constexpr vector(const vector& other) : 
       data_(nullptr), size_(other.size_), capacity_(other.capacity_)
     {
       if (capacity_ > 0) {
-        data_ = static_cast<T*>(operator new[](capacity_ * sizeof(T)));
-        std::uninitialized_copy(other.data_, other.data_ + size_, data_);
+        data_ = allocate(capacity_);
+        for (size_t i = 0; i < size_; ++i) std::construct_at(data_ + i, other.data_[i]);
       }
     }
 
     // copy assignment operator
-    vector& operator=(const vector& other) {
+    constexpr vector& operator=(const vector& other) {
       if (this != &other) {
         vector temp(other);
         swap(temp);
@@ -138,16 +150,16 @@ namespace karls_standard_library {
     }
 
     // move constructor
-    vector(vector&& other) : 
+    constexpr vector(vector&& other) : 
       data_(exchange(other.data_, nullptr)),
       size_(exchange(other.size_, 0)),
       capacity_(exchange(other.capacity_, 0)) {}
 
     // move assignment operator
-    vector& operator=(vector&& other) {
+    constexpr vector& operator=(vector&& other) {
       if (this != &other) {
         clear();
-        operator delete[](data_);
+        deallocate();
         data_ = exchange(other.data_, nullptr);
         size_ = exchange(other.size_, 0);
         capacity_ = exchange(other.capacity_, 0);
@@ -156,38 +168,42 @@ namespace karls_standard_library {
     }
 
     // true if vector is empty, false otherwise
-    bool empty() const noexcept { return size_ == 0; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
 
     // return size of the vector
-    size_t size() const noexcept { return size_; }
+    constexpr size_t size() const noexcept { return size_; }
 
     // return capacity of the vector
-    size_t capacity() const noexcept { return capacity_; }
+    constexpr size_t capacity() const noexcept { return capacity_; }
 
     // direct access into vector
-    T& operator[](size_t index) noexcept { return data_[index]; }
-    const T& operator[](size_t index) const noexcept { return data_[index]; }
+    constexpr T& operator[](size_t index) noexcept { return data_[index]; }
+    constexpr const T& operator[](size_t index) const noexcept { return data_[index]; }
 
     // direct access to first element
-    T& front() noexcept { return data_[0]; }
-    const T& front() const noexcept { return data_[0]; }
+    constexpr T& front() noexcept { return data_[0]; }
+    constexpr const T& front() const noexcept { return data_[0]; }
 
     // direct access to last element
-    T& back() noexcept { return data_[size_ - 1]; }
-    const T& back() const noexcept { return data_[size_ - 1]; }
+    constexpr T& back() noexcept { return data_[size_ - 1]; }
+    constexpr const T& back() const noexcept { return data_[size_ - 1]; }
+
+    // direct access to the underlying storage
+    constexpr T* data() noexcept { return data_; }
+    constexpr const T* data() const noexcept { return data_; }
 
     // index into the vector with bounds checking
-    T& at(size_t index) {
+    constexpr T& at(size_t index) {
       if (index >= size_) throw std::out_of_range("Index out of bounds"); 
       return data_[index];
     }
-    const T& at(size_t index) const {
+    constexpr const T& at(size_t index) const {
       if (index >= size_) throw std::out_of_range("Index out of bounds");
       return data_[index];
     }
 
     // remove unused capacity
-    void shrink_to_fit() noexcept {
+    constexpr void shrink_to_fit() noexcept {
       if (size_ == capacity_) 
       {
         return;
@@ -197,102 +213,100 @@ namespace karls_standard_library {
         dealloc();
         return;
       }
-      T* new_data = static_cast<T*>(operator new[](size_ * sizeof(T)));
-      for (size_t i = 0; i < size_; ++i) {
-        if constexpr (std::is_nothrow_move_constructible_v<T>) {
-          new(&new_data[i]) T(move(data_[i]));
-        }
-        else {
-          new(&new_data[i]) T(data_[i]);
-        }
-        data_[i].~T();
-      }
-      operator delete[](data_);
+      T* new_data = allocate(size_);
+      relocate(new_data);
+      deallocate();
       data_ = new_data;
       capacity_ = size_;
     }
 
     // remove all elements and reduce size to 0; capacity remains unchanged
-    void clear() noexcept {
+    constexpr void clear() noexcept {
       for (size_t i = 0; i < size_; ++i) {
-        data_[i].~T();
+        std::destroy_at(data_ + i);
       }
       size_ = 0;
     }
 
     // add element to end of vector
-    void push_back(const T& value) noexcept {
+    constexpr void push_back(const T& value) {
       if (size_ == capacity_) {
+        // value may be an element of this vector, which growing frees
+        T copy = value;
         size_t new_cap = (capacity_ == 0) ? 1 : 2 * capacity_;
         reserve(new_cap);
+        std::construct_at(data_ + size_, karls_standard_library::move(copy));
+        ++size_;
+        return;
       }
-      new(&data_[size_]) T(value);
+      std::construct_at(data_ + size_, value);
       ++size_;
     }
 
     template<typename... Args>
-    reference emplace_back(Args... args) {
+    constexpr reference emplace_back(Args... args) {
       if (size_ == capacity_) {
         size_t new_cap = (capacity_ == 0) ? 1 : 2 * capacity_;
         reserve(new_cap);
       }
-      new(&data_[size_]) T(forward<Args>(args)...);
+      std::construct_at(data_ + size_, karls_standard_library::forward<Args>(args)...);
       return data_[size_++];
     }
     
     // remove element from end of vector
-    void pop_back() noexcept {
+    constexpr void pop_back() noexcept {
       if (size_ > 0) {
         --size_;
-        data_[size_].~T();
+        std::destroy_at(data_ + size_);
       }
     }
 
-    void resize(size_t count) { resize(count, T{}); }
-    void resize(size_t count, const T& value) {
+    constexpr void resize(size_t count) { resize(count, T{}); }
+    constexpr void resize(size_t count, const T& value) {
       if (count == 0) return;
       else if (count < size_) {
         for (size_t i = count; i < size_; ++i) {
-          data_[i].~T();
+          std::destroy_at(data_ + i);
         }
         size_ = count;
       }
       else {
         reserve(count);
         for (size_t i = size_; i < count; ++i) {
-          new(&data_[i]) T(value);
+          std::construct_at(data_ + i, value);
         }
         size_ = count;
       }
     }
 
-    void reserve(size_t new_cap) {
+    constexpr void reserve(size_t new_cap) {
       if (capacity_ >= new_cap) return;
-      T* new_data = static_cast<T*>(operator new[](new_cap * sizeof(T)));
-      for (size_t i = 0; i < size_; ++i) {
-        if constexpr (std::is_nothrow_move_constructible_v<T>) {
-          new(&new_data[i]) T(move(data_[i]));
-        }
-        else {
-          new(&new_data[i]) T(data_[i]);
-        }
-        data_[i].~T();
-      }
-      operator delete[](data_);
+      T* new_data = allocate(new_cap);
+      relocate(new_data);
+      deallocate();
       data_ = new_data;
       capacity_ = new_cap;
     }
 
     // swap with other vector
-    void swap(vector& other) noexcept {
+    constexpr void swap(vector& other) noexcept {
       swap(data_, other.data_);
       swap(size_, other.size_);
       swap(capacity_, other.capacity_);
     }
   };
 
+  // hash of the elements in order
+  template<typename T>
+  struct hash<vector<T>> {
+    size_t operator()(const vector<T>& v) const noexcept
+    {
+      return hash_range(v.data(), v.size());
+    }
+  };
+
   template<typename T, typename U>
-  bool operator==(const vector<T>& lhs, const vector<U>& rhs) {
+  constexpr bool operator==(const vector<T>& lhs, const vector<U>& rhs) {
     if (lhs.size() != rhs.size()) return false;
     else {
       for (size_t i = 0; i < lhs.size(); ++i) {
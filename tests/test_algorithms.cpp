@@ -2,8 +2,10 @@
 #include <stdexcept>
 #include <climits>
 #include <iterator>
+#include <list>
 #include <gtest/gtest.h>
 #include "karls_standard_library/algorithm.hpp"
+#include "karls_standard_library/array.hpp"
 #include "karls_standard_library/string.hpp"
 #include "karls_standard_library/vector.hpp"
 
@@ -162,4 +164,164 @@ TEST_F(algorithms_test, count_tests)
     [](const int& x) -> bool { return x == 1; }
   );
   EXPECT_EQ(result4, 0);
-}
\ No newline at end of file
+}
+
+// squares of the primes below limit, computed with a transient vector
+template<size_t N>
+constexpr array<int, N> prime_squares(int limit)
+{
+  vector<int> primes;
+  for (int n = 2; primes.size() < N && n < limit; ++n)
+  {
+    if (none_of(primes.begin(), primes.end(), [n](int p) { return n % p == 0; }))
+    {
+      primes.push_back(n);
+    }
+  }
+  array<int, N> table{};
+  for (size_t i = 0; i < N; ++i) table[i] = primes[i] * primes[i];
+  return table;
+}
+
+TEST_F(algorithms_test, constant_evaluation)
+{
+  constexpr array<int, 5> squares = prime_squares<5>(100);
+  static_assert(squares[0] == 4 && squares[4] == 121);
+  static_assert(max(squares[1], squares[2]) == 25 && min(squares[1], squares[2]) == 9);
+  static_assert(find(squares.begin(), squares.end(), 49) == squares.begin() + 3);
+  static_assert(count_if(squares.begin(), squares.end(), [](int x) { return x % 2; }) == 4);
+  static_assert([]() {
+    vector<int> v{3, 1, 2};
+    v.reserve(16);
+    v.emplace_back(4);
+    vector<int> copy = v;
+    copy.pop_back();
+    return v.size() == 4 && copy.size() == 3 && equal(copy.begin(), copy.end(), v.begin())
+      && all_of(v.begin(), v.end(), [](int x) { return x > 0; });
+  }());
+  // pushing an element of the vector itself when it has to grow; reading
+  // the freed storage would not be a constant expression
+  static_assert([]() {
+    vector<int> v{7};
+    while (v.size() < 20) v.push_back(v[0]);
+    return count(v.begin(), v.end(), 7) == 20;
+  }());
+  EXPECT_EQ(squares[3], 49);
+}
+
+TEST_F(algorithms_test, sorted_set_operations)
+{
+  vector<int> a{1, 2, 2, 3, 5, 8};
+  vector<int> b{2, 2, 2, 4, 5};
+  vector<int> out;
+
+  merge(a.begin(), a.end(), b.begin(), b.end(), back_inserter(out));
+  EXPECT_EQ(out, (vector<int>{1, 2, 2, 2, 2, 2, 3, 4, 5, 5, 8}));
+
+  // duplicates pair up one to one, as in std
+  out.clear();
+  set_union(a.begin(), a.end(), b.begin(), b.end(), back_inserter(out));
+  EXPECT_EQ(out, (vector<int>{1, 2, 2, 2, 3, 4, 5, 8}));
+
+  out.clear();
+  set_intersection(a.begin(), a.end(), b.begin(), b.end(), back_inserter(out));
+  EXPECT_EQ(out, (vector<int>{2, 2, 5}));
+
+  out.clear();
+  set_difference(a.begin(), a.end(), b.begin(), b.end(), back_inserter(out));
+  EXPECT_EQ(out, (vector<int>{1, 3, 8}));
+
+  vector<int> sub{2, 5, 8};
+  EXPECT_TRUE(includes(a.begin(), a.end(), sub.begin(), sub.end()));
+  EXPECT_FALSE(includes(a.begin(), a.end(), b.begin(), b.end()));
+  EXPECT_TRUE(includes(a.begin(), a.end(), sub.begin(), sub.begin()));
+
+  // descending ranges with a comparator
+  vector<int> c{9, 7, 5};
+  vector<int> d{8, 7, 1};
+  out.clear();
+  set_union(c.begin(), c.end(), d.begin(), d.end(), back_inserter(out), [](int x, int y) { return x > y; });
+  EXPECT_EQ(out, (vector<int>{9, 8, 7, 5, 1}));
+
+  static_assert([] {
+    array<int, 4> x{1, 3, 5, 7};
+    array<int, 4> y{3, 4, 5, 6};
+    array<int, 4> common{};
+    auto end = set_intersection(x.begin(), x.end(), y.begin(), y.end(), common.begin());
+    return end - common.begin() == 2 && common[0] == 3 && common[1] == 5;
+  }());
+}
+
+TEST_F(algorithms_test, unique)
+{
+  vector<int> v{1, 1, 2, 2, 2, 3, 1, 1};
+  auto end = unique(v.begin(), v.end());
+  EXPECT_EQ(end - v.begin(), 4);
+  EXPECT_TRUE(equal(v.begin(), end, vector<int>{1, 2, 3, 1}.begin()));
+
+  vector<string> words{"a", "A", "b", "B", "b"};
+  auto last = unique(words.begin(), words.end(), [](const string& x, const string& y) { return (x[0] | 0x20) == (y[0] | 0x20); });
+  EXPECT_EQ(last - words.begin(), 2);
+  EXPECT_EQ(words[1], "b");
+
+  vector<int> empty;
+  EXPECT_EQ(unique(empty.begin(), empty.end()), empty.end());
+}
+
+TEST_F(algorithms_test, binary_search)
+{
+  vector<int> v{1, 2, 2, 2, 5, 7, 9};
+  EXPECT_EQ(lower_bound(v.begin(), v.end(), 2) - v.begin(), 1);
+  EXPECT_EQ(upper_bound(v.begin(), v.end(), 2) - v.begin(), 4);
+  EXPECT_EQ(lower_bound(v.begin(), v.end(), 0) - v.begin(), 0);
+  EXPECT_EQ(lower_bound(v.begin(), v.end(), 10), v.end());
+  EXPECT_EQ(upper_bound(v.begin(), v.end(), 9), v.end());
+
+  auto range = equal_range(v.begin(), v.end(), 2);
+  EXPECT_EQ(range.first - v.begin(), 1);
+  EXPECT_EQ(range.second - v.begin(), 4);
+  range = equal_range(v.begin(), v.end(), 3);
+  EXPECT_EQ(range.first, range.second);
+
+  EXPECT_TRUE(binary_search(v.begin(), v.end(), 7));
+  EXPECT_FALSE(binary_search(v.begin(), v.end(), 6));
+
+  vector<int> empty;
+  EXPECT_EQ(lower_bound(empty.begin(), empty.end(), 1), empty.end());
+  EXPECT_FALSE(binary_search(empty.begin(), empty.end(), 1));
+
+  // every position of every size, against std, including ranges large
+  // enough to take the prefetching and the branching paths
+  for (int n : {1, 2, 3, 4, 5, 8, 17, 100, 5000, 100000})
+  {
+    vector<int> sorted;
+    for (int i = 0; i < n; ++i) sorted.push_back(2 * i);
+    for (int x = -1; x <= 2 * n; ++x)
+    {
+      EXPECT_EQ(lower_bound(sorted.begin(), sorted.end(), x) - sorted.begin(),
+                std::lower_bound(sorted.data(), sorted.data() + n, x) - sorted.data());
+      EXPECT_EQ(upper_bound(sorted.begin(), sorted.end(), x) - sorted.begin(),
+                std::upper_bound(sorted.data(), sorted.data() + n, x) - sorted.data());
+    }
+  }
+
+  // descending with a comparator, and a predicate split
+  vector<int> down{9, 7, 7, 3};
+  auto greater = [](int x, int y) { return x > y; };
+  EXPECT_EQ(lower_bound(down.begin(), down.end(), 7, greater) - down.begin(), 1);
+  EXPECT_EQ(upper_bound(down.begin(), down.end(), 7, greater) - down.begin(), 3);
+  EXPECT_TRUE(binary_search(down.begin(), down.end(), 3, greater));
+  EXPECT_EQ(partition_point(v.begin(), v.end(), [](int x) { return x < 5; }) - v.begin(), 4);
+
+  // bidirectional iterators take the halving loop; qualified, since std
+  // iterators would also find the std overloads
+  std::list<int> l{1, 3, 3, 5};
+  EXPECT_EQ(std::distance(l.begin(), karls_standard_library::lower_bound(l.begin(), l.end(), 3)), 1);
+  EXPECT_EQ(std::distance(l.begin(), karls_standard_library::upper_bound(l.begin(), l.end(), 3)), 3);
+  EXPECT_FALSE(karls_standard_library::binary_search(l.begin(), l.end(), 4));
+
+  static_assert([] {
+    array<int, 5> a{1, 3, 5, 7, 9};
+    return lower_bound(a.begin(), a.end(), 6) - a.begin() == 3 && binary_search(a.begin(), a.end(), 9);
+  }());
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <random>
+#include "karls_standard_library/bitset.hpp"
+
+using namespace karls_standard_library;
+
+class bitset_test : public testing::Test
+{
+protected:
+  bitset_test() = default;
+  ~bitset_test() = default;
+};
+
+TEST_F(bitset_test, fixed_bitset)
+{
+  bitset<130> bits;
+  EXPECT_TRUE(bits.none());
+  bits.set(0).set(64).set(129);
+  bits[70] = true;
+  EXPECT_EQ(bits.count(), 4);
+  EXPECT_TRUE(bits[129]);
+  EXPECT_TRUE(bits.test(70));
+  EXPECT_THROW(bits.test(130), std::out_of_range);
+
+  EXPECT_EQ(bits.find_first(), 0);
+  EXPECT_EQ(bits.find_next(0), 64);
+  EXPECT_EQ(bits.find_next(64), 70);
+  EXPECT_EQ(bits.find_next(70), 129);
+  EXPECT_EQ(bits.find_next(129), npos);
+
+  bitset<130> inverted = ~bits;
+  EXPECT_EQ(inverted.count(), 126);
+  EXPECT_TRUE((inverted & bits).none());
+  EXPECT_TRUE((inverted | bits).all());
+  EXPECT_EQ((inverted ^ bits).count(), 130);
+  inverted.and_not(bitset<130>().set());
+  EXPECT_TRUE(inverted.none());
+
+  bits.flip(0).reset(64);
+  EXPECT_EQ(bits.find_first(), 70);
+
+  constexpr bitset<10> small = bitset<10>(0b1011).set(9);
+  static_assert(small.count() == 4 && small[9] && !small[2]);
+  static_assert(bitset<8>(0x1ff).count() == 8);
+
+  // the storage word of an empty bitset never holds a bit
+  static_assert(bitset<0>().set().count() == 0 && (~bitset<0>()).none());
+  bitset<0> empty;
+  EXPECT_EQ(empty.size(), 0);
+  EXPECT_TRUE(empty.set().none());
+  EXPECT_TRUE(empty.flip().all());
+  EXPECT_EQ(empty.find_first(), npos);
+  EXPECT_TRUE(empty == bitset<0>());
+}
+
+TEST_F(bitset_test, dynamic_bitset)
+{
+  dynamic_bitset bits(100, true);
+  EXPECT_EQ(bits.size(), 100);
+  EXPECT_EQ(bits.count(), 100);
+  EXPECT_EQ(bits.word_count(), 2);
+  EXPECT_TRUE(bits.all());
+
+  bits.resize(200, false);
+  EXPECT_EQ(bits.count(), 100);
+  bits.resize(250, true);
+  EXPECT_EQ(bits.count(), 150);
+  EXPECT_FALSE(bits[150]);
+  EXPECT_TRUE(bits[249]);
+  bits.resize(120);
+  EXPECT_EQ(bits.count(), 100);
+
+  dynamic_bitset pushed;
+  for (int i = 0; i < 300; ++i) pushed.push_back(i % 3 == 0);
+  EXPECT_EQ(pushed.count(), 100);
+  size_t seen = 0;
+  for (size_t i = pushed.find_first(); i != npos; i = pushed.find_next(i))
+  {
+    EXPECT_EQ(i % 3, 0);
+    ++seen;
+  }
+  EXPECT_EQ(seen, 100);
+  pushed.pop_back();
+  EXPECT_EQ(pushed.size(), 299);
+
+  dynamic_bitset single;
+  single.push_back(true);
+  single.pop_back();
+  single.pop_back();
+  EXPECT_EQ(single.size(), 0);
+  EXPECT_TRUE(single.none());
+
+  dynamic_bitset a(1000), b(1000);
+  for (size_t i = 0; i < 1000; i += 2) a.set(i);
+  for (size_t i = 0; i < 1000; i += 3) b.set(i);
+  EXPECT_EQ((a & b).count(), 167);
+  EXPECT_EQ((a | b).count(), 500 + 334 - 167);
+  EXPECT_EQ((a ^ b).count(), 500 + 334 - 2 * 167);
+  EXPECT_EQ(dynamic_bitset(a).and_not(b).count(), 500 - 167);
+  EXPECT_EQ((~a).count(), 500);
+  EXPECT_THROW(a &= dynamic_bitset(999), std::invalid_argument);
+  EXPECT_TRUE(a == a);
+  EXPECT_FALSE(a == b);
+}
+
+TEST_F(bitset_test, rank_select)
+{
+  std::mt19937_64 rng(7);
+  dynamic_bitset bits;
+  for (int i = 0; i < 5000; ++i) bits.push_back(rng() % 5 == 0);
+
+  rank_select index(bits);
+  EXPECT_EQ(index.count(), bits.count());
+  size_t ones = 0;
+  for (size_t i = 0; i <= bits.size(); ++i)
+  {
+    EXPECT_EQ(index.rank1(i), ones);
+    EXPECT_EQ(index.rank0(i), i - ones);
+    if (i < bits.size() && bits[i])
+    {
+      EXPECT_EQ(index.select1(ones), i);
+      ++ones;
+    }
+  }
+  EXPECT_EQ(index.select1(ones), npos);
+
+  bitset<64> word(0x8000000000000001ull);
+  rank_select small(word);
+  EXPECT_EQ(small.rank1(64), 2);
+  EXPECT_EQ(small.select1(1), 63);
+}
@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include "karls_standard_library/charconv.hpp"
+#include "karls_standard_library/string.hpp"
+
+using namespace karls_standard_library;
+
+class charconv_test : public testing::Test
+{
+protected:
+  charconv_test() = default;
+  ~charconv_test() = default;
+
+  template<typename T>
+  std::string format(T value)
+  {
+    char buffer[64];
+    to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value);
+    EXPECT_EQ(result.ec, std::errc{});
+    return std::string(buffer, result.ptr);
+  }
+
+  template<typename T>
+  T parse(const std::string& text, std::errc expected = std::errc{})
+  {
+    T value{};
+    from_chars_result result = from_chars(text.data(), text.data() + text.size(), value);
+    EXPECT_EQ(result.ec, expected) << text;
+    return value;
+  }
+};
+
+TEST_F(charconv_test, integer_to_chars)
+{
+  EXPECT_EQ(format(0), "0");
+  EXPECT_EQ(format(7), "7");
+  EXPECT_EQ(format(10), "10");
+  EXPECT_EQ(format(-99), "-99");
+  EXPECT_EQ(format(1234567890u), "1234567890");
+  EXPECT_EQ(format(std::numeric_limits<std::int64_t>::min()), "-9223372036854775808");
+  EXPECT_EQ(format(std::numeric_limits<std::uint64_t>::max()), "18446744073709551615");
+  EXPECT_EQ(format(static_cast<signed char>(-128)), "-128");
+
+  // every power of ten and its neighbours crosses a digit count boundary
+  std::uint64_t p = 1;
+  for (int i = 0; i < 19; ++i, p *= 10)
+  {
+    EXPECT_EQ(format(p), std::to_string(p));
+    EXPECT_EQ(format(p - 1), std::to_string(p - 1));
+    EXPECT_EQ(format(p + 1), std::to_string(p + 1));
+  }
+}
+
+TEST_F(charconv_test, to_chars_short_buffer)
+{
+  char buffer[4];
+  to_chars_result result = to_chars(buffer, buffer + 4, 12345);
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+  EXPECT_EQ(result.ptr, buffer + 4);
+  result = to_chars(buffer, buffer + 4, 1234);
+  EXPECT_EQ(result.ec, std::errc{});
+  EXPECT_EQ(std::string(buffer, result.ptr), "1234");
+  result = to_chars(buffer, buffer + 4, 0.125);
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+}
+
+TEST_F(charconv_test, integer_from_chars)
+{
+  EXPECT_EQ(parse<int>("0"), 0);
+  EXPECT_EQ(parse<int>("-2147483648"), std::numeric_limits<int>::min());
+  EXPECT_EQ(parse<std::uint64_t>("18446744073709551615"), std::numeric_limits<std::uint64_t>::max());
+  EXPECT_EQ(parse<std::uint64_t>("000000000000000000000012345678901234567"), 12345678901234567u);
+  parse<std::uint64_t>("18446744073709551616", std::errc::result_out_of_range);
+  parse<std::uint64_t>("30000000000000000000", std::errc::result_out_of_range);
+  parse<std::int8_t>("128", std::errc::result_out_of_range);
+  EXPECT_EQ(parse<std::int8_t>("-128"), -128);
+  parse<unsigned>("-1", std::errc::invalid_argument);
+  parse<int>("", std::errc::invalid_argument);
+  parse<int>("+1", std::errc::invalid_argument);
+
+  // parsing stops at the first non digit
+  const char text[] = "12345678901x";
+  long value = 0;
+  from_chars_result result = from_chars(text, text + 12, value);
+  EXPECT_EQ(value, 12345678901);
+  EXPECT_EQ(result.ptr, text + 11);
+
+  // an out of range value is not stored
+  int kept = 5;
+  const char big[] = "99999999999";
+  result = from_chars(big, big + 11, kept);
+  EXPECT_EQ(result.ec, std::errc::result_out_of_range);
+  EXPECT_EQ(result.ptr, big + 11);
+  EXPECT_EQ(kept, 5);
+}
+
+TEST_F(charconv_test, float_to_chars_shortest)
+{
+  EXPECT_EQ(format(0.0), "0");
+  EXPECT_EQ(format(-0.0), "-0");
+  EXPECT_EQ(format(0.1), "0.1");
+  EXPECT_EQ(format(0.1f), "0.1");
+  EXPECT_EQ(format(1.0 / 3.0), "0.3333333333333333");
+  EXPECT_EQ(format(2.5), "2.5");
+  EXPECT_EQ(format(100.0), "100");
+  EXPECT_EQ(format(123456.0), "123456");
+  EXPECT_EQ(format(1e22), "1e+22");
+  EXPECT_EQ(format(1e-7), "1e-07");
+  EXPECT_EQ(format(0.001), "0.001");
+  EXPECT_EQ(format(1.5e300), "1.5e+300");
+  EXPECT_EQ(format(5e-324), "5e-324");
+  EXPECT_EQ(format(std::numeric_limits<double>::max()), "1.7976931348623157e+308");
+  EXPECT_EQ(format(std::numeric_limits<double>::min()), "2.2250738585072014e-308");
+  EXPECT_EQ(format(std::numeric_limits<float>::max()), "3.4028235e+38");
+  EXPECT_EQ(format(std::numeric_limits<float>::denorm_min()), "1e-45");
+  EXPECT_EQ(format(std::numeric_limits<double>::infinity()), "inf");
+  EXPECT_EQ(format(-std::numeric_limits<float>::infinity()), "-inf");
+  EXPECT_EQ(format(std::numeric_limits<double>::quiet_NaN()), "nan");
+
+  // fixed notation of a large integer prints its exact value
+  EXPECT_EQ(format(36028797018963968.0), "36028797018963968");
+}
+
+TEST_F(charconv_test, float_from_chars)
+{
+  EXPECT_EQ(parse<double>("0.1"), 0.1);
+  EXPECT_EQ(parse<double>("-2.5e-3"), -2.5e-3);
+  EXPECT_EQ(parse<double>("1E10"), 1e10);
+  EXPECT_EQ(parse<double>(".5"), 0.5);
+  EXPECT_EQ(parse<double>("5."), 5.0);
+  EXPECT_EQ(parse<float>("3.4028235e38"), std::numeric_limits<float>::max());
+  EXPECT_EQ(parse<double>("4.9406564584124654e-324"), std::numeric_limits<double>::denorm_min());
+  EXPECT_EQ(parse<double>("2.2250738585072011e-308"), 2.2250738585072011e-308);
+  EXPECT_EQ(parse<double>("9007199254740993"), 9007199254740992.0);
+  EXPECT_EQ(parse<double>("123456789012345678901234567890"), 123456789012345678901234567890.0);
+  EXPECT_TRUE(std::signbit(parse<double>("-0")));
+  EXPECT_EQ(parse<double>("-Infinity"), -std::numeric_limits<double>::infinity());
+  EXPECT_TRUE(std::isnan(parse<float>("nan")));
+  parse<double>("1e400", std::errc::result_out_of_range);
+  parse<double>("1e-400", std::errc::result_out_of_range);
+  parse<double>("e5", std::errc::invalid_argument);
+  parse<double>(".", std::errc::invalid_argument);
+
+  // halfway between 1 and the next float: ties to even, one more digit up
+  EXPECT_EQ(parse<float>("1.000000059604644775390625"), 1.0f);
+  EXPECT_EQ(parse<float>("1.00000005960464477539062501"), std::nextafter(1.0f, 2.0f));
+
+  // an exponent marker without digits is left unparsed
+  const char text[] = "1.5e+x";
+  double value = 0;
+  from_chars_result result = from_chars(text, text + 6, value);
+  EXPECT_EQ(value, 1.5);
+  EXPECT_EQ(result.ptr, text + 3);
+}
+
+TEST_F(charconv_test, float_from_chars_long_digits)
+{
+  // exact halfway points between neighbouring floats, and the same digits
+  // with one more nonzero digit, need every digit to round correctly.
+  // the midpoints are exact in the wider type, and strtod in the "C"
+  // locale is the reference
+  std::mt19937_64 rng(13);
+  // the same digits with a 1 appended before the exponent
+  auto above = [](const std::string& s) {
+    size_t e = s.find('e');
+    std::string t(s, 0, e);
+    t += '1';
+    t.append(s, e, std::string::npos);
+    return t;
+  };
+  auto check = [&](const char* text) {
+    std::string s(text);
+    for (const std::string& t : {s, above(s)})
+    {
+      double expected = std::strtod(t.c_str(), nullptr);
+      double value = parse<double>(t, expected == 0 ? std::errc::result_out_of_range : std::errc{});
+      if (expected != 0)
+      {
+        EXPECT_EQ(value, expected) << t;
+      }
+    }
+  };
+  char buffer[1200];
+  for (int i = 0; i < 2000; ++i)
+  {
+    std::uint64_t bits = rng() >> 1;
+    if (i % 4 == 0) bits &= (std::uint64_t(1) << 52) - 1;  // subnormal
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    double next = std::nextafter(d, std::numeric_limits<double>::infinity());
+    if (!std::isfinite(next)) continue;
+    long double middle = (static_cast<long double>(d) + static_cast<long double>(next)) / 2;
+    std::snprintf(buffer, sizeof(buffer), "%.780Le", middle);
+    check(buffer);
+  }
+
+  for (int i = 0; i < 2000; ++i)
+  {
+    std::uint32_t bits = static_cast<std::uint32_t>(rng()) >> 1;
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    float next = std::nextafter(f, std::numeric_limits<float>::infinity());
+    if (!std::isfinite(next)) continue;
+    double middle = (static_cast<double>(f) + static_cast<double>(next)) / 2;
+    std::snprintf(buffer, sizeof(buffer), "%.160e", middle);
+    std::string s(buffer);
+    for (const std::string& t : {s, above(s)})
+    {
+      float expected = std::strtof(t.c_str(), nullptr);
+      float value = parse<float>(t, expected == 0 ? std::errc::result_out_of_range : std::errc{});
+      if (expected != 0)
+      {
+        EXPECT_EQ(value, expected) << t;
+      }
+    }
+  }
+
+  // past 768 digits only whether the rest is zero matters
+  std::string tie(1000, '0');
+  tie.insert(0, "9007199254740993.");
+  EXPECT_EQ(parse<double>(tie), 9007199254740992.0);
+  tie += '1';
+  EXPECT_EQ(parse<double>(tie), 9007199254740994.0);
+  EXPECT_EQ(parse<double>("9007199254740992.99999999999999999999"), 9007199254740992.0);
+}
+
+TEST_F(charconv_test, float_round_trip)
+{
+  std::mt19937_64 rng(7);
+  for (int i = 0; i < 100000; ++i)
+  {
+    std::uint64_t bits = rng();
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    if (std::isnan(d)) continue;
+    std::string text = format(d);
+    EXPECT_LE(text.size(), max_chars<double>);
+    double back = parse<double>(text);
+    EXPECT_EQ(std::memcmp(&back, &d, sizeof(d)), 0) << text;
+
+    std::uint32_t small = static_cast<std::uint32_t>(bits);
+    float f;
+    std::memcpy(&f, &small, sizeof(f));
+    if (std::isnan(f)) continue;
+    text = format(f);
+    EXPECT_LE(text.size(), max_chars<float>);
+    float back_f = parse<float>(text);
+    EXPECT_EQ(std::memcmp(&back_f, &f, sizeof(f)), 0) << text;
+  }
+}
+
+TEST_F(charconv_test, string_append_number)
+{
+  string s;
+  s.append_number(42).append(", ", 2).append_number(-7LL).append(", ", 2).append_number(0.25).append(", ", 2).append_number(1.5f);
+  EXPECT_EQ(string_view(s), string_view("42, -7, 0.25, 1.5"));
+
+  string many;
+  for (int i = 0; i < 1000; ++i) many.append_number(i);
+  EXPECT_EQ(many.size(), 10 + 90 * 2 + 900 * 3);
+}
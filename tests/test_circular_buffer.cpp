@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include "karls_standard_library/circular_buffer.hpp"
+
+using namespace karls_standard_library;
+
+class circular_buffer_test : public testing::Test
+{
+protected:
+  circular_buffer_test() = default;
+  ~circular_buffer_test() = default;
+};
+
+TEST_F(circular_buffer_test, both_ends)
+{
+  circular_buffer<std::string> ring(4);
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.capacity(), 4);
+  EXPECT_TRUE(ring.push_back("b"));
+  EXPECT_TRUE(ring.push_front("a"));
+  EXPECT_TRUE(ring.emplace_back(2, 'c'));
+  EXPECT_TRUE(ring.push_back("d"));
+  EXPECT_TRUE(ring.full());
+  EXPECT_FALSE(ring.push_back("e"));
+  EXPECT_FALSE(ring.push_front("z"));
+
+  EXPECT_EQ(ring.front(), "a");
+  EXPECT_EQ(ring.back(), "d");
+  EXPECT_EQ(ring[2], "cc");
+  EXPECT_THROW(ring.at(4), std::out_of_range);
+
+  ring.pop_front();
+  ring.pop_back();
+  EXPECT_EQ(ring.size(), 2);
+  EXPECT_EQ(ring.front(), "b");
+  EXPECT_EQ(ring.back(), "cc");
+
+  circular_buffer<std::string> copy = ring;
+  ring.clear();
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(copy[1], "cc");
+  ring = std::move(copy);
+  EXPECT_EQ(ring.size(), 2);
+  EXPECT_EQ(ring.capacity(), 4);
+}
+
+TEST_F(circular_buffer_test, overwrite_and_spans)
+{
+  circular_buffer<int> window(5, overflow_mode::overwrite);
+  for (int i = 0; i < 12; ++i) window.push_back(i);
+  EXPECT_EQ(window.size(), 5);
+  EXPECT_EQ(window.front(), 7);
+  EXPECT_EQ(window.back(), 11);
+
+  // contents wrap: 7 8 9 | 10 11 stored as [10 11 7 8 9]
+  auto one = window.array_one();
+  auto two = window.array_two();
+  EXPECT_EQ(one.size() + two.size(), 5);
+  EXPECT_EQ(one[0], 7);
+  int sum = std::accumulate(one.begin(), one.end(), 0) + std::accumulate(two.begin(), two.end(), 0);
+  EXPECT_EQ(sum, 7 + 8 + 9 + 10 + 11);
+
+  // overwriting from the front drops the newest
+  window.push_front(100);
+  EXPECT_EQ(window.front(), 100);
+  EXPECT_EQ(window.back(), 10);
+
+  // random access iterators
+  std::sort(window.begin(), window.end());
+  EXPECT_TRUE(std::is_sorted(window.begin(), window.end()));
+  EXPECT_EQ(window.end() - window.begin(), 5);
+  EXPECT_EQ(*(window.begin() + 4), 100);
+  const auto& view = window;
+  circular_buffer<int>::const_iterator it = window.begin();
+  EXPECT_EQ(it[1], 8);
+  EXPECT_EQ(std::count_if(view.begin(), view.end(), [](int v) { return v > 8; }), 3);
+
+  window.set_mode(overflow_mode::reject);
+  EXPECT_FALSE(window.push_back(1));
+}
+
+TEST_F(circular_buffer_test, static_circular_buffer)
+{
+  static_circular_buffer<std::string, 3> recent(overflow_mode::overwrite);
+  EXPECT_EQ(recent.capacity(), 3);
+  for (int i = 0; i < 10; ++i) recent.push_back(std::to_string(i));
+  EXPECT_EQ(recent.size(), 3);
+  EXPECT_EQ(recent.front(), "7");
+  EXPECT_EQ(recent.back(), "9");
+
+  auto copy = recent;
+  EXPECT_EQ(copy[1], "8");
+  auto moved = std::move(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved[2], "9");
+
+  static_circular_buffer<int, 4> small;
+  for (int i = 0; i < 4; ++i) small.push_back(i);
+  EXPECT_FALSE(small.push_back(4));
+  small.pop_front();
+  small.push_back(4);
+  EXPECT_EQ(small.array_one().size(), 3);
+  EXPECT_EQ(small.array_two().size(), 1);
+  EXPECT_EQ(small.array_two()[0], 4);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "karls_standard_library/concurrent_unordered_map.hpp"
+#include "karls_standard_library/string.hpp"
+
+using namespace karls_standard_library;
+
+class concurrent_unordered_map_test : public testing::Test
+{
+protected:
+  concurrent_unordered_map_test() = default;
+  ~concurrent_unordered_map_test() = default;
+
+  static constexpr int threads = 4;
+  static constexpr int keys = 2000;
+};
+
+TEST_F(concurrent_unordered_map_test, insert_find_erase)
+{
+  concurrent_unordered_map<int, string> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.insert(1, string("one")));
+  EXPECT_FALSE(map.insert(1, string("uno")));
+  EXPECT_EQ(*map.find(1), "one");
+  EXPECT_FALSE(map.find(2).has_value());
+
+  EXPECT_TRUE(map.insert_or_assign(2, string("two")));
+  EXPECT_FALSE(map.insert_or_assign(2, string("dos")));
+  EXPECT_EQ(*map.find(2), "dos");
+  EXPECT_EQ(map.size(), 2);
+
+  EXPECT_TRUE(map.erase(1));
+  EXPECT_FALSE(map.erase(1));
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_TRUE(map.contains(2));
+  EXPECT_EQ(map.size(), 1);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST_F(concurrent_unordered_map_test, update_and_visit)
+{
+  concurrent_unordered_map<string, int> map(4);
+  EXPECT_EQ(map.shard_count(), 4);
+  EXPECT_FALSE(map.update(string("a"), [](int& v) { ++v; }));
+  map.insert(string("a"), 1);
+  EXPECT_TRUE(map.update(string("a"), [](int& v) { v += 10; }));
+
+  int seen = 0;
+  EXPECT_TRUE(map.visit(string("a"), [&](const int& v) { seen = v; }));
+  EXPECT_EQ(seen, 11);
+
+  map.upsert(string("b"), [](int& v) { ++v; }, 41);
+  map.upsert(string("b"), [](int& v) { ++v; }, 0);
+  EXPECT_EQ(*map.find(string("b")), 43);
+}
+
+TEST_F(concurrent_unordered_map_test, growth_and_erase_keep_probe_runs)
+{
+  // one shard so every key shares a table and probe runs get long
+  concurrent_unordered_map<int, int> map(1);
+  for (int i = 0; i < keys; ++i) map.insert(i, i * 2);
+  EXPECT_EQ(map.size(), keys);
+  for (int i = 0; i < keys; i += 2) EXPECT_TRUE(map.erase(i));
+  EXPECT_EQ(map.size(), keys / 2);
+  for (int i = 0; i < keys; ++i)
+  {
+    auto value = map.find(i);
+    if (i % 2 == 0) EXPECT_FALSE(value.has_value());
+    else EXPECT_EQ(*value, i * 2);
+  }
+}
+
+TEST_F(concurrent_unordered_map_test, for_each_shard)
+{
+  concurrent_unordered_map<int, int> map(8);
+  for (int i = 0; i < keys; ++i) map.insert(i, 1);
+
+  long total = 0;
+  size_t shards = 0;
+  map.for_each_shard([&](size_t index) {
+    ++shards;
+    map.for_each_in_shard(index, [&](const int&, int& v) {
+      total += v;
+      v = 2;
+    });
+  });
+  EXPECT_EQ(shards, 8);
+  EXPECT_EQ(total, keys);
+
+  total = 0;
+  map.for_each([&](const int&, int& v) { total += v; });
+  EXPECT_EQ(total, 2 * keys);
+}
+
+TEST_F(concurrent_unordered_map_test, concurrent_writers_and_readers)
+{
+  concurrent_unordered_map<int, long> map;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&map, t]() {
+      for (int i = 0; i < keys; ++i)
+      {
+        // disjoint keys per thread plus one shared counter per key
+        map.insert_or_assign(t * keys + i, static_cast<long>(i));
+        map.upsert(-1 - i, [](long& v) { ++v; }, 0L);
+        map.find(i);
+        if (i % 64 == 0) std::this_thread::yield();
+      }
+    });
+  }
+  for (auto& w : workers) w.join();
+
+  EXPECT_EQ(map.size(), static_cast<size_t>(threads * keys + keys));
+  for (int i = 0; i < keys; ++i)
+  {
+    EXPECT_EQ(*map.find(-1 - i), threads);
+    EXPECT_EQ(*map.find((threads - 1) * keys + i), i);
+  }
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include "karls_standard_library/format.hpp"
+
+using namespace karls_standard_library;
+
+class format_test : public testing::Test
+{
+protected:
+  format_test() = default;
+  ~format_test() = default;
+};
+
+struct point {
+  int x;
+  int y;
+};
+
+// sized user formatter, written in place like the built in ones
+template<>
+struct karls_standard_library::formatter<point> {
+  size_t size(const point& p) const noexcept { return 3 + formatter<int>{}.size(p.x) + formatter<int>{}.size(p.y); }
+  char* write(char* out, const point& p) const noexcept
+  {
+    *out++ = '(';
+    out = formatter<int>{}.write(out, p.x);
+    *out++ = ',';
+    out = formatter<int>{}.write(out, p.y);
+    *out++ = ')';
+    return out;
+  }
+};
+
+struct tags {
+  int count;
+};
+
+// appending user formatter, for output with no size bound up front
+template<>
+struct karls_standard_library::formatter<tags> {
+  void append(string& out, const tags& t) const
+  {
+    for (int i = 0; i < t.count; ++i) format_to<"[{}]">(out, i);
+  }
+};
+
+template<fixed_string Fmt, typename... Args>
+constexpr bool formats = requires(const Args&... args) { format<Fmt>(args...); };
+
+TEST_F(format_test, builtin_types)
+{
+  string s = format<"{} + {} = {}">(1, 2, 3);
+  EXPECT_EQ(string_view(s), "1 + 2 = 3");
+
+  s = format<"{}|{}|{}|{}">(-42, std::numeric_limits<std::uint64_t>::max(), 'x', true);
+  EXPECT_EQ(string_view(s), "-42|18446744073709551615|x|true");
+
+  s = format<"{} {} {}">(0.1, 2.5f, 1e100);
+  EXPECT_EQ(string_view(s), "0.1 2.5 1e+100");
+
+  string name("karl");
+  const char* greeting = "hello";
+  s = format<"{}, {}{}">(greeting, name, "!");
+  EXPECT_EQ(string_view(s), "hello, karl!");
+
+  s = format<"{} and {}">(string_view("view"), "fixed"_fs);
+  EXPECT_EQ(string_view(s), "view and fixed");
+}
+
+TEST_F(format_test, literal_text_and_escapes)
+{
+  EXPECT_EQ(string_view(format<"no arguments">()), "no arguments");
+  EXPECT_EQ(string_view(format<"">()), "");
+  EXPECT_EQ(string_view(format<"{{{}}}">(7)), "{7}");
+  EXPECT_EQ(string_view(format<"{{}}">()), "{}");
+  EXPECT_EQ(string_view(format<"{}{}">(1, 2)), "12");
+}
+
+TEST_F(format_test, argument_count_is_checked)
+{
+  static_assert(formats<"{}", int>);
+  static_assert(!formats<"{}">);
+  static_assert(!formats<"{}", int, int>);
+  static_assert(!formats<"{{}}", int>);
+}
+
+TEST_F(format_test, user_formatters)
+{
+  string s = format<"p = {}">(point{3, -4});
+  EXPECT_EQ(string_view(s), "p = (3,-4)");
+
+  s = format<"{}: {} after {}">("tags", tags{3}, point{0, 0});
+  EXPECT_EQ(string_view(s), "tags: [0][1][2] after (0,0)");
+}
+
+TEST_F(format_test, format_to_appends_in_place)
+{
+  string line("log: ");
+  format_to<"{} items in {} ms">(line, 12, 3.5);
+  EXPECT_EQ(string_view(line), "log: 12 items in 3.5 ms");
+
+  // a reused buffer stops allocating once it is large enough
+  string buffer;
+  buffer.reserve(256);
+  const char* data = buffer.data();
+  for (int i = 0; i < 100; ++i)
+  {
+    buffer.clear();
+    format_to<"request {} took {} us: {}">(buffer, i, i * 1.5, "ok");
+  }
+  EXPECT_EQ(buffer.data(), data);
+  EXPECT_EQ(string_view(buffer), "request 99 took 148.5 us: ok");
+}
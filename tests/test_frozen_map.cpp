@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <sstream>
+#include "karls_standard_library/fixed_string.hpp"
+#include "karls_standard_library/frozen_map.hpp"
+#include "karls_standard_library/frozen_set.hpp"
+#include "karls_standard_library/string.hpp"
+
+using namespace karls_standard_library;
+
+class frozen_map_test : public testing::Test
+{
+protected:
+  frozen_map_test() = default;
+  ~frozen_map_test() = default;
+};
+
+// fixed_string as a non-type template parameter
+template<fixed_string Name>
+struct opcode {
+  static constexpr string_view name() { return Name; }
+};
+
+enum class token { kw_if, kw_else, kw_while, kw_for, kw_return, kw_break, kw_continue };
+
+constexpr auto keywords = make_frozen_map<string_view, token>({
+  {"if", token::kw_if}, {"else", token::kw_else}, {"while", token::kw_while},
+  {"for", token::kw_for}, {"return", token::kw_return}, {"break", token::kw_break},
+  {"continue", token::kw_continue}
+});
+
+TEST_F(frozen_map_test, fixed_string)
+{
+  constexpr fixed_string hello("hello");
+  static_assert(hello.size() == 5);
+  static_assert(hello == fixed_string("hello"));
+  static_assert(hello != fixed_string("hell"));
+  static_assert(hello < fixed_string("help"));
+  static_assert((hello + fixed_string(", world")).view() == "hello, world");
+  static_assert("abc"_fs.size() == 3);
+  static_assert(opcode<"add">::name() == "add");
+  static_assert(!std::is_same_v<opcode<"add">, opcode<"sub">>);
+
+  EXPECT_STREQ(hello.c_str(), "hello");
+  EXPECT_EQ(hash<fixed_string<5>>{}(hello), hash<string_view>{}(string_view("hello")));
+  std::ostringstream os;
+  os << hello;
+  EXPECT_EQ(os.str(), "hello");
+}
+
+TEST_F(frozen_map_test, compile_time_lookup)
+{
+  static_assert(keywords.size() == 7);
+  static_assert(*keywords.find("while") == token::kw_while);
+  static_assert(keywords.at("continue") == token::kw_continue);
+  static_assert(!keywords.contains("goto"));
+  static_assert(keywords.find("") == nullptr);
+  static_assert(keywords.value_or("iff", token::kw_break) == token::kw_break);
+
+  // the same lookups at run time must agree with the compile time hash
+  string word("return");
+  EXPECT_EQ(keywords.at(word), token::kw_return);
+  EXPECT_EQ(keywords.count(string_view("els")), 0);
+  EXPECT_THROW(keywords.at("goto"), std::out_of_range);
+
+  size_t visited = 0;
+  keywords.for_each([&](string_view key, token value) {
+    EXPECT_EQ(keywords.at(key), value);
+    EXPECT_EQ(keywords.index_of(key), visited);
+    ++visited;
+  });
+  EXPECT_EQ(visited, 7);
+}
+
+TEST_F(frozen_map_test, integer_keys_and_sets)
+{
+  constexpr auto squares = make_frozen_map<int, int>({
+    {1, 1}, {2, 4}, {3, 9}, {4, 16}, {5, 25}, {-6, 36}, {1000000, 0}
+  });
+  static_assert(squares.at(-6) == 36);
+  static_assert(!squares.contains(6));
+
+  constexpr auto primes = make_frozen_set<int>({2, 3, 5, 7, 11, 13, 17, 19, 23, 29});
+  static_assert(primes.contains(23) && !primes.contains(21));
+  static_assert(primes.index_of(4) == npos);
+  int sum = 0;
+  for (int p : primes) sum += p;
+  EXPECT_EQ(sum, 129);
+
+  constexpr auto single = make_frozen_set<string_view>({"only"});
+  static_assert(single.contains("only") && !single.contains("other"));
+}
+
+TEST_F(frozen_map_test, large_runtime_build)
+{
+  // the same constexpr builder also runs at run time
+  static string storage[3000];
+  static Pair<string_view, int> items[3000];
+  for (int i = 0; i < 3000; ++i)
+  {
+    storage[i] = "key_";
+    for (int n = i; ; n /= 10)
+    {
+      storage[i] += static_cast<char>('0' + n % 10);
+      if (n < 10) break;
+    }
+    items[i] = Pair<string_view, int>(string_view(storage[i]), i);
+  }
+  auto* map = new frozen_map<string_view, int, 3000>(items);
+  for (int i = 0; i < 3000; ++i) EXPECT_EQ(map->at(storage[i]), i);
+  EXPECT_FALSE(map->contains("key_"));
+  EXPECT_FALSE(map->contains("key_3000"));
+  delete map;
+
+  Pair<string_view, int> duplicates[3] = {{"a", 1}, {"b", 2}, {"a", 3}};
+  EXPECT_THROW((frozen_map<string_view, int, 3>(duplicates)), std::invalid_argument);
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <set>
+#include "karls_standard_library/functional.hpp"
+#include "karls_standard_library/string.hpp"
+#include "karls_standard_library/string_view.hpp"
+#include "karls_standard_library/vector.hpp"
+#include "karls_standard_library/array.hpp"
+#include "karls_standard_library/utility.hpp"
+#include "karls_standard_library/intern_pool.hpp"
+#include "karls_standard_library/memory.hpp"
+
+using namespace karls_standard_library;
+
+class functional_test : public testing::Test
+{
+protected:
+  functional_test() = default;
+  ~functional_test() = default;
+};
+
+TEST_F(functional_test, comparators)
+{
+  EXPECT_TRUE(less<int>{}(1, 2));
+  EXPECT_TRUE(greater<int>{}(2, 1));
+  EXPECT_TRUE(equal_to<int>{}(3, 3));
+  EXPECT_TRUE(not_equal_To<int>{}(3, 4));
+}
+
+TEST_F(functional_test, integer_hash)
+{
+  std::set<size_t> seen;
+  for (int i = 0; i < 10000; ++i) seen.insert(hash<int>{}(i));
+  EXPECT_EQ(seen.size(), 10000);
+
+  // consecutive keys must differ in the low bits tables index with
+  std::set<size_t> buckets;
+  for (int i = 0; i < 64; ++i) buckets.insert(hash<int>{}(i) & 1023);
+  EXPECT_GT(buckets.size(), 55);
+
+  EXPECT_TRUE(is_avalanching_v<hash<int>>);
+  EXPECT_TRUE(is_avalanching_v<hash<string>>);
+  EXPECT_FALSE(is_avalanching_v<hash<vector<int>>>);
+}
+
+TEST_F(functional_test, float_and_pointer_hash)
+{
+  EXPECT_EQ(hash<double>{}(0.0), hash<double>{}(-0.0));
+  EXPECT_NE(hash<double>{}(1.0), hash<double>{}(2.0));
+
+  // equal long doubles hash equal whatever their padding bytes hold
+  unsigned char zeros[sizeof(long double)] = {};
+  unsigned char ones[sizeof(long double)];
+  std::memset(ones, 0xff, sizeof(ones));
+  long double value = 1.5L;
+  std::memcpy(zeros, &value, hash<long double>::value_bytes);
+  std::memcpy(ones, &value, hash<long double>::value_bytes);
+  long double x, y;
+  std::memcpy(&x, zeros, sizeof(x));
+  std::memcpy(&y, ones, sizeof(y));
+  EXPECT_EQ(hash<long double>{}(x), hash<long double>{}(y));
+  EXPECT_EQ(hash<long double>{}(x), hash<long double>{}(1.5L));
+  EXPECT_NE(hash<long double>{}(1.5L), hash<long double>{}(2.5L));
+  int a = 0, b = 0;
+  EXPECT_NE(hash<int*>{}(&a), hash<int*>{}(&b));
+  EXPECT_EQ(hash<int*>{}(&a), hash<int*>{}(&a));
+}
+
+TEST_F(functional_test, string_hash)
+{
+  string s("metric_name");
+  intern_pool pool;
+  EXPECT_EQ(hash<string>{}(s), hash<string_view>{}("metric_name"));
+  EXPECT_EQ(hash<interned_string>{}(pool.intern(s)), hash<string>{}(s));
+  EXPECT_NE(hash<string>{}(s), hash<string>{}(string("metric_namf")));
+  EXPECT_EQ(hash<string>{}(string()), hash<string_view>{}(""));
+}
+
+TEST_F(functional_test, long_input_hash)
+{
+  // every length across the short, medium and striped paths
+  string text(5000, 'x');
+  std::set<size_t> by_length;
+  for (size_t n = 0; n <= text.size(); ++n)
+  {
+    by_length.insert(hash_bytes(text.data(), n));
+  }
+  EXPECT_EQ(by_length.size(), text.size() + 1);
+
+  // a single flipped bit anywhere changes the hash
+  size_t base = hash_bytes(text.data(), text.size());
+  for (size_t i = 0; i < text.size(); i += 61)
+  {
+    text[i] ^= 1;
+    EXPECT_NE(hash_bytes(text.data(), text.size()), base);
+    text[i] ^= 1;
+  }
+
+  // swapping two stripes changes the hash
+  string swapped = text;
+  for (size_t i = 0; i < 64; ++i)
+  {
+    text[i] = 'a';
+    text[64 + i] = 'b';
+    swapped[i] = 'b';
+    swapped[64 + i] = 'a';
+  }
+  EXPECT_NE(hash_bytes(text.data(), text.size()), hash_bytes(swapped.data(), swapped.size()));
+}
+
+TEST_F(functional_test, container_hash)
+{
+  vector<int> v1{1, 2, 3};
+  vector<int> v2{1, 2, 3};
+  vector<int> v3{3, 2, 1};
+  EXPECT_EQ(hash<vector<int>>{}(v1), hash<vector<int>>{}(v2));
+  EXPECT_NE(hash<vector<int>>{}(v1), hash<vector<int>>{}(v3));
+
+  array<int, 3> a{1, 2, 3};
+  size_t array_hash = hash<array<int, 3>>{}(a);
+  EXPECT_EQ(array_hash, hash<vector<int>>{}(v1));
+
+  vector<string> words{"a", "b"};
+  vector<string> other{"ab", ""};
+  EXPECT_NE(hash<vector<string>>{}(words), hash<vector<string>>{}(other));
+
+  using int_pair = Pair<int, int>;
+  int_pair p(1, 2);
+  int_pair q(2, 1);
+  EXPECT_NE(hash<int_pair>{}(p), hash<int_pair>{}(q));
+}
+
+namespace {
+  int add(int a, int b) { return a + b; }
+}
+
+TEST_F(functional_test, function_basics)
+{
+  function<int(int, int)> empty;
+  EXPECT_FALSE(empty);
+  EXPECT_TRUE(empty == nullptr);
+  EXPECT_THROW(empty(1, 2), std::bad_function_call);
+
+  function<int(int, int)> f = add;
+  EXPECT_TRUE(f);
+  EXPECT_EQ(f(2, 3), 5);
+
+  int offset = 10;
+  f = [offset](int a, int b) { return a * b + offset; };
+  EXPECT_EQ(f(2, 3), 16);
+
+  function<int(int, int)> copy = f;
+  function<int(int, int)> moved = move(f);
+  EXPECT_FALSE(f);
+  EXPECT_EQ(copy(1, 1), 11);
+  EXPECT_EQ(moved(1, 1), 11);
+  moved = nullptr;
+  EXPECT_FALSE(moved);
+}
+
+TEST_F(functional_test, function_storage)
+{
+  struct small { void* a; void* b; int operator()() const { return 1; } };
+  struct large { char bytes[256]; int operator()() const { return bytes[0]; } };
+  EXPECT_TRUE((function<int()>::fits_inline<small>()));
+  EXPECT_FALSE((function<int()>::fits_inline<large>()));
+  EXPECT_TRUE((function<int(), 256>::fits_inline<large>()));
+
+  // heap stored callables keep working through copies and moves
+  large l{};
+  l.bytes[0] = 7;
+  function<int()> f = l;
+  function<int()> g = f;
+  function<int()> h = move(f);
+  EXPECT_EQ(g(), 7);
+  EXPECT_EQ(h(), 7);
+
+  // stateful callables keep their own state per copy
+  int calls = 0;
+  function<int()> counter = [calls]() mutable { return ++calls; };
+  EXPECT_EQ(counter(), 1);
+  function<int()> counter_copy = counter;
+  EXPECT_EQ(counter(), 2);
+  EXPECT_EQ(counter_copy(), 2);
+}
+
+TEST_F(functional_test, move_only_function)
+{
+  unique_ptr<int> p(new int(42));
+  move_only_function<int()> f = [p = move(p)]() mutable { return *p; };
+  EXPECT_EQ(f(), 42);
+
+  move_only_function<int()> g = move(f);
+  EXPECT_FALSE(f);
+  EXPECT_EQ(g(), 42);
+
+  move_only_function<void(int&)> inc = [](int& x) { ++x; };
+  int x = 1;
+  inc(x);
+  EXPECT_EQ(x, 2);
+}
+
+TEST_F(functional_test, function_ref)
+{
+  int total = 0;
+  auto accumulate = [&total](int x) { total += x; };
+  function_ref<void(int)> ref = accumulate;
+  ref(3);
+  ref(4);
+  EXPECT_EQ(total, 7);
+
+  function_ref<int(int, int)> fn = add;
+  EXPECT_EQ(fn(20, 22), 42);
+
+  auto apply = [](function_ref<int(int)> f, int x) { return f(x); };
+  EXPECT_EQ(apply([](int x) { return x * 2; }, 21), 42);
+  EXPECT_EQ(sizeof(function_ref<int(int)>), 2 * sizeof(void*));
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include "karls_standard_library/hive.hpp"
+
+using namespace karls_standard_library;
+
+class hive_test : public testing::Test
+{
+protected:
+  hive_test() = default;
+  ~hive_test() = default;
+};
+
+TEST_F(hive_test, stable_pointers)
+{
+  hive<std::string> h;
+  vector<std::string*> pointers;
+  for (int i = 0; i < 100; ++i) pointers.push_back(&*h.insert(std::to_string(i)));
+  EXPECT_EQ(h.size(), 100);
+  EXPECT_GE(h.capacity(), 100);
+
+  for (int i = 0; i < 100; i += 3) h.erase(h.get_iterator(pointers[i]));
+  EXPECT_EQ(h.size(), 66);
+  for (int i = 1; i < 100; i += 3) EXPECT_EQ(*pointers[i], std::to_string(i));
+
+  // erased slots are reused before new storage is touched
+  size_t capacity = h.capacity();
+  for (int i = 0; i < 34; ++i) h.emplace(3, 'x');
+  EXPECT_EQ(h.capacity(), capacity);
+  EXPECT_EQ(h.size(), 100);
+  for (int i = 2; i < 100; i += 3) EXPECT_EQ(*pointers[i], std::to_string(i));
+
+  size_t xs = 0;
+  for (const std::string& s : h) xs += (s == "xxx");
+  EXPECT_EQ(xs, 34);
+  EXPECT_EQ(h.get_iterator(nullptr), h.end());
+}
+
+TEST_F(hive_test, matches_reference_model)
+{
+  std::mt19937 rng(11);
+  hive<int> h;
+  vector<int*> live;
+  long expected = 0;
+  for (int step = 0; step < 20000; ++step)
+  {
+    if (live.empty() || rng() % 3 != 0)
+    {
+      int value = static_cast<int>(rng() % 1000);
+      live.push_back(&*h.insert(value));
+      expected += value;
+    }
+    else
+    {
+      size_t k = rng() % live.size();
+      expected -= *live[k];
+      h.erase(h.get_iterator(live[k]));
+      live[k] = live.back();
+      live.pop_back();
+    }
+  }
+  EXPECT_EQ(h.size(), live.size());
+  long sum = 0;
+  size_t count = 0;
+  for (int v : h)
+  {
+    sum += v;
+    ++count;
+  }
+  EXPECT_EQ(sum, expected);
+  EXPECT_EQ(count, live.size());
+
+  // erase while iterating
+  for (auto it = h.begin(); it != h.end();)
+  {
+    if (*it % 2) it = h.erase(it);
+    else ++it;
+  }
+  for (int v : h) EXPECT_EQ(v % 2, 0);
+
+  hive<int> copy = h;
+  EXPECT_EQ(copy.size(), h.size());
+  h.clear();
+  EXPECT_TRUE(h.empty());
+  EXPECT_EQ(h.begin(), h.end());
+  h = std::move(copy);
+  EXPECT_FALSE(h.empty());
+}
+
+TEST_F(hive_test, erase_between_runs)
+{
+  // erasing the slot between two runs merges them; the old start of the
+  // right run must not be reused as if it were still a run
+  hive<int> h;
+  vector<int*> slots;
+  for (int i = 0; i < 8; ++i) slots.push_back(&*h.insert(i));
+  h.erase(h.get_iterator(slots[2]));
+  h.erase(h.get_iterator(slots[4]));
+  h.erase(h.get_iterator(slots[3]));
+  h.insert(100);
+  EXPECT_EQ(h.size(), 6);
+  std::multiset<int> seen(h.begin(), h.end());
+  EXPECT_EQ(seen, (std::multiset<int>{0, 1, 5, 6, 7, 100}));
+
+  // full contents against a reference after every step
+  std::mt19937 rng(3);
+  hive<int> model_hive;
+  std::multiset<int> model;
+  vector<int*> live;
+  for (int step = 0; step < 3000; ++step)
+  {
+    if (live.empty() || rng() % 2 != 0)
+    {
+      int value = static_cast<int>(rng() % 100);
+      live.push_back(&*model_hive.insert(value));
+      model.insert(value);
+    }
+    else
+    {
+      size_t k = rng() % live.size();
+      model.erase(model.find(*live[k]));
+      model_hive.erase(model_hive.get_iterator(live[k]));
+      live[k] = live.back();
+      live.pop_back();
+    }
+    ASSERT_EQ(std::multiset<int>(model_hive.begin(), model_hive.end()), model) << "step " << step;
+  }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "karls_standard_library/integer_sets.hpp"
+
+using namespace karls_standard_library;
+
+class integer_sets_test : public testing::Test
+{
+protected:
+  integer_sets_test() = default;
+  ~integer_sets_test() = default;
+
+  // n distinct sorted values below limit
+  static std::vector<uint32_t> sorted_sample(std::mt19937& rng, size_t n, uint32_t limit)
+  {
+    std::vector<uint32_t> values;
+    values.reserve(n * 2);
+    std::uniform_int_distribution<uint32_t> pick(0, limit - 1);
+    while (values.size() < n * 2) values.push_back(pick(rng));
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    values.resize(std::min(values.size(), n));
+    return values;
+  }
+
+  static std::vector<uint32_t> expected(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b)
+  {
+    std::vector<uint32_t> out;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    return out;
+  }
+
+  // run a kernel into an output of exactly min(a, b) elements, so the
+  // sanitizers catch any write past it
+  template<typename Kernel>
+  static std::vector<uint32_t> run(Kernel kernel, const std::vector<uint32_t>& a, const std::vector<uint32_t>& b)
+  {
+    std::vector<uint32_t> out(std::min(a.size(), b.size()));
+    size_t n = kernel(a.data(), a.size(), b.data(), b.size(), out.data());
+    out.resize(n);
+    return out;
+  }
+};
+
+TEST_F(integer_sets_test, kernels_match_std)
+{
+  std::mt19937 rng(7);
+  const size_t sizes[] = {0, 1, 7, 8, 9, 31, 64, 100, 1000};
+  for (size_t na : sizes)
+  {
+    for (size_t nb : sizes)
+    {
+      for (uint32_t limit : {16u, 200u, 5000u, 4000000000u})
+      {
+        auto a = sorted_sample(rng, na, limit);
+        auto b = sorted_sample(rng, nb, limit);
+        auto want = expected(a, b);
+
+        EXPECT_EQ(run(detail::intersect_scalar<true>, a, b), want);
+        EXPECT_EQ(detail::intersect_scalar<false>(a.data(), a.size(), b.data(), b.size(), nullptr), want.size());
+        if (!a.empty())
+        {
+          EXPECT_EQ(run(detail::intersect_galloping<true>, a, b), want);
+          EXPECT_EQ(detail::intersect_galloping<false>(a.data(), a.size(), b.data(), b.size(), nullptr), want.size());
+        }
+#if defined(__AVX2__)
+        EXPECT_EQ(run(detail::intersect_avx2<true>, a, b), want);
+        EXPECT_EQ(detail::intersect_avx2<false>(a.data(), a.size(), b.data(), b.size(), nullptr), want.size());
+#endif
+        EXPECT_EQ(run(detail::intersect<true>, a, b), want);
+        EXPECT_EQ(intersection_size(a.data(), a.size(), b.data(), b.size()), want.size());
+      }
+    }
+  }
+}
+
+TEST_F(integer_sets_test, skewed_sizes)
+{
+  std::mt19937 rng(11);
+  for (size_t ratio : {1, 10, 100, 1000, 10000})
+  {
+    auto large = sorted_sample(rng, 200000, 1u << 22);
+    auto small = sorted_sample(rng, std::max<size_t>(1, large.size() / ratio), 1u << 22);
+    // make sure some elements match
+    for (size_t i = 0; i < small.size(); i += 3) small[i] = large[i * ratio % large.size()];
+    std::sort(small.begin(), small.end());
+    small.erase(std::unique(small.begin(), small.end()), small.end());
+
+    auto want = expected(small, large);
+    EXPECT_EQ(run(detail::intersect<true>, small, large), want);
+    EXPECT_EQ(run(detail::intersect<true>, large, small), want);
+    EXPECT_EQ(intersection_size(large.data(), large.size(), small.data(), small.size()), want.size());
+  }
+}
+
+TEST_F(integer_sets_test, counting_and_vectors)
+{
+  vector<uint32_t> a{1, 3, 5, 7, 9, 11, 13, 15, 17, 19};
+  vector<uint32_t> b{3, 4, 5, 6, 7, 19, 20};
+
+  EXPECT_EQ(intersect_sorted(a, b), (vector<uint32_t>{3, 5, 7, 19}));
+  EXPECT_EQ(intersection_size(a.data(), a.size(), b.data(), b.size()), 4u);
+  EXPECT_EQ(union_size(a.data(), a.size(), b.data(), b.size()), 13u);
+  EXPECT_EQ(difference_size(a.data(), a.size(), b.data(), b.size()), 6u);
+  EXPECT_EQ(difference_size(b.data(), b.size(), a.data(), a.size()), 3u);
+
+  vector<uint32_t> none{2, 4};
+  EXPECT_TRUE(intersect_sorted(a, none).empty());
+  EXPECT_TRUE(intersect_sorted(a, vector<uint32_t>{}).empty());
+
+  static_assert([] {
+    uint32_t x[] = {1, 2, 3, 10};
+    uint32_t y[] = {2, 3, 4};
+    uint32_t out[3] = {};
+    return intersect_sorted(x, 4, y, 3, out) == 2 && out[0] == 2 && out[1] == 3;
+  }());
+}
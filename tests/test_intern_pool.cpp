@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "karls_standard_library/intern_pool.hpp"
+#include "karls_standard_library/string.hpp"
+
+using namespace karls_standard_library;
+
+class intern_pool_test : public testing::Test
+{
+protected:
+  intern_pool_test() = default;
+  ~intern_pool_test() = default;
+
+  intern_pool pool;
+};
+
+TEST_F(intern_pool_test, default_handle)
+{
+  interned_string s;
+  EXPECT_FALSE(s);
+  EXPECT_TRUE(s.empty());
+  EXPECT_STREQ(s.c_str(), "");
+  EXPECT_EQ(sizeof(s), sizeof(void*));
+}
+
+TEST_F(intern_pool_test, same_text_same_handle)
+{
+  string text("requests_total");
+  interned_string a = pool.intern("requests_total");
+  interned_string b = pool.intern(text);
+  interned_string c = pool.intern("errors_total");
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a == c);
+  EXPECT_EQ(a.data(), b.data());
+  EXPECT_EQ(a.hash(), b.hash());
+  EXPECT_STREQ(a.c_str(), "requests_total");
+  EXPECT_EQ(a.str(), text);
+  EXPECT_EQ(pool.size(), 2);
+  EXPECT_EQ(pool.string_bytes(), 26);
+}
+
+TEST_F(intern_pool_test, find_does_not_insert)
+{
+  EXPECT_FALSE(pool.find("missing"));
+  interned_string a = pool.intern("present");
+  EXPECT_TRUE(pool.find("present") == a);
+  EXPECT_FALSE(pool.find("missing"));
+  EXPECT_EQ(pool.size(), 1);
+  EXPECT_TRUE(pool.intern("") == pool.intern(""));
+  EXPECT_TRUE(pool.intern(""));
+}
+
+TEST_F(intern_pool_test, growth_keeps_handles)
+{
+  std::vector<interned_string> handles;
+  for (int i = 0; i < 5000; ++i)
+  {
+    handles.push_back(pool.intern(std::to_string(i).c_str()));
+  }
+  EXPECT_EQ(pool.size(), 5000);
+  for (int i = 0; i < 5000; ++i)
+  {
+    interned_string again = pool.intern(std::to_string(i).c_str());
+    EXPECT_TRUE(again == handles[i]);
+    EXPECT_STREQ(again.c_str(), std::to_string(i).c_str());
+  }
+  EXPECT_GT(pool.memory_usage(), pool.string_bytes());
+}
+
+TEST_F(intern_pool_test, concurrent_intern)
+{
+  const int threads = 4;
+  const int names = 2000;
+  std::vector<std::vector<interned_string>> results(threads);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([this, t, &results]() {
+      for (int i = 0; i < names; ++i)
+      {
+        std::string name = "metric_" + std::to_string((i * 7 + t) % names);
+        results[t].push_back(pool.intern(name.c_str()));
+      }
+    });
+  }
+  for (std::thread& w : workers) w.join();
+
+  EXPECT_EQ(pool.size(), names);
+  for (int t = 0; t < threads; ++t)
+  {
+    for (int i = 0; i < names; ++i)
+    {
+      std::string name = "metric_" + std::to_string((i * 7 + t) % names);
+      EXPECT_TRUE(results[t][i] == pool.find(name.c_str()));
+    }
+  }
+}
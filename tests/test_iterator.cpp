@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include "karls_standard_library/iterator.hpp"
+#include "karls_standard_library/algorithm.hpp"
+#include "karls_standard_library/vector.hpp"
+#include "karls_standard_library/string.hpp"
+#include "karls_standard_library/array.hpp"
+
+using namespace karls_standard_library;
+
+class iterator_test : public testing::Test
+{
+protected:
+  iterator_test() = default;
+  ~iterator_test() = default;
+};
+
+// every contiguous container iterator models the strongest standard concept
+static_assert(std::contiguous_iterator<vector<int>::iterator>);
+static_assert(std::contiguous_iterator<vector<int>::const_iterator>);
+static_assert(std::contiguous_iterator<string::iterator>);
+static_assert(std::contiguous_iterator<string::const_iterator>);
+static_assert(std::contiguous_iterator<array<int, 4>::iterator>);
+static_assert(std::contiguous_iterator<array<int, 4>::const_iterator>);
+static_assert(std::ranges::contiguous_range<vector<int>>);
+static_assert(std::ranges::contiguous_range<const string>);
+
+static_assert(std::is_same_v<std::iter_reference_t<vector<int>::const_iterator>, const int&>);
+static_assert(std::is_convertible_v<vector<int>::iterator, vector<int>::const_iterator>);
+static_assert(!std::is_convertible_v<vector<int>::const_iterator, vector<int>::iterator>);
+static_assert(!std::is_convertible_v<vector<int>::iterator, vector<long>::iterator>);
+
+static_assert(std::random_access_iterator<vector<int>::reverse_iterator>);
+static_assert(std::random_access_iterator<move_iterator<vector<int>::iterator>>);
+static_assert(std::is_same_v<std::iter_reference_t<move_iterator<vector<int>::iterator>>, int&&>);
+static_assert(std::output_iterator<back_insert_iterator<vector<int>>, int>);
+
+// copies between contiguous ranges of trivially copyable elements use memmove
+static_assert(detail::is_memmove_copyable_v<vector<int>::const_iterator, vector<int>::iterator>);
+static_assert(detail::is_memmove_copyable_v<string::const_iterator, char*>);
+static_assert(detail::is_memmove_copyable_v<array<double, 4>::iterator, vector<double>::iterator>);
+static_assert(!detail::is_memmove_copyable_v<vector<int>::iterator, vector<int>::const_iterator>);
+static_assert(!detail::is_memmove_copyable_v<vector<int>::iterator, vector<long>::iterator>);
+static_assert(!detail::is_memmove_copyable_v<vector<int>::reverse_iterator, vector<int>::iterator>);
+static_assert(!detail::is_memmove_copyable_v<vector<string>::iterator, vector<string>::iterator>);
+
+constexpr int copy_at_compile_time()
+{
+  int from[4] = {1, 2, 3, 4};
+  vector<int> to(4);
+  karls_standard_library::copy(from, from + 4, to.begin());
+  return to[0] + to[3];
+}
+static_assert(copy_at_compile_time() == 5);
+
+TEST_F(iterator_test, contiguous_arithmetic)
+{
+  vector<int> v{5, 3, 9, 1, 7};
+  auto first = v.begin();
+  auto last = v.end();
+  EXPECT_EQ(last - first, 5);
+  EXPECT_EQ(*(first + 2), 9);
+  EXPECT_EQ(*(2 + first), 9);
+  EXPECT_EQ(first[4], 7);
+  EXPECT_TRUE(first < last);
+  EXPECT_EQ(std::to_address(first + 1), v.data() + 1);
+
+  // mixed iterator and const_iterator comparison
+  const vector<int>& cv = v;
+  EXPECT_TRUE(first == cv.begin());
+  EXPECT_TRUE(cv.end() > first);
+
+  std::sort(v.begin(), v.end());
+  EXPECT_TRUE(std::is_sorted(cv.begin(), cv.end()));
+  EXPECT_EQ(*std::lower_bound(cv.begin(), cv.end(), 6), 7);
+  EXPECT_EQ(std::accumulate(cv.begin(), cv.end(), 0), 25);
+
+  string s("hello");
+  std::ranges::reverse(s);
+  EXPECT_EQ(string_view(s), "olleh");
+}
+
+TEST_F(iterator_test, reverse_iteration)
+{
+  vector<int> v{1, 2, 3, 4};
+  vector<int> out;
+  for (auto it = v.rbegin(); it != v.rend(); ++it) out.push_back(*it);
+  EXPECT_EQ(out, (vector<int>{4, 3, 2, 1}));
+  EXPECT_EQ(v.rend() - v.rbegin(), 4);
+  EXPECT_EQ(v.rbegin()[1], 3);
+  EXPECT_EQ(v.crbegin().base(), v.cend());
+
+  string s("abc");
+  string r;
+  for (auto it = s.crbegin(); it != s.crend(); ++it) r += *it;
+  EXPECT_EQ(string_view(r), "cba");
+
+  array<int, 3> a{7, 8, 9};
+  EXPECT_EQ(*a.rbegin(), 9);
+  EXPECT_EQ(*(a.rend() - 1), 7);
+}
+
+TEST_F(iterator_test, move_iterator_moves)
+{
+  vector<std::unique_ptr<int>> from;
+  for (int i = 0; i < 3; ++i) from.emplace_back(new int(i));
+
+  std::unique_ptr<int> to[3];
+  karls_standard_library::copy(karls_standard_library::make_move_iterator(from.begin()),
+                               karls_standard_library::make_move_iterator(from.end()), to);
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(from[i], nullptr);
+    EXPECT_EQ(*to[i], i);
+  }
+}
+
+TEST_F(iterator_test, back_inserter_and_copy)
+{
+  vector<int> v{1, 2, 3};
+  vector<int> out;
+  std::copy(v.begin(), v.end(), back_inserter(out));
+  karls_standard_library::copy(v.cbegin(), v.cend(), back_inserter(out));
+  EXPECT_EQ(out, (vector<int>{1, 2, 3, 1, 2, 3}));
+
+  // the memmove path handles overlap and returns the end of the output
+  vector<int> w{1, 2, 3, 4, 5};
+  auto end = karls_standard_library::copy(w.begin() + 1, w.end(), w.begin());
+  EXPECT_EQ(end, w.begin() + 4);
+  EXPECT_EQ(w, (vector<int>{2, 3, 4, 5, 5}));
+
+  EXPECT_EQ(karls_standard_library::distance(v.begin(), v.end()), 3);
+  EXPECT_EQ(*karls_standard_library::next(v.begin(), 2), 3);
+  EXPECT_EQ(*karls_standard_library::prev(v.end()), 3);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include "karls_standard_library/mmap_vector.hpp"
+
+using namespace karls_standard_library;
+
+class mmap_vector_test : public testing::Test
+{
+protected:
+  std::string path;
+
+  mmap_vector_test() : path(testing::TempDir() + "mmap_vector_test.bin") { std::remove(path.c_str()); }
+  ~mmap_vector_test() { std::remove(path.c_str()); }
+};
+
+struct record {
+  std::uint32_t id;
+  float price;
+  std::uint64_t volume;
+};
+
+TEST_F(mmap_vector_test, write_then_read)
+{
+  {
+    mmap_vector<record> out(path.c_str(), mmap_mode::read_write);
+    EXPECT_TRUE(out.is_open());
+    EXPECT_TRUE(out.empty());
+    for (std::uint32_t i = 0; i < 10000; ++i) out.push_back({i, i * 0.5f, i * 100ull});
+    EXPECT_EQ(out.size(), 10000);
+    EXPECT_GE(out.capacity(), 10000);
+    out[5].volume = 42;
+    out.flush();
+  }
+
+  mmap_vector<record> in(path.c_str());
+  EXPECT_EQ(in.mode(), mmap_mode::read_only);
+  EXPECT_EQ(in.size(), 10000);
+  EXPECT_EQ(in.capacity(), 10000);
+  EXPECT_EQ(in[9999].id, 9999);
+  EXPECT_FLOAT_EQ(in.back().price, 9999 * 0.5f);
+  EXPECT_EQ(in.at(5).volume, 42);
+  EXPECT_THROW(in.at(10000), std::out_of_range);
+  EXPECT_THROW(in.push_back({}), std::logic_error);
+  // the size of a read only file never changes, even below capacity
+  EXPECT_THROW(in.pop_back(), std::logic_error);
+  EXPECT_THROW(in.clear(), std::logic_error);
+  EXPECT_EQ(in.size(), 10000);
+
+  EXPECT_TRUE(in.advise(mmap_advice::sequential));
+  EXPECT_TRUE(in.advise(mmap_advice::willneed, 100, 1000));
+  in.advise(mmap_advice::hugepage);
+  std::uint64_t total = 0;
+  for (const record& r : in) total += r.id;
+  EXPECT_EQ(total, 9999ull * 10000ull / 2);
+}
+
+TEST_F(mmap_vector_test, resize_and_reopen)
+{
+  mmap_vector<std::uint64_t> v(path.c_str(), mmap_mode::read_write);
+  v.resize(100);
+  EXPECT_EQ(v.size(), 100);
+  EXPECT_EQ(v[99], 0);
+  for (size_t i = 0; i < v.size(); ++i) v[i] = i * i;
+  v.resize(1'000'000);
+  EXPECT_EQ(v[99], 99 * 99);
+  EXPECT_EQ(v[999'999], 0);
+  v.resize(50);
+  v.pop_back();
+
+  mmap_vector<std::uint64_t> moved = std::move(v);
+  EXPECT_FALSE(v.is_open());
+  moved.close();
+
+  // the file was cut back to size() on close
+  mmap_vector<std::uint64_t> again(path.c_str(), mmap_mode::read_write);
+  EXPECT_EQ(again.size(), 49);
+  EXPECT_EQ(again[48], 48 * 48);
+
+  EXPECT_THROW(mmap_vector<std::uint64_t>("/nonexistent/dir/file"), std::system_error);
+  mmap_vector<char> bytes(path.c_str());
+  EXPECT_EQ(bytes.size(), 49 * sizeof(std::uint64_t));
+  EXPECT_THROW((mmap_vector<record>(path.c_str())), std::runtime_error);
+}
+
+TEST_F(mmap_vector_test, push_back_own_element)
+{
+  // each push at full capacity grows the mapping while value points into it
+  mmap_vector<std::uint64_t> v(path.c_str(), mmap_mode::read_write);
+  v.push_back(7);
+  for (int i = 0; i < 20; ++i)
+  {
+    while (v.size() < v.capacity()) v.push_back(v.size());
+    v.push_back(v[0]);
+    EXPECT_EQ(v.back(), 7);
+  }
+}
+
+TEST_F(mmap_vector_test, read_only_pop_then_push)
+{
+  {
+    mmap_vector<std::uint64_t> out(path.c_str(), mmap_mode::read_write);
+    for (std::uint64_t i = 0; i < 100; ++i) out.push_back(i);
+  }
+  // capacity is the file size, so a push after a pop would not grow and
+  // would write straight into the read only mapping
+  mmap_vector<std::uint64_t> in(path.c_str());
+  EXPECT_THROW(in.pop_back(), std::logic_error);
+  EXPECT_THROW(in.push_back(100), std::logic_error);
+  EXPECT_EQ(in.size(), 100);
+  EXPECT_EQ(in.back(), 99);
+}
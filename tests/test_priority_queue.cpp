@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "karls_standard_library/priority_queue.hpp"
+
+using namespace karls_standard_library;
+
+class priority_queue_test : public testing::Test
+{
+protected:
+  priority_queue_test() = default;
+  ~priority_queue_test() = default;
+};
+
+TEST_F(priority_queue_test, heap_algorithms)
+{
+  std::mt19937 rng(3);
+  int values[257];
+  for (int& v : values) v = static_cast<int>(rng() % 1000);
+
+  int heap[257];
+  std::copy(values, values + 257, heap);
+  make_heap(heap, heap + 257);
+  EXPECT_TRUE(is_heap(heap, heap + 257));
+  EXPECT_EQ(heap[0], *std::max_element(values, values + 257));
+  sort_heap(heap, heap + 257);
+  EXPECT_TRUE(std::is_sorted(heap, heap + 257));
+
+  // grow one element at a time, binary and 8-ary
+  int binary[257];
+  for (int i = 0; i < 257; ++i)
+  {
+    binary[i] = values[i];
+    push_heap<2>(binary, binary + i + 1, greater<int>());
+    EXPECT_TRUE((is_heap<2>(binary, binary + i + 1, greater<int>())));
+  }
+  EXPECT_EQ(binary[0], *std::min_element(values, values + 257));
+  int wide[257];
+  std::copy(values, values + 257, wide);
+  make_heap<8>(wide, wide + 257);
+  pop_heap<8>(wide, wide + 257);
+  EXPECT_EQ(wide[256], heap[256]);
+  EXPECT_TRUE(is_heap<8>(wide, wide + 256));
+}
+
+TEST_F(priority_queue_test, priority_queue)
+{
+  priority_queue<std::string> words;
+  EXPECT_TRUE(words.empty());
+  for (const char* w : {"pear", "apple", "zucchini", "fig", "melon"}) words.push(w);
+  EXPECT_EQ(words.size(), 5);
+  EXPECT_EQ(words.top(), "zucchini");
+  words.pop();
+  EXPECT_EQ(words.take(), "pear");
+  EXPECT_EQ(words.top(), "melon");
+
+  std::mt19937 rng(5);
+  std::vector<int> input(1000);
+  for (int& v : input) v = static_cast<int>(rng() % 5000);
+  priority_queue<int, greater<int>> q(input.begin(), input.end());
+  std::sort(input.begin(), input.end());
+  for (int expected : input) EXPECT_EQ(q.take(), expected);
+  EXPECT_TRUE(q.empty());
+}
+
+TEST_F(priority_queue_test, indexed_priority_queue)
+{
+  indexed_priority_queue<int, greater<int>> q;
+  auto a = q.push(50);
+  auto b = q.push(40);
+  auto c = q.push(30);
+  auto d = q.push(20);
+  EXPECT_EQ(q.top(), 20);
+  EXPECT_EQ(q.top_handle(), d);
+
+  q.decrease_key(a, 10);
+  EXPECT_EQ(q.top_handle(), a);
+  q.update(a, 45);
+  EXPECT_EQ(q.top_handle(), d);
+  q.erase(c);
+  EXPECT_FALSE(q.contains(c));
+  EXPECT_THROW(q.value(c), std::out_of_range);
+  EXPECT_EQ(q.value(b), 40);
+  EXPECT_EQ(q.take(), 20);
+  EXPECT_EQ(q.take(), 40);
+  EXPECT_EQ(q.take(), 45);
+  EXPECT_TRUE(q.empty());
+
+  // random updates against a brute force model
+  std::mt19937 rng(9);
+  std::vector<int> model(500);
+  std::vector<size_t> handles(500);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    model[i] = static_cast<int>(rng() % 100000);
+    handles[i] = q.push(model[i]);
+  }
+  for (int step = 0; step < 2000; ++step)
+  {
+    size_t i = rng() % 500;
+    if (model[i] < 0) continue;
+    if (step % 7 == 0)
+    {
+      q.erase(handles[i]);
+      model[i] = -1;
+    }
+    else
+    {
+      model[i] = static_cast<int>(rng() % 100000);
+      q.update(handles[i], model[i]);
+    }
+  }
+  std::vector<int> live;
+  for (int v : model) if (v >= 0) live.push_back(v);
+  std::sort(live.begin(), live.end());
+  EXPECT_EQ(q.size(), live.size());
+  for (int expected : live) EXPECT_EQ(q.take(), expected);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <list>
+#include <ranges>
+#include "karls_standard_library/ranges.hpp"
+#include "karls_standard_library/vector.hpp"
+#include "karls_standard_library/string.hpp"
+#include "karls_standard_library/array.hpp"
+
+using namespace karls_standard_library;
+
+class ranges_test : public testing::Test
+{
+protected:
+  ranges_test() = default;
+  ~ranges_test() = default;
+};
+
+static_assert(std::ranges::view<ref_view<vector<int>>>);
+static_assert(std::ranges::random_access_range<decltype(std::declval<vector<int>&>() | views::transform([](int x) { return x; }))>);
+static_assert(std::ranges::bidirectional_range<decltype(std::declval<vector<int>&>() | views::filter([](int) { return true; }))>);
+static_assert(std::ranges::contiguous_range<decltype(std::declval<vector<int>&>() | views::take(2))>);
+static_assert(std::ranges::contiguous_range<decltype(std::declval<vector<int>&>() | views::drop(2))>);
+static_assert(std::ranges::sized_range<decltype(views::zip(std::declval<vector<int>&>(), std::declval<string&>()))>);
+
+// views only refer to the range they adapt
+static_assert(sizeof(ref_view<vector<int>>) == sizeof(void*));
+static_assert(sizeof(decltype(std::declval<vector<int>&>() | views::filter([](int) { return true; }))) == sizeof(void*));
+
+constexpr int sum_of_odd_squares()
+{
+  array<int, 6> a{1, 2, 3, 4, 5, 6};
+  int total = 0;
+  for (int x : a | views::filter([](int x) { return x % 2 == 1; }) | views::transform([](int x) { return x * x; })) total += x;
+  return total;
+}
+static_assert(sum_of_odd_squares() == 35);
+
+TEST_F(ranges_test, filter_transform_take)
+{
+  vector<int> v{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  int bias = 100;
+  auto odd = [](int x) { return x % 2 == 1; };
+  auto shifted = [bias](int x) { return x + bias; };
+
+  vector<int> out;
+  for (int x : v | views::filter(odd) | views::transform(shifted) | views::take(3)) out.push_back(x);
+  EXPECT_EQ(out, (vector<int>{101, 103, 105}));
+
+  // a pipeline built up front and applied later
+  auto pipeline = views::filter(odd) | views::transform(shifted) | views::drop(1);
+  EXPECT_EQ(v | pipeline | to<vector>(), (vector<int>{103, 105, 107, 109}));
+
+  // call syntax builds the same views
+  auto squares = views::transform(views::take(v, 4), [](int x) { return x * x; });
+  EXPECT_EQ(squares.size(), 4u);
+  EXPECT_EQ(squares[3], 16);
+  EXPECT_EQ(std::ranges::distance(views::drop(v, 20)), 0);
+
+  // filtering walks backwards too
+  auto evens = v | views::filter([](int x) { return x % 2 == 0; });
+  EXPECT_EQ(*std::ranges::prev(evens.end()), 10);
+
+  // elements are references into the container
+  for (int& x : v | views::filter(odd)) x = 0;
+  EXPECT_EQ(std::ranges::count(v, 0), 5);
+}
+
+TEST_F(ranges_test, take_and_drop_bounds)
+{
+  std::list<int> l{1, 2, 3, 4, 5};
+  auto first = views::take(l, 2);
+  EXPECT_EQ((first | to<vector>()), (vector<int>{1, 2}));
+  EXPECT_EQ((views::take(l, 10) | to<vector>()), (vector<int>{1, 2, 3, 4, 5}));
+  EXPECT_EQ((views::drop(l, 3) | to<vector>()), (vector<int>{4, 5}));
+
+  // an unsized base counts down as it goes
+  auto big = l | views::filter([](int x) { return x > 1; }) | views::take(2);
+  EXPECT_EQ((big | to<vector>()), (vector<int>{2, 3}));
+  auto all = l | views::filter([](int x) { return x > 1; }) | views::take(10);
+  EXPECT_EQ((all | to<vector>()), (vector<int>{2, 3, 4, 5}));
+}
+
+TEST_F(ranges_test, chunk)
+{
+  vector<int> v{1, 2, 3, 4, 5, 6, 7};
+  auto chunks = v | views::chunk(3);
+  EXPECT_EQ(chunks.size(), 3u);
+
+  vector<int> sums;
+  for (auto chunk : chunks)
+  {
+    int sum = 0;
+    for (int x : chunk) sum += x;
+    sums.push_back(sum);
+  }
+  EXPECT_EQ(sums, (vector<int>{6, 15, 7}));
+
+  vector<int> empty;
+  EXPECT_TRUE((empty | views::chunk(2)).empty());
+}
+
+TEST_F(ranges_test, zip_and_enumerate)
+{
+  vector<int> numbers{1, 2, 3, 4};
+  string letters("abc");
+
+  string joined;
+  for (auto [n, c] : views::zip(numbers, letters))
+  {
+    joined += c;
+    joined += static_cast<char>('0' + n);
+  }
+  EXPECT_EQ(string_view(joined), "a1b2c3");
+  EXPECT_EQ(views::zip(numbers, letters).size(), 3u);
+
+  // zipped elements are references, so writes go through
+  for (auto [n, c] : views::zip(numbers, letters)) n *= 10;
+  EXPECT_EQ(numbers, (vector<int>{10, 20, 30, 4}));
+
+  ptrdiff_t expected = 0;
+  for (auto [i, c] : letters | views::enumerate)
+  {
+    EXPECT_EQ(i, expected++);
+    EXPECT_EQ(c, letters[i]);
+  }
+  EXPECT_EQ(expected, 3);
+
+  // an unsized zip stops at the shortest range
+  std::list<int> l{7, 8};
+  EXPECT_EQ(std::ranges::distance(views::zip(l, numbers)), 2);
+}
+
+TEST_F(ranges_test, to_materializes)
+{
+  vector<int> v{3, 1, 2};
+  vector<long> wide = to<vector<long>>(v);
+  EXPECT_EQ(wide, (vector<long>{3, 1, 2}));
+
+  // a sized range is allocated for once
+  auto doubled = v | views::transform([](int x) { return x * 2; }) | to<vector>();
+  EXPECT_EQ(doubled.capacity(), 3u);
+  EXPECT_EQ(doubled, (vector<int>{6, 2, 4}));
+
+  string s("Hello");
+  string upper = s | views::transform([](char c) { return static_cast<char>(c & ~0x20); }) | to<string>();
+  EXPECT_EQ(string_view(upper), "HELLO");
+
+  // a temporary container is owned by the pipeline
+  auto tail = vector<int>{1, 2, 3, 4} | views::drop(2) | to<vector>();
+  EXPECT_EQ(tail, (vector<int>{3, 4}));
+
+  // the standard adaptors accept these views
+  auto reversed = v | views::transform([](int x) { return x + 1; }) | std::views::reverse | to<vector>();
+  EXPECT_EQ(reversed, (vector<int>{3, 2, 4}));
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include "karls_standard_library/ring_buffer.hpp"
+#include "karls_standard_library/string.hpp"
+
+using namespace karls_standard_library;
+
+class ring_buffer_test : public testing::Test
+{
+protected:
+  ring_buffer_test() = default;
+  ~ring_buffer_test() = default;
+
+  static constexpr int items = 20000;
+};
+
+TEST_F(ring_buffer_test, spsc_single_thread)
+{
+  spsc_ring<string, 4> ring;
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.capacity(), 4);
+  EXPECT_TRUE(ring.try_push(string("a")));
+  EXPECT_TRUE(ring.try_push(string("b")));
+  EXPECT_TRUE(ring.try_push(string("c")));
+  EXPECT_TRUE(ring.try_push(string("d")));
+  EXPECT_FALSE(ring.try_push(string("e")));
+  EXPECT_EQ(ring.size(), 4);
+
+  string out;
+  EXPECT_TRUE(ring.try_pop(out));
+  EXPECT_EQ(out, "a");
+  EXPECT_TRUE(ring.try_push(string("e")));
+  for (const char* expected : {"b", "c", "d", "e"})
+  {
+    EXPECT_TRUE(ring.try_pop(out));
+    EXPECT_EQ(out, expected);
+  }
+  EXPECT_FALSE(ring.try_pop(out));
+}
+
+TEST_F(ring_buffer_test, batched_operations)
+{
+  spsc_ring<int, 8> spsc;
+  mpmc_ring<int, 8> mpmc;
+  int input[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  int output[10] = {};
+
+  EXPECT_EQ(spsc.push_n(input, 10), 8);
+  EXPECT_EQ(spsc.pop_n(output, 3), 3);
+  EXPECT_EQ(spsc.push_n(input + 8, 2), 2);
+  EXPECT_EQ(spsc.pop_n(output + 3, 10), 7);
+  for (int i = 0; i < 10; ++i) EXPECT_EQ(output[i], i);
+
+  EXPECT_EQ(mpmc.push_n(input, 10), 8);
+  EXPECT_EQ(mpmc.pop_n(output, 5), 5);
+  EXPECT_EQ(mpmc.push_n(input + 8, 2), 2);
+  EXPECT_EQ(mpmc.pop_n(output + 5, 10), 5);
+  EXPECT_EQ(output[0], 0);
+  EXPECT_EQ(output[7], 7);
+  EXPECT_EQ(output[9], 9);
+  EXPECT_TRUE(mpmc.empty());
+}
+
+TEST_F(ring_buffer_test, spsc_preserves_order)
+{
+  spsc_ring<int, 64> ring;
+  std::thread producer([&ring]() {
+    for (int i = 0; i < items; ++i)
+    {
+      while (!ring.try_push(i)) std::this_thread::yield();
+    }
+  });
+  bool ordered = true;
+  for (int expected = 0; expected < items;)
+  {
+    int value;
+    if (ring.try_pop(value))
+    {
+      ordered = ordered && value == expected;
+      ++expected;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+}
+
+TEST_F(ring_buffer_test, mpmc_delivers_everything_once)
+{
+  mpmc_ring<int, 256> ring;
+  const int producers = 4;
+  const int consumers = 4;
+  const int per_producer = items / producers;
+  std::atomic<long long> sum{0};
+  std::atomic<int> received{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+  {
+    threads.emplace_back([&ring, p, per_producer]() {
+      int batch[4];
+      for (int i = 0; i < per_producer; i += 4)
+      {
+        for (int j = 0; j < 4; ++j) batch[j] = p * per_producer + i + j + 1;
+        size_t done = 0;
+        while ((done += ring.push_n(batch + done, 4 - done)) < 4)
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c)
+  {
+    threads.emplace_back([&]() {
+      int value;
+      while (received.load() < producers * per_producer)
+      {
+        if (ring.try_pop(value))
+        {
+          sum += value;
+          ++received;
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (std::thread& t : threads) t.join();
+
+  long long n = producers * per_producer;
+  EXPECT_EQ(received.load(), n);
+  EXPECT_EQ(sum.load(), n * (n + 1) / 2);
+}
+
+TEST_F(ring_buffer_test, blocking_rings)
+{
+  blocking_spsc_ring<int, 4> spsc;
+  std::thread producer([&spsc]() {
+    for (int i = 0; i < 10000; ++i) spsc.push(i);
+  });
+  long long sum = 0;
+  for (int i = 0; i < 10000; ++i) sum += spsc.pop();
+  producer.join();
+  EXPECT_EQ(sum, 10000LL * 9999 / 2);
+
+  blocking_mpmc_ring<int, 2> mpmc;
+  std::vector<std::thread> threads;
+  std::atomic<long long> total{0};
+  for (int t = 0; t < 3; ++t)
+  {
+    threads.emplace_back([&mpmc]() {
+      for (int i = 1; i <= 1000; ++i) mpmc.push(i);
+    });
+    threads.emplace_back([&mpmc, &total]() {
+      for (int i = 0; i < 1000; ++i) total += mpmc.pop();
+    });
+  }
+  for (std::thread& t : threads) t.join();
+  EXPECT_EQ(total.load(), 3 * 500500LL);
+  EXPECT_TRUE(mpmc.empty());
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "karls_standard_library/rope.hpp"
+#include "karls_standard_library/string.hpp"
+
+using namespace karls_standard_library;
+
+class rope_test : public testing::Test
+{
+protected:
+  rope_test() = default;
+  ~rope_test() = default;
+
+  // text of the given size with a repeating pattern
+  static string pattern(size_t count)
+  {
+    string s;
+    for (size_t i = 0; i < count; ++i) s += static_cast<char>('a' + i % 26);
+    return s;
+  }
+};
+
+TEST_F(rope_test, default_constructor)
+{
+  rope r;
+  EXPECT_TRUE(r.empty());
+  EXPECT_EQ(r.size(), 0);
+  EXPECT_TRUE(r.str().empty());
+}
+
+TEST_F(rope_test, construct_and_index)
+{
+  string text = pattern(5000);
+  rope r(text);
+  EXPECT_EQ(r.size(), 5000);
+  EXPECT_EQ(r.str(), text);
+  for (size_t i = 0; i < text.size(); i += 97) EXPECT_EQ(r[i], text[i]);
+  EXPECT_THROW(r.at(5000), std::out_of_range);
+}
+
+TEST_F(rope_test, concatenation_stays_balanced)
+{
+  rope r;
+  string expected;
+  for (int i = 0; i < 20000; ++i)
+  {
+    r += "ab";
+    expected.append("ab");
+  }
+  EXPECT_EQ(r.size(), 40000);
+  EXPECT_EQ(r.str(), expected);
+  EXPECT_LE(r.height(), 16);
+
+  rope twice = r + r;
+  EXPECT_EQ(twice.size(), 80000);
+  r.append(r);
+  EXPECT_EQ(r.size(), 80000);
+  EXPECT_EQ(r[79999], 'b');
+}
+
+TEST_F(rope_test, substr_insert_erase)
+{
+  string text = pattern(3000);
+  rope r(text);
+
+  rope sub = r.substr(1000, 700);
+  EXPECT_EQ(sub.str(), text.substr(1000, 700));
+  EXPECT_EQ(r.substr(2990).str(), text.substr(2990));
+
+  r.insert(1500, "INSERTED");
+  EXPECT_EQ(r.size(), 3008);
+  EXPECT_EQ(r.substr(1500, 8).str(), "INSERTED");
+  EXPECT_EQ(r.substr(0, 1500).str(), text.substr(0, 1500));
+  EXPECT_EQ(r.substr(1508).str(), text.substr(1500));
+
+  r.erase(1500, 8);
+  EXPECT_EQ(r.str(), text);
+  r.erase(0);
+  EXPECT_TRUE(r.empty());
+  EXPECT_THROW(r.insert(1, "x"), std::out_of_range);
+}
+
+TEST_F(rope_test, copies_share_structure)
+{
+  rope a("shared text");
+  rope b = a;
+  b.insert(0, "un");
+  EXPECT_EQ(a.str(), "shared text");
+  EXPECT_EQ(b.str(), "unshared text");
+
+  std::ostringstream os;
+  os << b;
+  EXPECT_EQ(os.str(), "unshared text");
+}
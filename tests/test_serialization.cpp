@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include "karls_standard_library/serialization.hpp"
+
+using namespace karls_standard_library;
+
+class serialization_test : public testing::Test
+{
+protected:
+  serialization_test() = default;
+  ~serialization_test() = default;
+};
+
+struct tick {
+  std::uint32_t id;
+  double price;
+};
+
+TEST_F(serialization_test, contiguous_blocks)
+{
+  vector<tick> ticks;
+  for (std::uint32_t i = 0; i < 1000; ++i) ticks.push_back({i, i * 0.25});
+  vector<unsigned char> bytes = serialize(ticks);
+  EXPECT_EQ(bytes.size(), 16 + 1000 * sizeof(tick));
+
+  // the view points straight into the buffer
+  std::span<const tick> view = deserialize_view<vector<tick>>(bytes.data(), bytes.size());
+  EXPECT_EQ(view.size(), 1000);
+  EXPECT_EQ(static_cast<const void*>(view.data()), static_cast<const void*>(bytes.data() + 16));
+  EXPECT_DOUBLE_EQ(view[999].price, 999 * 0.25);
+
+  vector<tick> copy = deserialize<vector<tick>>(bytes.data(), bytes.size());
+  EXPECT_EQ(copy.size(), 1000);
+  EXPECT_EQ(copy[500].id, 500);
+
+  array<std::int16_t, 4> small{1, -2, 3, -4};
+  vector<unsigned char> small_bytes = serialize(small);
+  auto small_view = deserialize_view<array<std::int16_t, 4>>(small_bytes.data(), small_bytes.size());
+  EXPECT_EQ(small_view[3], -4);
+  EXPECT_EQ((deserialize<array<std::int16_t, 4>>(small_bytes.data(), small_bytes.size())[1]), -2);
+
+  // type, length and truncation are checked
+  EXPECT_THROW(deserialize_view<vector<float>>(bytes.data(), bytes.size()), std::runtime_error);
+  EXPECT_THROW((deserialize_view<array<std::int16_t, 5>>(small_bytes.data(), small_bytes.size())), std::runtime_error);
+  EXPECT_THROW(deserialize_view<vector<tick>>(bytes.data(), bytes.size() - 1), std::out_of_range);
+}
+
+TEST_F(serialization_test, strings_and_nesting)
+{
+  vector<string> words;
+  words.push_back(string("alpha"));
+  words.push_back(string(""));
+  words.push_back(string("a considerably longer word"));
+  vector<unsigned char> bytes = serialize(words);
+
+  auto view = deserialize_view<vector<string>>(bytes.data(), bytes.size());
+  EXPECT_EQ(view.size(), 3);
+  EXPECT_TRUE(view[0] == string_view("alpha"));
+  EXPECT_TRUE(view[1].empty());
+  EXPECT_EQ(view[2].size(), 26);
+  EXPECT_THROW(view.at(3), std::out_of_range);
+  vector<string> copy = deserialize<vector<string>>(bytes.data(), bytes.size());
+  EXPECT_TRUE(copy[2] == words[2]);
+
+  vector<vector<std::uint64_t>> rows(3);
+  for (std::uint64_t i = 0; i < 10; ++i) rows[2].push_back(i * i);
+  rows[0].push_back(7);
+  vector<unsigned char> row_bytes = serialize(rows);
+  auto row_view = deserialize_view<vector<vector<std::uint64_t>>>(row_bytes.data(), row_bytes.size());
+  EXPECT_EQ(row_view[0].size(), 1);
+  EXPECT_EQ(row_view[1].size(), 0);
+  EXPECT_EQ(row_view[2][9], 81);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(row_view[2].data()) % alignof(std::uint64_t), 0);
+  auto row_copy = deserialize<vector<vector<std::uint64_t>>>(row_bytes.data(), row_bytes.size());
+  EXPECT_EQ(row_copy[2][3], 9);
+
+  // several values in one archive
+  binary_writer out;
+  out.write(Pair<string, std::uint32_t>(string("key"), 42u));
+  out.write(words);
+  out.write(3.5);
+  binary_reader in(out.data(), out.size());
+  auto entry = in.view<Pair<string, std::uint32_t>>();
+  EXPECT_TRUE(entry.first == string_view("key"));
+  EXPECT_EQ(entry.second, 42u);
+  EXPECT_EQ(in.view<vector<string>>().size(), 3);
+  EXPECT_DOUBLE_EQ(in.read<double>(), 3.5);
+  EXPECT_EQ(in.remaining(), 0);
+}
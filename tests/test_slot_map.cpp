@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include "karls_standard_library/slot_map.hpp"
+
+using namespace karls_standard_library;
+
+class slot_map_test : public testing::Test
+{
+protected:
+  slot_map_test() = default;
+  ~slot_map_test() = default;
+};
+
+TEST_F(slot_map_test, insert_erase_lookup)
+{
+  slot_map<std::string> names;
+  EXPECT_TRUE(names.empty());
+  slot_handle a = names.insert("alpha");
+  slot_handle b = names.emplace(3, 'b');
+  slot_handle c = names.insert(std::string("gamma"));
+  EXPECT_EQ(names.size(), 3);
+  EXPECT_EQ(names[a], "alpha");
+  EXPECT_EQ(names.at(b), "bbb");
+  EXPECT_EQ(*names.find(c), "gamma");
+
+  // erasing moves the last value into the hole; handles keep working
+  EXPECT_TRUE(names.erase(a));
+  EXPECT_FALSE(names.erase(a));
+  EXPECT_FALSE(names.contains(a));
+  EXPECT_EQ(names.find(a), nullptr);
+  EXPECT_THROW(names.at(a), std::out_of_range);
+  EXPECT_EQ(names[b], "bbb");
+  EXPECT_EQ(names[c], "gamma");
+  EXPECT_EQ(names.data()[0], "gamma");
+  EXPECT_EQ(names.handle_at(0), c);
+
+  // the freed slot is reused under a new generation
+  slot_handle d = names.insert("delta");
+  EXPECT_EQ(d.index, a.index);
+  EXPECT_NE(d, a);
+  EXPECT_FALSE(names.contains(a));
+  EXPECT_EQ(names[d], "delta");
+
+  EXPECT_FALSE(names.contains(slot_handle{}));
+  EXPECT_TRUE(slot_handle{}.is_null());
+
+  names.clear();
+  EXPECT_TRUE(names.empty());
+  EXPECT_FALSE(names.contains(b));
+  EXPECT_FALSE(names.contains(d));
+}
+
+TEST_F(slot_map_test, dense_iteration)
+{
+  slot_map<int> values;
+  vector<slot_handle> handles;
+  for (int i = 0; i < 1000; ++i) handles.push_back(values.insert(i));
+  for (int i = 0; i < 1000; i += 2) values.erase(handles[i]);
+  EXPECT_EQ(values.size(), 500);
+
+  long sum = 0;
+  for (int v : values) sum += v;
+  EXPECT_EQ(sum, 500L * 500L);
+  for (size_t i = 0; i < values.size(); ++i) EXPECT_EQ(values[values.handle_at(i)], values.data()[i]);
+  for (int i = 1; i < 1000; i += 2) EXPECT_EQ(values[handles[i]], i);
+
+  const slot_map<int>& view = values;
+  size_t count = 0;
+  for (const int& v : view) count += (v % 2 == 1);
+  EXPECT_EQ(count, 500);
+}
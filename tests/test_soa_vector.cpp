@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "karls_standard_library/soa_vector.hpp"
+
+using namespace karls_standard_library;
+
+class soa_vector_test : public testing::Test
+{
+protected:
+  soa_vector_test() = default;
+  ~soa_vector_test() = default;
+};
+
+template<typename Id, typename Price, typename Name>
+struct trade {
+  Id id;
+  Price price;
+  Name name;
+};
+
+// counts live objects and throws from the construction that brings
+// countdown to zero
+struct fragile {
+  static inline int live = 0;
+  static inline int countdown = -1;
+  int value;
+
+  static void check()
+  {
+    if (countdown > 0 && --countdown == 0) throw std::runtime_error("fragile");
+  }
+  fragile(int v = 0) : value(v) { check(); ++live; }
+  fragile(const fragile& other) : value(other.value) { check(); ++live; }
+  ~fragile() { --live; }
+};
+
+TEST_F(soa_vector_test, push_back_and_access)
+{
+  soa_vector<int, double> v;
+  EXPECT_TRUE(v.empty());
+  for (int i = 0; i < 100; ++i) v.push_back(i, i * 0.5);
+  EXPECT_EQ(v.size(), 100);
+  EXPECT_EQ(v.capacity(), 128);
+
+  EXPECT_EQ(v[10].get<0>(), 10);
+  EXPECT_DOUBLE_EQ(v[10].get<1>(), 5.0);
+  v[10].get<1>() = 42.0;
+  EXPECT_DOUBLE_EQ(v.get<1>(10), 42.0);
+  EXPECT_THROW(v.at(100), std::out_of_range);
+
+  auto [id, price] = v[20];
+  price = -1.0;
+  EXPECT_EQ(id, 20);
+  EXPECT_DOUBLE_EQ(v.get<1>(20), -1.0);
+
+  v.pop_back();
+  EXPECT_EQ(v.size(), 99);
+  EXPECT_EQ(v.back().get<0>(), 98);
+}
+
+TEST_F(soa_vector_test, named_fields)
+{
+  basic_soa_vector<trade, int, double, std::string> trades;
+  trades.emplace_back(1, 10.5, "abc");
+  trades.emplace_back(2, 20.25, std::string(40, 'x'));
+  trades[0].price += 1.0;
+  EXPECT_DOUBLE_EQ(trades[0].price, 11.5);
+  EXPECT_EQ(trades[1].name.size(), 40);
+  EXPECT_EQ(trades.at(1).id, 2);
+
+  const auto& view = trades;
+  EXPECT_EQ(view[0].name, "abc");
+
+  // growth relocates every column, including non trivial ones
+  for (int i = 3; i <= 50; ++i) trades.emplace_back(i, i * 1.0, std::to_string(i));
+  EXPECT_EQ(trades[1].name, std::string(40, 'x'));
+  EXPECT_EQ(trades[49].name, "50");
+
+  auto copy = trades;
+  trades.clear();
+  EXPECT_TRUE(trades.empty());
+  EXPECT_EQ(copy.size(), 50);
+  EXPECT_EQ(copy[2].id, 3);
+
+  trades = std::move(copy);
+  EXPECT_EQ(trades.size(), 50);
+  trades.shrink_to_fit();
+  EXPECT_EQ(trades.capacity(), 50);
+  EXPECT_EQ(trades[49].name, "50");
+}
+
+TEST_F(soa_vector_test, columns)
+{
+  soa_vector<std::uint8_t, double, float> v;
+  v.resize(1000);
+  EXPECT_EQ(v.size(), 1000);
+  EXPECT_EQ(v.get<1>(999), 0.0);
+
+  // every column starts on its own cache line
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data<0>()) % cache_line_size, 0);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data<1>()) % cache_line_size, 0);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data<2>()) % cache_line_size, 0);
+
+  auto prices = v.column<1>();
+  EXPECT_EQ(prices.size(), 1000);
+  for (size_t i = 0; i < prices.size(); ++i) prices[i] = static_cast<double>(i);
+  double sum = 0;
+  for (double p : v.column<1>()) sum += p;
+  EXPECT_DOUBLE_EQ(sum, 999.0 * 1000.0 / 2.0);
+
+  v.resize(10);
+  EXPECT_EQ(v.size(), 10);
+  EXPECT_EQ(v.column<2>().size(), 10);
+  EXPECT_DOUBLE_EQ(v.get<1>(9), 9.0);
+}
+
+TEST_F(soa_vector_test, throwing_field)
+{
+  {
+    using fragile_pairs = soa_vector<fragile, fragile>;
+    fragile_pairs v;
+    v.reserve(8);
+    v.emplace_back(1, 2);
+    fragile first(3), second(4);
+    EXPECT_EQ(fragile::live, 4);
+
+    // the second field throws after the first was built
+    fragile::countdown = 2;
+    EXPECT_THROW(v.emplace_back(first, second), std::runtime_error);
+    EXPECT_EQ(v.size(), 1);
+    EXPECT_EQ(fragile::live, 4);
+
+    // resize keeps the rows built before the throw
+    fragile::countdown = 6;
+    EXPECT_THROW(v.resize(5), std::runtime_error);
+    EXPECT_EQ(v.size(), 2);
+    EXPECT_EQ(fragile::live, 6);
+
+    fragile::countdown = 3;
+    EXPECT_THROW(fragile_pairs{v}, std::runtime_error);
+    EXPECT_EQ(fragile::live, 6);
+
+    fragile::countdown = -1;
+    fragile_pairs copy(v);
+    EXPECT_EQ(copy.get<1>(0).value, 2);
+    EXPECT_EQ(fragile::live, 10);
+  }
+  EXPECT_EQ(fragile::live, 0);
+}
+
+TEST_F(soa_vector_test, throwing_growth)
+{
+  {
+    soa_vector<std::string, fragile, fragile> v;
+    for (int i = 0; i < 4; ++i) v.emplace_back(std::string(40, static_cast<char>('a' + i)), i, -i);
+    EXPECT_EQ(v.capacity(), 4);
+    EXPECT_EQ(fragile::live, 8);
+
+    // growth copies every column before the old block is released; the
+    // copies of the fragile columns are constructions 1 to 8, so each
+    // throw below leaves the vector as it was
+    fragile four(4), minus_four(-4);
+    for (int countdown : {1, 3, 4, 5, 8})
+    {
+      fragile::countdown = countdown;
+      EXPECT_THROW(v.push_back(std::string("e"), four, minus_four), std::runtime_error);
+      fragile::countdown = -1;
+      EXPECT_EQ(v.size(), 4);
+      EXPECT_EQ(v.capacity(), 4);
+      EXPECT_EQ(fragile::live, 10);
+      for (int i = 0; i < 4; ++i)
+      {
+        EXPECT_EQ(v.get<0>(static_cast<size_t>(i)), std::string(40, static_cast<char>('a' + i)));
+        EXPECT_EQ(v.get<1>(static_cast<size_t>(i)).value, i);
+        EXPECT_EQ(v.get<2>(static_cast<size_t>(i)).value, -i);
+      }
+    }
+
+    v.push_back(std::string("e"), four, minus_four);
+    EXPECT_EQ(v.size(), 5);
+    EXPECT_EQ(v.get<2>(4).value, -4);
+    EXPECT_EQ(fragile::live, 12);
+  }
+  EXPECT_EQ(fragile::live, 0);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "karls_standard_library/static_search_index.hpp"
+
+using namespace karls_standard_library;
+
+class static_search_index_test : public testing::Test
+{
+protected:
+  static_search_index_test() = default;
+  ~static_search_index_test() = default;
+
+  // compare every query against std on the same sorted keys
+  template<typename T>
+  static void check(const std::vector<T>& keys, const std::vector<T>& queries)
+  {
+    static_search_index<T> index(keys.data(), keys.size());
+    ASSERT_EQ(index.size(), keys.size());
+    for (T x : queries)
+    {
+      size_t lower = static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), x) - keys.begin());
+      size_t upper = static_cast<size_t>(std::upper_bound(keys.begin(), keys.end(), x) - keys.begin());
+      ASSERT_EQ(index.lower_bound(x), lower) << "n = " << keys.size() << ", x = " << x;
+      ASSERT_EQ(index.upper_bound(x), upper) << "n = " << keys.size() << ", x = " << x;
+      ASSERT_EQ(index.contains(x), std::binary_search(keys.begin(), keys.end(), x));
+    }
+  }
+
+  // random sorted keys with duplicates, queried at, between and around them
+  template<typename T>
+  static void check_random(std::mt19937& rng, size_t n, T low, T high)
+  {
+    std::uniform_int_distribution<long long> pick(static_cast<long long>(low), static_cast<long long>(high));
+    std::vector<T> keys;
+    for (size_t i = 0; i < n; ++i) keys.push_back(static_cast<T>(pick(rng)));
+    std::sort(keys.begin(), keys.end());
+    std::vector<T> queries = keys;
+    for (size_t i = 0; i < 200; ++i) queries.push_back(static_cast<T>(pick(rng)));
+    queries.push_back(std::numeric_limits<T>::lowest());
+    queries.push_back(std::numeric_limits<T>::max());
+    check(keys, queries);
+  }
+};
+
+TEST_F(static_search_index_test, matches_std)
+{
+  std::mt19937 rng(7);
+  // sizes around node and level boundaries for 16 and 8 keys per node
+  for (size_t n : {1, 2, 7, 8, 9, 15, 16, 17, 144, 271, 272, 273, 1000, 4625, 5000, 80000})
+  {
+    check_random<uint32_t>(rng, n, 0, 1000000);
+    check_random<int32_t>(rng, n, -1000, 1000);
+    check_random<int64_t>(rng, n, -1000000, 1000000);
+    check_random<uint16_t>(rng, n, 0, 60000);
+  }
+}
+
+TEST_F(static_search_index_test, extreme_keys)
+{
+  // unsigned keys across the sign bit, and keys equal to the padding
+  std::vector<uint32_t> keys{0, 1, 0x7fffffffu, 0x80000000u, 0xfffffffeu, 0xffffffffu, 0xffffffffu};
+  check(keys, {0u, 1u, 2u, 0x7fffffffu, 0x80000000u, 0x80000001u, 0xfffffffeu, 0xffffffffu});
+
+  std::vector<uint64_t> wide{1, 1ull << 63, ~0ull};
+  check(wide, {0ull, 1ull, 2ull, 1ull << 63, (1ull << 63) + 1, ~0ull - 1, ~0ull});
+
+  std::vector<int32_t> negative(100, std::numeric_limits<int32_t>::min());
+  negative.push_back(std::numeric_limits<int32_t>::max());
+  check(negative, {std::numeric_limits<int32_t>::min(), 0, std::numeric_limits<int32_t>::max()});
+}
+
+TEST_F(static_search_index_test, floating_point)
+{
+  std::vector<double> keys;
+  for (int i = 0; i < 3000; ++i) keys.push_back(i * 0.5 - 100);
+  check(keys, {-1000.0, -100.0, -99.75, 0.0, 0.25, 1399.5, 1500.0,
+               std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()});
+
+  std::vector<float> floats{-std::numeric_limits<float>::infinity(), -1.5f, 0.0f, 2.0f, std::numeric_limits<float>::max()};
+  check(floats, {-std::numeric_limits<float>::infinity(), -2.0f, 0.0f, 1.0f, 2.0f, 3.0f,
+                 std::numeric_limits<float>::max(), std::numeric_limits<float>::infinity()});
+}
+
+TEST_F(static_search_index_test, construction_and_copies)
+{
+  static_search_index<int> empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.lower_bound(5), 0u);
+  EXPECT_EQ(empty.upper_bound(5), 0u);
+  EXPECT_FALSE(empty.contains(5));
+
+  vector<int> sorted;
+  for (int i = 0; i < 1000; ++i) sorted.push_back(i * 3);
+  static_search_index<int> index(sorted);
+  EXPECT_EQ(index.size(), 1000u);
+  EXPECT_EQ(index[10], 30);
+  EXPECT_EQ(index.lower_bound(31), 11u);
+  EXPECT_TRUE(index.contains(2997));
+  EXPECT_GE(index.memory_usage(), 1000 * sizeof(int));
+
+  static_search_index<int> copy = index;
+  EXPECT_EQ(copy.lower_bound(31), 11u);
+  static_search_index<int> moved = karls_standard_library::move(copy);
+  EXPECT_EQ(moved.upper_bound(30), 11u);
+  EXPECT_TRUE(copy.empty());
+
+  copy = moved;
+  moved = static_search_index<int>();
+  EXPECT_TRUE(moved.empty());
+  EXPECT_EQ(copy.lower_bound(-1), 0u);
+  EXPECT_EQ(copy.lower_bound(3000), 1000u);
+}
@@ -1,5 +1,7 @@
 #include <iostream>
 #include <stdexcept>
+#include <sstream>
+#include <iomanip>
 #include <gtest/gtest.h>
 #include "karls_standard_library/string.hpp"
 #include "karls_standard_library/utility.hpp"
@@ -91,3 +93,113 @@ TEST_F(string_test, move_operations)
   EXPECT_EQ(temp2, "move test 2");
   EXPECT_FALSE(temp2 == move_dummy2);
 }
+
+TEST_F(string_test, stream_output)
+{
+  std::ostringstream os;
+  os << cstr_constructed << ' ' << default_constructed << fill_constructed;
+  EXPECT_EQ(os.str(), "hello aaaaa");
+}
+
+TEST_F(string_test, stream_input)
+{
+  std::string long_token(5000, 'x');
+  std::istringstream is("  first\tsecond\n" + long_token);
+  string token;
+  is >> token;
+  EXPECT_EQ(token, "first");
+  is >> token;
+  EXPECT_EQ(token, "second");
+  is >> token;
+  EXPECT_EQ(token.size(), 5000);
+  EXPECT_EQ(token, string(5000, 'x'));
+  EXPECT_TRUE(is.eof());
+  EXPECT_FALSE(is >> token);
+}
+
+TEST_F(string_test, stream_input_width)
+{
+  std::istringstream is("abcdef");
+  string token;
+  is >> std::setw(3) >> token;
+  EXPECT_EQ(token, "abc");
+  is >> token;
+  EXPECT_EQ(token, "def");
+}
+
+TEST_F(string_test, getline)
+{
+  std::istringstream is("a longer first line\n\nlast");
+  string line;
+  EXPECT_TRUE(getline(is, line));
+  EXPECT_EQ(line, "a longer first line");
+  size_t cap = line.capacity();
+  EXPECT_TRUE(getline(is, line));
+  EXPECT_TRUE(line.empty());
+  EXPECT_EQ(line.capacity(), cap);
+  EXPECT_TRUE(getline(is, line));
+  EXPECT_EQ(line, "last");
+  EXPECT_TRUE(is.eof());
+  EXPECT_FALSE(getline(is, line));
+
+  std::istringstream csv("x,y");
+  getline(csv, line, ',');
+  EXPECT_EQ(line, "x");
+}
+
+TEST_F(string_test, split)
+{
+  vector<string> parts = split(string("a b  c"));
+  EXPECT_EQ(parts.size(), 4);
+  EXPECT_EQ(parts[0], "a");
+  EXPECT_EQ(parts[1], "b");
+  EXPECT_TRUE(parts[2].empty());
+  EXPECT_EQ(parts[3], "c");
+}
+
+// index of keyword in a space separated list, or -1; runs at compile time
+constexpr int keyword_index(const char* list, string_view keyword)
+{
+  string text(list);
+  int index = 0;
+  string word;
+  for (size_t i = 0; i <= text.size(); ++i)
+  {
+    if (i == text.size() || text[i] == ' ')
+    {
+      if (string_view(word) == keyword) return index;
+      word.clear();
+      ++index;
+    }
+    else
+    {
+      word += text[i];
+    }
+  }
+  return -1;
+}
+
+TEST_F(string_test, constant_evaluation)
+{
+  static_assert(keyword_index("if else while for return", "while") == 2);
+  static_assert(keyword_index("if else while for return", "goto") == -1);
+  static_assert([]() {
+    string s("hello");
+    s.append(", world");
+    s += '!';
+    string t = s.substr(0, 5);
+    t.resize(7, 'x');
+    string u = s;
+    u.replace("l", "L");
+    return s.size() == 13 && t == string("helloxx") && u == string("heLLo, worLd!")
+      && s < t && s.at(12) == '!';
+  }());
+  // appended chars go after the existing ones
+  static_assert([]() {
+    string s("ab");
+    s.append(3, 'c').append(0, 'd').append(1, 'e');
+    return s == string("abccce");
+  }());
+  string runtime("heLLo");
+  EXPECT_EQ(runtime.replace("LL", "ll"), string("hello"));
+}
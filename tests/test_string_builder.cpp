@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "karls_standard_library/string_builder.hpp"
+#include "karls_standard_library/string.hpp"
+
+using namespace karls_standard_library;
+
+class string_builder_test : public testing::Test
+{
+protected:
+  string_builder_test() = default;
+  ~string_builder_test() = default;
+};
+
+TEST_F(string_builder_test, default_constructor)
+{
+  string_builder sb;
+  EXPECT_TRUE(sb.empty());
+  EXPECT_EQ(sb.size(), 0);
+  EXPECT_TRUE(sb.str().empty());
+}
+
+TEST_F(string_builder_test, append_pieces)
+{
+  string_builder sb;
+  string s("world");
+  sb.append("hello").append(", ").append(s);
+  sb += '!';
+  sb += string_view("?!", 1);
+  EXPECT_EQ(sb.size(), 14);
+  EXPECT_EQ(sb.str(), "hello, world!?");
+}
+
+TEST_F(string_builder_test, spans_many_chunks)
+{
+  string_builder sb;
+  string expected;
+  for (int i = 0; i < 10000; ++i)
+  {
+    char c = static_cast<char>('a' + i % 26);
+    sb += c;
+    expected += c;
+  }
+  sb.append(3000, 'z');
+  expected.append(string(3000, 'z'));
+  string result = sb.str();
+  EXPECT_EQ(result.size(), 13000);
+  EXPECT_EQ(result.capacity(), 13000);
+  EXPECT_EQ(result, expected);
+}
+
+TEST_F(string_builder_test, clear_and_reuse)
+{
+  string_builder sb(64);
+  sb.append(string(1000, 'x'));
+  sb.clear();
+  EXPECT_TRUE(sb.empty());
+  sb.append("again");
+  EXPECT_EQ(sb.str(), "again");
+
+  string_builder moved(move(sb));
+  EXPECT_TRUE(sb.empty());
+  EXPECT_EQ(moved.str(), "again");
+}
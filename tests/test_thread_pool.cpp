@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include "karls_standard_library/thread_pool.hpp"
+#include "karls_standard_library/concurrent_unordered_map.hpp"
+#include "karls_standard_library/string.hpp"
+
+using namespace karls_standard_library;
+
+class thread_pool_test : public testing::Test
+{
+protected:
+  thread_pool_test() : pool(4) {}
+  ~thread_pool_test() = default;
+
+  thread_pool pool;
+};
+
+// naive recursive fibonacci; every call forks a task and joins it
+long fib(thread_pool& pool, int n)
+{
+  if (n < 2) return n;
+  auto left = pool.submit([&pool, n]() { return fib(pool, n - 1); });
+  long right = fib(pool, n - 2);
+  return left.get() + right;
+}
+
+TEST_F(thread_pool_test, submit_returns_results)
+{
+  EXPECT_EQ(pool.size(), 4);
+  auto a = pool.submit([]() { return 40 + 2; });
+  auto b = pool.submit([]() { return string("pool"); });
+  std::atomic<int> ran{0};
+  auto c = pool.submit([&ran]() { ran.store(1); });
+  EXPECT_EQ(a.get(), 42);
+  EXPECT_EQ(b.get(), "pool");
+  c.get();
+  EXPECT_EQ(ran.load(), 1);
+  EXPECT_FALSE(a.valid());
+}
+
+TEST_F(thread_pool_test, submit_propagates_exceptions)
+{
+  auto f = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+  EXPECT_THROW(f.get(), std::runtime_error);
+}
+
+TEST_F(thread_pool_test, nested_tasks_do_not_deadlock)
+{
+  // workers waiting on futures run other tasks instead of blocking
+  EXPECT_EQ(fib(pool, 18), 2584);
+}
+
+TEST_F(thread_pool_test, parallel_for_visits_every_index_once)
+{
+  constexpr int n = 10000;
+  static std::atomic<int> hits[n];
+  pool.parallel_for(0, n, 64, [](int i) { hits[i].fetch_add(1, std::memory_order_relaxed); });
+  for (int i = 0; i < n; ++i) EXPECT_EQ(hits[i].load(), 1);
+
+  int calls = 0;
+  pool.parallel_for(5, 5, 1, [&calls](int) { ++calls; });
+  EXPECT_EQ(calls, 0);
+}
+
+TEST_F(thread_pool_test, task_group_joins_and_rethrows)
+{
+  std::atomic<int> sum{0};
+  {
+    task_group group(pool);
+    for (int i = 1; i <= 100; ++i) group.run([&sum, i]() { sum.fetch_add(i); });
+    group.wait();
+    EXPECT_EQ(sum.load(), 5050);
+
+    group.run([]() { throw std::logic_error("bad"); });
+    group.run([&sum]() { sum.fetch_add(1); });
+    EXPECT_THROW(group.wait(), std::logic_error);
+    EXPECT_EQ(sum.load(), 5051);
+  }
+}
+
+TEST_F(thread_pool_test, external_thread_waits_on_group)
+{
+  // the group is destroyed as soon as wait() returns
+  for (int round = 0; round < 200; ++round)
+  {
+    std::atomic<int> done{0};
+    task_group group(pool);
+    group.run([&done]() { done.fetch_add(1); });
+    group.run([&done]() { done.fetch_add(1); });
+    group.wait();
+    EXPECT_EQ(done.load(), 2);
+  }
+}
+
+TEST_F(thread_pool_test, pinned_pool_and_map_shards)
+{
+  thread_pool pinned(2, thread_affinity::pin);
+  concurrent_unordered_map<int, int> map(16);
+  for (int i = 0; i < 1000; ++i) map.insert(i, 1);
+
+  // walk the map's shards in parallel
+  pinned.parallel_for(size_t(0), map.shard_count(), size_t(1), [&map](size_t shard) {
+    map.for_each_in_shard(shard, [](const int&, int& v) { v += 1; });
+  });
+  long total = 0;
+  map.for_each([&total](const int&, int& v) { total += v; });
+  EXPECT_EQ(total, 2000);
+}
+
+TEST_F(thread_pool_test, destructor_runs_queued_tasks)
+{
+  std::atomic<int> ran{0};
+  {
+    thread_pool local(2);
+    for (int i = 0; i < 500; ++i) local.post([&ran]() { ran.fetch_add(1); });
+  }
+  EXPECT_EQ(ran.load(), 500);
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "karls_standard_library/utf8.hpp"
+
+using namespace karls_standard_library;
+
+class utf8_test : public testing::Test
+{
+protected:
+  utf8_test() = default;
+  ~utf8_test() = default;
+
+  // mixed text of one to four byte characters
+  static std::string sample_text(std::mt19937& rng, size_t characters)
+  {
+    const char* pieces[] = {"a", "Z", " ", "\xc3\xa9", "\xd0\x96", "\xe2\x82\xac", "\xe4\xb8\xad", "\xef\xbf\xbd", "\xf0\x9f\x98\x80", "\xf4\x8f\xbf\xbf"};
+    std::string text;
+    for (size_t i = 0; i < characters; ++i) text += pieces[rng() % 10];
+    return text;
+  }
+
+  // validate at every offset so both the block loop and the padded tail
+  // see the interesting bytes
+  static bool valid_everywhere(const std::string& inner, bool expected)
+  {
+    for (size_t prefix : {0, 1, 31, 62, 63, 64, 100})
+    {
+      std::string text = std::string(prefix, 'x') + inner + std::string(prefix % 7, 'y');
+      if (utf8::validate(text.data(), text.size()) != expected) return false;
+      if (detail::validate_utf8_scalar(text.data(), text.size()) != expected) return false;
+    }
+    return true;
+  }
+};
+
+TEST_F(utf8_test, validate)
+{
+  EXPECT_TRUE(utf8::validate(""));
+  EXPECT_TRUE(utf8::validate(string("plain ascii")));
+  for (const char* valid : {"\xc2\x80", "\xdf\xbf", "\xe0\xa0\x80", "\xed\x9f\xbf", "\xee\x80\x80",
+                            "\xef\xbf\xbf", "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf"})
+  {
+    EXPECT_TRUE(valid_everywhere(valid, true)) << valid;
+  }
+  // stray continuation, overlong forms, surrogates, past 10ffff, bad
+  // leads, and sequences cut short
+  for (const char* invalid : {"\x80", "\xbf", "\xc0\x80", "\xc1\xbf", "\xe0\x80\x80", "\xe0\x9f\xbf",
+                              "\xed\xa0\x80", "\xed\xbf\xbf", "\xf0\x80\x80\x80", "\xf0\x8f\xbf\xbf",
+                              "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", "\xff", "\xfe", "\xc2", "\xe2\x82",
+                              "\xf0\x9f\x98", "\xc2\x41", "\xe2\x82\x41", "\xc2\x80\x80", "\xf0\x9f\x98\x80\x80"})
+  {
+    EXPECT_TRUE(valid_everywhere(invalid, false)) << testing::PrintToString(std::string(invalid));
+  }
+  static_assert(utf8::validate("\xe2\x82\xac") && !utf8::validate("\xe2\x82"));
+}
+
+TEST_F(utf8_test, validate_matches_scalar)
+{
+  // random corruption of valid text, compared with the scalar validator
+  std::mt19937 rng(11);
+  for (int round = 0; round < 3000; ++round)
+  {
+    std::string text = sample_text(rng, 1 + rng() % 120);
+    int edits = static_cast<int>(rng() % 3);
+    for (int e = 0; e < edits; ++e) text[rng() % text.size()] = static_cast<char>(rng());
+    ASSERT_EQ(utf8::validate(text.data(), text.size()), detail::validate_utf8_scalar(text.data(), text.size()))
+      << testing::PrintToString(text);
+  }
+}
+
+TEST_F(utf8_test, count_codepoints)
+{
+  EXPECT_EQ(utf8::count_codepoints(""), 0u);
+  EXPECT_EQ(utf8::count_codepoints("h\xc3\xa9llo \xe2\x82\xac \xf0\x9f\x98\x80"), 9u);
+  std::mt19937 rng(5);
+  std::string text = sample_text(rng, 1000);
+  EXPECT_EQ(utf8::count_codepoints(string_view(text.data(), text.size())), 1000u);
+  static_assert(utf8::count_codepoints("\xe2\x82\xac!") == 2);
+}
+
+TEST_F(utf8_test, transcoding)
+{
+  std::mt19937 rng(9);
+  for (size_t characters : {0, 1, 15, 16, 17, 200})
+  {
+    std::string text = sample_text(rng, characters) + std::string(characters % 40, 'q');
+    string_view view(text.data(), text.size());
+
+    vector<char16_t> utf16 = utf8::to_utf16(view);
+    std::u16string expected16;
+    vector<char32_t> utf32 = utf8::to_utf32(view);
+    ASSERT_EQ(utf32.size(), utf8::count_codepoints(view));
+    for (char32_t cp : utf32)
+    {
+      if (cp < 0x10000) expected16 += static_cast<char16_t>(cp);
+      else
+      {
+        expected16 += static_cast<char16_t>(0xd800 + ((cp - 0x10000) >> 10));
+        expected16 += static_cast<char16_t>(0xdc00 + ((cp - 0x10000) & 0x3ff));
+      }
+    }
+    ASSERT_EQ(std::u16string(utf16.begin(), utf16.end()), expected16);
+
+    EXPECT_EQ(utf8::from_utf16(utf16), view);
+    EXPECT_EQ(utf8::from_utf32(utf32), view);
+  }
+
+  vector<char32_t> code_points = utf8::to_utf32("a\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+  EXPECT_EQ(code_points, (vector<char32_t>{U'a', U'é', U'€', U'\U0001f600'}));
+}
+
+TEST_F(utf8_test, transcoding_errors)
+{
+  // the error count is the offset of the first bad unit
+  std::string bad = std::string(40, 'a') + "\xe2\x82" + "b";
+  std::vector<char16_t> out16(bad.size());
+  utf8::transcode_result r = utf8::to_utf16(bad.data(), bad.size(), out16.data());
+  EXPECT_EQ(r.ec, std::errc::illegal_byte_sequence);
+  EXPECT_EQ(r.count, 40u);
+  EXPECT_THROW(utf8::to_utf32(string_view(bad.data(), bad.size())), std::invalid_argument);
+
+  std::u16string lone = u"abcdefghijklmnopq";
+  lone[3] = 0xd800;
+  char out[64];
+  r = utf8::from_utf16(lone.data(), lone.size(), out);
+  EXPECT_EQ(r.ec, std::errc::illegal_byte_sequence);
+  EXPECT_EQ(r.count, 3u);
+  r = utf8::from_utf16(u"\xdc00", 1, out);
+  EXPECT_EQ(r.ec, std::errc::illegal_byte_sequence);
+  EXPECT_THROW(utf8::from_utf16(vector<char16_t>{u'x', 0xd83d}), std::invalid_argument);
+
+  std::u32string too_large = U"0123456789";
+  too_large[9] = 0x110000;
+  r = utf8::from_utf32(too_large.data(), too_large.size(), out);
+  EXPECT_EQ(r.ec, std::errc::illegal_byte_sequence);
+  EXPECT_EQ(r.count, 9u);
+  EXPECT_THROW(utf8::from_utf32(vector<char32_t>{0xdfff}), std::invalid_argument);
+}
+
+TEST_F(utf8_test, ascii_case)
+{
+  string s("Hello, WORLD! \xc3\x89t\xc3\xa9 [@`{] abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+  string lower = s;
+  ascii::to_lower(lower);
+  EXPECT_EQ(lower, "hello, world! \xc3\x89t\xc3\xa9 [@`{] abcdefghijklmnopqrstuvwxyz abcdefghijklmnopqrstuvwxyz");
+  string upper = s;
+  ascii::to_upper(upper);
+  EXPECT_EQ(upper, "HELLO, WORLD! \xc3\x89T\xc3\xa9 [@`{] ABCDEFGHIJKLMNOPQRSTUVWXYZ ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+
+  EXPECT_TRUE(ascii::iequals(lower, upper));
+  EXPECT_TRUE(ascii::iequals(s, upper));
+  EXPECT_FALSE(ascii::iequals("[", "{"));
+  EXPECT_FALSE(ascii::iequals("@", "`"));
+  EXPECT_FALSE(ascii::iequals("abc", "abcd"));
+  EXPECT_TRUE(ascii::iequals("", ""));
+
+  // every byte value, against the scalar definition
+  std::string all;
+  for (int c = 0; c < 256; ++c) all += static_cast<char>(c);
+  std::string mapped = all;
+  ascii::to_lower(mapped.data(), mapped.size());
+  for (int c = 0; c < 256; ++c)
+  {
+    char expected = (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : static_cast<char>(c);
+    EXPECT_EQ(mapped[static_cast<size_t>(c)], expected) << c;
+  }
+  std::string shifted = all.substr(1) + all[0];
+  EXPECT_FALSE(ascii::iequals(string_view(all.data(), all.size()), string_view(shifted.data(), shifted.size())));
+
+  static_assert(ascii::iequals("Straße", "STRAßE"));
+}
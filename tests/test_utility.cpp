@@ -1,4 +1,6 @@
 #include <iostream>
+#include <memory>
+#include <string>
 #include <type_traits>
 #include <gtest/gtest.h>
 #include "karls_standard_library/utility.hpp"
@@ -47,3 +49,96 @@ int forward_test::Object::moves = 0;
 int forward_test::Object::destructions = 0;
 
 
+
+class pair_test : public testing::Test
+{
+protected:
+  pair_test() = default;
+  ~pair_test() = default;
+
+  // counts how each member was made
+  struct tracked {
+    static int constructions;
+    static int copies;
+    static int assignments;
+    int value;
+
+    tracked() : value(0) { ++constructions; }
+    tracked(int v) : value(v) { ++constructions; }
+    tracked(const tracked& other) : value(other.value) { ++copies; }
+    tracked& operator=(const tracked& other)
+    {
+      value = other.value;
+      ++assignments;
+      return *this;
+    }
+  };
+
+  void SetUp() override
+  {
+    tracked::constructions = 0;
+    tracked::copies = 0;
+    tracked::assignments = 0;
+  }
+};
+
+int pair_test::tracked::constructions = 0;
+int pair_test::tracked::copies = 0;
+int pair_test::tracked::assignments = 0;
+
+static_assert(std::is_trivially_copyable_v<Pair<int, double>>);
+static_assert(std::is_trivially_copyable_v<Pair<Pair<int, int>, char*>>);
+static_assert(std::is_trivially_copy_constructible_v<Pair<long, float>>);
+static_assert(std::is_trivially_move_assignable_v<Pair<long, float>>);
+static_assert(!std::is_trivially_copyable_v<Pair<int, std::string>>);
+
+TEST_F(pair_test, members_constructed_in_place)
+{
+  Pair<tracked, tracked> p(1, 2);
+  EXPECT_EQ(tracked::constructions, 2);
+  EXPECT_EQ(tracked::assignments, 0);
+  EXPECT_EQ(p.first.value, 1);
+  EXPECT_EQ(p.second.value, 2);
+
+  Pair<tracked, tracked> q(p);
+  EXPECT_EQ(tracked::copies, 2);
+  EXPECT_EQ(q.second.value, 2);
+}
+
+TEST_F(pair_test, construction_and_conversion)
+{
+  Pair<int, double> zero;
+  EXPECT_EQ(zero.first, 0);
+  EXPECT_EQ(zero.second, 0.0);
+
+  Pair<long, double> widened = Pair<int, float>(3, 1.5f);
+  EXPECT_EQ(widened.first, 3);
+  EXPECT_EQ(widened.second, 1.5);
+
+  Pair deduced(1, 'c');
+  static_assert(std::is_same_v<decltype(deduced), Pair<int, char>>);
+
+  auto made = karls_standard_library::make_pair(std::string("key"), 7);
+  EXPECT_EQ(made.first, "key");
+  EXPECT_EQ(made.second, 7);
+
+  // move only members
+  Pair<std::unique_ptr<int>, int> owner(std::make_unique<int>(5), 1);
+  Pair<std::unique_ptr<int>, int> moved(std::move(owner));
+  EXPECT_EQ(*moved.first, 5);
+  EXPECT_EQ(owner.first, nullptr);
+}
+
+TEST_F(pair_test, comparison_and_swap)
+{
+  Pair<int, int> a(1, 2);
+  Pair<int, int> b(1, 3);
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(a != b);
+  EXPECT_EQ(a, (Pair<int, int>(1, 2)));
+  EXPECT_TRUE((Pair<int, double>(1, 0.5)) < (Pair<int, double>(2, 0.0)));
+
+  swap(a, b);
+  EXPECT_EQ(a.second, 3);
+  EXPECT_EQ(b.second, 2);
+}